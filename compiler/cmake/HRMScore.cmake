@@ -0,0 +1,128 @@
+# Scores the solutions by compiling them to HRM assembly and running it in hrmsim.
+# The scores of the last run are kept in WORK_DIR, and the delta is reported against them.
+#
+# cmake -DHRC=<hrc> -DHRMSIM=<hrmsim> -DSOLUTIONS_DIR=<dir> -DWORK_DIR=<dir> -P HRMScore.cmake
+
+foreach(var HRC HRMSIM SOLUTIONS_DIR WORK_DIR)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} is not set")
+    endif()
+endforeach()
+
+file(MAKE_DIRECTORY ${WORK_DIR}/build/ir)
+set(SCORE_FILE ${WORK_DIR}/scores.txt)
+
+# the last scores: "name size speed" per line
+if(EXISTS ${SCORE_FILE})
+    file(STRINGS ${SCORE_FILE} last_scores)
+    foreach(line IN LISTS last_scores)
+        string(REPLACE " " ";" fields "${line}")
+        list(GET fields 0 name)
+        list(GET fields 1 LAST_SIZE_${name})
+        list(GET fields 2 LAST_SPEED_${name})
+    endforeach()
+endif()
+
+function(format_delta current last out)
+    if("${last}" STREQUAL "" OR "${current}" STREQUAL "-" OR "${last}" STREQUAL "-")
+        set(${out} "" PARENT_SCOPE)
+        return()
+    endif()
+    math(EXPR delta "${current} - ${last}")
+    if(delta GREATER 0)
+        set(${out} " (+${delta})" PARENT_SCOPE)
+    elseif(delta LESS 0)
+        set(${out} " (${delta})" PARENT_SCOPE)
+    else()
+        set(${out} "" PARENT_SCOPE)
+    endif()
+endfunction()
+
+file(GLOB solutions ${SOLUTIONS_DIR}/*.hrml)
+list(SORT solutions COMPARE NATURAL)
+
+set(scores "")
+set(total_size 0)
+set(total_speed 0)
+set(failed "")
+
+message("solution        size        speed")
+foreach(solution IN LISTS solutions)
+    get_filename_component(name ${solution} NAME_WE)
+    set(assembly ${WORK_DIR}/${name}.hrm)
+
+    execute_process(
+        COMMAND ${HRC} -s hrm -o ${assembly} ${solution}
+        WORKING_DIRECTORY ${WORK_DIR}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_VARIABLE error)
+    if(NOT result EQUAL 0)
+        message("${name}: failed to compile\n${error}")
+        list(APPEND failed ${name})
+        continue()
+    endif()
+
+    file(STRINGS ${solution} inputs REGEX "^// Input:")
+    file(STRINGS ${solution} outputs REGEX "^// Output:")
+    set(data_args "")
+    if(inputs)
+        string(REGEX REPLACE "^// Input:[ ]*" "" inputs "${inputs}")
+        list(APPEND data_args -I "${inputs}")
+    endif()
+    if(outputs)
+        string(REGEX REPLACE "^// Output:[ ]*" "" outputs "${outputs}")
+        list(APPEND data_args -E "${outputs}")
+    endif()
+
+    execute_process(
+        COMMAND ${HRMSIM} --score ${data_args} ${assembly}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE score
+        ERROR_VARIABLE error
+        OUTPUT_STRIP_TRAILING_WHITESPACE)
+    if(NOT result EQUAL 0)
+        message("${name}: failed to run\n${error}")
+        list(APPEND failed ${name})
+        continue()
+    endif()
+
+    string(REPLACE " " ";" score "${score}")
+    list(GET score 0 size)
+    # without test data the speed means nothing
+    if(inputs)
+        list(GET score 1 speed)
+        math(EXPR total_speed "${total_speed} + ${speed}")
+    else()
+        set(speed "-")
+    endif()
+    math(EXPR total_size "${total_size} + ${size}")
+
+    format_delta(${size} "${LAST_SIZE_${name}}" size_delta)
+    format_delta(${speed} "${LAST_SPEED_${name}}" speed_delta)
+    string(APPEND scores "${name} ${size} ${speed}\n")
+
+    set(line "${name}")
+    string(LENGTH "${line}" length)
+    math(EXPR padding "16 - ${length}")
+    string(REPEAT " " ${padding} spaces)
+    set(size_text "${size}${size_delta}")
+    string(LENGTH "${size_text}" length)
+    math(EXPR padding "12 - ${length}")
+    if(padding LESS 1)
+        set(padding 1)
+    endif()
+    string(REPEAT " " ${padding} size_spaces)
+    message("${line}${spaces}${size_text}${size_spaces}${speed}${speed_delta}")
+endforeach()
+
+string(APPEND scores "total ${total_size} ${total_speed}\n")
+format_delta(${total_size} "${LAST_SIZE_total}" size_delta)
+format_delta(${total_speed} "${LAST_SPEED_total}" speed_delta)
+message("total           ${total_size}${size_delta}    ${total_speed}${speed_delta}")
+
+if(failed)
+    message(FATAL_ERROR "Failed: ${failed}")
+endif()
+
+file(WRITE ${SCORE_FILE} "${scores}")
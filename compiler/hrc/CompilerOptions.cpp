@@ -36,7 +36,7 @@ CompilerOptions parse_arguments(int argc, char **argv)
         ("output,o", po::value<std::string>(), "Output file name") //
         ("optimization,O", po::value<std::string>(), "Optimization level (0-2 or 's' for size)") //
         ("include,I", po::value<std::vector<std::string>>()->multitoken(), "Include paths for header files") //
-        ("stage,s", po::value<std::string>()->implicit_value(""), "Run a specific compilation stage (lexer, parser, etc.)") //
+        ("stage,s", po::value<std::string>()->implicit_value(""), "Run a specific compilation stage (lexer, parser, etc.). 'hrm' emits the HRM assembly") //
         ("help,h", "Show help message") //
         ("version,V", "Show version information") //
         ("verbose,v",
@@ -10,11 +10,11 @@ Utilities::~Utilities()
 {
 }
 
-void Utilities::write_token_list_to_file(FILE *file, const std::vector<TokenPtr> &tokens)
+void Utilities::write_token_list_to_file(FILE *file, const TokenBuffer &tokens)
 {
     int indent = 0;
-    for (const TokenPtr &token : tokens) {
-        std::string name = token->get_token_name();
+    for (std::size_t index = 0; index < tokens.size(); ++index) {
+        std::string name = get_token_name(tokens.token_id(index));
         if (name[0] == 'T') {
             std::fprintf(file, ";\n");
             for (int i = 0; i < indent; ++i) {
@@ -39,7 +39,7 @@ void Utilities::write_token_list_to_file(FILE *file, const std::vector<TokenPtr>
             continue;
         }
 
-        std::fprintf(file, "%s ", token->get_token_name());
+        std::fprintf(file, "%s ", name.c_str());
     }
 }
 
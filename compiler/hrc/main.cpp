@@ -1,21 +1,26 @@
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 #include <spdlog/spdlog.h>
 
 #include "ASTBuilder.h"
 #include "ASTNodeGraphvizBuilder.h"
+#include "ASTParser.h"
+#include "ASTSimplificationPass.h"
 #include "ClearSymbolTablePass.h"
 #include "CompilerOptions.h"
-#include "ConstantFoldingPass.h"
 #include "ControlFlowVerificationPass.h"
-#include "DeadCodeEliminationPass.h"
 #include "ErrorManager.h"
 #include "FileManager.h"
+#include "HRMAssemblyEmitter.h"
 #include "HRLLexer.h"
 #include "IRGenOptions.h"
 #include "IROptimizationPassManager.h"
 #include "IRProgramStructure.h"
+#include "LowerToLIRPass.h"
 #include "ParseTreeNodeForward.h"
 #include "ParseTreeNodeGraphvizBuilder.h"
 #include "RecursiveDescentParser.h"
@@ -64,7 +69,7 @@ int main(int argc, char **argv)
     errmgr.add_common_filters();
 
     HRLLexer lexer;
-    std::vector<TokenPtr> tokens;
+    TokenBuffer tokens;
 
     bool ok = lexer.lex(file, fileManager.get_input_file_path(), tokens);
     if (!ok) {
@@ -73,40 +78,54 @@ int main(int argc, char **argv)
         abort();
     }
 
+    const bool emit_hrm = options.stage == "hrm";
+
     // bullshit
-    FILE *output = fileManager.open_output_file();
-    if (output == nullptr) {
-        output = stdout;
-    } else {
-        Utilities::write_token_list_to_file(output, tokens);
+    if (!emit_hrm) {
+        FILE *output = fileManager.open_output_file();
+        if (output != nullptr) {
+            Utilities::write_token_list_to_file(output, tokens);
+        }
     }
 
     fclose(file);
 
-    // Parser stage
-    hrl::parser::RecursiveDescentParser parser(options.input_file, tokens);
-    hrl::parser::CompilationUnitPTNodePtr compilation_unit;
-    bool parsed = parser.parse(compilation_unit);
-    if (!parsed) {
-        errmgr.print_all();
-        spdlog::error("Error occured during parsing");
-        abort();
-    }
-    hrl::parser::ParseTreeNodeGraphvizBuilder graphviz(compilation_unit);
-    graphviz.generate_graphviz("build/pt.dot");
-
+    // Parser stage. The parse tree is only built for its graph, emitting HRM parses straight into the AST.
     hrl::parser::CompilationUnitASTNodePtr ast;
-    hrl::parser::ASTBuilder builder(compilation_unit);
-    if (!builder.build(ast)) {
-        errmgr.print_all();
-        spdlog::error("Error occured during AST construction");
-        abort();
+    if (emit_hrm) {
+        hrl::parser::ASTParser parser(options.input_file, tokens);
+        if (!parser.parse(ast)) {
+            errmgr.print_all();
+            spdlog::error("Error occured during parsing");
+            abort();
+        }
+    } else {
+        hrl::parser::RecursiveDescentParser parser(options.input_file, tokens);
+        hrl::parser::CompilationUnitPTNodePtr compilation_unit;
+        bool parsed = parser.parse(compilation_unit);
+        if (!parsed) {
+            errmgr.print_all();
+            spdlog::error("Error occured during parsing");
+            abort();
+        }
+        hrl::parser::ParseTreeNodeGraphvizBuilder graphviz(compilation_unit);
+        graphviz.generate_graphviz("build/pt.dot");
+
+        hrl::parser::ASTBuilder builder(compilation_unit, tokens.source(), tokens.strings());
+        if (!builder.build(ast)) {
+            errmgr.print_all();
+            spdlog::error("Error occured during AST construction");
+            abort();
+        }
     }
 
     hrl::parser::ASTNodeGraphvizBuilder graphviz_ast(ast);
     graphviz_ast.generate_graphviz("build/ast.dot");
 
     hrl::semanalyzer::SemanticAnalysisPassManager sem_passmgr(ast, std::make_shared<std::string>(options.input_file));
+    sem_passmgr.set_fusion_enabled(true);
+    sem_passmgr.set_thread_count(std::thread::hardware_concurrency());
+    sem_passmgr.set_change_tracking_enabled(true);
 
     // analyze, optimize and clean up
     if (true) {
@@ -114,8 +133,7 @@ int main(int argc, char **argv)
         auto pre_symtbl_analyzer = sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>("PreliminarySymbolTableAnalyzer");
         auto ubi_preliminary = sem_passmgr.add_pass<hrl::semanalyzer::UseBeforeInitializationCheckPass>("PreliminaryUseBeforeInitializationCheckPass");
         // may mutate the node
-        auto constfolder = sem_passmgr.add_pass<hrl::semanalyzer::ConstantFoldingPass>("ConstantFoldingPass");
-        auto dce = sem_passmgr.add_pass<hrl::semanalyzer::DeadCodeEliminationPass>("DeadCodeElimination");
+        auto simplifier = sem_passmgr.add_pass<hrl::semanalyzer::ASTSimplificationPass>("ASTSimplificationPass");
         auto unused_var = sem_passmgr.add_pass<hrl::semanalyzer::UnusedSymbolAnalysisPass>("UnusedVariableElimination");
         auto clear_symtbl = sem_passmgr.add_pass<hrl::semanalyzer::ClearSymbolTablePass>("ClearSymbolTablePass");
         auto strip_sym_attr = sem_passmgr.add_pass<hrl::semanalyzer::StripAttributePass>("StripSymbolAttributesPass");
@@ -146,7 +164,32 @@ int main(int argc, char **argv)
         abort();
     }
 
-    std::cout << prog->to_string(true);
+    if (!emit_hrm) {
+        std::cout << prog->to_string(true);
+        return 0;
+    }
+
+    hrl::irgen::IROptimizationPassManager lowering_passmgr(prog, irgen_options);
+    lowering_passmgr.add_pass<hrl::irgen::LowerToLIRPass>("LowerToLIRPass", "build/ir/lir.hrasm");
+    if (lowering_passmgr.run(true) != 0) {
+        spdlog::error("Error occured lowering to LIR");
+        abort();
+    }
+
+    std::ostringstream assembly;
+    hrl::irgen::HRMAssemblyEmitter emitter(prog);
+    if (emitter.emit(assembly) != 0) {
+        spdlog::error("Error occured emitting HRM assembly");
+        abort();
+    }
+    spdlog::info("HRM assembly size: {}", emitter.get_size());
+
+    if (options.output_file) {
+        std::ofstream output(*options.output_file);
+        output << assembly.str();
+    } else {
+        std::cout << assembly.str();
+    }
 
     return 0;
 }
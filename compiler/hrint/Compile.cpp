@@ -1,28 +1,29 @@
 #include <cerrno>
 #include <cstring>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <spdlog/spdlog.h>
 
-#include "ASTBuilder.h"
 #include "ASTNodeForward.h"
+#include "ASTParser.h"
+#include "ASTSimplificationPass.h"
 #include "AnalyzeLivenessPass.h"
 #include "BuildControlFlowGraphPass.h"
 #include "BuildSSAPass.h"
 #include "ClearSymbolTablePass.h"
 #include "Compile.h"
-#include "ConstantFoldingPass.h"
 #include "ControlFlowVerificationPass.h"
-#include "DeadCodeEliminationPass.h"
 #include "EliminateDeadBasicBlockPass.h"
 #include "ErrorManager.h"
 #include "HRLLexer.h"
 #include "IRGenOptions.h"
 #include "IROptimizationPassManager.h"
 #include "InterpreterOptions.h"
+#include "LowerToLIRPass.h"
 #include "MergeConditionalBranchPass.h"
-#include "RecursiveDescentParser.h"
+#include "PartialEvaluationPass.h"
 #include "RemoveDeadInstructionsPass.h"
 #include "RenumberVariableIdPass.h"
 #include "SemanticAnalysisPassManager.h"
@@ -33,6 +34,7 @@
 #include "TACGen.h"
 #include "UnusedSymbolAnalysisPass.h"
 #include "UseBeforeInitializationCheckPass.h"
+#include "VariableSlotResolutionPass.h"
 #include "VerifySSAPass.h"
 #include "hrint_global.h"
 
@@ -55,23 +57,20 @@ int compile_to_ast_and_hir(const InterpreterOptions &options, hrl::parser::Compi
 
     // Lexing
     hrl::lexer::HRLLexer lexer;
-    std::vector<hrl::lexer::TokenPtr> tokens;
+    hrl::lexer::TokenBuffer tokens;
     bool ok = lexer.lex(file, options.input_file, tokens);
     fclose(file);
     CHECK_OK(ok);
 
-    // Parsing
-    hrl::parser::RecursiveDescentParser parser(options.input_file, tokens);
-    hrl::parser::CompilationUnitPTNodePtr compilation_unit;
-    bool parsed = parser.parse(compilation_unit);
+    // Parsing, straight into the AST
+    hrl::parser::ASTParser parser(options.input_file, tokens);
+    bool parsed = parser.parse(ast);
     CHECK_OK(parsed);
 
-    // Building AST
-    hrl::parser::ASTBuilder builder(compilation_unit);
-    bool built = builder.build(ast);
-    CHECK_OK(built);
-
     hrl::semanalyzer::SemanticAnalysisPassManager sem_passmgr(ast, std::make_shared<std::string>(options.input_file));
+    sem_passmgr.set_fusion_enabled(true);
+    sem_passmgr.set_thread_count(std::thread::hardware_concurrency());
+    sem_passmgr.set_change_tracking_enabled(true);
 
     // analyze, optimize and clean up
     if (options.enable_opt) {
@@ -79,8 +78,7 @@ int compile_to_ast_and_hir(const InterpreterOptions &options, hrl::parser::Compi
         auto pre_symtbl_analyzer = sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>("PreliminarySemanticAnalysisSymbolTableAnalyzer");
         auto ubi_preliminary = sem_passmgr.add_pass<hrl::semanalyzer::UseBeforeInitializationCheckPass>("PreliminaryUseBeforeInitializationCheckPass");
         // may mutate the node
-        auto constfolder = sem_passmgr.add_pass<hrl::semanalyzer::ConstantFoldingPass>("ConstantFoldingPass");
-        auto dce = sem_passmgr.add_pass<hrl::semanalyzer::DeadCodeEliminationPass>("DeadCodeElimination");
+        auto simplifier = sem_passmgr.add_pass<hrl::semanalyzer::ASTSimplificationPass>("ASTSimplificationPass");
         auto unused_var = sem_passmgr.add_pass<hrl::semanalyzer::UnusedSymbolAnalysisPass>("UnusedVariableElimination");
         auto clear_symtbl = sem_passmgr.add_pass<hrl::semanalyzer::ClearSymbolTablePass>("ClearSymbolTablePass");
         auto strip_sym_attr = sem_passmgr.add_pass<hrl::semanalyzer::StripAttributePass>("StripSymbolAttributesPass");
@@ -90,6 +88,7 @@ int compile_to_ast_and_hir(const InterpreterOptions &options, hrl::parser::Compi
     auto post_symtbl_analyzer = sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>("FinalSemanticAnalysisSymbolTableAnalyzer");
     auto ubi_final = sem_passmgr.add_pass<hrl::semanalyzer::UseBeforeInitializationCheckPass>("FinalUseBeforeInitializationCheckPass");
     auto cfv = sem_passmgr.add_pass<hrl::semanalyzer::ControlFlowVerificationPass>("ControlFlowVerificationPass");
+    auto slot_resolver = sem_passmgr.add_pass<hrl::semanalyzer::VariableSlotResolutionPass>("VariableSlotResolutionPass");
     auto tacgen = sem_passmgr.add_pass<hrl::irgen::TACGen>("TACGen");
 
     int sema_result = sem_passmgr.run(true);
@@ -110,6 +109,9 @@ int transform_hir(const InterpreterOptions &options, const irgen::ProgramPtr &pr
     }
 
     hrl::irgen::IRGenOptions irgen_opt;
+    if (options.enable_opt) {
+        irgen_opt.MultiplyLowering = hrl::irgen::IROptimizationFor::OptForSpeed;
+    }
     hrl::irgen::IROptimizationPassManager irop_passmgr(program, irgen_opt);
     irop_passmgr.add_pass<hrl::irgen::RemoveDeadInstructionsPass>(
         "StripNoOpPass",
@@ -131,6 +133,12 @@ int transform_hir(const InterpreterOptions &options, const irgen::ProgramPtr &pr
         "EliminateDeadBasicBlockPass",
         "build/edbb.hrasm",
         "build/edbb.dot");
+    if (options.enable_opt) {
+        irop_passmgr.add_pass<hrl::interpreter::PartialEvaluationPass>(
+            "PartialEvaluationPass",
+            "build/pe.hrasm",
+            "build/pe.dot");
+    }
     irop_passmgr.add_pass<hrl::irgen::AnalyzeLivenessPass>(
         "AnalyzeLivenessPassPreSSA",
         "build/liveness.hrasm",
@@ -155,6 +163,13 @@ int transform_hir(const InterpreterOptions &options, const irgen::ProgramPtr &pr
         // there's no opt passes yet
     }
 
+    if (options.compile_target >= CompileTarget::LIR_SSA) {
+        irop_passmgr.add_pass<hrl::irgen::LowerToLIRPass>(
+            "LowerToLIRPass",
+            "build/lir.hrasm",
+            "build/lir.dot");
+    }
+
     ErrorManager::instance().print_all();
     int irgen_result = irop_passmgr.run(true);
     if (irgen_result != 0) {
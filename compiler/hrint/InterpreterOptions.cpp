@@ -51,6 +51,8 @@ static CompileTarget string_to_compile_target(const std::string &str)
 {
     if (str == "AST") {
         return CompileTarget::AST;
+    } else if (str == "AST_FAST") {
+        return CompileTarget::AST_FAST;
     } else if (str == "HIR") {
         return CompileTarget::HIR;
     } else if (str == "HIR_SSA") {
@@ -72,8 +74,9 @@ InterpreterOptions parse_arguments(int argc, char **argv)
         ("version,V", "Show version information") //
         ("input,i", po::value<std::string>(&options.input_file)->required(), "Input source file") //
         ("input-data,I", po::value<std::string>(), "Input data as comma-separated values or a file") //
-        ("compile-target,c", po::value<std::string>()->default_value("AST"), "Compile target (AST, HIR, HIR_SSA, LIR_SSA)") //
+        ("compile-target,c", po::value<std::string>()->default_value("AST"), "Compile target (AST, AST_FAST, HIR, HIR_SSA, LIR_SSA)") //
         ("no-opt", po::bool_switch()->default_value(false), "Disable optimizations") //
+        ("stats", po::bool_switch()->default_value(false), "Print runtime statistics as JSON after execution") //
         ("verbose,v",
             po::value<std::string>()
                 ->implicit_value("debug")
@@ -138,6 +141,7 @@ InterpreterOptions parse_arguments(int argc, char **argv)
     }
 
     options.enable_opt = !vm["no-opt"].as<bool>();
+    options.print_stats = vm["stats"].as<bool>();
 
     if (vm.count("compile-target")) {
         std::string target_str = vm["compile-target"].as<std::string>();
@@ -8,9 +8,10 @@
 
 enum class CompileTarget {
     AST = 0,
-    HIR = 1,
-    HIR_SSA = 2,
-    LIR_SSA = 3,
+    AST_FAST = 1,
+    HIR = 2,
+    HIR_SSA = 3,
+    LIR_SSA = 4,
 };
 
 enum class VerbosityLevel {
@@ -24,6 +25,7 @@ struct InterpreterOptions {
     std::string input_file;
     std::vector<hrl::interpreter::HRMByte> input_data;
     bool enable_opt = true;
+    bool print_stats = false;
     VerbosityLevel verbosity = VerbosityLevel::Normal;
     CompileTarget compile_target;
 };
@@ -8,6 +8,7 @@
 #include "ASTInterpreter.h"
 #include "ASTNodeForward.h"
 #include "Compile.h"
+#include "CompiledASTInterpreter.h"
 #include "IRInterpreter.h"
 #include "IRProgramStructure.h"
 #include "InterpreterAccumulator.h"
@@ -15,6 +16,7 @@
 #include "InterpreterMemoryManager.h"
 #include "InterpreterExceptions.h"
 #include "InterpreterOptions.h"
+#include "LIRInterpreter.h"
 #include "SymbolTable.h"
 #include "TerminalColor.h"
 
@@ -67,6 +69,9 @@ int main(int argc, char **argv)
     case CompileTarget::AST:
         interpreter = new ASTInterpreter(std::make_shared<std::string>(options.input_file), ast, symtbl, ioman, memman);
         break;
+    case CompileTarget::AST_FAST:
+        interpreter = new CompiledASTInterpreter(std::make_shared<std::string>(options.input_file), ast, symtbl, ioman, memman);
+        break;
     case CompileTarget::HIR_SSA:
         enforce_ssa = true;
         [[fallthrough]];
@@ -74,8 +79,8 @@ int main(int argc, char **argv)
         interpreter = new IRInterpreter(ioman, memman, program, enforce_ssa);
         break;
     case CompileTarget::LIR_SSA:
-        spdlog::error("Not yet implemented for LIR SSA");
-        throw;
+        interpreter = new LIRInterpreter(ioman, memman, program);
+        break;
     default:
         spdlog::error("Unknown compile target. {}", __PRETTY_FUNCTION__);
         throw;
@@ -107,6 +112,13 @@ int main(int argc, char **argv)
         }
     }
 
+    if (options.print_stats) {
+        if (!AbstractInterpreter::statistics_enabled()) {
+            spdlog::warn("hrint is built without HRL_INTERPRETER_STATISTICS. All statistics are zero.");
+        }
+        std::cout << interpreter->get_statistics().to_json() << std::endl;
+    }
+
     delete interpreter;
     return 0;
 }
@@ -0,0 +1,112 @@
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include "HRMByte.h"
+#include "SimulatorOptions.h"
+#include "Versioning.h"
+
+namespace po = boost::program_options;
+
+static std::vector<hrl::interpreter::HRMByte> parse_data(const std::string &data_str)
+{
+    std::vector<hrl::interpreter::HRMByte> data;
+    std::vector<std::string> tokens;
+    boost::split(tokens, data_str, boost::is_any_of(","));
+
+    for (auto &token : tokens) {
+        boost::algorithm::trim(token);
+        int value;
+
+        if (token.empty()) {
+            continue;
+        } else if (token.size() == 1 && std::isalpha(token[0])) {
+            char ch = static_cast<char>(std::toupper(token[0]));
+            data.push_back(hrl::interpreter::HRMByte(ch));
+        } else if (std::from_chars(token.data(), token.data() + token.size(), value).ec == std::errc()) {
+            data.push_back(hrl::interpreter::HRMByte(value));
+        } else {
+            throw std::runtime_error("Invalid data: " + token);
+        }
+    }
+
+    return data;
+}
+
+SimulatorOptions parse_arguments(int argc, char **argv)
+{
+    SimulatorOptions options;
+
+    po::options_description desc("Allowed options");
+    desc.add_options() //
+        ("help,h", "Display help message") //
+        ("version,V", "Show version information") //
+        ("input,i", po::value<std::string>(&options.input_file)->required(), "HRM assembly file") //
+        ("input-data,I", po::value<std::vector<std::string>>()->composing(), "An input set as comma-separated values. Can be repeated") //
+        ("expected-output,E", po::value<std::vector<std::string>>()->composing(), "The output expected from the input set of the same position. Can be repeated") //
+        ("score", po::bool_switch(&options.score_only), "Print the size and speed scores only") //
+        ("verbose,v", po::bool_switch(&options.verbose), "Print the debug messages");
+
+    po::positional_options_description pos_desc;
+    pos_desc.add("input", 1);
+
+    po::variables_map vm;
+    try {
+        po::store(po::command_line_parser(argc, argv)
+                      .options(desc)
+                      .positional(pos_desc)
+                      .run(),
+            vm);
+
+        if (vm.count("help")) {
+            std::cout << "Usage: " << argv[0] << " [options] [input_file]\n";
+            std::cout << desc << std::endl;
+            exit(EXIT_SUCCESS);
+        }
+
+        if (vm.count("version")) {
+            std::cout << "hrmsim simulator " << git_tag() << std::endl;
+            std::cout << "built with " << compiler_version() << " (" << build_type() << ") on " << build_timestamp() << std::endl;
+            std::cout << "    Report bugs at https://github.com/sakamoto-poteko/HumanResourceCompiler" << std::endl;
+            exit(EXIT_SUCCESS);
+        }
+
+        po::notify(vm);
+    } catch (const po::error &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        std::cerr << "Usage: " << argv[0] << " [options] [input_file]\n";
+        std::cerr << desc << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    try {
+        if (vm.count("input-data")) {
+            for (const std::string &data : vm["input-data"].as<std::vector<std::string>>()) {
+                options.input_sets.push_back(parse_data(data));
+            }
+        }
+        if (vm.count("expected-output")) {
+            for (const std::string &data : vm["expected-output"].as<std::vector<std::string>>()) {
+                options.expected_outputs.push_back(parse_data(data));
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to parse data: " << e.what() << "\n";
+        exit(EXIT_FAILURE);
+    }
+
+    if (options.input_sets.empty()) {
+        options.input_sets.emplace_back();
+    }
+    if (options.expected_outputs.size() > options.input_sets.size()) {
+        std::cerr << "There are more expected outputs than input sets\n";
+        exit(EXIT_FAILURE);
+    }
+
+    return options;
+}
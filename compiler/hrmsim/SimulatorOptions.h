@@ -0,0 +1,22 @@
+#ifndef SIMULATOROPTIONS_H
+#define SIMULATOROPTIONS_H
+
+#include <string>
+#include <vector>
+
+#include "HRMByte.h"
+
+struct SimulatorOptions {
+    std::string input_file;
+    // each set is run separately and scored
+    std::vector<std::vector<hrl::interpreter::HRMByte>> input_sets;
+    // the output expected from each input set, if given
+    std::vector<std::vector<hrl::interpreter::HRMByte>> expected_outputs;
+    // print the scores only
+    bool score_only = false;
+    bool verbose = false;
+};
+
+SimulatorOptions parse_arguments(int argc, char **argv);
+
+#endif
@@ -0,0 +1,87 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string/join.hpp>
+#include <spdlog/spdlog.h>
+
+#include "HRMAssemblySimulator.h"
+#include "HRMByte.h"
+#include "InterpreterExceptions.h"
+#include "InterpreterIOManager.h"
+#include "InterpreterMemoryManager.h"
+#include "SimulatorOptions.h"
+
+using namespace hrl::interpreter;
+
+static std::string to_string(const std::vector<HRMByte> &data)
+{
+    std::vector<std::string> strings;
+    for (const HRMByte &value : data) {
+        std::ostringstream ss;
+        ss << value;
+        strings.push_back(ss.str());
+    }
+    return boost::algorithm::join(strings, ",");
+}
+
+int main(int argc, char **argv)
+{
+    spdlog::set_pattern("%^[%l]%$ %v");
+
+    SimulatorOptions options = parse_arguments(argc, argv);
+    spdlog::set_level(options.verbose ? spdlog::level::debug : spdlog::level::warn);
+
+    std::ifstream file(options.input_file);
+    if (!file) {
+        spdlog::error("Cannot open input file: '{}'", options.input_file);
+        exit(EXIT_FAILURE);
+    }
+    std::stringstream assembly;
+    assembly << file.rdbuf();
+
+    bool all_passed = true;
+    for (std::size_t i = 0; i < options.input_sets.size(); ++i) {
+        InterpreterMemoryManager memman;
+        InterpreterIOManager ioman;
+        HRMAssemblySimulator simulator(ioman, memman, assembly.str());
+
+        for (const HRMByte &input : options.input_sets[i]) {
+            ioman.push_input(input);
+        }
+        std::vector<HRMByte> outputs;
+        ioman.set_on_output_pushed([&outputs](HRMByte value) {
+            outputs.push_back(value);
+        });
+
+        try {
+            if (simulator.exec() != 0) {
+                exit(EXIT_FAILURE);
+            }
+        } catch (const InterpreterException &ex) {
+            if (ex.get_error_type() != InterpreterException::ErrorType::EndOfInput) {
+                spdlog::error("Input set {}: {}", i + 1, ex.what());
+                all_passed = false;
+                continue;
+            }
+        }
+
+        if (i < options.expected_outputs.size() && outputs != options.expected_outputs[i]) {
+            spdlog::error("Input set {}: the output '{}' is not the expected '{}'", i + 1, to_string(outputs), to_string(options.expected_outputs[i]));
+            all_passed = false;
+            continue;
+        }
+
+        if (options.score_only) {
+            std::cout << simulator.get_size() << " " << simulator.get_steps() << std::endl;
+        } else {
+            std::cout << "Input set " << i + 1 << ": size " << simulator.get_size() << ", speed " << simulator.get_steps() << std::endl;
+            std::cout << "  output: " << to_string(outputs) << std::endl;
+        }
+    }
+
+    return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,12 +1,15 @@
 #ifndef AST_INTERPRETER_H
 #define AST_INTERPRETER_H
 
+#include <cstddef>
 #include <list>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "ASTNodeForward.h"
 #include "AbstractInterpreter.h"
+#include "HRMByte.h"
 #include "InterpreterAccumulator.h"
 #include "InterpreterIOManager.h"
 #include "InterpreterMemoryManager.h"
@@ -39,6 +42,9 @@ public:
     // tuple<invoking statement, invoked function>, left is bottom
     std::vector<std::tuple<parser::InvocationExpressionASTNodePtr, parser::AbstractSubroutineASTNodePtr>> get_call_stack() const;
 
+protected:
+    std::string get_opcode_name(std::size_t opcode) const override;
+
 private:
     enum ControlFlowState : int {
         CF_Normal = 0,
@@ -104,16 +110,25 @@ private:
 
     // [End Group]
 
+    // indexed by the slots from VariableSlotResolutionPass. nullopt if not assigned yet.
+    using VariableSlots = std::vector<std::optional<HRMByte>>;
+
     struct CallFrame {
         parser::AbstractSubroutineASTNodePtr subroutine_node;
         parser::InvocationExpressionASTNodePtr invocation_node;
-        std::map<semanalyzer::SymbolPtr, HRMByte> variables;
+        VariableSlots variables;
     };
 
-    void set_variable(const semanalyzer::SymbolPtr &symbol, HRMByte value);
-    bool get_variable(const semanalyzer::SymbolPtr &symbol, HRMByte &value);
-    std::map<semanalyzer::SymbolPtr, HRMByte> _global_variables;
+    static unsigned int get_frame_size(const parser::ASTNodePtr &node);
+    std::optional<HRMByte> &get_variable_slot(const parser::ASTNodePtr &node);
+    void set_variable(const parser::ASTNodePtr &node, HRMByte value);
+    bool get_variable(const parser::ASTNodePtr &node, HRMByte &value);
+    VariableSlots _global_variables;
+    // start runs without a call frame
+    VariableSlots _start_variables;
     std::list<CallFrame> _call_stack;
+    // the global initializers run before start, so their calls are one level shallower
+    bool _start_entered = false;
 };
 
 CLOSE_INTERPRETER_NAMESPACE
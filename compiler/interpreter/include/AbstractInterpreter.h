@@ -1,9 +1,13 @@
 #ifndef ABSTRACTINTERPRETER_H
 #define ABSTRACTINTERPRETER_H
 
+#include <cstddef>
+#include <string>
+
 #include "InterpreterAccumulator.h"
 #include "InterpreterIOManager.h"
 #include "InterpreterMemoryManager.h"
+#include "InterpreterStatistics.h"
 #include "interpreter_global.h"
 
 OPEN_INTERPRETER_NAMESPACE
@@ -13,6 +17,14 @@ public:
     virtual ~AbstractInterpreter() = default;
     virtual int exec() = 0;
 
+    /**
+     * @brief Get the statistics of the last exec(). The counters are only collected when built with
+     * HRL_INTERPRETER_STATISTICS, otherwise everything is zero.
+     */
+    const InterpreterStatistics &get_statistics() const { return _statistics; }
+
+    static constexpr bool statistics_enabled() { return InterpreterStatisticsCounter::enabled; }
+
 protected:
     AbstractInterpreter(InterpreterIOManager &ioman, InterpreterMemoryManager &memman);
     InterpreterIOManager &get_io_manager();
@@ -20,6 +32,38 @@ protected:
 
     InterpreterIOManager &_io_manager;
     InterpreterMemoryManager &_memory_manager;
+    InterpreterStatisticsCounter _counter;
+
+    /**
+     * @brief Name of the opcode counted by _counter.instruction()
+     */
+    virtual std::string get_opcode_name(std::size_t opcode) const = 0;
+
+    /**
+     * @brief Starts the counters on construction and publishes them on destruction, so the statistics
+     * are also available when exec() leaves with an exception like end of input.
+     */
+    class StatisticsScope {
+    public:
+        explicit StatisticsScope(AbstractInterpreter &interpreter)
+            : _interpreter(interpreter)
+        {
+            _interpreter._counter.begin();
+        }
+
+        ~StatisticsScope()
+        {
+            _interpreter._counter.end(_interpreter._statistics, [this](std::size_t opcode) {
+                return _interpreter.get_opcode_name(opcode);
+            });
+        }
+
+    private:
+        AbstractInterpreter &_interpreter;
+    };
+
+private:
+    InterpreterStatistics _statistics;
 };
 
 CLOSE_INTERPRETER_NAMESPACE
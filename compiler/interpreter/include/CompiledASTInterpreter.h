@@ -0,0 +1,129 @@
+#ifndef COMPILED_AST_INTERPRETER_H
+#define COMPILED_AST_INTERPRETER_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "ASTNode.h"
+#include "ASTNodeForward.h"
+#include "AbstractInterpreter.h"
+#include "HRMByte.h"
+#include "InterpreterIOManager.h"
+#include "InterpreterMemoryManager.h"
+#include "SymbolTable.h"
+#include "hrl_global.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+/**
+ * @brief Executes the analyzed AST like ASTInterpreter, but compiles it once into a tree of closures first.
+ * Symbols, variable slots and invocation targets are resolved at compile time, so the execution is a direct
+ * call chain without visitor dispatch or attribute lookups.
+ *
+ * The AST must be resolved by VariableSlotResolutionPass. The behavior, including the errors raised and the
+ * accumulator observed through subroutine values, matches ASTInterpreter.
+ */
+class CompiledASTInterpreter : public AbstractInterpreter {
+public:
+    CompiledASTInterpreter(
+        StringPtr filename,
+        parser::CompilationUnitASTNodePtr root,
+        semanalyzer::SymbolTablePtr symbol_table,
+        InterpreterIOManager &ioman,
+        InterpreterMemoryManager &memman);
+
+    ~CompiledASTInterpreter();
+
+    int exec() override;
+
+protected:
+    std::string get_opcode_name(std::size_t opcode) const override;
+
+private:
+    enum class Completion {
+        Normal,
+        Return,
+        Break,
+        Continue,
+    };
+
+    // indexed by the slots from VariableSlotResolutionPass. nullopt if not assigned yet.
+    using VariableSlots = std::vector<std::optional<HRMByte>>;
+    using Expression = std::function<HRMByte()>;
+    using Statement = std::function<Completion()>;
+
+    struct CompiledSubroutine {
+        parser::ASTNodeType node_type;
+        unsigned int frame_size = 0;
+        std::optional<unsigned int> parameter_slot;
+        Statement body;
+    };
+
+    StringPtr _filename;
+    parser::CompilationUnitASTNodePtr _root;
+    semanalyzer::SymbolTablePtr _symbol_table;
+
+    // [Group] Compiled program
+    bool _compiled = false;
+    std::map<const parser::ASTNode *, std::unique_ptr<CompiledSubroutine>> _subroutines;
+    const CompiledSubroutine *_start = nullptr;
+    // floor inits and global variable declarations
+    std::vector<Statement> _global_initializers;
+    unsigned int _global_slot_count = 0;
+    // [End Group]
+
+    // [Group] Execution state
+    VariableSlots _global_variables;
+    VariableSlots *_frame = nullptr;
+    // mirrors the accumulator of ASTInterpreter. it's observable through the value of a subroutine without return value.
+    std::optional<HRMByte> _register;
+    std::size_t _call_depth = 0;
+    // [End Group]
+
+    // [Group] Compilation
+    void compile();
+    Statement compile_statement(const parser::ASTNodePtr &node);
+    Expression compile_expression(const parser::AbstractExpressionASTNodePtr &node);
+    Statement compile_variable_assignment(const parser::VariableAssignmentASTNodePtr &node);
+    Statement compile_floor_assignment(const parser::FloorAssignmentASTNodePtr &node, bool is_floor_init);
+    Statement compile_statement_block(const parser::StatementBlockASTNodePtr &node);
+    Statement compile_if(const parser::IfStatementASTNodePtr &node);
+    Statement compile_while(const parser::WhileStatementASTNodePtr &node);
+    Statement compile_for(const parser::ForStatementASTNodePtr &node);
+    Expression compile_condition(const parser::AbstractExpressionASTNodePtr &node);
+    template <bool IsGlobal>
+    Statement compile_variable_store(parser::ASTNodeType node_type, unsigned int slot, Expression value);
+    template <bool IsGlobal>
+    Expression compile_variable_load(parser::ASTNodeType node_type, unsigned int slot);
+    template <bool IsGlobal, bool Increment>
+    Expression compile_bump(parser::ASTNodeType node_type, unsigned int slot, StringPtr var_name);
+    Expression compile_binary_expression(const parser::AbstractBinaryExpressionASTNodePtr &node);
+    Expression compile_invocation(const parser::InvocationExpressionASTNodePtr &node, bool value_used);
+    // [End Group]
+
+    // [Group] Execution helpers
+    template <bool IsGlobal>
+    std::optional<HRMByte> &variable(unsigned int slot)
+    {
+        if constexpr (IsGlobal) {
+            return _global_variables[slot];
+        } else {
+            return (*_frame)[slot];
+        }
+    }
+
+    HRMByte set_register(HRMByte value);
+    HRMByte read_register();
+    void call(const CompiledSubroutine &subroutine, const std::optional<HRMByte> &argument);
+    // [End Group]
+};
+
+CLOSE_INTERPRETER_NAMESPACE
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef HRMASSEMBLYSIMULATOR_H
+#define HRMASSEMBLYSIMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AbstractInterpreter.h"
+#include "HRMByte.h"
+#include "InterpreterAccumulator.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+/**
+ * @brief Executes the HRM assembly text as the game does, and scores it by size and speed.
+ *
+ * Comments, DEFINE blocks and COMMENT instructions are skipped. The lines above the program header of the form
+ * "-- floor[n] = v --" and "-- floor_max = n --" set up the floor, which the game leaves to the level.
+ * The program ends when it runs past the last instruction, or when inbox finds the input empty.
+ */
+class HRMAssemblySimulator : public AbstractInterpreter {
+public:
+    HRMAssemblySimulator(InterpreterIOManager &ioman, InterpreterMemoryManager &memman, const std::string &assembly)
+        : AbstractInterpreter(ioman, memman)
+        , _assembly(assembly)
+    {
+    }
+
+    ~HRMAssemblySimulator() = default;
+
+    /**
+     * @brief Parse and execute the assembly.
+     * @return 0 on success, 1 if the assembly cannot be parsed
+     */
+    int exec() override;
+
+    /**
+     * @brief The size score, the number of instructions. Available after exec().
+     */
+    std::size_t get_size() const { return _instructions.size(); }
+
+    /**
+     * @brief The speed score of the last exec(), the number of instructions executed.
+     */
+    std::uint64_t get_steps() const { return _steps; }
+
+protected:
+    std::string get_opcode_name(std::size_t opcode) const override;
+
+private:
+    enum class Opcode : std::uint8_t {
+        Inbox,
+        Outbox,
+        CopyFrom,
+        CopyTo,
+        Add,
+        Sub,
+        BumpUp,
+        BumpDown,
+        Jump,
+        JumpIfZero,
+        JumpIfNegative,
+    };
+
+    struct Instruction {
+        Opcode opcode;
+        // the floor, or the instruction index to jump to
+        int operand = 0;
+        bool indirect = false;
+    };
+
+    std::string _assembly;
+    std::vector<Instruction> _instructions;
+    std::map<int, HRMByte> _floor_inits;
+    int _floor_max = -1;
+    InterpreterAccumulator _accumulator;
+    std::uint64_t _steps = 0;
+
+    int parse();
+    int address_of(const Instruction &instruction);
+};
+
+CLOSE_INTERPRETER_NAMESPACE
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef IRINTERPRETER_H
 #define IRINTERPRETER_H
 
+#include <cstddef>
 #include <list>
 #include <string>
 
@@ -27,7 +28,20 @@ public:
 
     int exec() override;
 
-private:
+protected:
+    std::string get_opcode_name(std::size_t opcode) const override;
+
+    /**
+     * @brief Called before \p instruction, the \p instruction_index th instruction of \p basic_block, is executed in the
+     * topmost call frame. Derived evaluators throw from here to suspend the execution.
+     */
+    virtual void before_instruction(const irgen::BasicBlockPtr &basic_block, std::size_t instruction_index, const irgen::TACPtr &instruction)
+    {
+        UNUSED(basic_block);
+        UNUSED(instruction_index);
+        UNUSED(instruction);
+    }
+
     struct CallFrame {
         std::string subroutine_name;
         std::map<int, HRMByte> variables;
@@ -39,10 +53,12 @@ private:
 
     irgen::ProgramPtr _program;
     std::map<int, HRMByte> _global_variables;
+    std::list<CallFrame> _calling_stack;
+
+private:
     std::map<std::string, irgen::SubroutinePtr> _subroutines;
     bool _enforce_ssa;
 
-    std::list<CallFrame> _calling_stack;
     HRMByte _return_value;
 
     void exec_subroutine(const irgen::SubroutinePtr &subroutine, HRMByte parameter = HRMByte());
@@ -17,6 +17,8 @@ public:
     bool get_floor(int id, HRMByte &value);
     void set_floor_max(int floormax);
 
+    const std::map<int, HRMByte> &get_floors() const { return _floor; }
+
 private:
     std::map<int, HRMByte> _floor;
     int _floormax = 63;
@@ -0,0 +1,121 @@
+#ifndef INTERPRETER_STATISTICS_H
+#define INTERPRETER_STATISTICS_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+/**
+ * @brief Runtime statistics of one interpreter execution.
+ *
+ * The instruction histogram is keyed by the opcode name of the engine, i.e. the IR operation for
+ * IRInterpreter and the AST node type for ASTInterpreter.
+ */
+struct InterpreterStatistics {
+    std::map<std::string, std::uint64_t> instructions;
+    std::uint64_t instructions_total = 0;
+    std::uint64_t calls = 0;
+    std::uint64_t max_call_depth = 0;
+    std::uint64_t floor_reads = 0;
+    std::uint64_t floor_writes = 0;
+    std::uint64_t inbox = 0;
+    std::uint64_t outbox = 0;
+    std::uint64_t phi_evaluations = 0;
+    std::chrono::nanoseconds wall_time { 0 };
+
+    std::string to_json() const;
+};
+
+/**
+ * @brief Counter policy used by the interpreters. The disabled specialization has empty bodies
+ * so every counting site is compiled away.
+ *
+ * @tparam Enabled Whether the counters are collected
+ */
+template <bool Enabled>
+class StatisticsCounter;
+
+template <>
+class StatisticsCounter<true> {
+public:
+    static constexpr bool enabled = true;
+    static constexpr std::size_t MAX_OPCODES = 256;
+
+    void begin()
+    {
+        _opcodes.fill(0);
+        _stats = InterpreterStatistics();
+        _started_at = std::chrono::steady_clock::now();
+    }
+
+    void instruction(std::size_t opcode) { ++_opcodes[opcode]; }
+
+    void call(std::size_t depth)
+    {
+        ++_stats.calls;
+        _stats.max_call_depth = std::max<std::uint64_t>(_stats.max_call_depth, depth);
+    }
+
+    void floor_read() { ++_stats.floor_reads; }
+    void floor_write() { ++_stats.floor_writes; }
+    void inbox() { ++_stats.inbox; }
+    void outbox() { ++_stats.outbox; }
+    void phi() { ++_stats.phi_evaluations; }
+
+    template <typename OpcodeNameFunc>
+    void end(InterpreterStatistics &out, OpcodeNameFunc opcode_name)
+    {
+        _stats.wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _started_at);
+        for (std::size_t opcode = 0; opcode < MAX_OPCODES; ++opcode) {
+            if (_opcodes[opcode] != 0) {
+                _stats.instructions[opcode_name(opcode)] = _opcodes[opcode];
+                _stats.instructions_total += _opcodes[opcode];
+            }
+        }
+        out = std::move(_stats);
+    }
+
+private:
+    std::array<std::uint64_t, MAX_OPCODES> _opcodes {};
+    InterpreterStatistics _stats;
+    std::chrono::steady_clock::time_point _started_at;
+};
+
+template <>
+class StatisticsCounter<false> {
+public:
+    static constexpr bool enabled = false;
+
+    void begin() { }
+    void instruction(std::size_t) { }
+    void call(std::size_t) { }
+    void floor_read() { }
+    void floor_write() { }
+    void inbox() { }
+    void outbox() { }
+    void phi() { }
+
+    template <typename OpcodeNameFunc>
+    void end(InterpreterStatistics &, OpcodeNameFunc)
+    {
+    }
+};
+
+#ifdef HRL_INTERPRETER_STATISTICS
+using InterpreterStatisticsCounter = StatisticsCounter<true>;
+#else
+using InterpreterStatisticsCounter = StatisticsCounter<false>;
+#endif
+
+CLOSE_INTERPRETER_NAMESPACE
+
+#endif
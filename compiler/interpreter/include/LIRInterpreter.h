@@ -0,0 +1,98 @@
+#ifndef LIRINTERPRETER_H
+#define LIRINTERPRETER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "AbstractInterpreter.h"
+#include "HRMByte.h"
+#include "IROps.h"
+#include "IRProgramStructure.h"
+#include "InterpreterAccumulator.h"
+#include "Operand.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+/**
+ * @brief Executes the LIR lowered by LowerToLIRPass on an accumulator machine, and counts the HRM steps.
+ *
+ * The local tiles are per call frame. The constant tiles are read-only and preset. The floor is the memory manager.
+ * The pseudo instructions c, ret and hlt are executed but not counted as steps.
+ */
+class LIRInterpreter : public AbstractInterpreter {
+public:
+    LIRInterpreter(InterpreterIOManager &ioman, InterpreterMemoryManager &memman, const irgen::ProgramPtr &program)
+        : AbstractInterpreter(ioman, memman)
+        , _program(program)
+    {
+    }
+
+    ~LIRInterpreter() = default;
+
+    int exec() override;
+
+    /**
+     * @brief Get the HRM steps of the last exec(), the number of machine instructions executed. It's counted regardless
+     * of HRL_INTERPRETER_STATISTICS.
+     */
+    std::uint64_t get_steps() const { return _steps; }
+
+protected:
+    std::string get_opcode_name(std::size_t opcode) const override;
+
+private:
+    enum class TileSpace : std::uint8_t {
+        None,
+        Local,
+        Global,
+        Constant,
+    };
+
+    struct Tile {
+        TileSpace space = TileSpace::None;
+        unsigned int index = 0;
+    };
+
+    struct Instruction {
+        irgen::IROperation op;
+        Tile tile;
+        // the instruction index to jump to, or the subroutine index to call
+        std::size_t target = 0;
+    };
+
+    struct LoadedSubroutine {
+        std::string name;
+        std::vector<Instruction> instructions;
+        unsigned int frame_size = 0;
+    };
+
+    using Tiles = std::vector<std::optional<HRMByte>>;
+
+    struct CallFrame {
+        std::size_t subroutine;
+        // where the caller resumes
+        std::size_t return_address;
+        Tiles tiles;
+    };
+
+    irgen::ProgramPtr _program;
+    std::vector<LoadedSubroutine> _subroutines;
+    std::vector<HRMByte> _constants;
+    Tiles _globals;
+    InterpreterAccumulator _accumulator;
+    std::uint64_t _steps = 0;
+
+    std::size_t load();
+    Tile resolve_tile(const irgen::Operand &operand, unsigned int &frame_size);
+    HRMByte read_tile(const Tile &tile, const Tiles &locals) const;
+    std::optional<HRMByte> &writable_tile(const Tile &tile, Tiles &locals);
+    int floor_address(const Tile &tile, const Tiles &locals) const;
+};
+
+CLOSE_INTERPRETER_NAMESPACE
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef PARTIALEVALUATIONPASS_H
+#define PARTIALEVALUATIONPASS_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include "HRMByte.h"
+#include "IRGenOptions.h"
+#include "IROptimizationPass.h"
+#include "IRProgramStructure.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+// depends: CFG, non-SSA HIR
+// produces: CFG
+/**
+ * @brief Runs the program at compile time with IRInterpreter until the first input-dependent operation (inbox, outbox
+ * or halt), a runtime error or the step limit. The floor state is baked into the floor inits, and start gets a new
+ * entry block that restores the globals and the live locals, then jumps to where the evaluation stopped.
+ *
+ * The evaluation can only be resumed at the top level of start. If it stops inside a subroutine called by start,
+ * it resumes at that call.
+ */
+class PartialEvaluationPass : public irgen::IROptimizationPass {
+public:
+    PartialEvaluationPass(const irgen::ProgramPtr &program, const irgen::IRGenOptions &options)
+        : irgen::IROptimizationPass(program, options)
+    {
+    }
+
+    ~PartialEvaluationPass();
+
+    int run() override;
+
+    // The state of start where the execution resumes
+    struct ResumePoint {
+        std::string basic_block_label;
+        std::size_t instruction_index = 0;
+        // instructions executed at compile time
+        std::size_t steps = 0;
+        std::map<int, HRMByte> local_variables;
+        std::map<int, HRMByte> global_variables;
+        std::map<int, HRMByte> floors;
+    };
+
+protected:
+    int run_subroutine(const irgen::SubroutinePtr &subroutine, irgen::ProgramMetadata &metadata, const irgen::ProgramPtr &program) override;
+
+private:
+    bool evaluate(ResumePoint &resume_point);
+    bool rewrite(const ResumePoint &resume_point);
+};
+
+CLOSE_INTERPRETER_NAMESPACE
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <tuple>
@@ -14,6 +15,7 @@
 #include "InterpreterExceptions.h"
 #include "SemanticAnalysisPass.h"
 #include "Symbol.h"
+#include "VariableSlotResolutionPass.h"
 #include "hrl_global.h"
 #include "interpreter_global.h"
 
@@ -73,13 +75,11 @@ int ASTInterpreter::visit(const parser::VariableAssignmentASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    auto symbol = semanalyzer::Symbol::get_from(node);
-
     rc = traverse(node->get_value());
     RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
 
-    spdlog::debug("assigned variable '{}' with value {}", symbol->name, _accumulator.get_register());
-    set_variable(symbol, _accumulator.get_register());
+    spdlog::debug("assigned variable '{}' with value {}", *node->get_name(), _accumulator.get_register());
+    set_variable(node, _accumulator.get_register());
 
     END_VISIT();
 }
@@ -88,16 +88,14 @@ int ASTInterpreter::visit(const parser::VariableAccessASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    auto symbol = semanalyzer::Symbol::get_from(node);
-
     HRMByte value;
-    bool ok = get_variable(symbol, value);
+    bool ok = get_variable(node, value);
     if (!ok) {
         throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Variable is null");
     }
     _accumulator.set_register(value);
 
-    spdlog::debug("loaded variable '{}' with value {}", symbol->name, _accumulator.get_register());
+    spdlog::debug("loaded variable '{}' with value {}", *node->get_name(), _accumulator.get_register());
 
     END_VISIT();
 }
@@ -126,6 +124,10 @@ int ASTInterpreter::visit(const parser::FloorAssignmentASTNodePtr &node)
 
     _accumulator.set_register(value);
     _memory_manager.set_floor(flrid, value);
+    // the floor inits are part of the level setup, not the program
+    if (_ancestors.size() < 2 || _ancestors[_ancestors.size() - 2]->get_node_type() != parser::ASTNodeType::FloorBoxInitStatement) {
+        _counter.floor_write();
+    }
     spdlog::debug("set floor[{}] with value {}", flrid, value);
 
     END_VISIT();
@@ -144,6 +146,7 @@ int ASTInterpreter::visit(const parser::FloorAccessASTNodePtr &node)
     if (!ok) {
         throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
     }
+    _counter.floor_read();
     _accumulator.set_register(value);
 
     spdlog::debug("loaded floor[{}] with value {}", idx, _accumulator.get_register());
@@ -180,41 +183,37 @@ int ASTInterpreter::visit(const parser::NotExpressionASTNodePtr &node)
 int ASTInterpreter::visit(const parser::IncrementExpressionASTNodePtr &node)
 {
     BEGIN_VISIT();
-    auto symbol = semanalyzer::Symbol::get_from(node);
-    assert(symbol);
 
     HRMByte val;
-    bool ok = get_variable(symbol, val);
+    bool ok = get_variable(node, val);
     if (!ok) {
-        spdlog::critical("Variable '{}' is not found.", symbol->to_string());
+        spdlog::critical("Variable '{}' is not found.", *node->get_var_name());
         throw;
     }
     ++val;
-    set_variable(symbol, val);
+    set_variable(node, val);
     _accumulator.set_register(val);
 
-    spdlog::debug("bumped up {} to {}", symbol->name, _accumulator.get_register());
+    spdlog::debug("bumped up {} to {}", *node->get_var_name(), _accumulator.get_register());
     END_VISIT();
 }
 
 int ASTInterpreter::visit(const parser::DecrementExpressionASTNodePtr &node)
 {
     BEGIN_VISIT();
-    auto symbol = semanalyzer::Symbol::get_from(node);
-    assert(symbol);
 
     // NOTE: We don't have --floor[id] logic here.
     HRMByte val;
-    bool ok = get_variable(symbol, val);
+    bool ok = get_variable(node, val);
     if (!ok) {
-        spdlog::critical("Variable '{}' is not found.", symbol->to_string());
+        spdlog::critical("Variable '{}' is not found.", *node->get_var_name());
         throw;
     }
     --val;
-    set_variable(symbol, val);
+    set_variable(node, val);
     _accumulator.set_register(val);
 
-    spdlog::debug("bumped down {} to {}", symbol->name, _accumulator.get_register());
+    spdlog::debug("bumped down {} to {}", *node->get_var_name(), _accumulator.get_register());
     END_VISIT();
 }
 
@@ -368,8 +367,8 @@ int ASTInterpreter::visit(const parser::InvocationExpressionASTNodePtr &node)
     auto symbol = semanalyzer::Symbol::get_from(node);
     // special handling for lib func
     if (_symbol_table->is_library_function(symbol)) {
-        spdlog::debug("invoking library function {}", symbol->name);
-        rc = invoke_library_function(symbol->name);
+        spdlog::debug("invoking library function {}", *symbol->name);
+        rc = invoke_library_function(*symbol->name);
         RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
     } else {
         auto subroutine_node = WEAK_TO_SHARED(symbol->definition);
@@ -378,22 +377,25 @@ int ASTInterpreter::visit(const parser::InvocationExpressionASTNodePtr &node)
         auto type = subroutine_node->get_node_type();
 
         if (type == parser::ASTNodeType::FunctionDefinition) {
-            spdlog::debug("invoking function {}", symbol->name);
+            spdlog::debug("invoking function {}", *symbol->name);
             auto func = std::dynamic_pointer_cast<parser::FunctionDefinitionASTNode>(subroutine_node);
             _call_stack.push_back(CallFrame {
                 .subroutine_node = func,
                 .invocation_node = node,
-                .variables = {},
+                .variables = VariableSlots(get_frame_size(func)),
             });
+            // start runs without a call frame
+            _counter.call(_call_stack.size() + (_start_entered ? 1 : 0));
             rc = visit(func);
         } else if (type == parser::ASTNodeType::SubprocDefinition) {
-            spdlog::debug("invoking subproc {}", symbol->name);
+            spdlog::debug("invoking subproc {}", *symbol->name);
             auto sub = std::dynamic_pointer_cast<parser::SubprocDefinitionASTNode>(subroutine_node);
             _call_stack.push_back(CallFrame {
                 .subroutine_node = sub,
                 .invocation_node = node,
-                .variables = {},
+                .variables = VariableSlots(get_frame_size(sub)),
             });
+            _counter.call(_call_stack.size() + (_start_entered ? 1 : 0));
             rc = visit(sub);
         } else {
             spdlog::critical("Unknwon ASTNode type {}. {}", static_cast<int>(type), __PRETTY_FUNCTION__);
@@ -454,7 +456,6 @@ int ASTInterpreter::visit(const parser::WhileStatementASTNodePtr &node)
 
         // condition is true
         rc = traverse(node->get_body());
-        RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
 
         if (rc == CF_BreakRequested) {
             // for hit break
@@ -469,6 +470,8 @@ int ASTInterpreter::visit(const parser::WhileStatementASTNodePtr &node)
             rc = 0;
             spdlog::debug("continue requested");
         }
+
+        RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
     } while (true);
 
     END_VISIT();
@@ -495,7 +498,6 @@ int ASTInterpreter::visit(const parser::ForStatementASTNodePtr &node)
 
         // condition is true
         rc = traverse(node->get_body());
-        RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
 
         if (rc == CF_BreakRequested) {
             // for hit break
@@ -507,9 +509,12 @@ int ASTInterpreter::visit(const parser::ForStatementASTNodePtr &node)
         if (rc == CF_ContinueRequested) {
             // for hit continue. update and enter next loop
             // there's nothing special inside this if. it's the same as body is normally finished
+            rc = 0;
             spdlog::debug("continue requested");
         }
 
+        RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
+
         rc = traverse(node->get_update());
         RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
         spdlog::debug("for state updated");
@@ -567,9 +572,7 @@ int ASTInterpreter::visit_subroutine(const parser::AbstractSubroutineASTNodePtr
     auto &param = node->get_parameter();
     if (param) {
         // store the parameter value
-        semanalyzer::SymbolPtr sym = semanalyzer::Symbol::get_from(param);
-        assert(sym);
-        set_variable(sym, _accumulator.get_register());
+        set_variable(param, _accumulator.get_register());
     }
     rc = traverse(node->get_body());
     RETURN_IF_FAIL_IN_VISIT(rc);
@@ -598,6 +601,9 @@ int ASTInterpreter::visit(const parser::CompilationUnitASTNodePtr &node)
         _memory_manager.set_floor_max(node->get_floor_max().value());
     }
 
+    _global_variables.assign(get_frame_size(node), std::nullopt);
+    _start_entered = false;
+
     rc = traverse_multiple(node->get_floor_inits(), node->get_var_decls());
     RETURN_IF_ABNORMAL_RC_IN_VISIT(rc);
 
@@ -606,6 +612,9 @@ int ASTInterpreter::visit(const parser::CompilationUnitASTNodePtr &node)
         return *subroutine->get_name() == "start";
     });
 
+    _counter.call(1);
+    _start_entered = true;
+    _start_variables.assign(get_frame_size(*start_it), std::nullopt);
     if (auto sub_start = std::dynamic_pointer_cast<parser::SubprocDefinitionASTNode>(*start_it)) {
         rc = visit(sub_start);
     } else if (auto func_start = std::dynamic_pointer_cast<parser::FunctionDefinitionASTNode>(*start_it)) {
@@ -625,6 +634,7 @@ int ASTInterpreter::run()
 
 void ASTInterpreter::enter_node(const parser::ASTNodePtr &node)
 {
+    _counter.instruction(static_cast<std::size_t>(node->get_node_type()));
     spdlog::debug("Entered node {} on {}:{}", ast_node_type_to_string(node->get_node_type()), node->lineno(), node->colno());
     semanalyzer::SemanticAnalysisPass::enter_node(node);
 }
@@ -655,9 +665,15 @@ int ASTInterpreter::invoke_library_function(const std::string &name)
 
 int ASTInterpreter::exec()
 {
+    StatisticsScope statistics_scope(*this);
     return run();
 }
 
+std::string ASTInterpreter::get_opcode_name(std::size_t opcode) const
+{
+    return parser::ast_node_type_to_string(static_cast<parser::ASTNodeType>(opcode));
+}
+
 int ASTInterpreter::invoke_inbox()
 {
     HRMByte value;
@@ -665,6 +681,7 @@ int ASTInterpreter::invoke_inbox()
     if (!ok) {
         throw InterpreterException(InterpreterException::ErrorType::EndOfInput, "End of input reached");
     }
+    _counter.inbox();
     _accumulator.set_register(value);
 
     return 0;
@@ -673,48 +690,55 @@ int ASTInterpreter::invoke_inbox()
 int ASTInterpreter::invoke_outbox()
 {
     _io_manager.push_output(_accumulator.get_register());
+    _counter.outbox();
     _accumulator.reset_register();
 
     return 0;
 }
 
-void ASTInterpreter::set_variable(const semanalyzer::SymbolPtr &symbol, HRMByte value)
+unsigned int ASTInterpreter::get_frame_size(const parser::ASTNodePtr &node)
+{
+    auto layout = semanalyzer::FrameLayoutAttribute::get_from(node);
+    if (!layout) {
+        spdlog::critical("The AST is not resolved by VariableSlotResolutionPass. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+    return layout->get_slot_count();
+}
+
+std::optional<HRMByte> &ASTInterpreter::get_variable_slot(const parser::ASTNodePtr &node)
 {
-    if (_call_stack.empty()) {
-        spdlog::trace("Set global variable '{}' = {}", symbol->name, value);
-        _global_variables[symbol] = value;
+    auto slot = semanalyzer::VariableSlotAttribute::get_from(node);
+    if (!slot) {
+        spdlog::critical("The AST is not resolved by VariableSlotResolutionPass. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    if (slot->is_global()) {
+        return _global_variables[slot->get_slot()];
+    } else if (_call_stack.empty()) {
+        return _start_variables[slot->get_slot()];
     } else {
-        CallFrame &callframe = _call_stack.back();
-        auto glbvar_it = _global_variables.find(symbol);
-        if (glbvar_it == _global_variables.end()) {
-            spdlog::trace("Set local variable '{}' = {} in subroutine {}", symbol->name, value, *callframe.subroutine_node->get_name());
-            callframe.variables[symbol] = value;
-        } else {
-            spdlog::trace("Set global variable '{}' = {} in subroutine {}", symbol->name, value, *callframe.subroutine_node->get_name());
-            glbvar_it->second = value;
-        }
+        return _call_stack.back().variables[slot->get_slot()];
     }
 }
 
-bool ASTInterpreter::get_variable(const semanalyzer::SymbolPtr &symbol, HRMByte &value)
+void ASTInterpreter::set_variable(const parser::ASTNodePtr &node, HRMByte value)
 {
-    auto found_it = _global_variables.find(symbol);
-    if (found_it == _global_variables.end()) {
-        if (_call_stack.empty()) {
-            spdlog::trace("Global variable '{}' does not exist", symbol->name);
-            return false;
-        } else {
-            CallFrame &callframe = _call_stack.back();
-            found_it = callframe.variables.find(symbol);
-            if (found_it == callframe.variables.end()) {
-                spdlog::trace("Local variable '{}' in subroutine {} does not exist", symbol->name, *callframe.subroutine_node->get_name());
-                return false;
-            }
-        }
+    spdlog::trace("Set variable on {}:{} = {}", node->lineno(), node->colno(), value);
+    get_variable_slot(node) = value;
+}
+
+bool ASTInterpreter::get_variable(const parser::ASTNodePtr &node, HRMByte &value)
+{
+    const std::optional<HRMByte> &slot = get_variable_slot(node);
+    if (!slot.has_value()) {
+        spdlog::trace("Variable on {}:{} is not assigned", node->lineno(), node->colno());
+        return false;
     }
 
-    value = found_it->second;
-    spdlog::trace("Accessed variable '{}': {}", symbol->name, value);
+    value = slot.value();
+    spdlog::trace("Accessed variable on {}:{}: {}", node->lineno(), node->colno(), value);
     return true;
 }
 
@@ -0,0 +1,662 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "ASTNode.h"
+#include "CompiledASTInterpreter.h"
+#include "HRMByte.h"
+#include "InterpreterExceptions.h"
+#include "Symbol.h"
+#include "VariableSlotResolutionPass.h"
+#include "hrl_global.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+namespace {
+
+semanalyzer::VariableSlotAttributePtr get_slot_or_throw(const parser::ASTNodePtr &node)
+{
+    auto slot = semanalyzer::VariableSlotAttribute::get_from(node);
+    if (!slot) {
+        spdlog::critical("The AST is not resolved by VariableSlotResolutionPass. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+    return slot;
+}
+
+unsigned int get_frame_size_or_throw(const parser::ASTNodePtr &node)
+{
+    auto layout = semanalyzer::FrameLayoutAttribute::get_from(node);
+    if (!layout) {
+        spdlog::critical("The AST is not resolved by VariableSlotResolutionPass. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+    return layout->get_slot_count();
+}
+
+void ensure_non_zero(int value)
+{
+    if (value == 0) {
+        throw InterpreterException(InterpreterException::ErrorType::ValueIsZero, "Value cannot be zero");
+    }
+}
+
+}
+
+CompiledASTInterpreter::CompiledASTInterpreter(
+    StringPtr filename,
+    parser::CompilationUnitASTNodePtr root,
+    semanalyzer::SymbolTablePtr symbol_table,
+    InterpreterIOManager &ioman,
+    InterpreterMemoryManager &memman)
+    : AbstractInterpreter(ioman, memman)
+    , _filename(std::move(filename))
+    , _root(std::move(root))
+    , _symbol_table(std::move(symbol_table))
+{
+}
+
+CompiledASTInterpreter::~CompiledASTInterpreter()
+{
+}
+
+int CompiledASTInterpreter::exec()
+{
+    StatisticsScope statistics_scope(*this);
+
+    if (!_compiled) {
+        compile();
+        _compiled = true;
+    }
+
+    _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::CompilationUnit));
+
+    if (_root->get_floor_max().has_value()) {
+        _memory_manager.set_floor_max(_root->get_floor_max().value());
+    }
+
+    _global_variables.assign(_global_slot_count, std::nullopt);
+    _frame = nullptr;
+    _register.reset();
+    _call_depth = 0;
+
+    for (const Statement &initializer : _global_initializers) {
+        initializer();
+    }
+
+    call(*_start, std::nullopt);
+    return 0;
+}
+
+std::string CompiledASTInterpreter::get_opcode_name(std::size_t opcode) const
+{
+    return parser::ast_node_type_to_string(static_cast<parser::ASTNodeType>(opcode));
+}
+
+HRMByte CompiledASTInterpreter::set_register(HRMByte value)
+{
+    _register = value;
+    return value;
+}
+
+HRMByte CompiledASTInterpreter::read_register()
+{
+    if (!_register.has_value()) {
+        throw InterpreterException(InterpreterException::ErrorType::RegisterIsEmpty, "Register is empty");
+    }
+    return _register.value();
+}
+
+void CompiledASTInterpreter::call(const CompiledSubroutine &subroutine, const std::optional<HRMByte> &argument)
+{
+    VariableSlots frame(subroutine.frame_size);
+    VariableSlots *caller_frame = _frame;
+    _frame = &frame;
+    _counter.call(++_call_depth);
+    _counter.instruction(static_cast<std::size_t>(subroutine.node_type));
+
+    if (subroutine.parameter_slot.has_value()) {
+        frame[subroutine.parameter_slot.value()] = argument;
+    }
+    if (subroutine.body) {
+        subroutine.body();
+    }
+
+    --_call_depth;
+    _frame = caller_frame;
+}
+
+void CompiledASTInterpreter::compile()
+{
+    _subroutines.clear();
+    _global_initializers.clear();
+    _start = nullptr;
+
+    _global_slot_count = get_frame_size_or_throw(_root);
+
+    // create the subroutines first so invocations, including those in the global initializers, can be bound to them
+    // regardless of the definition order
+    for (const parser::AbstractSubroutineASTNodePtr &subroutine_node : _root->get_subroutines()) {
+        auto subroutine = std::make_unique<CompiledSubroutine>();
+        subroutine->node_type = subroutine_node->get_node_type();
+        subroutine->frame_size = get_frame_size_or_throw(subroutine_node);
+        if (subroutine_node->get_parameter()) {
+            subroutine->parameter_slot = get_slot_or_throw(subroutine_node->get_parameter())->get_slot();
+        }
+
+        if (*subroutine_node->get_name() == "start") {
+            _start = subroutine.get();
+        }
+        _subroutines.emplace(subroutine_node.get(), std::move(subroutine));
+    }
+
+    if (!_start) {
+        spdlog::critical("Subroutine 'start' is not defined. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    for (const parser::FloorBoxInitStatementASTNodePtr &floor_init : _root->get_floor_inits()) {
+        _global_initializers.push_back(compile_statement(floor_init));
+    }
+    for (const parser::VariableDeclarationASTNodePtr &var_decl : _root->get_var_decls()) {
+        _global_initializers.push_back(compile_statement(var_decl));
+    }
+
+    for (const parser::AbstractSubroutineASTNodePtr &subroutine_node : _root->get_subroutines()) {
+        if (subroutine_node->get_body()) {
+            _subroutines.at(subroutine_node.get())->body = compile_statement_block(subroutine_node->get_body());
+        }
+    }
+
+    spdlog::debug("Compiled {} subroutines and {} global initializers", _subroutines.size(), _global_initializers.size());
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_statement(const parser::ASTNodePtr &node)
+{
+    switch (node->get_node_type()) {
+    case parser::ASTNodeType::EmptyStatement:
+        return []() { return Completion::Normal; };
+
+    case parser::ASTNodeType::VariableDeclaration: {
+        auto decl = std::static_pointer_cast<parser::VariableDeclarationASTNode>(node);
+        Statement assignment = decl->get_assignment() ? compile_variable_assignment(decl->get_assignment()) : nullptr;
+        return [this, assignment]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::VariableDeclaration));
+            return assignment ? assignment() : Completion::Normal;
+        };
+    }
+
+    case parser::ASTNodeType::VariableAssignment:
+        return compile_variable_assignment(std::static_pointer_cast<parser::VariableAssignmentASTNode>(node));
+
+    case parser::ASTNodeType::FloorBoxInitStatement: {
+        auto floor_init = std::static_pointer_cast<parser::FloorBoxInitStatementASTNode>(node);
+        Statement assignment = compile_floor_assignment(floor_init->get_assignment(), true);
+        return [this, assignment]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::FloorBoxInitStatement));
+            return assignment();
+        };
+    }
+
+    case parser::ASTNodeType::FloorAssignment:
+        return compile_floor_assignment(std::static_pointer_cast<parser::FloorAssignmentASTNode>(node), false);
+
+    case parser::ASTNodeType::IfStatement:
+        return compile_if(std::static_pointer_cast<parser::IfStatementASTNode>(node));
+
+    case parser::ASTNodeType::WhileStatement:
+        return compile_while(std::static_pointer_cast<parser::WhileStatementASTNode>(node));
+
+    case parser::ASTNodeType::ForStatement:
+        return compile_for(std::static_pointer_cast<parser::ForStatementASTNode>(node));
+
+    case parser::ASTNodeType::ReturnStatement: {
+        auto return_node = std::static_pointer_cast<parser::ReturnStatementASTNode>(node);
+        Expression expression = return_node->get_expression() ? compile_expression(return_node->get_expression()) : nullptr;
+        return [this, expression]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::ReturnStatement));
+            if (expression) {
+                expression();
+            }
+            return Completion::Return;
+        };
+    }
+
+    case parser::ASTNodeType::BreakStatement:
+        return [this]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::BreakStatement));
+            return Completion::Break;
+        };
+
+    case parser::ASTNodeType::ContinueStatement:
+        return [this]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::ContinueStatement));
+            return Completion::Continue;
+        };
+
+    case parser::ASTNodeType::StatementBlock:
+        return compile_statement_block(std::static_pointer_cast<parser::StatementBlockASTNode>(node));
+
+    case parser::ASTNodeType::InvocationExpression: {
+        // the value of an invocation statement is discarded, so an empty register is fine
+        Expression invocation = compile_invocation(std::static_pointer_cast<parser::InvocationExpressionASTNode>(node), false);
+        return [invocation]() {
+            invocation();
+            return Completion::Normal;
+        };
+    }
+
+    default: {
+        auto expression_node = std::dynamic_pointer_cast<parser::AbstractExpressionASTNode>(node);
+        if (!expression_node) {
+            spdlog::critical("Unknown statement type {}. {}", static_cast<int>(node->get_node_type()), __PRETTY_FUNCTION__);
+            throw;
+        }
+        Expression expression = compile_expression(expression_node);
+        return [expression]() {
+            expression();
+            return Completion::Normal;
+        };
+    }
+    }
+}
+
+CompiledASTInterpreter::Expression CompiledASTInterpreter::compile_expression(const parser::AbstractExpressionASTNodePtr &node)
+{
+    switch (node->get_node_type()) {
+    case parser::ASTNodeType::Integer: {
+        auto integer = std::static_pointer_cast<parser::IntegerASTNode>(node);
+        HRMByte value = integer->get_is_char() ? HRMByte(static_cast<char>(integer->get_value())) : HRMByte(integer->get_value());
+        return [this, value]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::Integer));
+            return set_register(value);
+        };
+    }
+
+    case parser::ASTNodeType::Boolean: {
+        HRMByte value(std::static_pointer_cast<parser::BooleanASTNode>(node)->get_value() ? 1 : 0);
+        return [this, value]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::Boolean));
+            return set_register(value);
+        };
+    }
+
+    case parser::ASTNodeType::VariableAccess: {
+        auto slot = get_slot_or_throw(node);
+        if (slot->is_global()) {
+            return compile_variable_load<true>(node->get_node_type(), slot->get_slot());
+        } else {
+            return compile_variable_load<false>(node->get_node_type(), slot->get_slot());
+        }
+    }
+
+    case parser::ASTNodeType::FloorAccess: {
+        Expression index = compile_expression(std::static_pointer_cast<parser::FloorAccessASTNode>(node)->get_index_expr());
+        return [this, index]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::FloorAccess));
+            int idx = index().operator int();
+
+            HRMByte value;
+            bool ok = _memory_manager.get_floor(idx, value);
+            if (!ok) {
+                throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
+            }
+            _counter.floor_read();
+            return set_register(value);
+        };
+    }
+
+    case parser::ASTNodeType::NegativeExpression: {
+        Expression operand = compile_expression(std::static_pointer_cast<parser::NegativeExpressionASTNode>(node)->get_operand());
+        return [this, operand]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::NegativeExpression));
+            return set_register(-operand());
+        };
+    }
+
+    case parser::ASTNodeType::NotExpression: {
+        Expression operand = compile_expression(std::static_pointer_cast<parser::NotExpressionASTNode>(node)->get_operand());
+        return [this, operand]() {
+            _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::NotExpression));
+            return set_register(HRMByte(operand() ? 0 : 1));
+        };
+    }
+
+    case parser::ASTNodeType::IncrementExpression:
+    case parser::ASTNodeType::DecrementExpression: {
+        bool increment = node->get_node_type() == parser::ASTNodeType::IncrementExpression;
+        StringPtr var_name = increment
+            ? std::static_pointer_cast<parser::IncrementExpressionASTNode>(node)->get_var_name()
+            : std::static_pointer_cast<parser::DecrementExpressionASTNode>(node)->get_var_name();
+        auto slot = get_slot_or_throw(node);
+
+        if (slot->is_global()) {
+            return increment
+                ? compile_bump<true, true>(node->get_node_type(), slot->get_slot(), var_name)
+                : compile_bump<true, false>(node->get_node_type(), slot->get_slot(), var_name);
+        } else {
+            return increment
+                ? compile_bump<false, true>(node->get_node_type(), slot->get_slot(), var_name)
+                : compile_bump<false, false>(node->get_node_type(), slot->get_slot(), var_name);
+        }
+    }
+
+    case parser::ASTNodeType::AddExpression:
+    case parser::ASTNodeType::SubExpression:
+    case parser::ASTNodeType::MulExpression:
+    case parser::ASTNodeType::DivExpression:
+    case parser::ASTNodeType::ModExpression:
+    case parser::ASTNodeType::EqualExpression:
+    case parser::ASTNodeType::NotEqualExpression:
+    case parser::ASTNodeType::GreaterThanExpression:
+    case parser::ASTNodeType::GreaterEqualExpression:
+    case parser::ASTNodeType::LessThanExpression:
+    case parser::ASTNodeType::LessEqualExpression:
+    case parser::ASTNodeType::AndExpression:
+    case parser::ASTNodeType::OrExpression:
+        return compile_binary_expression(std::static_pointer_cast<parser::AbstractBinaryExpressionASTNode>(node));
+
+    case parser::ASTNodeType::InvocationExpression:
+        return compile_invocation(std::static_pointer_cast<parser::InvocationExpressionASTNode>(node), true);
+
+    default:
+        spdlog::critical("Unknown expression type {}. {}", static_cast<int>(node->get_node_type()), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_variable_assignment(const parser::VariableAssignmentASTNodePtr &node)
+{
+    Expression value = compile_expression(node->get_value());
+    auto slot = get_slot_or_throw(node);
+    if (slot->is_global()) {
+        return compile_variable_store<true>(node->get_node_type(), slot->get_slot(), std::move(value));
+    } else {
+        return compile_variable_store<false>(node->get_node_type(), slot->get_slot(), std::move(value));
+    }
+}
+
+template <bool IsGlobal>
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_variable_store(parser::ASTNodeType node_type, unsigned int slot, Expression value)
+{
+    return [this, node_type, slot, value]() {
+        _counter.instruction(static_cast<std::size_t>(node_type));
+        variable<IsGlobal>(slot) = value();
+        return Completion::Normal;
+    };
+}
+
+template <bool IsGlobal>
+CompiledASTInterpreter::Expression CompiledASTInterpreter::compile_variable_load(parser::ASTNodeType node_type, unsigned int slot)
+{
+    return [this, node_type, slot]() {
+        _counter.instruction(static_cast<std::size_t>(node_type));
+        const std::optional<HRMByte> &value = variable<IsGlobal>(slot);
+        if (!value.has_value()) {
+            throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Variable is null");
+        }
+        return set_register(value.value());
+    };
+}
+
+template <bool IsGlobal, bool Increment>
+CompiledASTInterpreter::Expression CompiledASTInterpreter::compile_bump(parser::ASTNodeType node_type, unsigned int slot, StringPtr var_name)
+{
+    return [this, node_type, slot, var_name]() {
+        _counter.instruction(static_cast<std::size_t>(node_type));
+        std::optional<HRMByte> &value = variable<IsGlobal>(slot);
+        if (!value.has_value()) {
+            spdlog::critical("Variable '{}' is not found.", *var_name);
+            throw;
+        }
+
+        HRMByte bumped = value.value();
+        if constexpr (Increment) {
+            ++bumped;
+        } else {
+            --bumped;
+        }
+        value = bumped;
+        return set_register(bumped);
+    };
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_floor_assignment(const parser::FloorAssignmentASTNodePtr &node, bool is_floor_init)
+{
+    Expression value_expr = compile_expression(node->get_value());
+    Expression floor_number = compile_expression(node->get_floor_number());
+
+    return [this, value_expr, floor_number, is_floor_init]() {
+        _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::FloorAssignment));
+        HRMByte value = value_expr();
+        int flrid = floor_number().operator int();
+
+        set_register(value);
+        _memory_manager.set_floor(flrid, value);
+        // the floor inits are part of the level setup, not the program
+        if (!is_floor_init) {
+            _counter.floor_write();
+        }
+        return Completion::Normal;
+    };
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_statement_block(const parser::StatementBlockASTNodePtr &node)
+{
+    std::vector<Statement> statements;
+    for (const parser::AbstractStatementASTNodePtr &statement : node->get_statements()) {
+        if (statement) {
+            statements.push_back(compile_statement(statement));
+        }
+    }
+
+    return [this, statements]() {
+        _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::StatementBlock));
+        for (const Statement &statement : statements) {
+            Completion completion = statement();
+            if (completion != Completion::Normal) {
+                return completion;
+            }
+        }
+        return Completion::Normal;
+    };
+}
+
+CompiledASTInterpreter::Expression CompiledASTInterpreter::compile_condition(const parser::AbstractExpressionASTNodePtr &node)
+{
+    if (node) {
+        return compile_expression(node);
+    } else {
+        // without a condition, ASTInterpreter tests what's left in the accumulator
+        return [this]() { return read_register(); };
+    }
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_if(const parser::IfStatementASTNodePtr &node)
+{
+    Expression condition = compile_condition(node->get_condition());
+    Statement then_branch = node->get_then_branch() ? compile_statement(node->get_then_branch()) : nullptr;
+    Statement else_branch = node->get_else_branch() ? compile_statement(node->get_else_branch()) : nullptr;
+
+    return [this, condition, then_branch, else_branch]() {
+        _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::IfStatement));
+        const Statement &branch = condition().operator bool() ? then_branch : else_branch;
+        return branch ? branch() : Completion::Normal;
+    };
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_while(const parser::WhileStatementASTNodePtr &node)
+{
+    Expression condition = compile_condition(node->get_condition());
+    Statement body = node->get_body() ? compile_statement(node->get_body()) : nullptr;
+
+    return [this, condition, body]() {
+        _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::WhileStatement));
+        while (condition().operator bool()) {
+            Completion completion = body ? body() : Completion::Normal;
+            if (completion == Completion::Break) {
+                break;
+            } else if (completion == Completion::Return) {
+                return completion;
+            }
+        }
+        return Completion::Normal;
+    };
+}
+
+CompiledASTInterpreter::Statement CompiledASTInterpreter::compile_for(const parser::ForStatementASTNodePtr &node)
+{
+    Statement init = node->get_init() ? compile_statement(node->get_init()) : nullptr;
+    Expression condition = compile_condition(node->get_condition());
+    Statement update = node->get_update() ? compile_statement(node->get_update()) : nullptr;
+    Statement body = node->get_body() ? compile_statement(node->get_body()) : nullptr;
+
+    return [this, init, condition, update, body]() {
+        _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::ForStatement));
+        if (init) {
+            init();
+        }
+
+        while (condition().operator bool()) {
+            Completion completion = body ? body() : Completion::Normal;
+            if (completion == Completion::Break) {
+                break;
+            } else if (completion == Completion::Return) {
+                return completion;
+            }
+
+            if (update) {
+                update();
+            }
+        }
+        return Completion::Normal;
+    };
+}
+
+CompiledASTInterpreter::Expression CompiledASTInterpreter::compile_binary_expression(const parser::AbstractBinaryExpressionASTNodePtr &node)
+{
+    parser::ASTNodeType node_type = node->get_node_type();
+    Expression left = compile_expression(node->get_left());
+    Expression right = compile_expression(node->get_right());
+
+    // both operands are always evaluated, there's no short circuit
+    auto make = [this, node_type, &left, &right](auto operation) -> Expression {
+        return [this, node_type, left, right, operation]() {
+            _counter.instruction(static_cast<std::size_t>(node_type));
+            HRMByte lhs = left();
+            HRMByte rhs = right();
+            return set_register(operation(lhs, rhs));
+        };
+    };
+
+    auto op = node->get_op();
+    switch (op) {
+    case parser::ASTBinaryOperator::ADD:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return lhs + rhs; });
+    case parser::ASTBinaryOperator::SUB:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return lhs - rhs; });
+    case parser::ASTBinaryOperator::MUL:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return lhs * rhs; });
+    case parser::ASTBinaryOperator::DIV:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) {
+            ensure_non_zero(rhs.operator int());
+            return lhs / rhs;
+        });
+    case parser::ASTBinaryOperator::MOD:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) {
+            ensure_non_zero(rhs.operator int());
+            return lhs % rhs;
+        });
+    case parser::ASTBinaryOperator::AND:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(lhs && rhs ? 1 : 0); });
+    case parser::ASTBinaryOperator::OR:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(lhs || rhs ? 1 : 0); });
+    case parser::ASTBinaryOperator::GT:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(static_cast<int>(lhs) > static_cast<int>(rhs) ? 1 : 0); });
+    case parser::ASTBinaryOperator::GE:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(static_cast<int>(lhs) >= static_cast<int>(rhs) ? 1 : 0); });
+    case parser::ASTBinaryOperator::LT:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(static_cast<int>(lhs) < static_cast<int>(rhs) ? 1 : 0); });
+    case parser::ASTBinaryOperator::LE:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(static_cast<int>(lhs) <= static_cast<int>(rhs) ? 1 : 0); });
+    case parser::ASTBinaryOperator::EQ:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(static_cast<int>(lhs) == static_cast<int>(rhs) ? 1 : 0); });
+    case parser::ASTBinaryOperator::NE:
+        return make([](const HRMByte &lhs, const HRMByte &rhs) { return HRMByte(static_cast<int>(lhs) != static_cast<int>(rhs) ? 1 : 0); });
+    default:
+        spdlog::critical("Unknown ASTBinaryOperator {}. {}", static_cast<int>(op), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+CompiledASTInterpreter::Expression CompiledASTInterpreter::compile_invocation(const parser::InvocationExpressionASTNodePtr &node, bool value_used)
+{
+    Expression argument = node->get_argument() ? compile_expression(node->get_argument()) : nullptr;
+    auto symbol = semanalyzer::Symbol::get_from(node);
+    if (!symbol) {
+        spdlog::critical("Invocation to '{}' is not resolved. {}", *node->get_func_name(), __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    if (_symbol_table->is_library_function(symbol)) {
+        if (*symbol->name == "inbox") {
+            return [this, argument]() {
+                _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::InvocationExpression));
+                if (argument) {
+                    argument();
+                }
+
+                HRMByte value;
+                bool ok = _io_manager.pop_input(value);
+                if (!ok) {
+                    throw InterpreterException(InterpreterException::ErrorType::EndOfInput, "End of input reached");
+                }
+                _counter.inbox();
+                return set_register(value);
+            };
+        } else if (*symbol->name == "outbox") {
+            return [this, argument, value_used]() {
+                _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::InvocationExpression));
+                HRMByte value = argument ? argument() : read_register();
+                _io_manager.push_output(value);
+                _counter.outbox();
+                _register.reset();
+                // outbox empties the accumulator. using its value is an error.
+                return value_used ? read_register() : HRMByte();
+            };
+        } else {
+            spdlog::critical("Unknwon library function {}. {}", *symbol->name, __PRETTY_FUNCTION__);
+            throw;
+        }
+    }
+
+    auto definition = WEAK_TO_SHARED(symbol->definition);
+    auto subroutine_it = _subroutines.find(definition.get());
+    if (subroutine_it == _subroutines.end()) {
+        spdlog::critical("Subroutine '{}' is not compiled. {}", *symbol->name, __PRETTY_FUNCTION__);
+        throw;
+    }
+    const CompiledSubroutine *subroutine = subroutine_it->second.get();
+
+    return [this, argument, subroutine, value_used]() {
+        _counter.instruction(static_cast<std::size_t>(parser::ASTNodeType::InvocationExpression));
+        std::optional<HRMByte> argument_value;
+        if (argument) {
+            argument_value = argument();
+        }
+
+        call(*subroutine, argument_value);
+        // the return value, or whatever left in the accumulator by a subroutine without return value
+        return value_used ? read_register() : HRMByte();
+    };
+}
+
+CLOSE_INTERPRETER_NAMESPACE
+// end
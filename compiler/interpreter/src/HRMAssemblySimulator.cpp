@@ -0,0 +1,359 @@
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <spdlog/spdlog.h>
+
+#include "HRMAssemblySimulator.h"
+#include "HRMByte.h"
+#include "InterpreterExceptions.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+namespace {
+
+const char *const PROGRAM_HEADER = "-- HUMAN RESOURCE MACHINE PROGRAM --";
+
+std::optional<int> parse_int(std::string_view text)
+{
+    int value;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<HRMByte> parse_value(std::string_view text)
+{
+    if (text.size() == 1 && std::isalpha(static_cast<unsigned char>(text[0]))) {
+        return HRMByte(static_cast<char>(std::toupper(static_cast<unsigned char>(text[0]))));
+    }
+    std::optional<int> value = parse_int(text);
+    if (!value) {
+        return std::nullopt;
+    }
+    return HRMByte(*value);
+}
+
+} // namespace
+
+int HRMAssemblySimulator::exec()
+{
+    StatisticsScope statistics_scope(*this);
+
+    _steps = 0;
+    _accumulator.reset_register();
+
+    int result = parse();
+    if (result != 0) {
+        return result;
+    }
+
+    if (_floor_max >= 0) {
+        _memory_manager.set_floor_max(_floor_max);
+    }
+    for (const auto &[floor, value] : _floor_inits) {
+        _memory_manager.set_floor(floor, value);
+    }
+
+    std::size_t pc = 0;
+    while (pc < _instructions.size()) {
+        const Instruction &instruction = _instructions[pc++];
+
+        HRMByte input;
+        if (instruction.opcode == Opcode::Inbox && !_io_manager.pop_input(input)) {
+            // the game ends the program successfully here, and the inbox is not counted
+            throw InterpreterException(InterpreterException::ErrorType::EndOfInput, "End of input reached");
+        }
+
+        ++_steps;
+        _counter.instruction(static_cast<std::size_t>(instruction.opcode));
+
+        switch (instruction.opcode) {
+        case Opcode::Inbox:
+            _counter.inbox();
+            _accumulator.set_register(input);
+            break;
+
+        case Opcode::Outbox:
+            _io_manager.push_output(_accumulator.get_register());
+            _accumulator.reset_register();
+            _counter.outbox();
+            break;
+
+        case Opcode::CopyFrom: {
+            HRMByte value;
+            if (!_memory_manager.get_floor(address_of(instruction), value)) {
+                throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
+            }
+            _counter.floor_read();
+            _accumulator.set_register(value);
+        } break;
+
+        case Opcode::CopyTo:
+            _memory_manager.set_floor(address_of(instruction), _accumulator.get_register());
+            _counter.floor_write();
+            break;
+
+        case Opcode::Add:
+        case Opcode::Sub: {
+            HRMByte value;
+            if (!_memory_manager.get_floor(address_of(instruction), value)) {
+                throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
+            }
+            _counter.floor_read();
+            if (instruction.opcode == Opcode::Add) {
+                _accumulator.set_register(_accumulator.get_register() + value);
+            } else {
+                _accumulator.set_register(_accumulator.get_register() - value);
+            }
+        } break;
+
+        case Opcode::BumpUp:
+        case Opcode::BumpDown: {
+            int address = address_of(instruction);
+            HRMByte value;
+            if (!_memory_manager.get_floor(address, value)) {
+                throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
+            }
+            if (value.is_char()) {
+                throw InterpreterException(InterpreterException::ErrorType::TypeMismatch, "Bump performed on char");
+            }
+            if (instruction.opcode == Opcode::BumpUp) {
+                ++value;
+            } else {
+                --value;
+            }
+            _counter.floor_read();
+            _memory_manager.set_floor(address, value);
+            _counter.floor_write();
+            _accumulator.set_register(value);
+        } break;
+
+        case Opcode::Jump:
+            pc = static_cast<std::size_t>(instruction.operand);
+            break;
+
+        case Opcode::JumpIfZero:
+            if (_accumulator.is_zero()) {
+                pc = static_cast<std::size_t>(instruction.operand);
+            }
+            break;
+
+        case Opcode::JumpIfNegative:
+            if (_accumulator.is_negative()) {
+                pc = static_cast<std::size_t>(instruction.operand);
+            }
+            break;
+        }
+    }
+
+    return 0;
+}
+
+std::string HRMAssemblySimulator::get_opcode_name(std::size_t opcode) const
+{
+    switch (static_cast<Opcode>(opcode)) {
+    case Opcode::Inbox:
+        return "INBOX";
+    case Opcode::Outbox:
+        return "OUTBOX";
+    case Opcode::CopyFrom:
+        return "COPYFROM";
+    case Opcode::CopyTo:
+        return "COPYTO";
+    case Opcode::Add:
+        return "ADD";
+    case Opcode::Sub:
+        return "SUB";
+    case Opcode::BumpUp:
+        return "BUMPUP";
+    case Opcode::BumpDown:
+        return "BUMPDN";
+    case Opcode::Jump:
+        return "JUMP";
+    case Opcode::JumpIfZero:
+        return "JUMPZ";
+    case Opcode::JumpIfNegative:
+        return "JUMPN";
+    }
+    return "UNKNOWN";
+}
+
+int HRMAssemblySimulator::parse()
+{
+    static const std::map<std::string, Opcode> opcodes {
+        { "INBOX", Opcode::Inbox },
+        { "OUTBOX", Opcode::Outbox },
+        { "COPYFROM", Opcode::CopyFrom },
+        { "COPYTO", Opcode::CopyTo },
+        { "ADD", Opcode::Add },
+        { "SUB", Opcode::Sub },
+        { "BUMPUP", Opcode::BumpUp },
+        { "BUMPDN", Opcode::BumpDown },
+        { "JUMP", Opcode::Jump },
+        { "JUMPZ", Opcode::JumpIfZero },
+        { "JUMPN", Opcode::JumpIfNegative },
+    };
+
+    _instructions.clear();
+    _floor_inits.clear();
+    _floor_max = -1;
+
+    std::map<std::string, int> label_addresses;
+    // vector<pair<instruction index, label>>
+    std::vector<std::pair<std::size_t, std::string>> jumps;
+
+    std::istringstream input(_assembly);
+    std::string line;
+    int line_number = 0;
+    bool in_program = false;
+    bool in_define = false;
+
+    while (std::getline(input, line)) {
+        ++line_number;
+        boost::algorithm::trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        if (in_define) {
+            // DEFINE blocks hold base64 drawings ending with ;
+            in_define = !line.ends_with(';');
+            continue;
+        }
+
+        if (line.starts_with("--")) {
+            if (line == PROGRAM_HEADER) {
+                in_program = true;
+                continue;
+            }
+
+            std::vector<std::string> tokens;
+            boost::split(tokens, line, boost::is_any_of(" []="), boost::token_compress_on);
+            // -- floor[n] = v --  splits into --, floor, n, v, --
+            if (!in_program && tokens.size() == 5 && tokens[1] == "floor") {
+                std::optional<int> floor = parse_int(tokens[2]);
+                std::optional<HRMByte> value = parse_value(tokens[3]);
+                if (!floor || !value) {
+                    spdlog::error("line {}: invalid floor initialization '{}'", line_number, line);
+                    return 1;
+                }
+                _floor_inits[*floor] = *value;
+            } else if (!in_program && tokens.size() == 4 && tokens[1] == "floor_max") {
+                std::optional<int> floor_max = parse_int(tokens[2]);
+                if (!floor_max) {
+                    spdlog::error("line {}: invalid floor max '{}'", line_number, line);
+                    return 1;
+                }
+                _floor_max = *floor_max;
+            }
+            continue;
+        }
+
+        if (!in_program) {
+            continue;
+        }
+
+        if (line.ends_with(':')) {
+            label_addresses[line.substr(0, line.size() - 1)] = static_cast<int>(_instructions.size());
+            continue;
+        }
+
+        std::vector<std::string> tokens;
+        boost::split(tokens, line, boost::is_space(), boost::token_compress_on);
+        const std::string &mnemonic = tokens.front();
+
+        if (mnemonic == "DEFINE") {
+            in_define = true;
+            continue;
+        }
+        if (mnemonic == "COMMENT") {
+            continue;
+        }
+
+        auto opcode_it = opcodes.find(mnemonic);
+        if (opcode_it == opcodes.end()) {
+            spdlog::error("line {}: unknown instruction '{}'", line_number, mnemonic);
+            return 1;
+        }
+
+        Instruction instruction { .opcode = opcode_it->second, .operand = 0, .indirect = false };
+        const bool takes_operand = instruction.opcode != Opcode::Inbox && instruction.opcode != Opcode::Outbox;
+        if (tokens.size() != (takes_operand ? 2u : 1u)) {
+            spdlog::error("line {}: '{}' takes {} operand", line_number, mnemonic, takes_operand ? "one" : "no");
+            return 1;
+        }
+
+        switch (instruction.opcode) {
+        case Opcode::Inbox:
+        case Opcode::Outbox:
+            break;
+        case Opcode::Jump:
+        case Opcode::JumpIfZero:
+        case Opcode::JumpIfNegative:
+            jumps.emplace_back(_instructions.size(), tokens[1]);
+            break;
+        default: {
+            std::string_view operand = tokens[1];
+            if (operand.size() > 2 && operand.front() == '[' && operand.back() == ']') {
+                instruction.indirect = true;
+                operand = operand.substr(1, operand.size() - 2);
+            }
+            std::optional<int> floor = parse_int(operand);
+            if (!floor || *floor < 0) {
+                spdlog::error("line {}: invalid floor '{}'", line_number, tokens[1]);
+                return 1;
+            }
+            instruction.operand = *floor;
+        } break;
+        }
+
+        _instructions.push_back(instruction);
+    }
+
+    if (!in_program) {
+        spdlog::error("The program header '{}' is missing", PROGRAM_HEADER);
+        return 1;
+    }
+
+    for (const auto &[index, label] : jumps) {
+        auto label_it = label_addresses.find(label);
+        if (label_it == label_addresses.end()) {
+            spdlog::error("Label '{}' is not defined", label);
+            return 1;
+        }
+        _instructions[index].operand = label_it->second;
+    }
+
+    return 0;
+}
+
+int HRMAssemblySimulator::address_of(const Instruction &instruction)
+{
+    if (!instruction.indirect) {
+        return instruction.operand;
+    }
+
+    HRMByte address;
+    if (!_memory_manager.get_floor(instruction.operand, address)) {
+        throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
+    }
+    if (address.is_char()) {
+        throw InterpreterException(InterpreterException::ErrorType::TypeMismatch, "Floor address is a char");
+    }
+    _counter.floor_read();
+    return address.operator int();
+}
+
+CLOSE_INTERPRETER_NAMESPACE
+// end
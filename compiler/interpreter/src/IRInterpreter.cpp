@@ -16,6 +16,8 @@ OPEN_INTERPRETER_NAMESPACE
 
 int IRInterpreter::exec()
 {
+    StatisticsScope statistics_scope(*this);
+
     irgen::ProgramMetadata &metadata = _program->get_metadata();
     _memory_manager.set_floor_max(metadata.get_floor_max());
     for (auto &[floor_id, floor_init_value] : _program->get_metadata().get_floor_inits()) {
@@ -34,6 +36,11 @@ int IRInterpreter::exec()
     return 0;
 }
 
+std::string IRInterpreter::get_opcode_name(std::size_t opcode) const
+{
+    return irgen::IROperationMetadata::to_string(static_cast<irgen::IROperation>(opcode));
+}
+
 void IRInterpreter::exec_subroutine(const irgen::SubroutinePtr &subroutine, HRMByte parameter)
 {
     spdlog::debug("[IRIntrExecSubroutine] Entered subroutine '{}'", subroutine->get_func_name());
@@ -45,6 +52,11 @@ void IRInterpreter::exec_subroutine(const irgen::SubroutinePtr &subroutine, HRMB
         .current_basic_block = nullptr,
     });
 
+    // the global initializer frame is not counted as a call
+    if (_calling_stack.size() > 1) {
+        _counter.call(_calling_stack.size() - 1);
+    }
+
     CallFrame &call_frame = _calling_stack.back();
     irgen::BasicBlockPtr &current_block = call_frame.current_basic_block;
 
@@ -78,12 +90,15 @@ void IRInterpreter::exec_subroutine(const irgen::SubroutinePtr &subroutine, HRMB
     while (current_block) {
         spdlog::debug("[IRIntrExecBB] Entered basic block '{}'", current_block->get_label());
         bool non_linear_control_flow = false;
+        std::size_t instruction_index = 0;
 
         for (const irgen::TACPtr &instruction : current_block->get_instructions()) {
             spdlog::debug("[IRIntrExecInstr] Executing {}", instruction->to_string(true));
+            before_instruction(current_block, instruction_index++, instruction);
 
             HRMByte op_result;
             const irgen::IROperation op = instruction->get_op();
+            _counter.instruction(static_cast<std::size_t>(op));
             const irgen::Operand &tgt = instruction->get_tgt();
             const irgen::Operand &src1 = instruction->get_src1();
             const irgen::Operand &src2 = instruction->get_src2();
@@ -206,12 +221,14 @@ void IRInterpreter::exec_subroutine(const irgen::SubroutinePtr &subroutine, HRMB
                 if (!_io_manager.pop_input(op_result)) {
                     throw InterpreterException(InterpreterException::ErrorType::EndOfInput, "End of input reached");
                 } else {
+                    _counter.inbox();
                     should_set_tgt_var = true;
                 }
                 break;
 
             case irgen::IROperation::OUTPUT:
                 _io_manager.push_output(get_variable(src1));
+                _counter.outbox();
                 break;
 
             case irgen::IROperation::PHI:
@@ -219,11 +236,28 @@ void IRInterpreter::exec_subroutine(const irgen::SubroutinePtr &subroutine, HRMB
                 assert(instruction->get_phi_incomings().contains(predecessor_block));
                 op_result = get_variable(irgen::Operand(std::get<0>(instruction->get_phi_incomings().at(predecessor_block))));
                 should_set_tgt_var = true;
+                _counter.phi();
                 break;
 
             case irgen::IROperation::NOP:
                 // do nothing
                 break;
+
+            case irgen::IROperation::INBOX:
+            case irgen::IROperation::OUTBOX:
+            case irgen::IROperation::COPYFROM:
+            case irgen::IROperation::COPYTO:
+            case irgen::IROperation::COPYFROMI:
+            case irgen::IROperation::COPYTOI:
+            case irgen::IROperation::ADDM:
+            case irgen::IROperation::SUBM:
+            case irgen::IROperation::BUMPUP:
+            case irgen::IROperation::BUMPDN:
+            case irgen::IROperation::JUMP:
+            case irgen::IROperation::JUMPZ:
+            case irgen::IROperation::JUMPN:
+                spdlog::error("Low IR instruction {} cannot be executed by the IR interpreter. Use LIRInterpreter instead. {}", instruction->to_string(), __PRETTY_FUNCTION__);
+                throw;
             }
 
             if (is_return) {
@@ -388,6 +422,7 @@ void IRInterpreter::move_data(irgen::IROperation op, const irgen::Operand &tgt,
             if (!_memory_manager.get_floor(floor_id, value)) {
                 throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
             }
+            _counter.floor_read();
         }
         set_variable(tgt, value);
         return;
@@ -411,6 +446,7 @@ void IRInterpreter::move_data(irgen::IROperation op, const irgen::Operand &tgt,
             _global_variables[floor_id] = get_variable(src2);
         } else {
             _memory_manager.set_floor(floor_id, get_variable(src2));
+            _counter.floor_write();
         }
         return;
     case irgen::IROperation::LOADI:
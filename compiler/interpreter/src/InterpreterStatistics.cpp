@@ -0,0 +1,37 @@
+#include <sstream>
+#include <string>
+
+#include "InterpreterStatistics.h"
+#include "interpreter_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+std::string InterpreterStatistics::to_json() const
+{
+    std::ostringstream ss;
+
+    // opcode names are identifiers or AST node type names, they never need escaping
+    ss << "{\n";
+    ss << "  \"instructions\": {";
+    bool first = true;
+    for (const auto &[opcode, count] : instructions) {
+        ss << (first ? "\n" : ",\n") << "    \"" << opcode << "\": " << count;
+        first = false;
+    }
+    ss << (first ? "},\n" : "\n  },\n");
+    ss << "  \"instructions_total\": " << instructions_total << ",\n";
+    ss << "  \"calls\": " << calls << ",\n";
+    ss << "  \"max_call_depth\": " << max_call_depth << ",\n";
+    ss << "  \"floor_reads\": " << floor_reads << ",\n";
+    ss << "  \"floor_writes\": " << floor_writes << ",\n";
+    ss << "  \"inbox\": " << inbox << ",\n";
+    ss << "  \"outbox\": " << outbox << ",\n";
+    ss << "  \"phi_evaluations\": " << phi_evaluations << ",\n";
+    ss << "  \"wall_time_ns\": " << wall_time.count() << "\n";
+    ss << "}";
+
+    return ss.str();
+}
+
+CLOSE_INTERPRETER_NAMESPACE
+// end
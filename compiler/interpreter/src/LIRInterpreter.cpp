@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "HRMByte.h"
+#include "IROps.h"
+#include "IRProgramStructure.h"
+#include "InterpreterExceptions.h"
+#include "LIRInterpreter.h"
+#include "Operand.h"
+#include "ThreeAddressCode.h"
+#include "interpreter_global.h"
+#include "semanalyzer_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+int LIRInterpreter::exec()
+{
+    StatisticsScope statistics_scope(*this);
+
+    std::size_t entry_point = load();
+
+    irgen::ProgramMetadata &metadata = _program->get_metadata();
+    _memory_manager.set_floor_max(metadata.get_floor_max());
+    for (auto &[floor_id, floor_init_value] : metadata.get_floor_inits()) {
+        _memory_manager.set_floor(floor_id, HRMByte(floor_init_value));
+    }
+
+    _steps = 0;
+    _accumulator.reset_register();
+
+    std::vector<CallFrame> calling_stack;
+    calling_stack.push_back({
+        .subroutine = entry_point,
+        .return_address = 0,
+        .tiles = Tiles(_subroutines.at(entry_point).frame_size),
+    });
+
+    const LoadedSubroutine *subroutine = &_subroutines.at(entry_point);
+    std::size_t pc = 0;
+
+    spdlog::debug("[LIRIntrExec] Starting LIR interpretation...");
+    while (true) {
+        // falling off the end returns
+        const irgen::IROperation op = pc < subroutine->instructions.size() ? subroutine->instructions[pc].op : irgen::IROperation::RET;
+
+        if (op == irgen::IROperation::RET) {
+            std::size_t return_address = calling_stack.back().return_address;
+            calling_stack.pop_back();
+            if (calling_stack.empty()) {
+                break;
+            }
+            subroutine = &_subroutines[calling_stack.back().subroutine];
+            pc = return_address;
+            continue;
+        }
+
+        const Instruction &instruction = subroutine->instructions[pc++];
+        Tiles &locals = calling_stack.back().tiles;
+
+        if (irgen::IROperationMetadata::is_low_level(op)) {
+            ++_steps;
+            _counter.instruction(static_cast<std::size_t>(op));
+        }
+
+        switch (op) {
+        case irgen::IROperation::INBOX: {
+            HRMByte value;
+            if (!_io_manager.pop_input(value)) {
+                throw InterpreterException(InterpreterException::ErrorType::EndOfInput, "End of input reached");
+            }
+            _counter.inbox();
+            _accumulator.set_register(value);
+        } break;
+
+        case irgen::IROperation::OUTBOX:
+            _io_manager.push_output(_accumulator.get_register());
+            _accumulator.reset_register();
+            _counter.outbox();
+            break;
+
+        case irgen::IROperation::COPYFROM:
+            _accumulator.set_register(read_tile(instruction.tile, locals));
+            break;
+
+        case irgen::IROperation::COPYTO:
+            writable_tile(instruction.tile, locals) = _accumulator.get_register();
+            break;
+
+        case irgen::IROperation::COPYFROMI: {
+            HRMByte value;
+            if (!_memory_manager.get_floor(floor_address(instruction.tile, locals), value)) {
+                throw InterpreterException(InterpreterException::ErrorType::FloorIsEmpty, "Floor is null");
+            }
+            _counter.floor_read();
+            _accumulator.set_register(value);
+        } break;
+
+        case irgen::IROperation::COPYTOI:
+            _memory_manager.set_floor(floor_address(instruction.tile, locals), _accumulator.get_register());
+            _counter.floor_write();
+            break;
+
+        case irgen::IROperation::ADDM:
+            _accumulator.set_register(_accumulator.get_register() + read_tile(instruction.tile, locals));
+            break;
+
+        case irgen::IROperation::SUBM:
+            _accumulator.set_register(_accumulator.get_register() - read_tile(instruction.tile, locals));
+            break;
+
+        case irgen::IROperation::BUMPUP:
+        case irgen::IROperation::BUMPDN: {
+            HRMByte value = read_tile(instruction.tile, locals);
+            if (value.is_char()) {
+                throw InterpreterException(InterpreterException::ErrorType::TypeMismatch, "Bump performed on char");
+            }
+            if (op == irgen::IROperation::BUMPUP) {
+                ++value;
+            } else {
+                --value;
+            }
+            writable_tile(instruction.tile, locals) = value;
+            _accumulator.set_register(value);
+        } break;
+
+        case irgen::IROperation::JUMP:
+            pc = instruction.target;
+            break;
+
+        case irgen::IROperation::JUMPZ:
+            if (_accumulator.is_zero()) {
+                pc = instruction.target;
+            }
+            break;
+
+        case irgen::IROperation::JUMPN:
+            if (_accumulator.is_negative()) {
+                pc = instruction.target;
+            }
+            break;
+
+        case irgen::IROperation::CALL: {
+            // the argument and the return value are in r0
+            const LoadedSubroutine &callee = _subroutines[instruction.target];
+            calling_stack.push_back({
+                .subroutine = instruction.target,
+                .return_address = pc,
+                .tiles = Tiles(callee.frame_size),
+            });
+            _counter.call(calling_stack.size() - 1);
+            subroutine = &callee;
+            pc = 0;
+        } break;
+
+        case irgen::IROperation::HALT:
+            throw InterpreterException(InterpreterException::ErrorType::HaltRequested, "Halt is requested");
+
+        default:
+            spdlog::error("{} is not a LIR instruction. {}", irgen::IROperationMetadata::to_string(op), __PRETTY_FUNCTION__);
+            throw;
+        }
+    }
+    spdlog::debug("[LIRIntrExec] LIR reached the end");
+
+    return 0;
+}
+
+std::string LIRInterpreter::get_opcode_name(std::size_t opcode) const
+{
+    irgen::IROperation op = static_cast<irgen::IROperation>(opcode);
+    std::string name = irgen::IROperationMetadata::to_string(op);
+    return irgen::IROperationMetadata::is_indirect(op) ? name + " []" : name;
+}
+
+std::size_t LIRInterpreter::load()
+{
+    _subroutines.clear();
+    _constants.clear();
+    _globals.clear();
+
+    std::map<std::string, std::size_t> subroutine_indices;
+    for (const irgen::SubroutinePtr &subroutine : _program->get_subroutines()) {
+        subroutine_indices.emplace(subroutine->get_func_name(), _subroutines.size());
+        _subroutines.push_back({ .name = subroutine->get_func_name(), .instructions = {}, .frame_size = 0 });
+    }
+
+    auto entry_it = subroutine_indices.find(semanalyzer::GLOBAL_SCOPE_ID);
+    if (entry_it == subroutine_indices.end()) {
+        spdlog::error("The program has no '{}' to start with. {}", semanalyzer::GLOBAL_SCOPE_ID, __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    for (const irgen::SubroutinePtr &subroutine : _program->get_subroutines()) {
+        LoadedSubroutine &loaded = _subroutines[subroutine_indices.at(subroutine->get_func_name())];
+
+        // an empty block is labeled at the next instruction
+        std::map<std::string, std::size_t> label_addresses;
+        std::size_t address = 0;
+        for (const irgen::BasicBlockPtr &basic_block : subroutine->get_basic_blocks()) {
+            label_addresses[basic_block->get_label()] = address;
+            address += basic_block->get_instructions().size();
+        }
+
+        for (const irgen::BasicBlockPtr &basic_block : subroutine->get_basic_blocks()) {
+            for (const irgen::TACPtr &tac : basic_block->get_instructions()) {
+                const irgen::IROperation op = tac->get_op();
+                Instruction instruction { .op = op, .tile = {}, .target = 0 };
+
+                switch (op) {
+                case irgen::IROperation::INBOX:
+                case irgen::IROperation::OUTBOX:
+                case irgen::IROperation::RET:
+                case irgen::IROperation::HALT:
+                    break;
+                case irgen::IROperation::COPYFROM:
+                case irgen::IROperation::COPYFROMI:
+                case irgen::IROperation::COPYTOI:
+                case irgen::IROperation::ADDM:
+                case irgen::IROperation::SUBM:
+                    instruction.tile = resolve_tile(tac->get_src1(), loaded.frame_size);
+                    break;
+                case irgen::IROperation::COPYTO:
+                case irgen::IROperation::BUMPUP:
+                case irgen::IROperation::BUMPDN:
+                    instruction.tile = resolve_tile(tac->get_tgt(), loaded.frame_size);
+                    break;
+                case irgen::IROperation::JUMP:
+                case irgen::IROperation::JUMPZ:
+                case irgen::IROperation::JUMPN:
+                    instruction.target = label_addresses.at(tac->get_tgt().get_label());
+                    break;
+                case irgen::IROperation::CALL:
+                    instruction.target = subroutine_indices.at(tac->get_src1().get_label());
+                    break;
+                default:
+                    spdlog::error("Subroutine '{}' is not lowered to LIR: {}. {}", subroutine->get_func_name(), tac->to_string(), __PRETTY_FUNCTION__);
+                    throw;
+                }
+
+                loaded.instructions.push_back(instruction);
+            }
+        }
+    }
+
+    return entry_it->second;
+}
+
+LIRInterpreter::Tile LIRInterpreter::resolve_tile(const irgen::Operand &operand, unsigned int &frame_size)
+{
+    switch (operand.get_type()) {
+    case irgen::Operand::OperandType::VariableId: {
+        int id = operand.get_register_id();
+        if (id >= 0) {
+            frame_size = std::max(frame_size, static_cast<unsigned int>(id) + 1);
+            return Tile { .space = TileSpace::Local, .index = static_cast<unsigned int>(id) };
+        } else {
+            unsigned int index = static_cast<unsigned int>(-id);
+            if (_globals.size() <= index) {
+                _globals.resize(index + 1);
+            }
+            return Tile { .space = TileSpace::Global, .index = index };
+        }
+    }
+    case irgen::Operand::OperandType::ImmediateValue:
+        _constants.emplace_back(operand.get_constant());
+        return Tile { .space = TileSpace::Constant, .index = static_cast<unsigned int>(_constants.size() - 1) };
+    default:
+        spdlog::error("Operand {} is not a tile. {}", std::string(operand), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+HRMByte LIRInterpreter::read_tile(const Tile &tile, const Tiles &locals) const
+{
+    const std::optional<HRMByte> *value = nullptr;
+
+    switch (tile.space) {
+    case TileSpace::Constant:
+        return _constants[tile.index];
+    case TileSpace::Local:
+        value = &locals[tile.index];
+        break;
+    case TileSpace::Global:
+        value = &_globals[tile.index];
+        break;
+    case TileSpace::None:
+        break;
+    }
+
+    if (value == nullptr || !value->has_value()) {
+        spdlog::error("The tile is read before assigned. This is likely a bug, consider report it. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+    return value->value();
+}
+
+std::optional<HRMByte> &LIRInterpreter::writable_tile(const Tile &tile, Tiles &locals)
+{
+    switch (tile.space) {
+    case TileSpace::Local:
+        return locals[tile.index];
+    case TileSpace::Global:
+        return _globals[tile.index];
+    case TileSpace::Constant:
+    case TileSpace::None:
+        break;
+    }
+
+    spdlog::error("The tile is not writable. This is likely a bug, consider report it. {}", __PRETTY_FUNCTION__);
+    throw;
+}
+
+int LIRInterpreter::floor_address(const Tile &tile, const Tiles &locals) const
+{
+    return read_tile(tile, locals).operator int();
+}
+
+CLOSE_INTERPRETER_NAMESPACE
+// end
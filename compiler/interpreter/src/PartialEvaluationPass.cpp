@@ -0,0 +1,322 @@
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "AnalyzeLivenessPass.h"
+#include "BuildControlFlowGraphPass.h"
+#include "EliminateDeadBasicBlockPass.h"
+#include "HRMByte.h"
+#include "IRInterpreter.h"
+#include "IROps.h"
+#include "IRProgramStructure.h"
+#include "InterpreterExceptions.h"
+#include "InterpreterIOManager.h"
+#include "InterpreterMemoryManager.h"
+#include "Operand.h"
+#include "PartialEvaluationPass.h"
+#include "ThreeAddressCode.h"
+#include "interpreter_global.h"
+#include "semanalyzer_global.h"
+
+OPEN_INTERPRETER_NAMESPACE
+
+namespace {
+
+// glb -> start
+constexpr std::size_t START_CALL_DEPTH = 2;
+
+struct EvaluationSuspended { };
+
+// the managers are in a base so they are constructed before the IRInterpreter which keeps references to them
+struct PartialEvaluatorManagers {
+    InterpreterIOManager io_manager;
+    InterpreterMemoryManager memory_manager;
+};
+
+class PartialEvaluator : private PartialEvaluatorManagers, public IRInterpreter {
+public:
+    PartialEvaluator(const irgen::ProgramPtr &program, unsigned int step_limit)
+        : IRInterpreter(io_manager, memory_manager, program, false)
+        , _step_limit(step_limit)
+    {
+    }
+
+    /**
+     * @brief Run the program until it can no longer be evaluated at compile time.
+     *
+     * @param resume_point [out] The state where start should resume
+     * @return true The execution stopped at a point where start can resume
+     * @return false There's nothing to resume. The program either finished, or stopped before start was entered.
+     */
+    bool evaluate(PartialEvaluationPass::ResumePoint &resume_point)
+    {
+        try {
+            exec();
+            spdlog::debug("[PartialEval] The program finished without any IO");
+            return false;
+        } catch (const EvaluationSuspended &) {
+            spdlog::debug("[PartialEval] Suspended after {} steps", _steps);
+        } catch (const InterpreterException &ex) {
+            // the error is for the runtime to raise
+            spdlog::debug("[PartialEval] Suspended by runtime error: {}", ex.what());
+        }
+
+        if (in_start() && _position_block) {
+            resume_point = make_resume_point();
+            return true;
+        } else if (_calling_stack.size() > START_CALL_DEPTH && _has_call_checkpoint) {
+            // the callee may have modified the globals and the floor. resume at the call.
+            resume_point = _call_checkpoint;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+protected:
+    void before_instruction(const irgen::BasicBlockPtr &basic_block, std::size_t instruction_index, const irgen::TACPtr &instruction) override
+    {
+        const irgen::IROperation op = instruction->get_op();
+
+        if (in_start()) {
+            _position_block = basic_block.get();
+            _position_index = instruction_index;
+
+            if (op == irgen::IROperation::CALL) {
+                _call_checkpoint = make_resume_point();
+                _has_call_checkpoint = true;
+            }
+        }
+
+        switch (op) {
+        case irgen::IROperation::INPUT:
+        case irgen::IROperation::OUTPUT:
+        case irgen::IROperation::HALT:
+            throw EvaluationSuspended();
+        default:
+            break;
+        }
+
+        if (_steps >= _step_limit) {
+            throw EvaluationSuspended();
+        }
+        ++_steps;
+    }
+
+private:
+    unsigned int _step_limit;
+    std::size_t _steps = 0;
+    // the last instruction of start about to execute
+    const irgen::BasicBlock *_position_block = nullptr;
+    std::size_t _position_index = 0;
+    PartialEvaluationPass::ResumePoint _call_checkpoint;
+    bool _has_call_checkpoint = false;
+
+    // A function called by a global initializer runs at the depth of start too
+    bool in_start() const
+    {
+        return _calling_stack.size() == START_CALL_DEPTH && _calling_stack.back().subroutine_name == "start";
+    }
+
+    PartialEvaluationPass::ResumePoint make_resume_point() const
+    {
+        return PartialEvaluationPass::ResumePoint {
+            .basic_block_label = _position_block->get_label(),
+            .instruction_index = _position_index,
+            .steps = _steps,
+            .local_variables = _calling_stack.back().variables,
+            .global_variables = _global_variables,
+            .floors = _memory_manager.get_floors(),
+        };
+    }
+};
+
+HRBox to_box(const HRMByte &value)
+{
+    return value.is_char() ? HRBox(value.operator char()) : HRBox(value.operator int());
+}
+
+irgen::SubroutinePtr find_subroutine(const irgen::ProgramPtr &program, const std::string &name)
+{
+    auto &subroutines = program->get_subroutines();
+    auto it = std::ranges::find_if(subroutines, [&name](const irgen::SubroutinePtr &subroutine) {
+        return subroutine->get_func_name() == name;
+    });
+    return it == subroutines.end() ? nullptr : *it;
+}
+
+}
+
+PartialEvaluationPass::~PartialEvaluationPass()
+{
+}
+
+int PartialEvaluationPass::run()
+{
+    for (const irgen::SubroutinePtr &subroutine : _program->get_subroutines()) {
+        if (subroutine->is_ssa()) {
+            spdlog::error("Partial evaluation requires non-SSA HIR but subroutine '{}' is SSA. {}", subroutine->get_func_name(), __PRETTY_FUNCTION__);
+            return 1;
+        }
+    }
+
+    ResumePoint resume_point;
+    if (!evaluate(resume_point)) {
+        spdlog::info("Partial evaluation: nothing to evaluate at compile time");
+        return 0;
+    }
+
+    if (!rewrite(resume_point)) {
+        return 0;
+    }
+
+    // rebuild the CFG and drop the blocks evaluated away
+    irgen::BuildControlFlowGraphPass cfg_builder(_program, _options);
+    int rc = cfg_builder.run();
+    if (rc != 0) {
+        return rc;
+    }
+
+    irgen::EliminateDeadBasicBlockPass dead_bb_eliminator(_program, _options);
+    return dead_bb_eliminator.run();
+}
+
+int PartialEvaluationPass::run_subroutine(const irgen::SubroutinePtr &subroutine, irgen::ProgramMetadata &metadata, const irgen::ProgramPtr &program)
+{
+    // this pass works on the whole program
+    UNUSED(subroutine);
+    UNUSED(metadata);
+    UNUSED(program);
+    return 0;
+}
+
+bool PartialEvaluationPass::evaluate(ResumePoint &resume_point)
+{
+    PartialEvaluator evaluator(_program, _options.PartialEvaluationStepLimit);
+    return evaluator.evaluate(resume_point);
+}
+
+bool PartialEvaluationPass::rewrite(const ResumePoint &resume_point)
+{
+    irgen::SubroutinePtr global_subroutine = find_subroutine(_program, semanalyzer::GLOBAL_SCOPE_ID);
+    irgen::SubroutinePtr start_subroutine = find_subroutine(_program, "start");
+    assert(global_subroutine && start_subroutine);
+
+    // the call to start is all left in glb
+    irgen::TACPtr start_invocation;
+    for (const irgen::BasicBlockPtr &basic_block : global_subroutine->get_basic_blocks()) {
+        for (const irgen::TACPtr &instruction : basic_block->get_instructions()) {
+            if (instruction->get_op() == irgen::IROperation::CALL && instruction->get_src1().get_label() == start_subroutine->get_func_name()) {
+                start_invocation = instruction;
+            }
+        }
+    }
+
+    if (!start_invocation) {
+        spdlog::critical("glb does not call start. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    auto &start_blocks = start_subroutine->get_basic_blocks();
+    auto resume_block_it = std::ranges::find_if(start_blocks, [&resume_point](const irgen::BasicBlockPtr &basic_block) {
+        return basic_block->get_label() == resume_point.basic_block_label;
+    });
+    if (resume_block_it == start_blocks.end()) {
+        spdlog::debug("[PartialEval] The resume point '{}' is not in start", resume_point.basic_block_label);
+        return false;
+    }
+    irgen::BasicBlockPtr resume_block = *resume_block_it;
+
+    // the variables live at the resume point: live out of the block, then walk back to the instruction
+    irgen::AnalyzeLivenessPass liveness(_program, _options);
+    int rc = liveness.run();
+    if (rc != 0) {
+        return false;
+    }
+
+    std::set<unsigned int> live_variables = resume_block->get_out_variables();
+    std::vector<irgen::TACPtr> resume_block_instructions(resume_block->get_instructions().begin(), resume_block->get_instructions().end());
+    for (std::size_t i = resume_block_instructions.size(); i-- > resume_point.instruction_index;) {
+        const irgen::TACPtr &instruction = resume_block_instructions.at(i);
+        const irgen::Operand &tgt = instruction->get_tgt();
+        const irgen::Operand &src1 = instruction->get_src1();
+        const irgen::Operand &src2 = instruction->get_src2();
+
+        if (tgt.get_type() == irgen::Operand::OperandType::VariableId && tgt.get_register_id() >= 0) {
+            live_variables.erase(tgt.get_register_id());
+        }
+        if (src1.get_type() == irgen::Operand::OperandType::VariableId && src1.get_register_id() >= 0) {
+            live_variables.insert(src1.get_register_id());
+        }
+        if (src2.get_type() == irgen::Operand::OperandType::VariableId && src2.get_register_id() >= 0) {
+            live_variables.insert(src2.get_register_id());
+        }
+    }
+
+    for (unsigned int variable : live_variables) {
+        if (!resume_point.local_variables.contains(static_cast<int>(variable))) {
+            spdlog::debug("[PartialEval] %{} is live at the resume point but never assigned", variable);
+            return false;
+        }
+    }
+
+    // glb stores + live locals + jump. no need to rewrite if it's slower.
+    std::size_t restore_cost = resume_point.global_variables.size() * 2 + live_variables.size() + 1;
+    if (resume_point.steps <= restore_cost) {
+        spdlog::info("Partial evaluation: {} instructions evaluated, not worth restoring the state with {}", resume_point.steps, restore_cost);
+        return false;
+    }
+
+    spdlog::info("Partial evaluation: {} instructions evaluated at compile time. Resuming at {}:{}",
+        resume_point.steps, resume_point.basic_block_label, resume_point.instruction_index);
+
+    std::map<int, HRBox> floor_inits;
+    for (const auto &[floor_id, value] : resume_point.floors) {
+        floor_inits.emplace(floor_id, to_box(value));
+    }
+    _program->get_metadata().set_floor_inits(floor_inits);
+
+    auto &global_blocks = global_subroutine->get_basic_blocks();
+    global_blocks.erase(std::next(global_blocks.begin()), global_blocks.end());
+    global_blocks.front()->get_instructions() = { start_invocation };
+
+    // split the resume block so the entry can jump to the instruction
+    std::string resume_label = resume_block->get_label();
+    if (resume_point.instruction_index > 0) {
+        auto &instructions = resume_block->get_instructions();
+        std::list<irgen::TACPtr> tail;
+        tail.splice(tail.begin(), instructions, std::next(instructions.begin(), resume_point.instruction_index), instructions.end());
+
+        resume_label = start_subroutine->get_func_name() + ".PE_resume";
+        start_blocks.insert(std::next(resume_block_it), std::make_shared<irgen::BasicBlock>(std::string(resume_label), std::move(tail)));
+    }
+
+    std::list<irgen::TACPtr> entry_instructions;
+    if (!resume_point.global_variables.empty()) {
+        irgen::Operand scratch(static_cast<int>(start_subroutine->get_max_reg_id() + 1));
+        for (const auto &[global_id, value] : resume_point.global_variables) {
+            entry_instructions.push_back(irgen::ThreeAddressCode::create_load_immediate(scratch, to_box(value)));
+            entry_instructions.push_back(irgen::ThreeAddressCode::create_data_movement(irgen::IROperation::STORE, irgen::Operand(), irgen::Operand(global_id), scratch));
+        }
+    }
+
+    for (unsigned int variable : live_variables) {
+        int var_id = static_cast<int>(variable);
+        entry_instructions.push_back(irgen::ThreeAddressCode::create_load_immediate(irgen::Operand(var_id), to_box(resume_point.local_variables.at(var_id))));
+    }
+
+    entry_instructions.push_back(irgen::ThreeAddressCode::create_branching(irgen::Operand(resume_label)));
+    start_blocks.push_front(std::make_shared<irgen::BasicBlock>(start_subroutine->get_func_name() + ".PE_entry", std::move(entry_instructions)));
+
+    return true;
+}
+
+CLOSE_INTERPRETER_NAMESPACE
+// end
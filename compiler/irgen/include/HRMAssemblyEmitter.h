@@ -0,0 +1,88 @@
+#ifndef HRMASSEMBLYEMITTER_H
+#define HRMASSEMBLYEMITTER_H
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "HRBox.h"
+#include "IROps.h"
+#include "IRProgramStructure.h"
+#include "irgen_global.h"
+
+OPEN_IRGEN_NAMESPACE
+
+/**
+ * @brief Emits the game-compatible HRM assembly from a program lowered by LowerToLIRPass.
+ *
+ * HRM has no call stack, so every call is inlined, and a recursive program cannot be emitted. The tiles are
+ * assigned to the floor after the ones the program uses. The constants need the floor to be initialized with them,
+ * and a floor tile already initialized with the same value is reused when the program never overwrites it.
+ * The required floor is listed above the program header as "-- floor[n] = v --", which the game ignores.
+ */
+class HRMAssemblyEmitter {
+public:
+    explicit HRMAssemblyEmitter(const ProgramPtr &program)
+        : _program(program)
+    {
+    }
+
+    ~HRMAssemblyEmitter() = default;
+
+    /**
+     * @brief Emit the assembly.
+     * @return 0 on success
+     */
+    int emit(std::ostream &out);
+
+    /**
+     * @brief The size score of the emitted program, the number of instructions.
+     */
+    std::size_t get_size() const { return _size; }
+
+    /**
+     * @brief Whether a subroutine reachable from the entry calls itself, directly or not.
+     */
+    static bool has_recursion(const ProgramPtr &program);
+
+private:
+    struct Line {
+        // a label if op is NOP
+        IROperation op = IROperation::NOP;
+        int floor = 0;
+        bool indirect = false;
+        std::string label;
+    };
+
+    ProgramPtr _program;
+    std::map<std::string, SubroutinePtr> _subroutines;
+    std::vector<Line> _lines;
+    // map<subroutine, map<variable id, floor>>
+    std::map<std::string, std::map<int, int>> _local_floors;
+    std::map<int, int> _global_floors;
+    // map<pair<is char, value>, floor>
+    std::map<std::pair<bool, int>, int> _constant_floors;
+    std::map<int, HRBox> _floor_inits;
+    // the floors of the local and global tiles
+    std::set<int> _tile_floors;
+    int _floor_max = 0;
+    std::string _end_label;
+    unsigned int _label_count = 0;
+    std::size_t _size = 0;
+
+    int allocate_floors();
+    int emit_subroutine(const SubroutinePtr &subroutine, const std::string &return_label, std::set<std::string> &active);
+    int floor_of(const std::string &subroutine, const Operand &operand) const;
+    std::string new_label();
+    void remove_dead_stores();
+    void optimize_jumps();
+    void write(std::ostream &out);
+};
+
+CLOSE_IRGEN_NAMESPACE
+
+#endif
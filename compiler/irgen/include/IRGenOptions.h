@@ -18,6 +18,8 @@ struct IRGenOptions {
     IROptimizationFor EliminateNop = IROptimizationFor::OptForSpeed;
     IROptimizationFor EliminateEnter = IROptimizationFor::OptForSpeed;
     IROptimizationFor EliminateDeadAssignment = IROptimizationFor::NoOpt;
+    // the max instructions the partial evaluator runs at compile time
+    unsigned int PartialEvaluationStepLimit = 100000;
 
     static IRGenOptions ForSpeed()
     {
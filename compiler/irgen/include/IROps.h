@@ -64,7 +64,21 @@ enum class IROperation : std::uint8_t {
     // Pseudo Operation
     PHI = 0x80,
 
-    // Low IR
+    // Low IR. The accumulator r0 is implicit. A memory operand is a local tile (%n), a global tile (glb%n) or a
+    // constant tile (#v). The indirect ops address the floor by the value of the operand. (0x90 - 0x9C)
+    INBOX = 0x90, // inbox. r0 = input
+    OUTBOX = 0x91, // outbox. output r0, then r0 is empty
+    COPYFROM = 0x92, // copyfrom a. r0 = a. a is src1
+    COPYTO = 0x93, // copyto a. a = r0. a is tgt
+    COPYFROMI = 0x94, // copyfrom [a]. r0 = floor[a]. a is src1
+    COPYTOI = 0x95, // copyto [a]. floor[a] = r0. a is src1
+    ADDM = 0x96, // add a. r0 = r0 + a. a is src1
+    SUBM = 0x97, // sub a. r0 = r0 - a. a is src1
+    BUMPUP = 0x98, // bump+ a. a = a + 1, then r0 = a. a is tgt
+    BUMPDN = 0x99, // bump- a. a = a - 1, then r0 = a. a is tgt
+    JUMP = 0x9A, // jump label
+    JUMPZ = 0x9B, // jumpz label. jump if r0 == 0
+    JUMPN = 0x9C, // jumpn label. jump if r0 < 0
 };
 
 struct IROperationMetadata {
@@ -73,6 +87,8 @@ struct IROperationMetadata {
     static bool is_branch(IROperation op);
     static bool is_comparison(IROperation op);
     static bool has_side_effect(IROperation op);
+    static bool is_low_level(IROperation op);
+    static bool is_indirect(IROperation op);
 };
 
 CLOSE_IRGEN_NAMESPACE
@@ -214,6 +214,8 @@ public:
 
     std::map<int, HRBox> get_floor_inits() { return _floor_inits; }
 
+    void set_floor_inits(const std::map<int, HRBox> &floor_inits) { _floor_inits = floor_inits; }
+
     int get_floor_max() const { return _floor_max; };
 
 private:
@@ -0,0 +1,39 @@
+#ifndef LOWERTOLIRPASS_H
+#define LOWERTOLIRPASS_H
+
+#include "IRGenOptions.h"
+#include "IROptimizationPass.h"
+#include "IRProgramStructure.h"
+#include "irgen_global.h"
+
+OPEN_IRGEN_NAMESPACE
+
+// Depends: SSA
+/**
+ * @brief Lowers the HIR in SSA form into LIR, the accumulator machine code described in design/arch.md.
+ *
+ * Every SSA variable is given its own local tile. Variables defined by an immediate load are read from the constant
+ * tiles directly. Phis are replaced by copies at the end of the predecessors, with the critical edges split.
+ * mul, div, mod, the comparisons and the logical operations are expanded into add/sub and jumpz/jumpn sequences.
+ *
+ * Calls and returns stay as the pseudo instructions c and ret, with the argument and the return value in r0.
+ * The CFG is rebuilt after lowering.
+ */
+class LowerToLIRPass : public IROptimizationPass {
+public:
+    LowerToLIRPass(const ProgramPtr &program, const IRGenOptions &options)
+        : IROptimizationPass(program, options)
+    {
+    }
+
+    ~LowerToLIRPass();
+
+    int run() override;
+
+protected:
+    int run_subroutine(const SubroutinePtr &subroutine, ProgramMetadata &metadata, const ProgramPtr &program) override;
+};
+
+CLOSE_IRGEN_NAMESPACE
+
+#endif
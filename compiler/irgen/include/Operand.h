@@ -1,10 +1,12 @@
 #ifndef OPERAND_H
 #define OPERAND_H
 
+#include <memory>
 #include <string>
 #include <variant>
 
 #include "HRBox.h"
+#include "hrl_global.h"
 #include "irgen_global.h"
 
 OPEN_IRGEN_NAMESPACE
@@ -37,7 +39,14 @@ public:
 
     explicit Operand(const std::string &label)
         : _type(OperandType::Label)
-        , _value(label)
+        , _value(std::make_shared<std::string>(label))
+    {
+    }
+
+    // The label shares \p label, such as an interned name, and so do the copies of the operand
+    explicit Operand(StringPtr label)
+        : _type(OperandType::Label)
+        , _value(std::move(label))
     {
     }
 
@@ -56,7 +65,7 @@ public:
 
     HRBox get_constant() const { return std::get<HRBox>(_value); }
 
-    std::string get_label() const { return std::get<std::string>(_value); }
+    const std::string &get_label() const { return *std::get<StringPtr>(_value); }
 
     void rename_register(unsigned int id);
 
@@ -65,8 +74,8 @@ private:
 
     // imm value: the HRBox value
     // reg: the int reg id. negative represents global
-    // label: string
-    std::variant<int, std::string, HRBox> _value;
+    // label: the shared string
+    std::variant<int, StringPtr, HRBox> _value;
 };
 
 CLOSE_IRGEN_NAMESPACE
@@ -9,9 +9,11 @@
 #include <boost/bimap.hpp>
 
 #include "ASTNodeForward.h"
+#include "ASTNodeSideTable.h"
 #include "HRBox.h"
 #include "IRProgramStructure.h"
 #include "SemanticAnalysisPass.h"
+#include "StringInterner.h"
 #include "Symbol.h"
 #include "ThreeAddressCode.h"
 #include "WithSymbolTable.h"
@@ -30,6 +32,16 @@ public:
 
     virtual int run() override;
 
+    semanalyzer::PassTraits get_traits() const override
+    {
+        return semanalyzer::PassTraits {
+            .read_only = true,
+            .required_attributes = { semanalyzer::ATTR_SEMANALYZER_SYMBOL },
+            .produced_attributes = {},
+            .invalidated_attributes = {},
+        };
+    }
+
     ProgramPtr get_built_program() { return _built_program; }
 
     void print();
@@ -80,35 +92,40 @@ private:
     unsigned int _current_block_label_id = 0;
     bool _in_global_var_decl = false;
     std::string _current_subroutine_name;
+    // the names and the labels are interned in the interner of the AST
+    StringInternerPtr _strings;
+    StringId _inbox_name = NO_STRING_ID;
+    StringId _outbox_name = NO_STRING_ID;
     std::list<TACPtr> _current_subroutine_tac;
 
     // map<Symbol, Var Operand>
     std::map<semanalyzer::SymbolPtr, Operand> _symbol_to_var_map;
-    // map<AST Node, result Operand>
-    std::map<parser::ASTNodePtr, Operand> _node_var_id_result;
+    // the result Operand of each AST node
+    parser::ASTNodeSideTable<Operand> _node_var_id_result;
 
     // the dest label for loop break
-    std::stack<std::string> _loop_break_dest;
+    std::stack<StringId> _loop_break_dest;
     // the dest label for loop continue
-    std::stack<std::string> _loop_continue_dest;
+    std::stack<StringId> _loop_continue_dest;
 
     // [Group] program representatoin
     // map<func name, IRs>
     std::map<std::string, std::list<TACPtr>> _subroutine_tacs;
     // map<label, IR iter>
-    boost::bimap<std::string, boost::bimaps::set_of<InstructionListIter>> _labels;
+    boost::bimap<StringId, boost::bimaps::set_of<InstructionListIter>> _labels;
     // map<floor id, value>
     std::map<int, HRBox> _floor_inits;
 
     int take_var_id_numbering();
-    std::string take_block_label();
-    std::string take_block_label(const std::string &msg);
+    Operand &node_result(const parser::ASTNodePtr &node);
+    StringId take_block_label();
+    StringId take_block_label(const std::string &msg);
 
     // Create the label, set the node to _labels
     InstructionListIter create_noop(const parser::ASTNodePtr &node);
-    InstructionListIter create_jmp(const std::string &label, const parser::ASTNodePtr &node);
-    InstructionListIter create_jnz(const Operand &operand, const std::string &label, const parser::ASTNodePtr &node);
-    InstructionListIter create_jz(const Operand &operand, const std::string &label, const parser::ASTNodePtr &node);
+    InstructionListIter create_jmp(StringId label, const parser::ASTNodePtr &node);
+    InstructionListIter create_jnz(const Operand &operand, StringId label, const parser::ASTNodePtr &node);
+    InstructionListIter create_jz(const Operand &operand, StringId label, const parser::ASTNodePtr &node);
     InstructionListIter create_instr(const TACPtr &instr);
 
     template <IROperation op>
@@ -66,6 +66,16 @@ public:
     static std::shared_ptr<ThreeAddressCode> create_return(std::shared_ptr<parser::ASTNode> ast = nullptr);
     static std::shared_ptr<ThreeAddressCode> create_return(const Operand &ret, std::shared_ptr<parser::ASTNode> ast = nullptr);
     static std::shared_ptr<ThreeAddressCode> create_phi(int var_id, std::shared_ptr<parser::ASTNode> ast = nullptr);
+    /**
+     * @brief Create a low IR instruction. The memory operand is placed as the op describes, the tgt for the tile written
+     * and the label, the src1 for the tile read.
+     *
+     * @param op A low IR operation
+     * @param operand The memory operand or the label. Null for inbox and outbox.
+     * @param ast
+     * @return std::shared_ptr<ThreeAddressCode>
+     */
+    static std::shared_ptr<ThreeAddressCode> create_accumulator(IROperation op, const Operand &operand = Operand(), std::shared_ptr<parser::ASTNode> ast = nullptr);
 
     /**
      * @brief Create an instruction without any check
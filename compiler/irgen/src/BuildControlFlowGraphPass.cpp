@@ -56,6 +56,8 @@ int hrl::irgen::BuildControlFlowGraphPass::run_subroutine(const SubroutinePtr &s
             case IROperation::JLE:
             case IROperation::JZ:
             case IROperation::JNZ:
+            case IROperation::JUMPZ:
+            case IROperation::JUMPN:
                 connect_next = true;
                 connect_target = true;
                 target = flow_xfer_instr->get_tgt().get_label();
@@ -63,6 +65,7 @@ int hrl::irgen::BuildControlFlowGraphPass::run_subroutine(const SubroutinePtr &s
 
                 // branch
             case IROperation::JMP:
+            case IROperation::JUMP:
                 connect_next = false;
                 connect_target = true;
                 target = flow_xfer_instr->get_tgt().get_label();
@@ -0,0 +1,541 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "HRBox.h"
+#include "HRMAssemblyEmitter.h"
+#include "IROps.h"
+#include "IRProgramStructure.h"
+#include "Operand.h"
+#include "ThreeAddressCode.h"
+#include "irgen_global.h"
+#include "semanalyzer_global.h"
+
+OPEN_IRGEN_NAMESPACE
+
+namespace {
+
+std::pair<bool, int> constant_key(const HRBox &value)
+{
+    return { value.is_char(), value.operator int() };
+}
+
+std::string constant_text(const HRBox &value)
+{
+    return value.is_char() ? std::string(1, value.operator char()) : std::to_string(value.operator int());
+}
+
+// the operand addressing a tile. labels are not included.
+const Operand *tile_operand(const TACPtr &instruction)
+{
+    switch (instruction->get_op()) {
+    case IROperation::COPYFROM:
+    case IROperation::COPYFROMI:
+    case IROperation::COPYTOI:
+    case IROperation::ADDM:
+    case IROperation::SUBM:
+        return &instruction->get_src1();
+    case IROperation::COPYTO:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
+        return &instruction->get_tgt();
+    default:
+        return nullptr;
+    }
+}
+
+const char *mnemonic(IROperation op)
+{
+    switch (op) {
+    case IROperation::INBOX:
+        return "INBOX";
+    case IROperation::OUTBOX:
+        return "OUTBOX";
+    case IROperation::COPYFROM:
+        return "COPYFROM";
+    case IROperation::COPYTO:
+        return "COPYTO";
+    case IROperation::ADDM:
+        return "ADD";
+    case IROperation::SUBM:
+        return "SUB";
+    case IROperation::BUMPUP:
+        return "BUMPUP";
+    case IROperation::BUMPDN:
+        return "BUMPDN";
+    case IROperation::JUMP:
+        return "JUMP";
+    case IROperation::JUMPZ:
+        return "JUMPZ";
+    case IROperation::JUMPN:
+        return "JUMPN";
+    default:
+        spdlog::critical("'{}' is not an HRM instruction. {}", IROperationMetadata::to_string(op), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+} // namespace
+
+int HRMAssemblyEmitter::emit(std::ostream &out)
+{
+    _subroutines.clear();
+    _lines.clear();
+    _local_floors.clear();
+    _global_floors.clear();
+    _constant_floors.clear();
+    _tile_floors.clear();
+    _label_count = 0;
+    _size = 0;
+
+    for (const SubroutinePtr &subroutine : _program->get_subroutines()) {
+        _subroutines[subroutine->get_func_name()] = subroutine;
+    }
+
+    auto entry_it = _subroutines.find(semanalyzer::GLOBAL_SCOPE_ID);
+    if (entry_it == _subroutines.end()) {
+        spdlog::error("The program has no '{}' to start with. {}", semanalyzer::GLOBAL_SCOPE_ID, __PRETTY_FUNCTION__);
+        return 1;
+    }
+
+    if (has_recursion(_program)) {
+        spdlog::error("The program is recursive, which cannot be emitted as HRM assembly since HRM has no call stack");
+        return 1;
+    }
+
+    int result = allocate_floors();
+    if (result != 0) {
+        return result;
+    }
+
+    _end_label = new_label();
+    std::set<std::string> active;
+    result = emit_subroutine(entry_it->second, _end_label, active);
+    if (result != 0) {
+        return result;
+    }
+    _lines.push_back(Line { .op = IROperation::NOP, .floor = 0, .indirect = false, .label = _end_label });
+
+    remove_dead_stores();
+    optimize_jumps();
+    _size = static_cast<std::size_t>(std::ranges::count_if(_lines, [](const Line &line) { return line.op != IROperation::NOP; }));
+    write(out);
+    return 0;
+}
+
+bool HRMAssemblyEmitter::has_recursion(const ProgramPtr &program)
+{
+    // map<caller, callees>
+    std::map<std::string, std::set<std::string>> calls;
+    for (const SubroutinePtr &subroutine : program->get_subroutines()) {
+        std::set<std::string> &callees = calls[subroutine->get_func_name()];
+        for (const BasicBlockPtr &basic_block : subroutine->get_basic_blocks()) {
+            for (const TACPtr &instruction : basic_block->get_instructions()) {
+                if (instruction->get_op() == IROperation::CALL) {
+                    callees.insert(instruction->get_src1().get_label());
+                }
+            }
+        }
+    }
+
+    // 0 unvisited, 1 on the path, 2 done
+    std::map<std::string, int> states;
+    std::function<bool(const std::string &)> visit = [&](const std::string &name) {
+        int &state = states[name];
+        if (state != 0) {
+            return state == 1;
+        }
+        state = 1;
+        for (const std::string &callee : calls[name]) {
+            if (visit(callee)) {
+                return true;
+            }
+        }
+        states[name] = 2;
+        return false;
+    };
+
+    return visit(semanalyzer::GLOBAL_SCOPE_ID);
+}
+
+int HRMAssemblyEmitter::allocate_floors()
+{
+    const ProgramMetadata &metadata = _program->get_metadata();
+    _floor_inits = metadata.get_floor_inits();
+
+    // the floors the program addresses itself
+    std::set<int> reserved;
+    std::set<int> written;
+    bool dynamic_access = false;
+    bool dynamic_write = false;
+
+    std::vector<HRBox> constants;
+    std::vector<int> globals;
+    std::vector<std::pair<std::string, int>> locals;
+
+    for (const SubroutinePtr &subroutine : _program->get_subroutines()) {
+        for (const BasicBlockPtr &basic_block : subroutine->get_basic_blocks()) {
+            for (const TACPtr &instruction : basic_block->get_instructions()) {
+                const Operand *operand = tile_operand(instruction);
+                if (operand == nullptr) {
+                    continue;
+                }
+
+                const bool indirect = IROperationMetadata::is_indirect(instruction->get_op());
+                const bool writes = instruction->get_op() == IROperation::COPYTOI;
+
+                switch (operand->get_type()) {
+                case Operand::OperandType::ImmediateValue:
+                    if (indirect) {
+                        int floor = operand->get_constant().operator int();
+                        reserved.insert(floor);
+                        if (writes) {
+                            written.insert(floor);
+                        }
+                        continue;
+                    }
+                    constants.push_back(operand->get_constant());
+                    break;
+                case Operand::OperandType::VariableId:
+                    if (indirect) {
+                        dynamic_access = true;
+                        dynamic_write = dynamic_write || writes;
+                    }
+                    if (operand->is_local_register()) {
+                        locals.emplace_back(subroutine->get_func_name(), operand->get_register_id());
+                    } else {
+                        globals.push_back(operand->get_register_id());
+                    }
+                    break;
+                default:
+                    spdlog::error("'{}' does not address a tile. {}", instruction->to_string(), __PRETTY_FUNCTION__);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    if (dynamic_access) {
+        for (int floor = 0; floor <= metadata.get_floor_max(); ++floor) {
+            reserved.insert(floor);
+        }
+    }
+    for (const auto &[floor, value] : _floor_inits) {
+        reserved.insert(floor);
+    }
+
+    int next_floor = 0;
+    auto allocate = [&]() {
+        while (reserved.contains(next_floor)) {
+            ++next_floor;
+        }
+        reserved.insert(next_floor);
+        return next_floor;
+    };
+
+    for (const HRBox &value : constants) {
+        auto key = constant_key(value);
+        if (_constant_floors.contains(key)) {
+            continue;
+        }
+
+        if (!dynamic_write) {
+            auto init_it = std::ranges::find_if(_floor_inits, [&](const std::pair<const int, HRBox> &init) {
+                return constant_key(init.second) == key && !written.contains(init.first);
+            });
+            if (init_it != _floor_inits.end()) {
+                _constant_floors[key] = init_it->first;
+                continue;
+            }
+        }
+
+        int floor = allocate();
+        _constant_floors[key] = floor;
+        _floor_inits.emplace(floor, value);
+    }
+
+    for (int id : globals) {
+        if (!_global_floors.contains(id)) {
+            _global_floors[id] = allocate();
+            _tile_floors.insert(_global_floors[id]);
+        }
+    }
+
+    for (const auto &[subroutine, id] : locals) {
+        std::map<int, int> &floors = _local_floors[subroutine];
+        if (!floors.contains(id)) {
+            floors[id] = allocate();
+            _tile_floors.insert(floors[id]);
+        }
+    }
+
+    _floor_max = reserved.empty() ? 0 : *reserved.rbegin();
+    return 0;
+}
+
+int HRMAssemblyEmitter::emit_subroutine(const SubroutinePtr &subroutine, const std::string &return_label, std::set<std::string> &active)
+{
+    const std::string &name = subroutine->get_func_name();
+    if (!active.insert(name).second) {
+        spdlog::error("Subroutine '{}' is recursive. {}", name, __PRETTY_FUNCTION__);
+        return 1;
+    }
+
+    // the blocks are inlined once per call, so the labels are made unique
+    const std::string prefix = new_label() + ":";
+
+    for (const BasicBlockPtr &basic_block : subroutine->get_basic_blocks()) {
+        _lines.push_back(Line { .op = IROperation::NOP, .floor = 0, .indirect = false, .label = prefix + basic_block->get_label() });
+
+        for (const TACPtr &instruction : basic_block->get_instructions()) {
+            const IROperation op = instruction->get_op();
+            Line line { .op = op, .floor = 0, .indirect = false, .label = {} };
+
+            switch (op) {
+            case IROperation::INBOX:
+            case IROperation::OUTBOX:
+                break;
+            case IROperation::COPYFROM:
+            case IROperation::COPYTO:
+            case IROperation::ADDM:
+            case IROperation::SUBM:
+            case IROperation::BUMPUP:
+            case IROperation::BUMPDN:
+                line.floor = floor_of(name, *tile_operand(instruction));
+                break;
+            case IROperation::COPYFROMI:
+            case IROperation::COPYTOI: {
+                const Operand &address = instruction->get_src1();
+                line.op = op == IROperation::COPYFROMI ? IROperation::COPYFROM : IROperation::COPYTO;
+                if (address.get_type() == Operand::OperandType::ImmediateValue) {
+                    line.floor = address.get_constant().operator int();
+                } else {
+                    line.floor = floor_of(name, address);
+                    line.indirect = true;
+                }
+            } break;
+            case IROperation::JUMP:
+            case IROperation::JUMPZ:
+            case IROperation::JUMPN:
+                line.label = prefix + instruction->get_tgt().get_label();
+                break;
+            case IROperation::CALL: {
+                std::string resume_label = new_label();
+                int result = emit_subroutine(_subroutines.at(instruction->get_src1().get_label()), resume_label, active);
+                if (result != 0) {
+                    return result;
+                }
+                line = Line { .op = IROperation::NOP, .floor = 0, .indirect = false, .label = resume_label };
+            } break;
+            case IROperation::RET:
+                line = Line { .op = IROperation::JUMP, .floor = 0, .indirect = false, .label = return_label };
+                break;
+            case IROperation::HALT:
+                // HRM stops at the end of the program
+                line = Line { .op = IROperation::JUMP, .floor = 0, .indirect = false, .label = _end_label };
+                break;
+            default:
+                spdlog::error("Subroutine '{}' is not lowered to LIR: {}. {}", name, instruction->to_string(), __PRETTY_FUNCTION__);
+                return 1;
+            }
+
+            _lines.push_back(std::move(line));
+        }
+    }
+
+    active.erase(name);
+    return 0;
+}
+
+int HRMAssemblyEmitter::floor_of(const std::string &subroutine, const Operand &operand) const
+{
+    if (operand.get_type() == Operand::OperandType::ImmediateValue) {
+        return _constant_floors.at(constant_key(operand.get_constant()));
+    } else if (operand.is_local_register()) {
+        return _local_floors.at(subroutine).at(operand.get_register_id());
+    } else {
+        return _global_floors.at(operand.get_register_id());
+    }
+}
+
+std::string HRMAssemblyEmitter::new_label()
+{
+    return "L" + std::to_string(++_label_count);
+}
+
+void HRMAssemblyEmitter::remove_dead_stores()
+{
+    // an SSA variable is stored even if only r0 uses it
+    std::set<int> read_floors;
+    for (const Line &line : _lines) {
+        switch (line.op) {
+        case IROperation::COPYTO:
+            if (line.indirect) {
+                read_floors.insert(line.floor);
+            }
+            break;
+        case IROperation::COPYFROM:
+        case IROperation::ADDM:
+        case IROperation::SUBM:
+        case IROperation::BUMPUP:
+        case IROperation::BUMPDN:
+            read_floors.insert(line.floor);
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::erase_if(_lines, [&](const Line &line) {
+        return line.op == IROperation::COPYTO && !line.indirect && _tile_floors.contains(line.floor) && !read_floors.contains(line.floor);
+    });
+}
+
+void HRMAssemblyEmitter::optimize_jumps()
+{
+    auto is_jump = [](const Line &line) {
+        return line.op == IROperation::JUMP || line.op == IROperation::JUMPZ || line.op == IROperation::JUMPN;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        std::map<std::string, std::size_t> label_lines;
+        for (std::size_t i = 0; i < _lines.size(); ++i) {
+            if (_lines[i].op == IROperation::NOP) {
+                label_lines[_lines[i].label] = i;
+            }
+        }
+
+        // the first instruction at or after a label
+        auto instruction_at = [&](const std::string &label) -> const Line * {
+            for (std::size_t i = label_lines.at(label); i < _lines.size(); ++i) {
+                if (_lines[i].op != IROperation::NOP) {
+                    return &_lines[i];
+                }
+            }
+            return nullptr;
+        };
+
+        // jump to a jump goes to its target directly
+        for (Line &line : _lines) {
+            if (!is_jump(line)) {
+                continue;
+            }
+
+            std::set<std::string> visited { line.label };
+            const Line *target = instruction_at(line.label);
+            while (target != nullptr && target->op == IROperation::JUMP && visited.insert(target->label).second) {
+                line.label = target->label;
+                changed = true;
+                target = instruction_at(line.label);
+            }
+        }
+
+        std::set<std::string> referenced;
+        for (const Line &line : _lines) {
+            if (is_jump(line)) {
+                referenced.insert(line.label);
+            }
+        }
+
+        std::vector<Line> lines;
+        lines.reserve(_lines.size());
+        bool reachable = true;
+        for (std::size_t i = 0; i < _lines.size(); ++i) {
+            const Line &line = _lines[i];
+
+            if (line.op == IROperation::NOP) {
+                if (referenced.contains(line.label)) {
+                    lines.push_back(line);
+                    reachable = true;
+                } else {
+                    changed = true;
+                }
+                continue;
+            }
+
+            if (!reachable) {
+                changed = true;
+                continue;
+            }
+
+            if (is_jump(line)) {
+                // a jump to where it falls through anyway
+                std::size_t next = i + 1;
+                while (next < _lines.size() && _lines[next].op == IROperation::NOP && _lines[next].label != line.label) {
+                    ++next;
+                }
+                if (next < _lines.size() && _lines[next].op == IROperation::NOP) {
+                    changed = true;
+                    continue;
+                }
+            }
+
+            lines.push_back(line);
+            if (line.op == IROperation::JUMP) {
+                reachable = false;
+            }
+        }
+
+        _lines = std::move(lines);
+    }
+}
+
+void HRMAssemblyEmitter::write(std::ostream &out)
+{
+    // a, b, ..., z, aa, ab, ...
+    std::map<std::string, std::string> names;
+    for (const Line &line : _lines) {
+        if (line.op == IROperation::NOP) {
+            std::string name;
+            for (std::size_t n = names.size() + 1; n > 0; n = (n - 1) / 26) {
+                name.insert(name.begin(), static_cast<char>('a' + (n - 1) % 26));
+            }
+            names[line.label] = name;
+        }
+    }
+
+    out << "-- floor_max = " << _floor_max << " --\n";
+    for (const auto &[floor, value] : _floor_inits) {
+        out << "-- floor[" << floor << "] = " << constant_text(value) << " --\n";
+    }
+    out << "-- HUMAN RESOURCE MACHINE PROGRAM --\n\n";
+
+    for (const Line &line : _lines) {
+        if (line.op == IROperation::NOP) {
+            out << names.at(line.label) << ":\n";
+            continue;
+        }
+
+        std::string text = mnemonic(line.op);
+        switch (line.op) {
+        case IROperation::INBOX:
+        case IROperation::OUTBOX:
+            break;
+        case IROperation::JUMP:
+        case IROperation::JUMPZ:
+        case IROperation::JUMPN:
+            text.resize(9, ' ');
+            text += names.at(line.label);
+            break;
+        default:
+            text.resize(9, ' ');
+            text += line.indirect ? "[" + std::to_string(line.floor) + "]" : std::to_string(line.floor);
+            break;
+        }
+        out << "    " << text << "\n";
+    }
+}
+
+CLOSE_IRGEN_NAMESPACE
+// end
@@ -92,6 +92,32 @@ std::string IROperationMetadata::to_string(IROperation op)
 
     case IROperation::PHI:
         return "phi";
+
+    // low ir
+    case IROperation::INBOX:
+        return "inbox";
+    case IROperation::OUTBOX:
+        return "outbox";
+    case IROperation::COPYFROM:
+    case IROperation::COPYFROMI:
+        return "copyfrom";
+    case IROperation::COPYTO:
+    case IROperation::COPYTOI:
+        return "copyto";
+    case IROperation::ADDM:
+        return "add";
+    case IROperation::SUBM:
+        return "sub";
+    case IROperation::BUMPUP:
+        return "bump+";
+    case IROperation::BUMPDN:
+        return "bump-";
+    case IROperation::JUMP:
+        return "jump";
+    case IROperation::JUMPZ:
+        return "jumpz";
+    case IROperation::JUMPN:
+        return "jumpn";
     }
 
     spdlog::critical("Unknown IR Op {}. {}", static_cast<int>(op), __PRETTY_FUNCTION__);
@@ -128,6 +154,16 @@ bool IROperationMetadata::is_branch(IROperation op)
     case IROperation::RET:
     case IROperation::HALT:
     case IROperation::PHI:
+    case IROperation::INBOX:
+    case IROperation::OUTBOX:
+    case IROperation::COPYFROM:
+    case IROperation::COPYTO:
+    case IROperation::COPYFROMI:
+    case IROperation::COPYTOI:
+    case IROperation::ADDM:
+    case IROperation::SUBM:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
         return false;
 
     case IROperation::JE:
@@ -139,6 +175,9 @@ bool IROperationMetadata::is_branch(IROperation op)
     case IROperation::JZ:
     case IROperation::JNZ:
     case IROperation::JMP:
+    case IROperation::JUMP:
+    case IROperation::JUMPZ:
+    case IROperation::JUMPN:
         return true;
     }
 
@@ -174,6 +213,16 @@ bool IROperationMetadata::is_control_transfer(IROperation op)
     case IROperation::PHI:
     // call is not for now
     case IROperation::CALL:
+    case IROperation::INBOX:
+    case IROperation::OUTBOX:
+    case IROperation::COPYFROM:
+    case IROperation::COPYTO:
+    case IROperation::COPYFROMI:
+    case IROperation::COPYTOI:
+    case IROperation::ADDM:
+    case IROperation::SUBM:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
         return false;
 
     case IROperation::JE:
@@ -188,6 +237,9 @@ bool IROperationMetadata::is_control_transfer(IROperation op)
     case IROperation::ENTER:
     case IROperation::RET:
     case IROperation::HALT:
+    case IROperation::JUMP:
+    case IROperation::JUMPZ:
+    case IROperation::JUMPN:
         return true;
     }
 
@@ -219,6 +271,20 @@ bool IROperationMetadata::has_side_effect(IROperation op)
     case IROperation::JNZ:
     case IROperation::JMP:
     case IROperation::CALL:
+    // every low ir op reads or writes the accumulator
+    case IROperation::INBOX:
+    case IROperation::OUTBOX:
+    case IROperation::COPYFROM:
+    case IROperation::COPYTO:
+    case IROperation::COPYFROMI:
+    case IROperation::COPYTOI:
+    case IROperation::ADDM:
+    case IROperation::SUBM:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
+    case IROperation::JUMP:
+    case IROperation::JUMPZ:
+    case IROperation::JUMPN:
         return true;
 
     case IROperation::MOV:
@@ -247,5 +313,15 @@ bool IROperationMetadata::has_side_effect(IROperation op)
     throw;
 }
 
+bool IROperationMetadata::is_low_level(IROperation op)
+{
+    return op >= IROperation::INBOX && op <= IROperation::JUMPN;
+}
+
+bool IROperationMetadata::is_indirect(IROperation op)
+{
+    return op == IROperation::COPYFROMI || op == IROperation::COPYTOI;
+}
+
 CLOSE_IRGEN_NAMESPACE
 // end
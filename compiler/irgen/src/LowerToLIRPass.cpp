@@ -0,0 +1,1108 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "BuildControlFlowGraphPass.h"
+#include "HRBox.h"
+#include "IRGenOptions.h"
+#include "IROps.h"
+#include "IRProgramStructure.h"
+#include "LowerToLIRPass.h"
+#include "Operand.h"
+#include "ThreeAddressCode.h"
+#include "irgen_global.h"
+
+OPEN_IRGEN_NAMESPACE
+
+namespace {
+
+bool is_same_tile(const Operand &lhs, const Operand &rhs)
+{
+    if (lhs.get_type() != rhs.get_type()) {
+        return false;
+    }
+
+    switch (lhs.get_type()) {
+    case Operand::OperandType::VariableId:
+        return lhs.get_register_id() == rhs.get_register_id();
+    case Operand::OperandType::ImmediateValue:
+        return lhs.get_constant().is_char() == rhs.get_constant().is_char()
+            && lhs.get_constant().operator int() == rhs.get_constant().operator int();
+    default:
+        return false;
+    }
+}
+
+bool is_int_constant(const Operand &operand)
+{
+    return operand.get_type() == Operand::OperandType::ImmediateValue && operand.get_constant().is_int();
+}
+
+bool is_int_constant(const Operand &operand, int value)
+{
+    return is_int_constant(operand) && operand.get_constant().operator int() == value;
+}
+
+Operand int_constant(int value)
+{
+    return Operand(HRBox(value));
+}
+
+/**
+ * @brief Lowers one subroutine. It emits the LIR instructions while tracking the tiles r0 holds, so a copyfrom of a
+ * tile r0 already holds is skipped.
+ */
+class SubroutineLowering {
+public:
+    SubroutineLowering(const SubroutinePtr &subroutine, const ProgramPtr &program, const IRGenOptions &options)
+        : _subroutine(subroutine)
+        , _options(options)
+    {
+        for (const SubroutinePtr &callee : program->get_subroutines()) {
+            if (!callee->has_return()) {
+                _void_subroutines.insert(callee->get_func_name());
+            }
+        }
+    }
+
+    int lower();
+
+private:
+    struct Trampoline {
+        std::string label;
+        const BasicBlock *predecessor;
+        BasicBlockPtr successor;
+    };
+
+    SubroutinePtr _subroutine;
+    const IRGenOptions &_options;
+    // r0 is empty after calling these
+    std::set<std::string> _void_subroutines;
+
+    // [Group] HIR
+    std::map<std::string, BasicBlockPtr> _hir_blocks;
+    // SSA variables defined by ldi, read from the constant tiles
+    std::map<int, HRBox> _constants;
+    // map<pair<predecessor, successor>, vector<pair<phi tgt, incoming var>>>
+    std::map<std::pair<const BasicBlock *, const BasicBlock *>, std::vector<std::pair<int, int>>> _phi_copies;
+    // [End Group]
+
+    // [Group] LIR
+    std::list<BasicBlockPtr> _blocks;
+    std::string _block_label;
+    std::list<TACPtr> _block_instructions;
+    bool _block_open = false;
+    std::string _label_prefix;
+    unsigned int _label_count = 0;
+    std::vector<Trampoline> _trampolines;
+    std::string _trap_label;
+    // tiles whose value r0 holds
+    std::vector<Operand> _accumulator;
+    unsigned int _scratch_base = 0;
+    unsigned int _scratch_used = 0;
+    // [End Group]
+
+    void collect_constants();
+    void collect_phi_copies();
+
+    int lower_instruction(const BasicBlockPtr &basic_block, const TACPtr &instruction, bool &falls_through);
+    void lower_add(const Operand &tgt, Operand src1, Operand src2);
+    void lower_sub(const Operand &tgt, const Operand &src1, const Operand &src2);
+    void lower_multiply(const Operand &tgt, const Operand &src1, const Operand &src2);
+    void lower_multiply_by_constant(const Operand &tgt, const Operand &src, int multiplier);
+    void lower_divide(IROperation op, const Operand &tgt, const Operand &src1, const Operand &src2);
+    void lower_logical(IROperation op, const Operand &tgt, const Operand &src1, const Operand &src2);
+    void lower_comparison(IROperation op, const Operand &tgt, const Operand &src1, const Operand &src2);
+    void lower_conditional_branch(const BasicBlockPtr &basic_block, const TACPtr &instruction);
+
+    // [Group] Emitting
+    void begin_block(const std::string &label, bool keep_accumulator);
+    void end_block();
+    void emit(IROperation op, const Operand &operand = Operand());
+    void emit_pseudo(const TACPtr &instruction);
+    void emit_load(const Operand &tile);
+    void emit_store(const Operand &tile);
+    void emit_bump(IROperation op, const Operand &tgt, const Operand &src);
+    void emit_compare_jump(IROperation comparison, const Operand &src1, const Operand &src2, const std::string &label);
+    void emit_difference_jump(IROperation comparison, const Operand &minuend, const Operand &subtrahend, const std::string &label);
+    void emit_jump_unless(IROperation op, const std::string &label);
+    void emit_phi_copies(const BasicBlock *predecessor, const BasicBlock *successor);
+    void remove_jumps_to_next();
+    // [End Group]
+
+    Operand tile(const Operand &variable) const;
+    Operand scratch();
+    std::string new_label();
+    std::string edge_label(const BasicBlockPtr &predecessor, const std::string &successor_label);
+    const std::string &trap_label();
+    bool holds(const Operand &tile) const;
+};
+
+int SubroutineLowering::lower()
+{
+    auto &hir_blocks = _subroutine->get_basic_blocks();
+    for (const BasicBlockPtr &basic_block : hir_blocks) {
+        _hir_blocks[basic_block->get_label()] = basic_block;
+    }
+
+    collect_constants();
+    collect_phi_copies();
+    _scratch_base = _subroutine->get_max_reg_id() + 1;
+
+    for (auto bb_it = hir_blocks.begin(); bb_it != hir_blocks.end(); ++bb_it) {
+        const BasicBlockPtr &basic_block = *bb_it;
+        _label_prefix = basic_block->get_label();
+        begin_block(basic_block->get_label(), false);
+
+        bool falls_through = true;
+        for (const TACPtr &instruction : basic_block->get_instructions()) {
+            _scratch_used = 0;
+            int rc = lower_instruction(basic_block, instruction, falls_through);
+            if (rc != 0) {
+                return rc;
+            }
+            // the rest is unreachable
+            if (!falls_through) {
+                break;
+            }
+        }
+
+        if (falls_through) {
+            auto next_it = std::next(bb_it);
+            if (next_it != hir_blocks.end()) {
+                _scratch_used = 0;
+                emit_phi_copies(basic_block.get(), next_it->get());
+            } else {
+                // falling off the end returns
+                emit_pseudo(ThreeAddressCode::create_return());
+            }
+        }
+    }
+
+    for (const Trampoline &trampoline : _trampolines) {
+        _scratch_used = 0;
+        begin_block(trampoline.label, false);
+        emit_phi_copies(trampoline.predecessor, trampoline.successor.get());
+        emit(IROperation::JUMP, Operand(trampoline.successor->get_label()));
+    }
+
+    if (!_trap_label.empty()) {
+        begin_block(_trap_label, false);
+        emit_pseudo(ThreeAddressCode::create_special(IROperation::HALT));
+    }
+
+    end_block();
+    remove_jumps_to_next();
+
+    hir_blocks = std::move(_blocks);
+    _subroutine->set_is_ssa(false);
+    return 0;
+}
+
+void SubroutineLowering::collect_constants()
+{
+    std::map<int, int> def_counts;
+    for (const auto &[label, basic_block] : _hir_blocks) {
+        for (const TACPtr &instruction : basic_block->get_instructions()) {
+            const Operand &tgt = instruction->get_tgt();
+            if (tgt.is_local_register()) {
+                ++def_counts[tgt.get_register_id()];
+            }
+        }
+    }
+
+    for (const auto &[label, basic_block] : _hir_blocks) {
+        for (const TACPtr &instruction : basic_block->get_instructions()) {
+            const Operand &tgt = instruction->get_tgt();
+            if (instruction->get_op() == IROperation::LOADI && tgt.is_local_register() && def_counts[tgt.get_register_id()] == 1) {
+                _constants.emplace(tgt.get_register_id(), instruction->get_src1().get_constant());
+            }
+        }
+    }
+}
+
+void SubroutineLowering::collect_phi_copies()
+{
+    for (const auto &[label, basic_block] : _hir_blocks) {
+        for (const TACPtr &instruction : basic_block->get_instructions()) {
+            if (instruction->get_op() != IROperation::PHI) {
+                continue;
+            }
+
+            for (const auto &[predecessor, incoming] : instruction->get_phi_incomings()) {
+                _phi_copies[{ predecessor.get(), basic_block.get() }].emplace_back(
+                    instruction->get_tgt().get_register_id(),
+                    static_cast<int>(std::get<0>(incoming)));
+            }
+        }
+    }
+}
+
+int SubroutineLowering::lower_instruction(const BasicBlockPtr &basic_block, const TACPtr &instruction, bool &falls_through)
+{
+    const IROperation op = instruction->get_op();
+    const Operand &tgt = instruction->get_tgt();
+    const Operand &src1 = instruction->get_src1();
+    const Operand &src2 = instruction->get_src2();
+
+    switch (op) {
+    case IROperation::MOV:
+        emit_load(tile(src1));
+        emit_store(tgt);
+        break;
+
+    case IROperation::LOADI:
+        if (!_constants.contains(tgt.get_register_id())) {
+            emit_load(src1);
+            emit_store(tgt);
+        }
+        break;
+
+    case IROperation::LOAD:
+        if (src1.get_type() == Operand::OperandType::ImmediateValue) {
+            // floor[n] is floor[#n]
+            emit(IROperation::COPYFROMI, src1);
+        } else if (src1.get_register_id() < 0) {
+            emit_load(src1);
+        } else {
+            emit(IROperation::COPYFROMI, tile(src1));
+        }
+        emit_store(tgt);
+        break;
+
+    case IROperation::STORE:
+        emit_load(tile(src2));
+        if (src1.get_type() == Operand::OperandType::ImmediateValue) {
+            emit(IROperation::COPYTOI, src1);
+        } else if (src1.get_register_id() < 0) {
+            emit_store(src1);
+        } else {
+            emit(IROperation::COPYTOI, tile(src1));
+        }
+        break;
+
+    case IROperation::ADD:
+        lower_add(tgt, tile(src1), tile(src2));
+        break;
+
+    case IROperation::SUB:
+        lower_sub(tgt, tile(src1), tile(src2));
+        break;
+
+    case IROperation::NEG:
+        emit_load(int_constant(0));
+        emit(IROperation::SUBM, tile(src1));
+        emit_store(tgt);
+        break;
+
+    case IROperation::MUL:
+        lower_multiply(tgt, tile(src1), tile(src2));
+        break;
+
+    case IROperation::DIV:
+    case IROperation::MOD:
+        lower_divide(op, tgt, tile(src1), tile(src2));
+        break;
+
+    case IROperation::AND:
+    case IROperation::OR:
+    case IROperation::NOT:
+        lower_logical(op, tgt, tile(src1), src2 ? tile(src2) : Operand());
+        break;
+
+    case IROperation::EQ:
+    case IROperation::NE:
+    case IROperation::LT:
+    case IROperation::LE:
+    case IROperation::GT:
+    case IROperation::GE:
+        lower_comparison(op, tgt, tile(src1), tile(src2));
+        break;
+
+    case IROperation::JE:
+    case IROperation::JNE:
+    case IROperation::JGT:
+    case IROperation::JLT:
+    case IROperation::JGE:
+    case IROperation::JLE:
+    case IROperation::JZ:
+    case IROperation::JNZ:
+        lower_conditional_branch(basic_block, instruction);
+        break;
+
+    case IROperation::JMP: {
+        auto target_it = _hir_blocks.find(tgt.get_label());
+        if (target_it == _hir_blocks.end()) {
+            spdlog::critical("BUG: target label '{}' does not exist in this subroutine. {}", tgt.get_label(), __PRETTY_FUNCTION__);
+            throw;
+        }
+        emit_phi_copies(basic_block.get(), target_it->second.get());
+        emit(IROperation::JUMP, tgt);
+        falls_through = false;
+    } break;
+
+    case IROperation::CALL:
+        // the argument is passed with r0. so is the return value.
+        if (src2.get_type() == Operand::OperandType::VariableId) {
+            emit_load(tile(src2));
+        }
+        emit_pseudo(ThreeAddressCode::create(IROperation::CALL, Operand(), src1, Operand(), instruction->get_ast_node()));
+        if (tgt.get_type() == Operand::OperandType::VariableId && !_void_subroutines.contains(src1.get_label())) {
+            emit_store(tgt);
+        }
+        break;
+
+    case IROperation::ENTER:
+        emit_store(tgt);
+        break;
+
+    case IROperation::RET:
+        if (src1.get_type() == Operand::OperandType::VariableId) {
+            emit_load(tile(src1));
+        }
+        emit_pseudo(ThreeAddressCode::create_return(instruction->get_ast_node()));
+        falls_through = false;
+        break;
+
+    case IROperation::INPUT:
+        emit(IROperation::INBOX);
+        emit_store(tgt);
+        break;
+
+    case IROperation::OUTPUT:
+        emit_load(tile(src1));
+        emit(IROperation::OUTBOX);
+        break;
+
+    case IROperation::HALT:
+        emit_pseudo(ThreeAddressCode::create_special(IROperation::HALT, instruction->get_ast_node()));
+        falls_through = false;
+        break;
+
+    case IROperation::NOP:
+    case IROperation::PHI:
+        // phis are copied in the predecessors
+        break;
+
+    case IROperation::INBOX:
+    case IROperation::OUTBOX:
+    case IROperation::COPYFROM:
+    case IROperation::COPYTO:
+    case IROperation::COPYFROMI:
+    case IROperation::COPYTOI:
+    case IROperation::ADDM:
+    case IROperation::SUBM:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
+    case IROperation::JUMP:
+    case IROperation::JUMPZ:
+    case IROperation::JUMPN:
+        spdlog::error("Subroutine '{}' is already lowered: {}. {}", _subroutine->get_func_name(), instruction->to_string(), __PRETTY_FUNCTION__);
+        return 1;
+    }
+
+    return 0;
+}
+
+void SubroutineLowering::lower_add(const Operand &tgt, Operand src1, Operand src2)
+{
+    // prefer bump for +1 and -1
+    if (is_int_constant(src1) && !is_int_constant(src2)) {
+        std::swap(src1, src2);
+    }
+
+    if (!is_int_constant(src1) && is_int_constant(src2, 1)) {
+        emit_bump(IROperation::BUMPUP, tgt, src1);
+    } else if (!is_int_constant(src1) && is_int_constant(src2, -1)) {
+        emit_bump(IROperation::BUMPDN, tgt, src1);
+    } else {
+        if (!holds(src1) && holds(src2)) {
+            std::swap(src1, src2);
+        }
+        emit_load(src1);
+        emit(IROperation::ADDM, src2);
+        emit_store(tgt);
+    }
+}
+
+void SubroutineLowering::lower_sub(const Operand &tgt, const Operand &src1, const Operand &src2)
+{
+    if (!is_int_constant(src1) && is_int_constant(src2, 1)) {
+        emit_bump(IROperation::BUMPDN, tgt, src1);
+    } else if (!is_int_constant(src1) && is_int_constant(src2, -1)) {
+        emit_bump(IROperation::BUMPUP, tgt, src1);
+    } else {
+        emit_load(src1);
+        emit(IROperation::SUBM, src2);
+        emit_store(tgt);
+    }
+}
+
+void SubroutineLowering::lower_multiply(const Operand &tgt, const Operand &src1, const Operand &src2)
+{
+    if (_options.MultiplyLowering == IROptimizationFor::OptForSpeed) {
+        if (is_int_constant(src2)) {
+            lower_multiply_by_constant(tgt, src1, src2.get_constant().operator int());
+            return;
+        } else if (is_int_constant(src1)) {
+            lower_multiply_by_constant(tgt, src2, src1.get_constant().operator int());
+            return;
+        }
+    }
+
+    // add |src2| times of src1 or -src1
+    Operand counter = scratch();
+    Operand multiplicand = scratch();
+    Operand product = scratch();
+    std::string negative_label = new_label();
+    std::string init_label = new_label();
+    std::string test_label = new_label();
+    std::string done_label = new_label();
+
+    emit_load(src2);
+    emit(IROperation::JUMPN, Operand(negative_label));
+    emit_store(counter);
+    emit_load(src1);
+    emit_store(multiplicand);
+    emit(IROperation::JUMP, Operand(init_label));
+
+    begin_block(negative_label, false);
+    emit_load(int_constant(0));
+    emit(IROperation::SUBM, src2);
+    emit_store(counter);
+    emit_load(int_constant(0));
+    emit(IROperation::SUBM, src1);
+    emit_store(multiplicand);
+
+    begin_block(init_label, false);
+    emit_load(int_constant(0));
+    emit_store(product);
+    emit_load(counter);
+
+    // r0 is the counter
+    begin_block(test_label, false);
+    emit(IROperation::JUMPZ, Operand(done_label));
+    emit_load(product);
+    emit(IROperation::ADDM, multiplicand);
+    emit_store(product);
+    emit(IROperation::BUMPDN, counter);
+    emit(IROperation::JUMP, Operand(test_label));
+
+    begin_block(done_label, false);
+    emit_load(product);
+    emit_store(tgt);
+}
+
+void SubroutineLowering::lower_multiply_by_constant(const Operand &tgt, const Operand &src, int multiplier)
+{
+    if (multiplier == 0) {
+        emit_load(int_constant(0));
+        emit_store(tgt);
+        return;
+    }
+
+    // double and add, from the most significant bit. every partial product is within the final product.
+    unsigned int magnitude = static_cast<unsigned int>(std::abs(multiplier));
+    int top_bit = 0;
+    while ((magnitude >> (top_bit + 1)) != 0) {
+        ++top_bit;
+    }
+
+    emit_load(src);
+    Operand doubled;
+    if (top_bit > 0 || multiplier < 0) {
+        doubled = scratch();
+    }
+    for (int bit = top_bit - 1; bit >= 0; --bit) {
+        emit_store(doubled);
+        emit(IROperation::ADDM, doubled);
+        if ((magnitude >> bit) & 1) {
+            emit(IROperation::ADDM, src);
+        }
+    }
+
+    if (multiplier < 0) {
+        emit_store(doubled);
+        emit_load(int_constant(0));
+        emit(IROperation::SUBM, doubled);
+    }
+    emit_store(tgt);
+}
+
+void SubroutineLowering::lower_divide(IROperation op, const Operand &tgt, const Operand &src1, const Operand &src2)
+{
+    const bool is_div = op == IROperation::DIV;
+    const bool constant_divisor = is_int_constant(src2) && !is_int_constant(src2, 0);
+    const bool negative_divisor = constant_divisor && src2.get_constant().operator int() < 0;
+
+    // subtract |src2| from |src1| until it's negative. the quotient is counted for div.
+    Operand remainder = scratch();
+    Operand quotient = is_div ? scratch() : Operand();
+    Operand divisor;
+
+    if (constant_divisor) {
+        divisor = int_constant(std::abs(src2.get_constant().operator int()));
+    } else {
+        divisor = scratch();
+        std::string negative_label = new_label();
+        std::string done_label = new_label();
+
+        emit_load(src2);
+        emit(IROperation::JUMPZ, Operand(trap_label()));
+        emit(IROperation::JUMPN, Operand(negative_label));
+        emit_store(divisor);
+        emit(IROperation::JUMP, Operand(done_label));
+
+        begin_block(negative_label, false);
+        emit_load(int_constant(0));
+        emit(IROperation::SUBM, src2);
+        emit_store(divisor);
+
+        begin_block(done_label, false);
+    }
+
+    std::string negative_dividend_label = new_label();
+    std::string init_label = new_label();
+    std::string loop_label = new_label();
+    std::string done_label = new_label();
+
+    emit_load(src1);
+    emit(IROperation::JUMPN, Operand(negative_dividend_label));
+    emit_store(remainder);
+    emit(IROperation::JUMP, Operand(init_label));
+
+    begin_block(negative_dividend_label, false);
+    emit_load(int_constant(0));
+    emit(IROperation::SUBM, src1);
+    emit_store(remainder);
+
+    begin_block(init_label, false);
+    if (is_div) {
+        emit_load(int_constant(0));
+        emit_store(quotient);
+    }
+
+    begin_block(loop_label, false);
+    emit_load(remainder);
+    emit(IROperation::SUBM, divisor);
+    emit(IROperation::JUMPN, Operand(done_label));
+    emit_store(remainder);
+    if (is_div) {
+        emit(IROperation::BUMPUP, quotient);
+    }
+    emit(IROperation::JUMP, Operand(loop_label));
+
+    begin_block(done_label, false);
+
+    std::string negative_result_label = new_label();
+    std::string positive_result_label = new_label();
+    std::string end_label = new_label();
+
+    if (is_div) {
+        // the quotient is negative if exactly one of the operands is negative
+        std::string negative_src1_label = new_label();
+        emit_load(src1);
+        emit(IROperation::JUMPN, Operand(negative_src1_label));
+        if (constant_divisor) {
+            emit(IROperation::JUMP, Operand(negative_divisor ? negative_result_label : positive_result_label));
+        } else {
+            emit_load(src2);
+            emit(IROperation::JUMPN, Operand(negative_result_label));
+            emit(IROperation::JUMP, Operand(positive_result_label));
+        }
+
+        begin_block(negative_src1_label, false);
+        if (constant_divisor) {
+            emit(IROperation::JUMP, Operand(negative_divisor ? positive_result_label : negative_result_label));
+        } else {
+            emit_load(src2);
+            emit(IROperation::JUMPN, Operand(positive_result_label));
+        }
+    } else {
+        // the remainder has the sign of the dividend
+        emit_load(src1);
+        emit(IROperation::JUMPN, Operand(negative_result_label));
+        emit(IROperation::JUMP, Operand(positive_result_label));
+    }
+
+    const Operand &result = is_div ? quotient : remainder;
+
+    begin_block(negative_result_label, false);
+    emit_load(int_constant(0));
+    emit(IROperation::SUBM, result);
+    emit(IROperation::JUMP, Operand(end_label));
+
+    begin_block(positive_result_label, false);
+    emit_load(result);
+
+    begin_block(end_label, false);
+    emit_store(tgt);
+}
+
+void SubroutineLowering::lower_logical(IROperation op, const Operand &tgt, const Operand &src1, const Operand &src2)
+{
+    std::string true_label = new_label();
+    std::string false_label = new_label();
+    std::string end_label = new_label();
+
+    switch (op) {
+    case IROperation::NOT:
+        emit_load(src1);
+        emit(IROperation::JUMPZ, Operand(true_label));
+        emit(IROperation::JUMP, Operand(false_label));
+        break;
+    case IROperation::AND:
+        emit_load(src1);
+        emit(IROperation::JUMPZ, Operand(false_label));
+        emit_load(src2);
+        emit(IROperation::JUMPZ, Operand(false_label));
+        emit(IROperation::JUMP, Operand(true_label));
+        break;
+    case IROperation::OR: {
+        std::string src2_label = new_label();
+        emit_load(src1);
+        emit(IROperation::JUMPZ, Operand(src2_label));
+        emit(IROperation::JUMP, Operand(true_label));
+        begin_block(src2_label, false);
+        emit_load(src2);
+        emit(IROperation::JUMPZ, Operand(false_label));
+        emit(IROperation::JUMP, Operand(true_label));
+    } break;
+    default:
+        spdlog::critical("'{}' is not a logical op. {}", IROperationMetadata::to_string(op), __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    begin_block(true_label, false);
+    emit_load(int_constant(1));
+    emit(IROperation::JUMP, Operand(end_label));
+
+    begin_block(false_label, false);
+    emit_load(int_constant(0));
+
+    begin_block(end_label, false);
+    emit_store(tgt);
+}
+
+void SubroutineLowering::lower_comparison(IROperation op, const Operand &tgt, const Operand &src1, const Operand &src2)
+{
+    std::string true_label = new_label();
+    std::string end_label = new_label();
+
+    emit_compare_jump(op, src1, src2, true_label);
+    emit_load(int_constant(0));
+    emit(IROperation::JUMP, Operand(end_label));
+
+    begin_block(true_label, false);
+    emit_load(int_constant(1));
+
+    begin_block(end_label, false);
+    emit_store(tgt);
+}
+
+void SubroutineLowering::lower_conditional_branch(const BasicBlockPtr &basic_block, const TACPtr &instruction)
+{
+    const std::string target_label = edge_label(basic_block, instruction->get_tgt().get_label());
+    const Operand &src1 = tile(instruction->get_src1());
+
+    switch (instruction->get_op()) {
+    case IROperation::JE:
+        emit_compare_jump(IROperation::EQ, src1, tile(instruction->get_src2()), target_label);
+        break;
+    case IROperation::JNE:
+        emit_compare_jump(IROperation::NE, src1, tile(instruction->get_src2()), target_label);
+        break;
+    case IROperation::JGT:
+        emit_compare_jump(IROperation::GT, src1, tile(instruction->get_src2()), target_label);
+        break;
+    case IROperation::JLT:
+        emit_compare_jump(IROperation::LT, src1, tile(instruction->get_src2()), target_label);
+        break;
+    case IROperation::JGE:
+        emit_compare_jump(IROperation::GE, src1, tile(instruction->get_src2()), target_label);
+        break;
+    case IROperation::JLE:
+        emit_compare_jump(IROperation::LE, src1, tile(instruction->get_src2()), target_label);
+        break;
+    case IROperation::JZ:
+    case IROperation::JNZ:
+        if (is_int_constant(src1)) {
+            // e.g. while (true)
+            if (is_int_constant(src1, 0) == (instruction->get_op() == IROperation::JZ)) {
+                emit(IROperation::JUMP, Operand(target_label));
+            }
+        } else if (instruction->get_op() == IROperation::JZ) {
+            emit_load(src1);
+            emit(IROperation::JUMPZ, Operand(target_label));
+        } else {
+            emit_load(src1);
+            emit_jump_unless(IROperation::JUMPZ, target_label);
+        }
+        break;
+    default:
+        spdlog::critical("'{}' is not a conditional branch. {}", instruction->to_string(), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+void SubroutineLowering::begin_block(const std::string &label, bool keep_accumulator)
+{
+    end_block();
+    _block_label = label;
+    _block_open = true;
+    if (!keep_accumulator) {
+        _accumulator.clear();
+    }
+}
+
+void SubroutineLowering::end_block()
+{
+    if (_block_open) {
+        _blocks.push_back(std::make_shared<BasicBlock>(std::move(_block_label), std::move(_block_instructions)));
+        _block_label.clear();
+        _block_instructions.clear();
+        _block_open = false;
+    }
+}
+
+void SubroutineLowering::emit(IROperation op, const Operand &operand)
+{
+    if (!_block_open) {
+        // unreachable, but still needs a block
+        begin_block(new_label(), false);
+    }
+
+    _block_instructions.push_back(ThreeAddressCode::create_accumulator(op, operand));
+
+    switch (op) {
+    case IROperation::COPYFROM:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
+        _accumulator = { operand };
+        break;
+    case IROperation::COPYTO:
+        // the tile now holds r0 as well
+        std::erase_if(_accumulator, [&operand](const Operand &held) { return is_same_tile(held, operand); });
+        _accumulator.push_back(operand);
+        break;
+    case IROperation::COPYTOI:
+        break;
+    case IROperation::JUMP:
+        end_block();
+        break;
+    case IROperation::JUMPZ:
+    case IROperation::JUMPN:
+        // the fall through keeps r0
+        begin_block(new_label(), true);
+        break;
+    default:
+        _accumulator.clear();
+        break;
+    }
+}
+
+void SubroutineLowering::emit_pseudo(const TACPtr &instruction)
+{
+    if (!_block_open) {
+        begin_block(new_label(), false);
+    }
+
+    _block_instructions.push_back(instruction);
+    _accumulator.clear();
+
+    if (instruction->get_op() != IROperation::CALL) {
+        end_block();
+    }
+}
+
+void SubroutineLowering::emit_load(const Operand &tile)
+{
+    if (!holds(tile)) {
+        emit(IROperation::COPYFROM, tile);
+    }
+}
+
+void SubroutineLowering::emit_store(const Operand &tile)
+{
+    emit(IROperation::COPYTO, tile);
+}
+
+void SubroutineLowering::emit_bump(IROperation op, const Operand &tgt, const Operand &src)
+{
+    emit_load(src);
+    emit_store(tgt);
+    emit(op, tgt);
+}
+
+void SubroutineLowering::emit_compare_jump(IROperation comparison, const Operand &src1, const Operand &src2, const std::string &label)
+{
+    // a > b and a <= b test b - a
+    const bool swapped = comparison == IROperation::GT || comparison == IROperation::LE;
+    const Operand &minuend = swapped ? src2 : src1;
+    const Operand &subtrahend = swapped ? src1 : src2;
+
+    if (is_int_constant(minuend, 0) || is_int_constant(subtrahend, 0)) {
+        emit_difference_jump(comparison, minuend, subtrahend, label);
+        return;
+    }
+
+    // the difference overflows when the signs differ, e.g. -999 <= 1. the sign alone decides it then.
+    // whether the branch is taken when the difference is known positive or negative
+    const bool taken_if_positive = comparison == IROperation::NE || comparison == IROperation::GE || comparison == IROperation::LE;
+    const bool taken_if_negative = comparison == IROperation::NE || comparison == IROperation::LT || comparison == IROperation::GT;
+
+    const bool minuend_known = is_int_constant(minuend);
+    const bool subtrahend_known = is_int_constant(subtrahend);
+    const bool minuend_negative = minuend_known && minuend.get_constant().operator int() < 0;
+    const bool subtrahend_negative = subtrahend_known && subtrahend.get_constant().operator int() < 0;
+
+    if (minuend_known && subtrahend_known) {
+        if (minuend_negative == subtrahend_negative) {
+            emit_difference_jump(comparison, minuend, subtrahend, label);
+        } else if (minuend_negative ? taken_if_negative : taken_if_positive) {
+            emit(IROperation::JUMP, Operand(label));
+        }
+        return;
+    }
+
+    std::string minuend_negative_label = new_label();
+    std::string positive_label = new_label();
+    std::string difference_label = new_label();
+    std::string end_label = new_label();
+    bool positive_reachable = false;
+
+    if (!minuend_known) {
+        emit_load(minuend);
+        emit(IROperation::JUMPN, Operand(minuend_negative_label));
+    }
+
+    if (!minuend_known || !minuend_negative) {
+        // minuend >= 0
+        if (!subtrahend_known) {
+            emit_load(subtrahend);
+            emit(IROperation::JUMPN, Operand(positive_label));
+            positive_reachable = true;
+        } else if (subtrahend_negative) {
+            emit(IROperation::JUMP, Operand(positive_label));
+            positive_reachable = true;
+        }
+        if (_block_open) {
+            emit(IROperation::JUMP, Operand(difference_label));
+        }
+    }
+
+    if (!minuend_known || minuend_negative) {
+        // minuend < 0
+        begin_block(minuend_negative_label, false);
+        if (!subtrahend_known) {
+            emit_load(subtrahend);
+            emit(IROperation::JUMPN, Operand(difference_label));
+        } else if (subtrahend_negative) {
+            emit(IROperation::JUMP, Operand(difference_label));
+        }
+        if (_block_open) {
+            emit(IROperation::JUMP, Operand(taken_if_negative ? label : end_label));
+        }
+    }
+
+    if (positive_reachable) {
+        begin_block(positive_label, false);
+        emit(IROperation::JUMP, Operand(taken_if_positive ? label : end_label));
+    }
+
+    begin_block(difference_label, false);
+    emit_difference_jump(comparison, minuend, subtrahend, label);
+    begin_block(end_label, false);
+}
+
+void SubroutineLowering::emit_difference_jump(IROperation comparison, const Operand &minuend, const Operand &subtrahend, const std::string &label)
+{
+    emit_load(minuend);
+    if (!is_int_constant(subtrahend, 0)) {
+        emit(IROperation::SUBM, subtrahend);
+    }
+
+    switch (comparison) {
+    case IROperation::EQ:
+        emit(IROperation::JUMPZ, Operand(label));
+        break;
+    case IROperation::NE:
+        emit_jump_unless(IROperation::JUMPZ, label);
+        break;
+    case IROperation::LT:
+    case IROperation::GT:
+        emit(IROperation::JUMPN, Operand(label));
+        break;
+    case IROperation::GE:
+    case IROperation::LE:
+        emit_jump_unless(IROperation::JUMPN, label);
+        break;
+    default:
+        spdlog::critical("'{}' is not a comparison. {}", IROperationMetadata::to_string(comparison), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+void SubroutineLowering::emit_jump_unless(IROperation op, const std::string &label)
+{
+    std::string skip_label = new_label();
+    emit(op, Operand(skip_label));
+    emit(IROperation::JUMP, Operand(label));
+    // both ways into the skip label keep r0
+    begin_block(skip_label, true);
+}
+
+void SubroutineLowering::emit_phi_copies(const BasicBlock *predecessor, const BasicBlock *successor)
+{
+    auto copies_it = _phi_copies.find({ predecessor, successor });
+    if (copies_it == _phi_copies.end()) {
+        return;
+    }
+
+    // vector<pair<tgt, src>>. the phis are evaluated in parallel.
+    std::vector<std::pair<Operand, Operand>> pending;
+    for (const auto &[tgt, src] : copies_it->second) {
+        Operand src_tile = tile(Operand(src));
+        if (!is_same_tile(Operand(tgt), src_tile)) {
+            pending.emplace_back(Operand(tgt), src_tile);
+        }
+    }
+
+    while (!pending.empty()) {
+        auto ready_it = std::ranges::find_if(pending, [&pending](const std::pair<Operand, Operand> &copy) {
+            return std::ranges::none_of(pending, [&copy](const std::pair<Operand, Operand> &other) {
+                return is_same_tile(other.second, copy.first);
+            });
+        });
+
+        if (ready_it != pending.end()) {
+            emit_load(ready_it->second);
+            emit_store(ready_it->first);
+            pending.erase(ready_it);
+        } else {
+            // a cycle. save one target so it can be overwritten
+            Operand saved = scratch();
+            Operand overwritten = pending.front().first;
+            emit_load(overwritten);
+            emit_store(saved);
+            for (auto &[tgt, src] : pending) {
+                if (is_same_tile(src, overwritten)) {
+                    src = saved;
+                }
+            }
+        }
+    }
+}
+
+void SubroutineLowering::remove_jumps_to_next()
+{
+    for (auto bb_it = _blocks.begin(); bb_it != _blocks.end(); ++bb_it) {
+        auto next_it = std::next(bb_it);
+        auto &instructions = (*bb_it)->get_instructions();
+        if (next_it == _blocks.end() || instructions.empty()) {
+            continue;
+        }
+
+        const TACPtr &last = instructions.back();
+        if (last->get_op() == IROperation::JUMP && last->get_tgt().get_label() == (*next_it)->get_label()) {
+            instructions.pop_back();
+        }
+    }
+}
+
+Operand SubroutineLowering::tile(const Operand &variable) const
+{
+    if (variable.is_local_register()) {
+        auto const_it = _constants.find(variable.get_register_id());
+        if (const_it != _constants.end()) {
+            return Operand(const_it->second);
+        }
+    }
+    return variable;
+}
+
+Operand SubroutineLowering::scratch()
+{
+    return Operand(static_cast<int>(_scratch_base + _scratch_used++));
+}
+
+std::string SubroutineLowering::new_label()
+{
+    return _label_prefix + ".L" + std::to_string(++_label_count);
+}
+
+std::string SubroutineLowering::edge_label(const BasicBlockPtr &predecessor, const std::string &successor_label)
+{
+    auto successor_it = _hir_blocks.find(successor_label);
+    if (successor_it == _hir_blocks.end()) {
+        spdlog::critical("BUG: target label '{}' does not exist in this subroutine. {}", successor_label, __PRETTY_FUNCTION__);
+        throw;
+    }
+
+    if (!_phi_copies.contains({ predecessor.get(), successor_it->second.get() })) {
+        return successor_label;
+    }
+
+    // split the edge, so the copies are not executed on the other edge
+    std::string label = new_label();
+    _trampolines.push_back({ label, predecessor.get(), successor_it->second });
+    return label;
+}
+
+const std::string &SubroutineLowering::trap_label()
+{
+    if (_trap_label.empty()) {
+        _trap_label = _subroutine->get_func_name() + ".trap";
+    }
+    return _trap_label;
+}
+
+bool SubroutineLowering::holds(const Operand &tile) const
+{
+    return std::ranges::any_of(_accumulator, [&tile](const Operand &held) {
+        return is_same_tile(held, tile);
+    });
+}
+
+}
+
+LowerToLIRPass::~LowerToLIRPass()
+{
+}
+
+int LowerToLIRPass::run()
+{
+    int rc = IROptimizationPass::run();
+    if (rc != 0) {
+        return rc;
+    }
+
+    BuildControlFlowGraphPass cfg_builder(_program, _options);
+    return cfg_builder.run();
+}
+
+int LowerToLIRPass::run_subroutine(const SubroutinePtr &subroutine, ProgramMetadata &metadata, const ProgramPtr &program)
+{
+    UNUSED(metadata);
+    UNUSED(program);
+
+    if (!subroutine->is_ssa()) {
+        spdlog::error("Lowering to LIR requires SSA HIR but subroutine '{}' is not SSA. {}", subroutine->get_func_name(), __PRETTY_FUNCTION__);
+        return 1;
+    }
+
+    SubroutineLowering lowering(subroutine, program, _options);
+    return lowering.lower();
+}
+
+CLOSE_IRGEN_NAMESPACE
+// end
@@ -99,7 +99,7 @@ Operand::operator std::string() const
             throw;
         }
     case OperandType::Label:
-        return std::get<std::string>(_value);
+        return *std::get<StringPtr>(_value);
     default:
         spdlog::critical("unknown operand type: {}. {}", static_cast<int>(_type), __PRETTY_FUNCTION__);
         throw;
@@ -50,7 +50,7 @@ std::list<BasicBlockPtr> TACGen::build_subroutine_split_tacs_to_basic_blocks(con
         if (current_label.empty()) {
             // set the new label. either there's a label, or we need to make a new
             if (instr_has_lbl) {
-                current_label = label_it->second;
+                current_label = _strings->str(label_it->second);
             } else {
                 // XB is a random name. I just found it's easier to see
                 current_label = subroutine_name + ".XB" + std::to_string(subroutine_block_id);
@@ -103,8 +103,8 @@ int TACGen::build_ir_program()
             has_return = false;
         } else {
             semanalyzer::SymbolPtr function_symbol;
-            std::string defined_scope;
-            bool ok = _symbol_table->lookup_symbol(semanalyzer::GLOBAL_SCOPE_ID, subroutine_name, false, function_symbol, defined_scope);
+            semanalyzer::ScopeId defined_scope;
+            bool ok = _symbol_table->lookup_symbol(semanalyzer::ScopeTree::GLOBAL_SCOPE, subroutine_name, false, function_symbol, defined_scope);
             UNUSED(ok);
             assert(ok);
             assert(function_symbol);
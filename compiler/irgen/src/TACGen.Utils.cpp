@@ -5,6 +5,8 @@
 
 #include <boost/range.hpp>
 
+#include "ASTNode.h"
+#include "ASTNodeArena.h"
 #include "IROps.h"
 #include "TACGen.h"
 #include "ThreeAddressCode.h"
@@ -14,6 +16,11 @@ OPEN_IRGEN_NAMESPACE
 
 int TACGen::run()
 {
+    _node_var_id_result.reset(*_root->get_arena());
+    _strings = _root->get_arena()->strings();
+    _inbox_name = _strings->intern("inbox");
+    _outbox_name = _strings->intern("outbox");
+
     int rc = visit(_root);
     if (rc != 0) {
         return rc;
@@ -30,18 +37,23 @@ int TACGen::take_var_id_numbering()
     return _current_subroutine_var_id++;
 }
 
-std::string TACGen::take_block_label()
+Operand &TACGen::node_result(const parser::ASTNodePtr &node)
+{
+    return _node_var_id_result[node];
+}
+
+StringId TACGen::take_block_label()
 {
     std::string result(_current_subroutine_name + ".B" + std::to_string(_current_block_label_id));
     ++_current_block_label_id;
-    return result;
+    return _strings->intern(result);
 }
 
-std::string TACGen::take_block_label(const std::string &msg)
+StringId TACGen::take_block_label(const std::string &msg)
 {
     std::string result(_current_subroutine_name + ".B" + std::to_string(_current_block_label_id) + "_" + msg);
     ++_current_block_label_id;
-    return result;
+    return _strings->intern(result);
 }
 
 InstructionListIter TACGen::create_noop(const parser::ASTNodePtr &node)
@@ -50,21 +62,21 @@ InstructionListIter TACGen::create_noop(const parser::ASTNodePtr &node)
     return std::prev(_current_subroutine_tac.end());
 }
 
-InstructionListIter TACGen::create_jmp(const std::string &label, const parser::ASTNodePtr &node)
+InstructionListIter TACGen::create_jmp(StringId label, const parser::ASTNodePtr &node)
 {
-    _current_subroutine_tac.emplace_back(ThreeAddressCode::create_branching(Operand(label), node));
+    _current_subroutine_tac.emplace_back(ThreeAddressCode::create_branching(Operand(_strings->shared(label)), node));
     return std::prev(_current_subroutine_tac.end());
 }
 
-InstructionListIter TACGen::create_jnz(const Operand &operand, const std::string &label, const parser::ASTNodePtr &node)
+InstructionListIter TACGen::create_jnz(const Operand &operand, StringId label, const parser::ASTNodePtr &node)
 {
-    _current_subroutine_tac.emplace_back(ThreeAddressCode::create_branching(IROperation::JNZ, Operand(label), operand, node));
+    _current_subroutine_tac.emplace_back(ThreeAddressCode::create_branching(IROperation::JNZ, Operand(_strings->shared(label)), operand, node));
     return std::prev(_current_subroutine_tac.end());
 }
 
-InstructionListIter TACGen::create_jz(const Operand &operand, const std::string &label, const parser::ASTNodePtr &node)
+InstructionListIter TACGen::create_jz(const Operand &operand, StringId label, const parser::ASTNodePtr &node)
 {
-    _current_subroutine_tac.emplace_back(ThreeAddressCode::create_branching(IROperation::JZ, Operand(label), operand, node));
+    _current_subroutine_tac.emplace_back(ThreeAddressCode::create_branching(IROperation::JZ, Operand(_strings->shared(label)), operand, node));
     return std::prev(_current_subroutine_tac.end());
 }
 
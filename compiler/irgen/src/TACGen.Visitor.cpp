@@ -40,7 +40,7 @@ int TACGen::visit(const parser::IntegerASTNodePtr &node)
 
     Operand result(take_var_id_numbering());
     create_instr(ThreeAddressCode::create_load_immediate(result, node->get_hrbox(), node));
-    _node_var_id_result[node] = result;
+    node_result(node) = result;
     END_VISIT();
 }
 
@@ -50,7 +50,7 @@ int TACGen::visit(const parser::BooleanASTNodePtr &node)
 
     Operand result(take_var_id_numbering());
     create_instr(ThreeAddressCode::create_load_immediate(result, HRBox(node->get_value() ? 1 : 0), node));
-    _node_var_id_result[node] = result;
+    node_result(node) = result;
     END_VISIT();
 }
 
@@ -75,7 +75,7 @@ int TACGen::visit(const parser::VariableDeclarationASTNodePtr &node)
         rc = traverse(asgn);
         RETURN_IF_FAIL_IN_VISIT(rc);
 
-        // auto result = _node_var_id_result[asgn];
+        // auto result = node_result(asgn);
         // assert(result);
 
         // create_instr(ThreeAddressCode::create_data_movement(HighLevelIROps::MOV, var, result));
@@ -85,7 +85,7 @@ int TACGen::visit(const parser::VariableDeclarationASTNodePtr &node)
         create_instr(ThreeAddressCode::create_load_immediate(var, HRBox(0), node));
     }
 
-    _node_var_id_result[node] = var;
+    node_result(node) = var;
     END_VISIT();
 }
 
@@ -103,7 +103,7 @@ int TACGen::visit(const parser::VariableAssignmentASTNodePtr &node)
     auto decl_operand = _symbol_to_var_map[symbol]; // this is created in visiting declaration node
     assert(decl_operand);
 
-    auto expr_result = _node_var_id_result[expr];
+    auto expr_result = node_result(expr);
     assert(expr_result);
 
     if (decl_operand.get_register_id() < 0) {
@@ -113,7 +113,7 @@ int TACGen::visit(const parser::VariableAssignmentASTNodePtr &node)
         create_instr(ThreeAddressCode::create_data_movement(IROperation::MOV, decl_operand, expr_result, Operand(), node));
     }
 
-    _node_var_id_result[node] = _node_var_id_result[expr];
+    node_result(node) = expr_result;
     END_VISIT();
 }
 
@@ -132,7 +132,7 @@ int TACGen::visit(const parser::VariableAccessASTNodePtr &node)
         create_instr(ThreeAddressCode::create_data_movement(IROperation::LOAD, result, src, Operand(), node));
     }
 
-    _node_var_id_result[node] = result;
+    node_result(node) = result;
     END_VISIT();
 }
 
@@ -174,19 +174,19 @@ int TACGen::visit(const parser::FloorAssignmentASTNodePtr &node)
     assert(value_node);
     rc = traverse(value_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
-    auto value = _node_var_id_result[value_node];
+    auto value = node_result(value_node);
     assert(value);
 
     auto index_node = node->get_floor_number();
     assert(index_node);
     rc = traverse(index_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
-    auto index = _node_var_id_result[index_node];
+    auto index = node_result(index_node);
     assert(index);
 
     Operand var(take_var_id_numbering());
     create_instr(ThreeAddressCode::create_data_movement(IROperation::STORE, Operand(), index, value, node));
-    _node_var_id_result[node] = var;
+    node_result(node) = var;
 
     END_VISIT();
 }
@@ -199,12 +199,12 @@ int TACGen::visit(const parser::FloorAccessASTNodePtr &node)
     assert(index_node);
     rc = traverse(index_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
-    auto index = _node_var_id_result[index_node];
+    auto index = node_result(index_node);
     assert(index);
 
     Operand var(take_var_id_numbering());
     create_instr(ThreeAddressCode::create_data_movement(IROperation::LOAD, var, index, Operand(), node));
-    _node_var_id_result[node] = var;
+    node_result(node) = var;
 
     END_VISIT();
 }
@@ -215,12 +215,12 @@ int TACGen::visit(const parser::NegativeExpressionASTNodePtr &node)
 
     rc = traverse(node->get_operand());
     RETURN_IF_FAIL_IN_VISIT(rc);
-    auto op = _node_var_id_result[node->get_operand()];
+    auto op = node_result(node->get_operand());
     assert(op);
 
     Operand var(take_var_id_numbering());
     create_instr(ThreeAddressCode::create_arithmetic(IROperation::NEG, var, op, node));
-    _node_var_id_result[node] = var;
+    node_result(node) = var;
 
     END_VISIT();
 }
@@ -231,12 +231,12 @@ int TACGen::visit(const parser::NotExpressionASTNodePtr &node)
 
     rc = traverse(node->get_operand());
     RETURN_IF_FAIL_IN_VISIT(rc);
-    auto op = _node_var_id_result[node->get_operand()];
+    auto op = node_result(node->get_operand());
     assert(op);
 
     Operand var(take_var_id_numbering());
     create_instr(ThreeAddressCode::create_logical(IROperation::NOT, var, op, node));
-    _node_var_id_result[node] = var;
+    node_result(node) = var;
 
     END_VISIT();
 }
@@ -263,7 +263,7 @@ int TACGen::visit(const parser::IncrementExpressionASTNodePtr &node)
         create_instr(ThreeAddressCode::create_data_movement(IROperation::MOV, original, var, Operand(), node));
     }
 
-    _node_var_id_result[node] = original;
+    node_result(node) = original;
 
     END_VISIT();
 }
@@ -290,7 +290,7 @@ int TACGen::visit(const parser::DecrementExpressionASTNodePtr &node)
         create_instr(ThreeAddressCode::create_data_movement(IROperation::MOV, original, var, Operand(), node));
     }
 
-    _node_var_id_result[node] = original;
+    node_result(node) = original;
 
     END_VISIT();
 }
@@ -308,14 +308,14 @@ int TACGen::visit_binary_expression(const parser::AbstractBinaryExpressionASTNod
     rc = traverse_multiple(left_node, right_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
 
-    auto left = _node_var_id_result[left_node];
-    auto right = _node_var_id_result[right_node];
+    auto left = node_result(left_node);
+    auto right = node_result(right_node);
     assert(left);
     assert(right);
 
     Operand tgt(take_var_id_numbering());
     create_binary_instr<op>(tgt, left, right, node);
-    _node_var_id_result[node] = tgt;
+    node_result(node) = tgt;
 
     END_VISIT();
 }
@@ -389,29 +389,29 @@ int TACGen::visit(const parser::InvocationExpressionASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    const std::string &func_name = *node->get_func_name();
+    StringId func_name = node->get_func_name_id();
 
     Operand result(take_var_id_numbering());
     auto param_node = node->get_argument();
     if (param_node) {
         rc = traverse(param_node);
         RETURN_IF_FAIL_IN_VISIT(rc);
-        Operand param = _node_var_id_result[param_node];
+        Operand param = node_result(param_node);
 
-        if (func_name == "outbox") {
+        if (func_name == _outbox_name) {
             create_instr(ThreeAddressCode::create_io(IROperation::OUTPUT, param, node));
-            _node_var_id_result[node] = Operand(HRBox(0));
+            node_result(node) = Operand(HRBox(0));
         } else {
-            create_instr(ThreeAddressCode::create_call(Operand(func_name), param, result, node));
-            _node_var_id_result[node] = result;
+            create_instr(ThreeAddressCode::create_call(Operand(node->get_func_name()), param, result, node));
+            node_result(node) = result;
         }
     } else {
-        if (func_name == "inbox") {
+        if (func_name == _inbox_name) {
             create_instr(ThreeAddressCode::create_io(IROperation::INPUT, result, node));
-            _node_var_id_result[node] = result;
+            node_result(node) = result;
         } else {
-            create_instr(ThreeAddressCode::create_call(Operand(func_name), result, node));
-            _node_var_id_result[node] = result;
+            create_instr(ThreeAddressCode::create_call(Operand(node->get_func_name()), result, node));
+            node_result(node) = result;
         }
     }
 
@@ -428,7 +428,7 @@ int TACGen::visit(const parser::IfStatementASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    std::string
+    StringId
         if_block_id(take_block_label("if")),
         then_block_id(take_block_label("then")),
         else_block_id(take_block_label("else")),
@@ -440,7 +440,7 @@ int TACGen::visit(const parser::IfStatementASTNodePtr &node)
     assert(cond_node);
     rc = traverse(cond_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
-    Operand cond = _node_var_id_result[cond_node];
+    Operand cond = node_result(cond_node);
     assert(cond);
     // if cond true (1), proceed to then block
     // if cond false (0), proceed to else block
@@ -477,7 +477,7 @@ int TACGen::visit(const parser::WhileStatementASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    std::string
+    StringId
         while_block_id(take_block_label("while")),
         loop_block_id(take_block_label("loop")),
         end_while_block_id(take_block_label("elihw"));
@@ -491,7 +491,7 @@ int TACGen::visit(const parser::WhileStatementASTNodePtr &node)
     assert(cond_node);
     rc = traverse(cond_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
-    Operand cond = _node_var_id_result[cond_node];
+    Operand cond = node_result(cond_node);
     assert(cond);
     // true: proceed
     // false (0): jump to end while
@@ -520,7 +520,7 @@ int TACGen::visit(const parser::ForStatementASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    std::string
+    StringId
         init_block_id(take_block_label("for")),
         cond_block_id(take_block_label("cond")),
         loop_block_id(take_block_label("loop")),
@@ -541,7 +541,7 @@ int TACGen::visit(const parser::ForStatementASTNodePtr &node)
     assert(cond_node);
     rc = traverse(cond_node);
     RETURN_IF_FAIL_IN_VISIT(rc);
-    Operand cond = _node_var_id_result[cond_node];
+    Operand cond = node_result(cond_node);
     assert(cond);
     // true: proceed
     // false (0): jump to end for
@@ -580,7 +580,7 @@ int TACGen::visit(const parser::ReturnStatementASTNodePtr &node)
     if (expr_node) {
         rc = traverse(expr_node);
         RETURN_IF_FAIL_IN_VISIT(rc);
-        auto expr = _node_var_id_result[expr_node];
+        auto expr = node_result(expr_node);
         create_instr(ThreeAddressCode::create_return(expr, node));
     } else {
         create_instr(ThreeAddressCode::create_return(node));
@@ -661,8 +661,8 @@ int TACGen::visit_subroutine(const parser::AbstractSubroutineASTNodePtr &node)
         func_end = create_instr(ThreeAddressCode::create_return(node));
     }
 
-    _labels.insert({ *node->get_name(), func_start });
-    _labels.insert({ *node->get_name() + ".end", func_end });
+    _labels.insert({ node->get_name_id(), func_start });
+    _labels.insert({ _strings->intern(*node->get_name() + ".end"), func_end });
 
     auto &list = _subroutine_tacs[*node->get_name()];
     list.swap(_current_subroutine_tac);
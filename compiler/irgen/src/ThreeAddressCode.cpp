@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -201,6 +202,43 @@ std::shared_ptr<ThreeAddressCode> ThreeAddressCode::create(IROperation op, const
     return std::shared_ptr<ThreeAddressCode>(new ThreeAddressCode(op, tgt, src1, src2, ast));
 }
 
+std::shared_ptr<ThreeAddressCode> ThreeAddressCode::create_accumulator(IROperation op, const Operand &operand, std::shared_ptr<parser::ASTNode> ast)
+{
+    switch (op) {
+    case IROperation::INBOX:
+    case IROperation::OUTBOX:
+        if (operand) {
+            throw std::runtime_error("INBOX and OUTBOX operations take no operand");
+        }
+        return std::shared_ptr<ThreeAddressCode>(new ThreeAddressCode(op, Operand(), Operand(), Operand(), ast));
+    case IROperation::COPYFROM:
+    case IROperation::COPYFROMI:
+    case IROperation::COPYTOI:
+    case IROperation::ADDM:
+    case IROperation::SUBM:
+        if (operand.get_type() != Operand::OperandType::VariableId && operand.get_type() != Operand::OperandType::ImmediateValue) {
+            throw std::runtime_error("Low IR memory operations require a variable or a constant");
+        }
+        return std::shared_ptr<ThreeAddressCode>(new ThreeAddressCode(op, Operand(), operand, Operand(), ast));
+    case IROperation::COPYTO:
+    case IROperation::BUMPUP:
+    case IROperation::BUMPDN:
+        if (operand.get_type() != Operand::OperandType::VariableId) {
+            throw std::runtime_error("COPYTO and BUMP operations require a variable");
+        }
+        return std::shared_ptr<ThreeAddressCode>(new ThreeAddressCode(op, operand, Operand(), Operand(), ast));
+    case IROperation::JUMP:
+    case IROperation::JUMPZ:
+    case IROperation::JUMPN:
+        if (operand.get_type() != Operand::OperandType::Label) {
+            throw std::runtime_error("JUMP operations require tgt to be a label");
+        }
+        return std::shared_ptr<ThreeAddressCode>(new ThreeAddressCode(op, operand, Operand(), Operand(), ast));
+    default:
+        throw std::invalid_argument("Invalid low IR operation");
+    }
+}
+
 std::shared_ptr<ThreeAddressCode> ThreeAddressCode::create_phi(int var_id, std::shared_ptr<parser::ASTNode> ast)
 {
     return std::shared_ptr<ThreeAddressCode>(new ThreeAddressCode(IROperation::PHI, Operand(var_id), Operand(), Operand(), ast));
@@ -209,7 +247,8 @@ std::shared_ptr<ThreeAddressCode> ThreeAddressCode::create_phi(int var_id, std::
 std::string ThreeAddressCode::to_string(bool with_color) const
 {
     auto instr = IROperationMetadata::to_string(_op);
-    instr.resize(4, ' ');
+    // low ir mnemonics are longer than 3 chars
+    instr.resize(std::max<std::size_t>(instr.size() + 1, 4), ' ');
 
     std::ostringstream oss;
 
@@ -231,7 +270,11 @@ std::string ThreeAddressCode::to_string(bool with_color) const
                 oss << ", ";
             }
             first = false;
-            oss << std::string(_src1);
+            if (IROperationMetadata::is_indirect(_op)) {
+                oss << "[" << std::string(_src1) << "]";
+            } else {
+                oss << std::string(_src1);
+            }
         }
         if (_src2) {
             if (!first) {
@@ -2,29 +2,54 @@
 #define HRLLEXER_H
 
 #include "ErrorManager.h"
+#include "HRLToken.h"
+#include "SourceFile.h"
 #include "lexer_global.h"
+#include "lexer_helper.h"
 
+#include <cstdio>
+#include <string>
+#include <string_view>
 #include <vector>
 
 OPEN_LEXER_NAMESPACE
 
+/**
+ * @brief Tokenizes the HRL source with a reentrant flex scanner or the hand-written HRLScanner. Each lexer owns its
+ * scanner and its state, so the lexers on different threads can lex different files concurrently.
+ */
 class HRLLexer {
 public:
+    enum class Backend {
+        Flex,
+        Handwritten,
+    };
+
+    /**
+     * @brief Lex with the backend selected at build time by HRL_LEXER_HANDWRITTEN.
+     */
     HRLLexer();
+    explicit HRLLexer(Backend backend);
     ~HRLLexer();
 
-    bool lex(FILE *in, const std::string &filepath, std::vector<TokenPtr> &result);
+    HRLLexer(const HRLLexer &) = delete;
+    HRLLexer &operator=(const HRLLexer &) = delete;
+
+    bool lex(FILE *in, const std::string &filepath, TokenBuffer &result);
 
 private:
-    int lexer_initialize(FILE *in);
+    int lexer_initialize(const SourceFilePtr &source);
     int lexer_finalize();
 
-    TokenPtr tokenize();
-    void print_tokenization_error(const std::string &filepath, int lineno, int colno, std::size_t width, const StringPtr &text);
-
-    void get_file_lines(FILE *in, std::vector<std::string> &rows);
+    TokenId tokenize(TokenBuffer &tokens);
+    void print_tokenization_error(const std::string &filepath, int lineno, int colno, std::size_t width, std::string_view text);
 
     ErrorManager &_errmgr;
+    Backend _backend;
+    // The yyscan_t of the generated scanner. Its state is _state, reached by yyextra.
+    void *_scanner = nullptr;
+    LexerState _state;
+    SourceFilePtr _source;
 };
 
 CLOSE_LEXER_NAMESPACE
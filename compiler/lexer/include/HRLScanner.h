@@ -0,0 +1,49 @@
+#ifndef HRLSCANNER_H
+#define HRLSCANNER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "HRLToken.h"
+#include "lexer_global.h"
+#include "lexer_helper.h"
+
+OPEN_LEXER_NAMESPACE
+
+/**
+ * @brief The hand-written alternative to the flex scanner of hrl.l, producing identical tokens.
+ *
+ * The keywords are looked up in a constexpr perfect hash table. The runs of blanks, comments, identifiers and
+ * integers are scanned 16 bytes at a time with SSE2 when it is available. The line and column follow the flex
+ * scanner, including the width of 1 it reports for the end of the input.
+ */
+class HRLScanner {
+public:
+    explicit HRLScanner(std::string_view input)
+        : _input(input)
+    {
+    }
+
+    ~HRLScanner() = default;
+
+    /**
+     * @brief Scan the next token into \p tokens, with the comments and newlines before it as its metadata.
+     *
+     * @param tokens
+     * @return TokenId The token scanned, END at the end of the input, or TOKEN_ERROR for an unrecognized character
+     */
+    TokenId scan(TokenBuffer &tokens);
+
+private:
+    std::string_view _input;
+    // The offset of the end of the last match. The tokens are positioned by their offsets only.
+    std::size_t _pos = 0;
+    std::vector<TokenMetadata> _metadata;
+
+    void match(std::size_t width);
+};
+
+CLOSE_LEXER_NAMESPACE
+
+#endif
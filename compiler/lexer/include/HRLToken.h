@@ -1,9 +1,15 @@
 #ifndef HRL_TOKEN
 #define HRL_TOKEN
 
-#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <vector>
 
+#include "SourceFile.h"
+#include "StringInterner.h"
 #include "hrl_global.h"
 #include "lexer_global.h"
 #include "lexer_helper.h"
@@ -92,100 +98,144 @@ inline bool is_token_binary_operator(TokenId token)
     }
 }
 
-class Token : std::enable_shared_from_this<Token> {
+const char *get_token_name(TokenId token_id);
+
+/**
+ * @brief The payload of the integer and boolean literals, and the interned id of the identifiers
+ */
+struct TokenPayload {
+    int value = 0;
+    bool is_char = false;
+};
+
+/**
+ * @brief The tokens of a source in structure-of-arrays form. The text, the identifier and the comments view the
+ * source, which the buffer keeps alive. The metadata of all tokens are in one side table, indexed by the token.
+ *
+ * The identifiers are interned into the StringInterner of the buffer when they're pushed. It's shared with the AST
+ * and the later stages of the compilation.
+ */
+class TokenBuffer {
 public:
-    Token(TokenId tokenId, int row, int col, std::size_t width, StringPtr text, const std::vector<TokenMetadata> &metadata)
-        : _token_id(tokenId)
-        , _lineno(row)
-        , _colno(col)
-        , _width(width)
-        , _text(text)
-        , _metadata(metadata)
+    TokenBuffer()
+        : TokenBuffer(nullptr)
+    {
+    }
+
+    explicit TokenBuffer(const SourceFilePtr &source)
+        : _source(source)
+        , _strings(std::make_shared<StringInterner>())
     {
+        _metadata_begins.push_back(0);
     }
 
-    virtual ~Token() { }
+    std::size_t size() const { return _ids.size(); }
+
+    bool empty() const { return _ids.empty(); }
+
+    TokenRef operator[](std::size_t index) const;
 
-    const char *get_token_name() const;
+    void push_back(TokenId token_id, std::size_t width, std::size_t offset,
+        const std::vector<TokenMetadata> &metadata, const std::optional<TokenPayload> &payload = std::nullopt);
 
-    TokenId token_id() const { return _token_id; }
+    TokenId token_id(std::size_t index) const { return _ids[index]; }
 
-    StringPtr token_text() const { return _text; }
+    // The line and the column are looked up in the line table of the source
+    int lineno(std::size_t index) const { return _source->lineno_at(_offsets[index]); }
 
-    int lineno() const { return _lineno; }
+    int colno(std::size_t index) const { return _source->colno_at(_offsets[index]); }
 
-    int colno() const { return _colno; }
+    SourceOffset offset(std::size_t index) const { return _offsets[index]; }
 
-    std::size_t width() const { return _width; }
+    std::size_t width(std::size_t index) const { return _widths[index]; }
 
-    const std::vector<TokenMetadata> &metadata() const { return _metadata; }
+    std::string_view token_text(std::size_t index) const { return _source->content().substr(_offsets[index], _widths[index]); }
 
-    void prepend_metadata_newline()
+    std::span<const TokenMetadata> metadata(std::size_t index) const
     {
-        _metadata.insert(
-            _metadata.begin(),
-            TokenMetadata {
-                .type = TokenMetadata::Newline,
-                .value = nullptr,
-            });
+        return std::span<const TokenMetadata>(_metadata).subspan(_metadata_begins[index], _metadata_begins[index + 1] - _metadata_begins[index]);
     }
 
-protected:
-    TokenId _token_id;
+    const TokenPayload &payload(std::size_t index) const { return _payloads[_payload_indices[index]]; }
 
-    int _lineno;
-    int _colno;
-    std::size_t _width;
-    StringPtr _text;
+    const SourceFilePtr &source() const { return _source; }
+
+    const StringInternerPtr &strings() const { return _strings; }
+
+    void swap(TokenBuffer &other) noexcept;
+
+private:
+    SourceFilePtr _source;
+    StringInternerPtr _strings;
+    std::vector<TokenId> _ids;
+    std::vector<SourceOffset> _offsets;
+    std::vector<std::uint32_t> _widths;
+    // index into _payloads, NO_PAYLOAD if the token has none
+    std::vector<std::uint32_t> _payload_indices;
+    std::vector<TokenPayload> _payloads;
+    // the metadata of token i are _metadata[_metadata_begins[i], _metadata_begins[i + 1])
+    std::vector<std::uint32_t> _metadata_begins;
     std::vector<TokenMetadata> _metadata;
+
+    static constexpr std::uint32_t NO_PAYLOAD = UINT32_MAX;
 };
 
-class BooleanToken : public Token {
+/**
+ * @brief A token in a TokenBuffer, referred to by its index. It is valid as long as the buffer is not destroyed or moved.
+ */
+class TokenRef {
 public:
-    BooleanToken(TokenId id, bool value, int row, int col, int width, StringPtr text, const std::vector<TokenMetadata> &metadata)
-        : Token(id, row, col, width, text, metadata)
-        , _value(value)
+    TokenRef() = default;
+
+    TokenRef(const TokenBuffer *buffer, std::size_t index)
+        : _buffer(buffer)
+        , _index(static_cast<std::uint32_t>(index))
     {
     }
 
-    int get_value() const { return _value; }
+    explicit operator bool() const { return _buffer != nullptr; }
 
-protected:
-    bool _value;
-};
+    std::size_t index() const { return _index; }
 
-class IntegerToken : public Token {
-public:
-    IntegerToken(TokenId id, int value, bool is_char, int row, int col, int width, StringPtr text, const std::vector<TokenMetadata> &metadata)
-        : Token(id, row, col, width, text, metadata)
-        , _value(value)
-        , _is_char(is_char)
-    {
-    }
+    TokenId token_id() const { return _buffer->token_id(_index); }
 
-    int get_value() const { return _value; }
+    const char *get_token_name() const { return lexer::get_token_name(token_id()); }
 
-    bool get_is_char() const { return _is_char; }
+    std::string_view token_text() const { return _buffer->token_text(_index); }
 
-protected:
-    int _value;
-    bool _is_char;
-};
+    int lineno() const { return _buffer->lineno(_index); }
 
-class IdentifierToken : public Token {
-public:
-    IdentifierToken(TokenId id, StringPtr value, int row, int col, int width, StringPtr text, const std::vector<TokenMetadata> &metadata)
-        : Token(id, row, col, width, text, metadata)
-        , _value(value)
-    {
-    }
+    int colno() const { return _buffer->colno(_index); }
+
+    SourceOffset offset() const { return _buffer->offset(_index); }
+
+    std::size_t width() const { return _buffer->width(_index); }
+
+    std::span<const TokenMetadata> metadata() const { return _buffer->metadata(_index); }
 
-    StringPtr get_value() const { return _value; }
+    std::string_view get_identifier() const { return token_text(); }
 
-protected:
-    StringPtr _value;
+    StringId get_identifier_id() const { return static_cast<StringId>(_buffer->payload(_index).value); }
+
+    // The identifier shared with the interner, instead of a copy of it
+    const StringPtr &get_identifier_name() const { return _buffer->strings()->shared(get_identifier_id()); }
+
+    int get_integer() const { return _buffer->payload(_index).value; }
+
+    bool get_is_char() const { return _buffer->payload(_index).is_char; }
+
+    bool get_boolean() const { return _buffer->payload(_index).value != 0; }
+
+private:
+    const TokenBuffer *_buffer = nullptr;
+    std::uint32_t _index = 0;
 };
 
+inline TokenRef TokenBuffer::operator[](std::size_t index) const
+{
+    return TokenRef(this, index);
+}
+
 CLOSE_LEXER_NAMESPACE
 
 #endif
\ No newline at end of file
@@ -12,14 +12,8 @@
 
 OPEN_LEXER_NAMESPACE
 
-class Token;
-class IdentifierToken;
-class IntegerToken;
-class BooleanToken;
-using TokenPtr = std::shared_ptr<Token>;
-using IdentifierTokenPtr = std::shared_ptr<IdentifierToken>;
-using IntegerTokenPtr = std::shared_ptr<IntegerToken>;
-using BooleanTokenPtr = std::shared_ptr<BooleanToken>;
+class TokenBuffer;
+class TokenRef;
 
 CLOSE_LEXER_NAMESPACE
 
@@ -1,6 +1,8 @@
 #ifndef LEXER_HELPER_H
 #define LEXER_HELPER_H
 
+#include <cstddef>
+#include <string_view>
 #include <vector>
 
 #include "hrl_global.h"
@@ -15,14 +17,14 @@ struct TokenMetadata {
     };
 
     Type type = Newline;
-    StringPtr value = nullptr;
+    // views the source of the token
+    std::string_view value;
 };
 
 struct CurrentToken {
 public:
     int integer;
     bool boolean;
-    StringPtr identifier;
     std::vector<TokenMetadata> preceding_metadata;
     bool is_char;
 
@@ -30,13 +32,35 @@ public:
     {
         integer = 0;
         boolean = false;
-        identifier.reset();
         preceding_metadata.clear();
         is_char = false;
     }
 };
 
-extern CurrentToken __currentToken;
+/**
+ * @brief The per-scanner state of the reentrant flex scanner, reached by yyextra in the rules.
+ */
+struct LexerState {
+    // The source, fed to the scanner by YY_INPUT
+    std::string_view input;
+    std::size_t input_pos = 0;
+    // The offset of the end of the last match in input. The line and the column are found from it when they're printed.
+    std::size_t offset = 0;
+    CurrentToken current_token;
+
+    void reset(std::string_view source)
+    {
+        input = source;
+        input_pos = 0;
+        offset = 0;
+        current_token.clear();
+    }
+
+    /**
+     * @brief The last match of length \p leng, viewed in the input rather than the scanner buffer
+     */
+    std::string_view matched(std::size_t leng) const { return input.substr(offset - leng, leng); }
+};
 
 CLOSE_LEXER_NAMESPACE
 
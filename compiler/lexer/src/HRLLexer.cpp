@@ -2,57 +2,66 @@
 
 #include "ErrorManager.h"
 #include "HRLLexer.h"
+#include "HRLScanner.h"
 #include "HRLToken.h"
 #include "lexer.h"
 #include "lexer_global.h"
 #include "lexer_helper.h"
 
-extern unsigned int yycolno;
-
 OPEN_LEXER_NAMESPACE
 
 HRLLexer::HRLLexer()
+#ifdef HRL_LEXER_HANDWRITTEN
+    : HRLLexer(Backend::Handwritten)
+#else
+    : HRLLexer(Backend::Flex)
+#endif
+{
+}
+
+HRLLexer::HRLLexer(Backend backend)
     : _errmgr(ErrorManager::instance())
+    , _backend(backend)
 {
+    yylex_init_extra(&_state, &_scanner);
 }
 
 HRLLexer::~HRLLexer()
 {
+    yylex_destroy(_scanner);
 }
 
-bool HRLLexer::lex(FILE *in, const std::string &filepath, std::vector<TokenPtr> &result)
+bool HRLLexer::lex(FILE *in, const std::string &filepath, TokenBuffer &result)
 {
     lexer_finalize(); // clean up if there's previous lexing context
-    lexer_initialize(in);
+    lexer_initialize(std::make_shared<const SourceFile>(in));
 
-    std::vector<std::string> lines;
-    get_file_lines(in, lines);
-    ErrorManager::instance().add_file(filepath, lines);
+    _errmgr.add_file(filepath, _source);
 
-    std::vector<TokenPtr> ret;
+    TokenBuffer ret(_source);
 
     // begin tokenization
     TokenId currentTokenId = END;
 
-    do {
-        TokenPtr token = tokenize();
-        currentTokenId = token->token_id();
-        ret.push_back(token);
-    } while (currentTokenId > 0);
+    if (_backend == Backend::Handwritten) {
+        HRLScanner scanner(_source->content());
+        do {
+            currentTokenId = scanner.scan(ret);
+        } while (currentTokenId > 0);
+    } else {
+        do {
+            currentTokenId = tokenize(ret);
+        } while (currentTokenId > 0);
+    }
 
     if (currentTokenId == END) {
-        // this is required that the formatter correctly handles first-line comment
-        // so it create a new line for the first line comment instead try to hook it to a void "previous line"
-        if (!ret.empty() && !ret.front()->metadata().empty()) {
-            ret.front()->prepend_metadata_newline();
-        }
         result.swap(ret);
         return true;
     }
 
     if (currentTokenId == TOKEN_ERROR) {
-        const auto &token = ret.back();
-        print_tokenization_error(filepath, token->lineno(), token->colno(), token->width(), token->token_text());
+        TokenRef token = ret[ret.size() - 1];
+        print_tokenization_error(filepath, token.lineno(), token.colno(), token.width(), token.token_text());
         return false;
     }
     // this is not supposed to happen. tokenization ended but not with either END or ERROR.
@@ -60,36 +69,44 @@ bool HRLLexer::lex(FILE *in, const std::string &filepath, std::vector<TokenPtr>
     return false;
 }
 
-int HRLLexer::lexer_initialize(FILE *in)
+int HRLLexer::lexer_initialize(const SourceFilePtr &source)
 {
-    yylex_destroy();
+    // start over with a fresh scanner, which may have buffered the previous file
+    yylex_destroy(_scanner);
+    yylex_init_extra(&_state, &_scanner);
 
-    yyin = in;
-    __currentToken.clear();
-    yylineno = 1;
+    _source = source;
+    _state.reset(_source->content());
     return 0;
 }
 
 int HRLLexer::lexer_finalize()
 {
-    yyin = nullptr;
+    _state.reset(std::string_view());
+    _source.reset();
     return 0;
 }
 
-TokenPtr HRLLexer::tokenize()
+TokenId HRLLexer::tokenize(TokenBuffer &tokens)
 {
-    int val = yylex();
-    TokenPtr token;
+    int val = yylex(_scanner);
 
     // as long as it's metadata, we keep tokenize next
     while (val >= COMMENT) {
-        val = yylex();
+        val = yylex(_scanner);
     }
 
     TokenId token_id = static_cast<TokenId>(val);
-    int lineno = yylineno; // line starts from 1
-    int colno = yycolno - yyleng + 1; // colno starts from 1
-    int width = yyleng;
+    int width = yyget_leng(_scanner);
+    // the end has no text, the scanner may report the end of buffer as the match
+    std::size_t offset = val == END ? _state.offset : _state.offset - width;
+    CurrentToken &current = _state.current_token;
+
+    // this is required that the formatter correctly handles first-line comment
+    // so it create a new line for the first line comment instead try to hook it to a void "previous line"
+    if (tokens.empty() && !current.preceding_metadata.empty()) {
+        current.preceding_metadata.insert(current.preceding_metadata.begin(), TokenMetadata { .type = TokenMetadata::Newline, .value = {} });
+    }
 
     switch (val) {
         // these are keywords and operators. no extra info stored in the token
@@ -132,68 +149,32 @@ TokenPtr HRLLexer::tokenize()
     case OPEN_BRACKET:
     case CLOSE_BRACKET:
     case COMMA:
-        token = std::make_shared<Token>(token_id, lineno, colno, width, std::make_shared<std::string>(yytext), __currentToken.preceding_metadata);
+        // identifiers are interned by the buffer
+    case IDENTIFIER:
+    case END:
+    case TOKEN_ERROR:
+        tokens.push_back(token_id, width, offset, current.preceding_metadata);
         break;
     // tokens has some payloads
     case BOOLEAN:
-        token = std::make_shared<BooleanToken>(token_id, __currentToken.boolean, lineno, colno, width, std::make_shared<std::string>(yytext), __currentToken.preceding_metadata);
+        tokens.push_back(token_id, width, offset, current.preceding_metadata, TokenPayload { .value = current.boolean, .is_char = false });
         break;
     case INTEGER:
-        token = std::make_shared<IntegerToken>(token_id, __currentToken.integer, __currentToken.is_char, lineno, colno, width, std::make_shared<std::string>(yytext), __currentToken.preceding_metadata);
-        break;
-    case IDENTIFIER:
-        token = std::make_shared<IdentifierToken>(token_id, __currentToken.identifier, lineno, colno, width, std::make_shared<std::string>(yytext), __currentToken.preceding_metadata);
-        break;
-    case END:
-        token = std::make_shared<Token>(END, lineno, colno, width, std::make_shared<std::string>(yytext), __currentToken.preceding_metadata);
-        break;
-    case TOKEN_ERROR:
-        token = std::make_shared<Token>(TOKEN_ERROR, lineno, colno, width, std::make_shared<std::string>(yytext), __currentToken.preceding_metadata);
+        tokens.push_back(token_id, width, offset, current.preceding_metadata, TokenPayload { .value = current.integer, .is_char = current.is_char });
         break;
     default:
         spdlog::critical("bug: unreachable tokenize default");
         abort();
     }
 
-    __currentToken.clear();
-    return token;
+    current.clear();
+    return token_id;
 }
 
-void HRLLexer::print_tokenization_error(const std::string &filepath, int lineno, int colno, std::size_t width, const StringPtr &text)
+void HRLLexer::print_tokenization_error(const std::string &filepath, int lineno, int colno, std::size_t width, std::string_view text)
 {
-    auto fmt = boost::format("Unrecognized token '%1%'") % *text;
+    auto fmt = boost::format("Unrecognized token '%1%'") % text;
     _errmgr.report(1001, ErrorSeverity::Error, ErrorLocation(filepath, lineno, colno, width), fmt.str());
 }
 
-void HRLLexer::get_file_lines(FILE *in, std::vector<std::string> &rows)
-{
-    std::vector<std::string> source_rows;
-
-    char buf[1024];
-    long current_pos = ftell(in);
-    std::fseek(in, current_pos, SEEK_SET);
-
-    std::string current_line;
-    current_line.reserve(128);
-
-    while (!std::feof(in)) {
-        size_t bytes_read = fread(buf, 1, sizeof(buf), in);
-
-        for (size_t i = 0; i < bytes_read; ++i) {
-            if (buf[i] == '\n') {
-                source_rows.push_back(current_line);
-                current_line.clear();
-            } else {
-                current_line.push_back(buf[i]);
-            }
-        }
-    }
-
-    source_rows.push_back(current_line);
-
-    fseek(in, current_pos, SEEK_SET);
-
-    rows.swap(source_rows);
-}
-
 CLOSE_LEXER_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HRL_SCANNER_SSE2 1
+#endif
+
+#include "HRLScanner.h"
+#include "HRLToken.h"
+#include "lexer_global.h"
+#include "lexer_helper.h"
+
+OPEN_LEXER_NAMESPACE
+
+namespace {
+
+struct Keyword {
+    std::string_view text;
+    TokenId token_id = IDENTIFIER;
+    // the value of true and false
+    int value = 0;
+};
+
+constexpr std::array<Keyword, 16> KEYWORDS { {
+    { "import", IMPORT, 0 },
+    { "return", RETURN, 0 },
+    { "let", LET, 0 },
+    { "init", INIT, 0 },
+    { "floor", FLOOR, 0 },
+    { "floor_max", FLOOR_MAX, 0 },
+    { "function", FUNCTION, 0 },
+    { "sub", SUBWORD, 0 },
+    { "if", IF, 0 },
+    { "else", ELSE, 0 },
+    { "while", WHILE, 0 },
+    { "for", FOR, 0 },
+    { "break", BREAK, 0 },
+    { "continue", CONTINUE, 0 },
+    { "true", BOOLEAN, 1 },
+    { "false", BOOLEAN, 0 },
+} };
+
+constexpr std::size_t KEYWORD_TABLE_SIZE = 32;
+
+constexpr std::size_t keyword_hash(std::string_view text)
+{
+    return (static_cast<unsigned char>(text.front()) * 8u + static_cast<unsigned char>(text.back()) * 4u + text.size()) % KEYWORD_TABLE_SIZE;
+}
+
+constexpr std::array<Keyword, KEYWORD_TABLE_SIZE> make_keyword_table()
+{
+    std::array<Keyword, KEYWORD_TABLE_SIZE> table {};
+    for (const Keyword &keyword : KEYWORDS) {
+        table[keyword_hash(keyword.text)] = keyword;
+    }
+    return table;
+}
+
+constexpr std::array<Keyword, KEYWORD_TABLE_SIZE> KEYWORD_TABLE = make_keyword_table();
+
+constexpr bool is_keyword_hash_perfect()
+{
+    for (const Keyword &keyword : KEYWORDS) {
+        if (KEYWORD_TABLE[keyword_hash(keyword.text)].text != keyword.text) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(is_keyword_hash_perfect(), "Two keywords have the same hash. Change the hash or the table size.");
+
+// an identifier if it's not a keyword
+constexpr const Keyword &lookup_keyword(std::string_view text)
+{
+    return KEYWORD_TABLE[keyword_hash(text)];
+}
+
+static_assert(lookup_keyword("floor_max").token_id == FLOOR_MAX);
+static_assert(lookup_keyword("floors").text != "floors");
+
+constexpr bool is_alpha(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+constexpr bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool is_identifier_char(char c)
+{
+    return is_alpha(c) || is_digit(c) || c == '_';
+}
+
+constexpr bool is_blank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+#ifdef HRL_SCANNER_SSE2
+// 0xFF for the bytes in [lo, hi]. SSE2 only compares signed bytes, so the range is shifted to start from -128.
+inline __m128i in_range(__m128i chunk, char lo, char hi)
+{
+    const __m128i shifted = _mm_add_epi8(chunk, _mm_set1_epi8(static_cast<char>(0x80 - lo)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(hi - lo + 1 - 0x80)));
+}
+
+inline __m128i blank_mask(__m128i chunk)
+{
+    return _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+}
+
+inline __m128i identifier_mask(__m128i chunk)
+{
+    __m128i mask = _mm_or_si128(in_range(chunk, 'A', 'Z'), in_range(chunk, 'a', 'z'));
+    mask = _mm_or_si128(mask, in_range(chunk, '0', '9'));
+    return _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+}
+
+inline __m128i digit_mask(__m128i chunk)
+{
+    return in_range(chunk, '0', '9');
+}
+
+inline __m128i not_newline_mask(__m128i chunk)
+{
+    return _mm_xor_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_set1_epi8(static_cast<char>(0xFF)));
+}
+#endif
+
+/**
+ * @brief The length of the run of [begin, end) in a character class, 16 bytes at a time while 16 bytes remain.
+ */
+template <typename VectorClass, typename ScalarClass>
+std::size_t span_of(const char *begin, const char *end, [[maybe_unused]] VectorClass vector_class, ScalarClass scalar_class)
+{
+    const char *p = begin;
+#ifdef HRL_SCANNER_SSE2
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(vector_class(chunk)));
+        if (mask != 0xFFFF) {
+            return static_cast<std::size_t>(p - begin) + static_cast<std::size_t>(std::countr_one(mask));
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && scalar_class(*p)) {
+        ++p;
+    }
+    return static_cast<std::size_t>(p - begin);
+}
+
+#ifdef HRL_SCANNER_SSE2
+#define VECTOR_CLASS(name) name##_mask
+#else
+#define VECTOR_CLASS(name) nullptr
+#endif
+
+// like atoi in hrl.l, which saturates to long before it narrows to int
+int digits_to_int(std::string_view digits)
+{
+    long value = 0;
+    for (char c : digits) {
+        const int digit = c - '0';
+        if (value > (LONG_MAX - digit) / 10) {
+            value = LONG_MAX;
+            break;
+        }
+        value = value * 10 + digit;
+    }
+    return static_cast<int>(value);
+}
+
+} // namespace
+
+TokenId HRLScanner::scan(TokenBuffer &tokens)
+{
+    const char *const end = _input.data() + _input.size();
+
+    while (_pos < _input.size()) {
+        const char *const p = _input.data() + _pos;
+        const std::size_t rest = _input.size() - _pos;
+        const char c = *p;
+
+        if (is_blank(c)) {
+            match(span_of(p, end, VECTOR_CLASS(blank), is_blank));
+            continue;
+        }
+
+        if (c == '\n' || c == '\r') {
+            match(1);
+            _metadata.push_back(TokenMetadata { .type = TokenMetadata::Newline, .value = {} });
+            continue;
+        }
+
+        if (c == '/' && rest > 1 && p[1] == '/') {
+            const std::size_t width = span_of(p, end, VECTOR_CLASS(not_newline), [](char ch) { return ch != '\n'; });
+            match(width);
+            _metadata.push_back(TokenMetadata { .type = TokenMetadata::Comment, .value = _input.substr(_pos - width, width) });
+            continue;
+        }
+
+        TokenId token_id = TOKEN_ERROR;
+        std::size_t width = 1;
+        std::optional<TokenPayload> payload;
+
+        if (is_alpha(c) || c == '_') {
+            width = span_of(p, end, VECTOR_CLASS(identifier), is_identifier_char);
+            const Keyword &keyword = lookup_keyword(std::string_view(p, width));
+            if (keyword.text == std::string_view(p, width)) {
+                token_id = keyword.token_id;
+                if (token_id == BOOLEAN) {
+                    payload = TokenPayload { .value = keyword.value, .is_char = false };
+                }
+            } else {
+                token_id = IDENTIFIER;
+            }
+        } else if (is_digit(c)) {
+            width = span_of(p, end, VECTOR_CLASS(digit), is_digit);
+            token_id = INTEGER;
+            payload = TokenPayload { .value = digits_to_int(std::string_view(p, width)), .is_char = false };
+        } else if (c == '\'' && rest >= 3 && is_alpha(p[1]) && p[2] == '\'') {
+            width = 3;
+            token_id = INTEGER;
+            payload = TokenPayload { .value = p[1] >= 'a' ? p[1] - 'a' + 'A' : p[1], .is_char = true };
+        } else {
+            const char next = rest > 1 ? p[1] : '\0';
+            width = 2;
+            switch (c) {
+            case '>':
+                token_id = next == '=' ? GE : (width = 1, GT);
+                break;
+            case '<':
+                token_id = next == '=' ? LE : (width = 1, LT);
+                break;
+            case '=':
+                token_id = next == '=' ? EE : (width = 1, EQ);
+                break;
+            case '!':
+                token_id = next == '=' ? NE : (width = 1, NOT);
+                break;
+            case '+':
+                token_id = next == '+' ? ADDADD : (width = 1, ADD);
+                break;
+            case '-':
+                token_id = next == '-' ? SUBSUB : (width = 1, SUB);
+                break;
+            case '&':
+                token_id = next == '&' ? AND : (width = 1, TOKEN_ERROR);
+                break;
+            case '|':
+                token_id = next == '|' ? OR : (width = 1, TOKEN_ERROR);
+                break;
+            default:
+                width = 1;
+                switch (c) {
+                case '(':
+                    token_id = OPEN_PAREN;
+                    break;
+                case ')':
+                    token_id = CLOSE_PAREN;
+                    break;
+                case '{':
+                    token_id = OPEN_BRACE;
+                    break;
+                case '}':
+                    token_id = CLOSE_BRACE;
+                    break;
+                case '[':
+                    token_id = OPEN_BRACKET;
+                    break;
+                case ']':
+                    token_id = CLOSE_BRACKET;
+                    break;
+                case ',':
+                    token_id = COMMA;
+                    break;
+                case '*':
+                    token_id = MUL;
+                    break;
+                case '/':
+                    token_id = DIV;
+                    break;
+                case '%':
+                    token_id = MOD;
+                    break;
+                case ';':
+                    token_id = T;
+                    break;
+                default:
+                    token_id = TOKEN_ERROR;
+                    break;
+                }
+                break;
+            }
+        }
+
+        match(width);
+
+        // the first line comment gets a newline before it, see HRLLexer::tokenize
+        if (tokens.empty() && !_metadata.empty()) {
+            _metadata.insert(_metadata.begin(), TokenMetadata { .type = TokenMetadata::Newline, .value = {} });
+        }
+        tokens.push_back(token_id, width, _pos - width, _metadata, payload);
+        _metadata.clear();
+        return token_id;
+    }
+
+    // flex matches the end of buffer character, so the end is 1 wide
+    if (tokens.empty() && !_metadata.empty()) {
+        _metadata.insert(_metadata.begin(), TokenMetadata { .type = TokenMetadata::Newline, .value = {} });
+    }
+    tokens.push_back(END, 1, _input.size(), _metadata);
+    _metadata.clear();
+    return END;
+}
+
+void HRLScanner::match(std::size_t width)
+{
+    _pos += width;
+}
+
+CLOSE_LEXER_NAMESPACE
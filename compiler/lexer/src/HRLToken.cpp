@@ -2,9 +2,9 @@
 
 OPEN_LEXER_NAMESPACE
 
-const char *Token::get_token_name() const
+const char *get_token_name(TokenId token_id)
 {
-    switch (_token_id) {
+    switch (token_id) {
     case END:
         return "END";
     case IMPORT:
@@ -94,4 +94,39 @@ const char *Token::get_token_name() const
     }
 }
 
-CLOSE_LEXER_NAMESPACE
\ No newline at end of file
+void TokenBuffer::push_back(TokenId token_id, std::size_t width, std::size_t offset,
+    const std::vector<TokenMetadata> &metadata, const std::optional<TokenPayload> &payload)
+{
+    _ids.push_back(token_id);
+    _offsets.push_back(static_cast<SourceOffset>(offset));
+    _widths.push_back(static_cast<std::uint32_t>(width));
+
+    if (token_id == IDENTIFIER) {
+        _payload_indices.push_back(static_cast<std::uint32_t>(_payloads.size()));
+        StringId id = _strings->intern(_source->content().substr(offset, width));
+        _payloads.push_back(TokenPayload { .value = static_cast<int>(id), .is_char = false });
+    } else if (payload.has_value()) {
+        _payload_indices.push_back(static_cast<std::uint32_t>(_payloads.size()));
+        _payloads.push_back(*payload);
+    } else {
+        _payload_indices.push_back(NO_PAYLOAD);
+    }
+
+    _metadata.insert(_metadata.end(), metadata.begin(), metadata.end());
+    _metadata_begins.push_back(static_cast<std::uint32_t>(_metadata.size()));
+}
+
+void TokenBuffer::swap(TokenBuffer &other) noexcept
+{
+    _source.swap(other._source);
+    _strings.swap(other._strings);
+    _ids.swap(other._ids);
+    _offsets.swap(other._offsets);
+    _widths.swap(other._widths);
+    _payload_indices.swap(other._payload_indices);
+    _payloads.swap(other._payloads);
+    _metadata_begins.swap(other._metadata_begins);
+    _metadata.swap(other._metadata);
+}
+
+CLOSE_LEXER_NAMESPACE
@@ -1,7 +0,0 @@
-#include "lexer_helper.h"
-
-OPEN_LEXER_NAMESPACE
-
-CurrentToken __currentToken;
-
-CLOSE_LEXER_NAMESPACE
\ No newline at end of file
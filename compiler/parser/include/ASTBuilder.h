@@ -6,6 +6,9 @@
 #include <stack>
 
 #include "ASTNode.h"
+#include "ASTNodeArena.h"
+#include "SourceFile.h"
+#include "StringInterner.h"
 #include "ParseTreeNode.h"
 #include "ParseTreeNodeForward.h"
 #include "ParseTreeNodeVisitor.h"
@@ -15,7 +18,8 @@ OPEN_PARSER_NAMESPACE
 
 class ASTBuilder : public ParseTreeNodeVisitor {
 public:
-    explicit ASTBuilder(CompilationUnitPTNodePtr root);
+    // \p source is where the tokens of the parse tree come from, and \p strings is where their identifiers are interned
+    ASTBuilder(CompilationUnitPTNodePtr root, SourceFilePtr source, StringInternerPtr strings);
     ~ASTBuilder() override = default;
 
     bool build(CompilationUnitASTNodePtr &result);
@@ -56,6 +60,8 @@ public:
 
 protected:
     CompilationUnitPTNodePtr _root;
+    SourceFilePtr _source;
+    ASTNodeArenaPtr _arena;
     std::stack<ASTNodePtr> _result_stack;
 
     template <typename ASTNodePtrT, typename ParseTreeNodePtrT>
@@ -76,9 +82,11 @@ protected:
         }
     }
 
-    static IntegerASTNodePtr make_literal_node(const IntegerLiteralPTNodePtr &node)
+    SourceOffset offset_of(const ParseTreePTNodePtr &node) const { return _source->offset_at(node->lineno(), node->colno()); }
+
+    IntegerASTNodePtr make_literal_node(const IntegerLiteralPTNodePtr &node)
     {
-        IntegerASTNodePtr val_expr = std::make_shared<IntegerASTNode>(node->lineno(), node->colno(), node->lineno(), int(node->lineno() + node->get_token()->width()), node->get_value(), node->get_is_char());
+        IntegerASTNodePtr val_expr = _arena->make<IntegerASTNode>(node->get_token().offset(), static_cast<SourceOffset>(node->get_token().offset() + node->get_token().width()), node->get_value(), node->get_is_char());
         return val_expr;
     }
 
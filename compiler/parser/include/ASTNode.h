@@ -1,6 +1,8 @@
 #ifndef ASTNODE_H
 #define ASTNODE_H
 
+#include <cstddef>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -10,6 +12,8 @@
 
 #include "ASTNodeForward.h"
 #include "HRBox.h"
+#include "SourceFile.h"
+#include "StringInterner.h"
 #include "hrl_global.h"
 #include "parser_global.h"
 
@@ -63,11 +67,9 @@ const char *ast_node_type_to_string(ASTNodeType type);
 
 class ASTNode : public std::enable_shared_from_this<ASTNode> {
 public:
-    ASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : _lineno(lineno)
-        , _colno(colno)
-        , _last_lineno(last_lineno)
-        , _last_colno(last_colno)
+    ASTNode(SourceOffset offset, SourceOffset last_offset)
+        : _offset(offset)
+        , _last_offset(last_offset)
     {
     }
 
@@ -77,16 +79,30 @@ public:
 
     virtual ASTNodeType get_node_type() = 0;
 
-    int &lineno() { return _lineno; }
+    // The id of the node in its ASTNodeArena, or NO_NODE_ID if it's not allocated from an arena
+    std::size_t node_id() const { return _node_id; }
 
-    int &colno() { return _colno; }
+    static constexpr std::size_t NO_NODE_ID = std::numeric_limits<std::size_t>::max();
 
-    int &last_lineno() { return _last_lineno; }
+    SourceOffset offset() const { return _offset; }
 
-    int &last_colno() { return _last_colno; }
+    // The end of the node, NO_SOURCE_OFFSET if it's not known
+    SourceOffset last_offset() const { return _last_offset; }
+
+    // The line and the column are looked up in the source of the arena, and are -1 if the position is not known
+    int lineno() const;
+
+    int colno() const;
+
+    int last_lineno() const;
+
+    int last_colno() const;
+
+    // The arena the node is allocated from, or nullptr if it's not
+    ASTNodeArena *get_arena() const { return _arena; }
 
     /**
-     * @brief Get the attribute attached to this node
+     * @brief Get the attribute attached to this node. The typed access is GetSetAttribute::get_from.
      *
      * @param attribute_id
      * @param out
@@ -95,14 +111,6 @@ public:
      */
     bool get_attribute(int attribute_id, ASTNodeAttributePtr &out) const;
 
-    /**
-     * @brief Attach the attribute to this node. If the \p attr is null, it won't be attached.
-     *
-     * @param attribute_id
-     * @param attr
-     */
-    void set_attribute(int attribute_id, ASTNodeAttributePtr attr);
-
     void remove_attribute(int attribute_id);
 
     void copy_attributes_from(const ASTNodePtr &node);
@@ -114,26 +122,30 @@ protected:
         return std::static_pointer_cast<T>(shared_from_this());
     }
 
+    // The names are kept as ids in the interner of the arena
+    const StringPtr &name_of(StringId id) const;
+
 private:
-    int _lineno;
-    int _colno;
-    int _last_lineno;
-    int _last_colno;
-    std::map<int, ASTNodeAttributePtr> _attributes;
+    friend class ASTNodeArena;
+
+    SourceOffset _offset;
+    SourceOffset _last_offset;
+    std::size_t _node_id = NO_NODE_ID;
+    ASTNodeArena *_arena = nullptr;
 };
 
 class AbstractStatementASTNode : public ASTNode {
 public:
-    AbstractStatementASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : ASTNode(lineno, colno, last_lineno, last_colno)
+    AbstractStatementASTNode(SourceOffset offset, SourceOffset last_offset)
+        : ASTNode(offset, last_offset)
     {
     }
 };
 
 class AbstractEmbeddedStatementASTNode : public AbstractStatementASTNode {
 public:
-    AbstractEmbeddedStatementASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : AbstractStatementASTNode(lineno, colno, last_lineno, last_colno)
+    AbstractEmbeddedStatementASTNode(SourceOffset offset, SourceOffset last_offset)
+        : AbstractStatementASTNode(offset, last_offset)
     {
     }
 };
@@ -141,8 +153,8 @@ public:
 // AbstractExpressionASTNode
 class AbstractExpressionASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    AbstractExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    AbstractExpressionASTNode(SourceOffset offset, SourceOffset last_offset)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
     {
     }
 };
@@ -150,8 +162,8 @@ public:
 // AbstractUnaryExpressionASTNode
 class AbstractUnaryExpressionASTNode : public AbstractExpressionASTNode {
 public:
-    AbstractUnaryExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr operand)
-        : AbstractExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    AbstractUnaryExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr operand)
+        : AbstractExpressionASTNode(offset, last_offset)
         , _operand(operand)
     {
     }
@@ -166,8 +178,8 @@ private:
 // AbstractPrimaryExpressionASTNode
 class AbstractPrimaryExpressionASTNode : public AbstractExpressionASTNode {
 public:
-    AbstractPrimaryExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : AbstractExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    AbstractPrimaryExpressionASTNode(SourceOffset offset, SourceOffset last_offset)
+        : AbstractExpressionASTNode(offset, last_offset)
     {
     }
 };
@@ -195,8 +207,8 @@ const char *get_ast_binary_operator_str(ASTBinaryOperator op);
 // AbstractBinaryExpressionASTNode
 class AbstractBinaryExpressionASTNode : public AbstractExpressionASTNode {
 public:
-    AbstractBinaryExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right, ASTBinaryOperator op)
-        : AbstractExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    AbstractBinaryExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right, ASTBinaryOperator op)
+        : AbstractExpressionASTNode(offset, last_offset)
         , _left(std::move(left))
         , _right(std::move(right))
         , _op(op)
@@ -218,15 +230,17 @@ private:
 
 class AbstractSubroutineASTNode : public ASTNode {
 public:
-    AbstractSubroutineASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr name, VariableDeclarationASTNodePtr parameter, StatementBlockASTNodePtr body)
-        : ASTNode(lineno, colno, last_lineno, last_colno)
-        , _name(std::move(name))
+    AbstractSubroutineASTNode(SourceOffset offset, SourceOffset last_offset, StringId name, VariableDeclarationASTNodePtr parameter, StatementBlockASTNodePtr body)
+        : ASTNode(offset, last_offset)
+        , _name(name)
         , _parameter(std::move(parameter))
         , _body(std::move(body))
     {
     }
 
-    StringPtr &get_name() { return _name; }
+    const StringPtr &get_name() const { return name_of(_name); }
+
+    StringId get_name_id() const { return _name; }
 
     VariableDeclarationASTNodePtr &get_parameter() { return _parameter; }
 
@@ -234,15 +248,15 @@ public:
 
 protected:
 private:
-    StringPtr _name;
+    StringId _name;
     VariableDeclarationASTNodePtr _parameter;
     StatementBlockASTNodePtr _body;
 };
 
 class EmptyStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    EmptyStatementASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    EmptyStatementASTNode(SourceOffset offset, SourceOffset last_offset)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
     {
     }
 
@@ -253,8 +267,8 @@ public:
 
 class IntegerASTNode : public AbstractPrimaryExpressionASTNode {
 public:
-    IntegerASTNode(int lineno, int colno, int last_lineno, int last_colno, int value, bool is_char)
-        : AbstractPrimaryExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    IntegerASTNode(SourceOffset offset, SourceOffset last_offset, int value, bool is_char)
+        : AbstractPrimaryExpressionASTNode(offset, last_offset)
         , _value(value)
         , _is_char(is_char)
     {
@@ -279,8 +293,8 @@ private:
 // BooleanASTNode
 class BooleanASTNode : public AbstractPrimaryExpressionASTNode {
 public:
-    BooleanASTNode(int lineno, int colno, int last_lineno, int last_colno, bool value)
-        : AbstractPrimaryExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    BooleanASTNode(SourceOffset offset, SourceOffset last_offset, bool value)
+        : AbstractPrimaryExpressionASTNode(offset, last_offset)
         , _value(value)
     {
     }
@@ -299,9 +313,9 @@ private:
 // VariableDeclarationASTNode
 class VariableDeclarationASTNode : public AbstractStatementASTNode {
 public:
-    VariableDeclarationASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr name, VariableAssignmentASTNodePtr assignment)
-        : AbstractStatementASTNode(lineno, colno, last_lineno, last_colno)
-        , _name(std::move(name))
+    VariableDeclarationASTNode(SourceOffset offset, SourceOffset last_offset, StringId name, VariableAssignmentASTNodePtr assignment)
+        : AbstractStatementASTNode(offset, last_offset)
+        , _name(name)
         , _assignment(std::move(assignment))
     {
     }
@@ -310,22 +324,24 @@ public:
 
     ASTNodeType get_node_type() override { return ASTNodeType::VariableDeclaration; }
 
-    StringPtr &get_name() { return _name; }
+    const StringPtr &get_name() const { return name_of(_name); }
+
+    StringId get_name_id() const { return _name; }
 
     VariableAssignmentASTNodePtr &get_assignment() { return _assignment; }
 
 protected:
 private:
-    StringPtr _name;
+    StringId _name;
     VariableAssignmentASTNodePtr _assignment;
 };
 
 // VariableAssignmentASTNode
 class VariableAssignmentASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    VariableAssignmentASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr name, AbstractExpressionASTNodePtr value)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
-        , _name(std::move(name))
+    VariableAssignmentASTNode(SourceOffset offset, SourceOffset last_offset, StringId name, AbstractExpressionASTNodePtr value)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
+        , _name(name)
         , _value(std::move(value))
     {
     }
@@ -334,21 +350,23 @@ public:
 
     ASTNodeType get_node_type() override { return ASTNodeType::VariableAssignment; }
 
-    StringPtr &get_name() { return _name; }
+    const StringPtr &get_name() const { return name_of(_name); }
+
+    StringId get_name_id() const { return _name; }
 
     AbstractExpressionASTNodePtr &get_value() { return _value; }
 
 protected:
 private:
-    StringPtr _name;
+    StringId _name;
     AbstractExpressionASTNodePtr _value;
 };
 
 // VariableAccessASTNode
 class VariableAccessASTNode : public AbstractPrimaryExpressionASTNode {
 public:
-    VariableAccessASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr name)
-        : AbstractPrimaryExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    VariableAccessASTNode(SourceOffset offset, SourceOffset last_offset, StringId name)
+        : AbstractPrimaryExpressionASTNode(offset, last_offset)
         , _name(name)
     {
     }
@@ -357,17 +375,19 @@ public:
 
     ASTNodeType get_node_type() override { return ASTNodeType::VariableAccess; }
 
-    StringPtr &get_name() { return _name; }
+    const StringPtr &get_name() const { return name_of(_name); }
+
+    StringId get_name_id() const { return _name; }
 
 protected:
 private:
-    StringPtr _name;
+    StringId _name;
 };
 
 class FloorBoxInitStatementASTNode : public ASTNode {
 public:
-    FloorBoxInitStatementASTNode(int lineno, int colno, int last_lineno, int last_colno, FloorAssignmentASTNodePtr assignment)
-        : ASTNode(lineno, colno, last_lineno, last_colno)
+    FloorBoxInitStatementASTNode(SourceOffset offset, SourceOffset last_offset, FloorAssignmentASTNodePtr assignment)
+        : ASTNode(offset, last_offset)
         , _assignment(std::move(assignment))
     {
     }
@@ -385,8 +405,8 @@ private:
 // FloorAssignmentASTNode
 class FloorAssignmentASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    FloorAssignmentASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr floor_number, AbstractExpressionASTNodePtr value)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    FloorAssignmentASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr floor_number, AbstractExpressionASTNodePtr value)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
         , _floor_number(std::move(floor_number))
         , _value(std::move(value))
     {
@@ -409,8 +429,8 @@ private:
 // FloorAccessASTNode
 class FloorAccessASTNode : public AbstractPrimaryExpressionASTNode {
 public:
-    FloorAccessASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr index_expr)
-        : AbstractPrimaryExpressionASTNode(lineno, colno, last_lineno, last_colno)
+    FloorAccessASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr index_expr)
+        : AbstractPrimaryExpressionASTNode(offset, last_offset)
         , _index_expr(std::move(index_expr))
     {
     }
@@ -429,8 +449,8 @@ private:
 // NegativeExpressionASTNode
 class NegativeExpressionASTNode : public AbstractUnaryExpressionASTNode {
 public:
-    NegativeExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr operand)
-        : AbstractUnaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(operand))
+    NegativeExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr operand)
+        : AbstractUnaryExpressionASTNode(offset, last_offset, std::move(operand))
     {
     }
 
@@ -444,8 +464,8 @@ private:
 // NotExpressionASTNode
 class NotExpressionASTNode : public AbstractUnaryExpressionASTNode {
 public:
-    NotExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr operand)
-        : AbstractUnaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(operand))
+    NotExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr operand)
+        : AbstractUnaryExpressionASTNode(offset, last_offset, std::move(operand))
     {
     }
 
@@ -459,9 +479,9 @@ private:
 // IncrementExpressionASTNode
 class IncrementExpressionASTNode : public AbstractUnaryExpressionASTNode {
 public:
-    IncrementExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr var_name)
-        : AbstractUnaryExpressionASTNode(lineno, colno, last_lineno, last_colno, nullptr)
-        , _var_name(std::move(var_name))
+    IncrementExpressionASTNode(SourceOffset offset, SourceOffset last_offset, StringId var_name)
+        : AbstractUnaryExpressionASTNode(offset, last_offset, nullptr)
+        , _var_name(var_name)
     {
     }
 
@@ -469,18 +489,20 @@ public:
 
     ASTNodeType get_node_type() override { return ASTNodeType::IncrementExpression; }
 
-    StringPtr &get_var_name() { return _var_name; }
+    const StringPtr &get_var_name() const { return name_of(_var_name); }
+
+    StringId get_var_name_id() const { return _var_name; }
 
 private:
-    StringPtr _var_name;
+    StringId _var_name;
 };
 
 // DecrementExpressionASTNode
 class DecrementExpressionASTNode : public AbstractUnaryExpressionASTNode {
 public:
-    DecrementExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr var_name)
-        : AbstractUnaryExpressionASTNode(lineno, colno, last_lineno, last_colno, nullptr)
-        , _var_name(std::move(var_name))
+    DecrementExpressionASTNode(SourceOffset offset, SourceOffset last_offset, StringId var_name)
+        : AbstractUnaryExpressionASTNode(offset, last_offset, nullptr)
+        , _var_name(var_name)
     {
     }
 
@@ -488,17 +510,19 @@ public:
 
     ASTNodeType get_node_type() override { return ASTNodeType::DecrementExpression; }
 
-    StringPtr &get_var_name() { return _var_name; }
+    const StringPtr &get_var_name() const { return name_of(_var_name); }
+
+    StringId get_var_name_id() const { return _var_name; }
 
 private:
-    StringPtr _var_name;
+    StringId _var_name;
 };
 
 // AddExpressionASTNode
 class AddExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    AddExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::ADD)
+    AddExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::ADD)
     {
     }
 
@@ -510,8 +534,8 @@ public:
 // SubExpressionASTNode
 class SubExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    SubExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::SUB)
+    SubExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::SUB)
     {
     }
 
@@ -523,8 +547,8 @@ public:
 // MulExpressionASTNode
 class MulExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    MulExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::MUL)
+    MulExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::MUL)
     {
     }
 
@@ -536,8 +560,8 @@ public:
 // DivExpressionASTNode
 class DivExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    DivExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::DIV)
+    DivExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::DIV)
     {
     }
 
@@ -549,8 +573,8 @@ public:
 // ModExpressionASTNode
 class ModExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    ModExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::MOD)
+    ModExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::MOD)
     {
     }
 
@@ -562,8 +586,8 @@ public:
 // EqualExpressionASTNode
 class EqualExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    EqualExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::EQ)
+    EqualExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::EQ)
     {
     }
 
@@ -575,8 +599,8 @@ public:
 // NotEqualExpressionASTNode
 class NotEqualExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    NotEqualExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::NE)
+    NotEqualExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::NE)
     {
     }
 
@@ -588,8 +612,8 @@ public:
 // GreaterThanExpressionASTNode
 class GreaterThanExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    GreaterThanExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::GT)
+    GreaterThanExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::GT)
     {
     }
 
@@ -601,8 +625,8 @@ public:
 // GreaterEqualExpressionASTNode
 class GreaterEqualExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    GreaterEqualExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::GE)
+    GreaterEqualExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::GE)
     {
     }
 
@@ -614,8 +638,8 @@ public:
 // LessThanExpressionASTNode
 class LessThanExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    LessThanExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::LT)
+    LessThanExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::LT)
     {
     }
 
@@ -627,8 +651,8 @@ public:
 // LessEqualExpressionASTNode
 class LessEqualExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    LessEqualExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::LE)
+    LessEqualExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::LE)
     {
     }
 
@@ -640,8 +664,8 @@ public:
 // AndExpressionASTNode
 class AndExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    AndExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::AND)
+    AndExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::AND)
     {
     }
 
@@ -653,8 +677,8 @@ public:
 // OrExpressionASTNode
 class OrExpressionASTNode : public AbstractBinaryExpressionASTNode {
 public:
-    OrExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
-        : AbstractBinaryExpressionASTNode(lineno, colno, last_lineno, last_colno, std::move(left), std::move(right), ASTBinaryOperator::OR)
+    OrExpressionASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+        : AbstractBinaryExpressionASTNode(offset, last_offset, std::move(left), std::move(right), ASTBinaryOperator::OR)
     {
     }
 
@@ -666,9 +690,9 @@ public:
 // InvocationExpressionASTNode
 class InvocationExpressionASTNode : public AbstractPrimaryExpressionASTNode {
 public:
-    InvocationExpressionASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr func_name, AbstractExpressionASTNodePtr arg)
-        : AbstractPrimaryExpressionASTNode(lineno, colno, last_lineno, last_colno)
-        , _func_name(std::move(func_name))
+    InvocationExpressionASTNode(SourceOffset offset, SourceOffset last_offset, StringId func_name, AbstractExpressionASTNodePtr arg)
+        : AbstractPrimaryExpressionASTNode(offset, last_offset)
+        , _func_name(func_name)
         , _args(std::move(arg))
     {
     }
@@ -677,21 +701,23 @@ public:
 
     ASTNodeType get_node_type() override { return ASTNodeType::InvocationExpression; }
 
-    StringPtr &get_func_name() { return _func_name; }
+    const StringPtr &get_func_name() const { return name_of(_func_name); }
+
+    StringId get_func_name_id() const { return _func_name; }
 
     AbstractExpressionASTNodePtr &get_argument() { return _args; }
 
 protected:
 private:
-    StringPtr _func_name;
+    StringId _func_name;
     AbstractExpressionASTNodePtr _args;
 };
 
 // IfStatementASTNode
 class IfStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    IfStatementASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr condition, AbstractEmbeddedStatementASTNodePtr then_branch, AbstractEmbeddedStatementASTNodePtr else_branch)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    IfStatementASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr condition, AbstractEmbeddedStatementASTNodePtr then_branch, AbstractEmbeddedStatementASTNodePtr else_branch)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
         , _condition(std::move(condition))
         , _then_branch(std::move(then_branch))
         , _else_branch(std::move(else_branch))
@@ -718,8 +744,8 @@ private:
 // WhileStatementASTNode
 class WhileStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    WhileStatementASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr condition, AbstractEmbeddedStatementASTNodePtr body)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    WhileStatementASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr condition, AbstractEmbeddedStatementASTNodePtr body)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
         , _condition(std::move(condition))
         , _body(std::move(body))
     {
@@ -742,8 +768,8 @@ private:
 // ForStatementASTNode
 class ForStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    ForStatementASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractStatementASTNodePtr init, AbstractExpressionASTNodePtr condition, AbstractStatementASTNodePtr update, AbstractEmbeddedStatementASTNodePtr body)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    ForStatementASTNode(SourceOffset offset, SourceOffset last_offset, AbstractStatementASTNodePtr init, AbstractExpressionASTNodePtr condition, AbstractStatementASTNodePtr update, AbstractEmbeddedStatementASTNodePtr body)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
         , _init(std::move(init))
         , _condition(std::move(condition))
         , _update(std::move(update))
@@ -776,8 +802,8 @@ private:
 // ReturnStatementASTNode
 class ReturnStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    ReturnStatementASTNode(int lineno, int colno, int last_lineno, int last_colno, AbstractExpressionASTNodePtr expression)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    ReturnStatementASTNode(SourceOffset offset, SourceOffset last_offset, AbstractExpressionASTNodePtr expression)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
         , _expression(std::move(expression))
     {
     }
@@ -795,8 +821,8 @@ private:
 
 class BreakStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    BreakStatementASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    BreakStatementASTNode(SourceOffset offset, SourceOffset last_offset)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
     {
     }
 
@@ -810,8 +836,8 @@ private:
 
 class ContinueStatementASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    ContinueStatementASTNode(int lineno, int colno, int last_lineno, int last_colno)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    ContinueStatementASTNode(SourceOffset offset, SourceOffset last_offset)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
     {
     }
 
@@ -826,8 +852,8 @@ private:
 // StatementBlockASTNode
 class StatementBlockASTNode : public AbstractEmbeddedStatementASTNode {
 public:
-    StatementBlockASTNode(int lineno, int colno, int last_lineno, int last_colno, StatementsVector statements)
-        : AbstractEmbeddedStatementASTNode(lineno, colno, last_lineno, last_colno)
+    StatementBlockASTNode(SourceOffset offset, SourceOffset last_offset, StatementsVector statements)
+        : AbstractEmbeddedStatementASTNode(offset, last_offset)
         , _statements(std::move(statements))
     {
     }
@@ -845,8 +871,8 @@ private:
 
 class SubprocDefinitionASTNode : public AbstractSubroutineASTNode {
 public:
-    SubprocDefinitionASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr name, VariableDeclarationASTNodePtr parameter, StatementBlockASTNodePtr body)
-        : AbstractSubroutineASTNode(lineno, colno, last_lineno, last_colno, name, parameter, body)
+    SubprocDefinitionASTNode(SourceOffset offset, SourceOffset last_offset, StringId name, VariableDeclarationASTNodePtr parameter, StatementBlockASTNodePtr body)
+        : AbstractSubroutineASTNode(offset, last_offset, name, parameter, body)
     {
     }
 
@@ -860,8 +886,8 @@ private:
 
 class FunctionDefinitionASTNode : public AbstractSubroutineASTNode {
 public:
-    FunctionDefinitionASTNode(int lineno, int colno, int last_lineno, int last_colno, StringPtr name, VariableDeclarationASTNodePtr parameter, StatementBlockASTNodePtr body)
-        : AbstractSubroutineASTNode(lineno, colno, last_lineno, last_colno, name, parameter, body)
+    FunctionDefinitionASTNode(SourceOffset offset, SourceOffset last_offset, StringId name, VariableDeclarationASTNodePtr parameter, StatementBlockASTNodePtr body)
+        : AbstractSubroutineASTNode(offset, last_offset, name, parameter, body)
     {
     }
 
@@ -876,13 +902,13 @@ private:
 // CompilationUnitASTNode
 class CompilationUnitASTNode : public ASTNode {
 public:
-    CompilationUnitASTNode(int lineno, int colno, int last_lineno, int last_colno,
+    CompilationUnitASTNode(SourceOffset offset, SourceOffset last_offset,
         std::vector<StringPtr> imports,
         std::vector<FloorBoxInitStatementASTNodePtr> floor_inits,
         std::optional<int> floor_max,
         std::vector<VariableDeclarationASTNodePtr> var_decls,
         std::vector<AbstractSubroutineASTNodePtr> subroutines)
-        : ASTNode(lineno, colno, last_lineno, last_colno)
+        : ASTNode(offset, last_offset)
         , _imports(std::move(imports))
         , _floor_inits(std::move(floor_inits))
         , _floor_max(floor_max)
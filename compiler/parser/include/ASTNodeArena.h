@@ -0,0 +1,160 @@
+#ifndef ASTNODEARENA_H
+#define ASTNODEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ASTNode.h"
+#include "ASTNodeAttributeTable.h"
+#include "ASTNodeForward.h"
+#include "SourceFile.h"
+#include "StringInterner.h"
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+/**
+ * @brief Allocates the AST nodes of a compilation, and numbers them with dense ids from 0.
+ *
+ * The nodes are carved from a monotonic buffer, so nothing is freed one by one. Every node keeps the arena alive
+ * through its allocator, and the buffer goes away in one release after the last node. The side tables of a pass are
+ * ASTNodeSideTable, indexed by ASTNode::node_id().
+ *
+ * The arena also holds the node attributes, one ASTNodeAttributeTable per attribute id, and shares the interner of
+ * the names with the tokens.
+ */
+class ASTNodeArena : public std::enable_shared_from_this<ASTNodeArena> {
+public:
+    // The positions of the nodes are offsets into \p source, and the names are ids in \p strings
+    static ASTNodeArenaPtr create(SourceFilePtr source, StringInternerPtr strings)
+    {
+        return ASTNodeArenaPtr(new ASTNodeArena(std::move(source), std::move(strings)));
+    }
+
+    ASTNodeArena(const ASTNodeArena &) = delete;
+    ASTNodeArena &operator=(const ASTNodeArena &) = delete;
+
+    ~ASTNodeArena() = default;
+
+    template <typename T, typename... Args>
+        requires std::is_base_of_v<ASTNode, T>
+    std::shared_ptr<T> make(Args &&...args)
+    {
+        std::shared_ptr<T> node = std::allocate_shared<T>(Allocator<T>(shared_from_this()), std::forward<Args>(args)...);
+        std::lock_guard lock(_mutex);
+        node->_node_id = _node_count++;
+        node->_arena = this;
+        return node;
+    }
+
+    const SourceFilePtr &source() const { return _source; }
+
+    const StringInternerPtr &strings() const { return _strings; }
+
+    // The ids given out are [0, node_count())
+    std::size_t node_count()
+    {
+        std::lock_guard lock(_mutex);
+        return _node_count;
+    }
+
+    // The table of attribute T, created on first use. Every type of attribute must have an id of its own.
+    template <typename T>
+    ASTNodeAttributeTable<T> &attribute_table()
+    {
+        int attribute_id = T::get_attribute_id();
+        std::lock_guard lock(_mutex);
+        if (static_cast<std::size_t>(attribute_id) >= _attribute_tables.size()) {
+            _attribute_tables.resize(attribute_id + 1);
+        }
+        auto &table = _attribute_tables[attribute_id];
+        if (!table) {
+            table = std::make_unique<ASTNodeAttributeTable<T>>();
+        }
+        return static_cast<ASTNodeAttributeTable<T> &>(*table);
+    }
+
+    // The table of the attribute id, or nullptr if no node ever had it
+    AbstractASTNodeAttributeTable *find_attribute_table(int attribute_id)
+    {
+        std::lock_guard lock(_mutex);
+        if (attribute_id < 0 || static_cast<std::size_t>(attribute_id) >= _attribute_tables.size()) {
+            return nullptr;
+        }
+        return _attribute_tables[attribute_id].get();
+    }
+
+    void copy_attributes(std::size_t from_node_id, std::size_t to_node_id)
+    {
+        std::lock_guard lock(_mutex);
+        for (auto &table : _attribute_tables) {
+            if (table) {
+                table->copy(from_node_id, to_node_id);
+            }
+        }
+    }
+
+private:
+    ASTNodeArena(SourceFilePtr source, StringInternerPtr strings)
+        : _source(std::move(source))
+        , _strings(std::move(strings))
+    {
+    }
+
+    template <typename T>
+    class Allocator {
+    public:
+        using value_type = T;
+
+        explicit Allocator(ASTNodeArenaPtr arena)
+            : _arena(std::move(arena))
+        {
+        }
+
+        template <typename U>
+        Allocator(const Allocator<U> &other)
+            : _arena(other._arena)
+        {
+        }
+
+        T *allocate(std::size_t n)
+        {
+            std::lock_guard lock(_arena->_mutex);
+            return static_cast<T *>(_arena->_buffer.allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *, std::size_t)
+        {
+            // released with the arena
+        }
+
+        template <typename U>
+        bool operator==(const Allocator<U> &other) const
+        {
+            return _arena == other._arena;
+        }
+
+    private:
+        template <typename U>
+        friend class Allocator;
+
+        ASTNodeArenaPtr _arena;
+    };
+
+    SourceFilePtr _source;
+    StringInternerPtr _strings;
+    std::mutex _mutex;
+    std::pmr::monotonic_buffer_resource _buffer;
+    std::size_t _node_count = 0;
+    // indexed by attribute id
+    std::vector<std::unique_ptr<AbstractASTNodeAttributeTable>> _attribute_tables;
+};
+
+CLOSE_PARSER_NAMESPACE
+
+#endif
@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "ASTNode.h"
+#include "ASTNodeArena.h"
 #include "parser_global.h"
 
 OPEN_PARSER_NAMESPACE
@@ -40,6 +41,7 @@ concept HasASTNodeGetAttributeId = requires {
     } -> std::same_as<int>;
 };
 
+// The typed access to the attribute table of T in the arena of the node
 template <typename T>
 class GetSetAttribute {
 public:
@@ -47,23 +49,23 @@ public:
         requires HasASTNodeGetAttributeId<T>
     static std::shared_ptr<T> get_from(const ASTNodePtrT &node)
     {
-        std::shared_ptr<ASTNodeAttribute> result;
-        node->get_attribute(static_cast<T *>(nullptr)->get_attribute_id(), result);
-        return std::static_pointer_cast<T>(result);
+        return node->get_arena()->template attribute_table<T>().get(node->node_id());
     }
 
     template <typename ASTNodePtrT = ASTNodePtr>
         requires HasASTNodeGetAttributeId<T>
     static void set_to(const ASTNodePtrT &node, const std::shared_ptr<T> &attr)
     {
-        node->set_attribute(static_cast<T *>(nullptr)->get_attribute_id(), attr);
+        if (attr) {
+            node->get_arena()->template attribute_table<T>().set(node->node_id(), attr);
+        }
     }
 
     template <typename ASTNodePtrT = ASTNodePtr>
         requires HasASTNodeGetAttributeId<T> && std::is_base_of_v<ASTNodeAttribute, T>
     void set_to(const ASTNodePtrT &node)
     {
-        node->set_attribute(static_cast<T *>(nullptr)->get_attribute_id(), static_cast<T *>(this)->shared_from_this());
+        set_to(node, std::static_pointer_cast<T>(static_cast<T *>(this)->shared_from_this()));
     }
 };
 
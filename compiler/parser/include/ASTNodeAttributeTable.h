@@ -0,0 +1,92 @@
+#ifndef ASTNODEATTRIBUTETABLE_H
+#define ASTNODEATTRIBUTETABLE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+class ASTNodeAttribute;
+using ASTNodeAttributePtr = std::shared_ptr<ASTNodeAttribute>;
+
+/**
+ * @brief The attributes of one kind for all nodes of an ASTNodeArena, indexed by ASTNode::node_id().
+ *
+ * The untyped interface is for the passes that handle attributes by their id, like StripAttributePass and
+ * ASTNodeGraphvizBuilder.
+ */
+class AbstractASTNodeAttributeTable {
+public:
+    virtual ~AbstractASTNodeAttributeTable() = default;
+
+    virtual ASTNodeAttributePtr get_attribute(std::size_t node_id) const = 0;
+    virtual void remove(std::size_t node_id) = 0;
+    virtual void copy(std::size_t from_node_id, std::size_t to_node_id) = 0;
+    // Remove the attribute from every node
+    virtual void clear() = 0;
+};
+
+/**
+ * @brief The attributes of type T. An entry is valid only if it's set in the current generation, so clear() is a
+ * bump of the generation. The stale values are dropped when they're overwritten or with the arena.
+ */
+template <typename T>
+class ASTNodeAttributeTable : public AbstractASTNodeAttributeTable {
+public:
+    ASTNodeAttributeTable() = default;
+    ~ASTNodeAttributeTable() override = default;
+
+    std::shared_ptr<T> get(std::size_t node_id) const
+    {
+        if (node_id < _entries.size() && _entries[node_id].generation == _generation) {
+            return _entries[node_id].value;
+        }
+        return nullptr;
+    }
+
+    void set(std::size_t node_id, std::shared_ptr<T> value)
+    {
+        if (node_id >= _entries.size()) {
+            _entries.resize(node_id + 1);
+        }
+        _entries[node_id] = Entry { .value = std::move(value), .generation = _generation };
+    }
+
+    ASTNodeAttributePtr get_attribute(std::size_t node_id) const override { return get(node_id); }
+
+    void remove(std::size_t node_id) override
+    {
+        if (node_id < _entries.size()) {
+            _entries[node_id] = Entry();
+        }
+    }
+
+    void copy(std::size_t from_node_id, std::size_t to_node_id) override
+    {
+        std::shared_ptr<T> value = get(from_node_id);
+        if (value) {
+            set(to_node_id, std::move(value));
+        } else {
+            remove(to_node_id);
+        }
+    }
+
+    void clear() override { ++_generation; }
+
+private:
+    struct Entry {
+        std::shared_ptr<T> value;
+        // 0 is never a current generation
+        unsigned int generation = 0;
+    };
+
+    std::vector<Entry> _entries;
+    unsigned int _generation = 1;
+};
+
+CLOSE_PARSER_NAMESPACE
+
+#endif
@@ -64,6 +64,8 @@ class FunctionDefinitionASTNode;
 
 class CompilationUnitASTNode;
 
+class ASTNodeArena;
+
 using ASTNodePtr = std::shared_ptr<ASTNode>;
 using IntegerASTNodePtr = std::shared_ptr<IntegerASTNode>;
 using BooleanASTNodePtr = std::shared_ptr<BooleanASTNode>;
@@ -121,6 +123,8 @@ using FunctionDefinitionASTNodePtr = std::shared_ptr<FunctionDefinitionASTNode>;
 
 using CompilationUnitASTNodePtr = std::shared_ptr<CompilationUnitASTNode>;
 
+using ASTNodeArenaPtr = std::shared_ptr<ASTNodeArena>;
+
 CLOSE_PARSER_NAMESPACE
 
 #endif
\ No newline at end of file
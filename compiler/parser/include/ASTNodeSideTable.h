@@ -0,0 +1,56 @@
+#ifndef ASTNODESIDETABLE_H
+#define ASTNODESIDETABLE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "ASTNode.h"
+#include "ASTNodeArena.h"
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+/**
+ * @brief A value of type T for every node of an ASTNodeArena, indexed by ASTNode::node_id().
+ *
+ * This is the private side table of a pass. Unlike the attributes, it's not kept by the arena. It's sized to the
+ * arena on reset(), and grows on demand for the nodes created after that.
+ */
+template <typename T>
+class ASTNodeSideTable {
+public:
+    ASTNodeSideTable() = default;
+    ~ASTNodeSideTable() = default;
+
+    // Drop all values, and make room for every node of \p arena
+    void reset(ASTNodeArena &arena)
+    {
+        _values.assign(arena.node_count(), T());
+    }
+
+    // The value of \p node, default constructed if it's never set. The node must be allocated from an arena.
+    T &operator[](const ASTNode &node)
+    {
+        std::size_t id = node.node_id();
+        if (id == ASTNode::NO_NODE_ID) {
+            spdlog::critical("AST node at {}:{} is not allocated from the arena. {}", node.lineno(), node.colno(), __PRETTY_FUNCTION__);
+            throw;
+        }
+
+        if (id >= _values.size()) {
+            _values.resize(id + 1);
+        }
+        return _values[id];
+    }
+
+    T &operator[](const ASTNodePtr &node) { return (*this)[*node]; }
+
+private:
+    std::vector<T> _values;
+};
+
+CLOSE_PARSER_NAMESPACE
+
+#endif
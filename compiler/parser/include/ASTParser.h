@@ -0,0 +1,74 @@
+#ifndef AST_PARSER_H
+#define AST_PARSER_H
+
+#include <string>
+
+#include "ASTNodeArena.h"
+#include "ASTNodeForward.h"
+#include "AbstractParser.h"
+#include "HRLToken.h"
+#include "lexer_global.h"
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+/**
+ * @brief Parses HRL straight into the AST, without the parse tree.
+ *
+ * It follows RecursiveDescentParser rule by rule and reports the same errors, and it builds the nodes ASTBuilder
+ * would build from the parse tree. Use it when neither the formatter nor the parse tree graph is wanted.
+ */
+class ASTParser : public AbstractParser {
+public:
+    explicit ASTParser(const std::string &filename, const lexer::TokenBuffer &tokens)
+        : AbstractParser(filename, tokens)
+        , _arena(ASTNodeArena::create(tokens.source(), tokens.strings())) {};
+
+    virtual ~ASTParser() = default;
+
+    virtual bool parse(CompilationUnitASTNodePtr &result);
+
+protected:
+    ASTNodeArenaPtr _arena;
+
+    [[nodiscard]] bool parse_compilation_unit(CompilationUnitASTNodePtr &node);
+    [[nodiscard]] bool parse_import_directive(StringPtr &node);
+    [[nodiscard]] bool parse_floor_box_init_statement(FloorBoxInitStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_floor_max_statement(int &node);
+    [[nodiscard]] bool parse_function_definition(FunctionDefinitionASTNodePtr &node);
+    [[nodiscard]] bool parse_subproc_definition(SubprocDefinitionASTNodePtr &node);
+    [[nodiscard]] bool parse_statement_block(StatementBlockASTNodePtr &node);
+    [[nodiscard]] bool parse_statement(AbstractStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_variable_declaration_statement(VariableDeclarationASTNodePtr &node);
+    [[nodiscard]] bool parse_variable_declaration(VariableDeclarationASTNodePtr &node);
+    [[nodiscard]] bool parse_floor_assignment_statement(FloorAssignmentASTNodePtr &node);
+    [[nodiscard]] bool parse_floor_assignment(FloorAssignmentASTNodePtr &node);
+    [[nodiscard]] bool parse_floor_access(FloorAccessASTNodePtr &node);
+    [[nodiscard]] bool parse_variable_assignment_statement(VariableAssignmentASTNodePtr &node);
+    [[nodiscard]] bool parse_variable_assignment(VariableAssignmentASTNodePtr &node);
+    [[nodiscard]] bool parse_invocation_statement(InvocationExpressionASTNodePtr &node);
+    [[nodiscard]] bool parse_embedded_statement(AbstractEmbeddedStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_if_statement(IfStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_while_statement(WhileStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_for_statement(ForStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_return_statement(ReturnStatementASTNodePtr &node);
+    [[nodiscard]] bool parse_empty_statement(EmptyStatementASTNodePtr &node);
+
+    [[nodiscard]] bool parse_expression(AbstractExpressionASTNodePtr &node);
+    // The positive expression and the parenthesized expression have no node of their own
+    [[nodiscard]] bool parse_unary_expression(AbstractExpressionASTNodePtr &node);
+    [[nodiscard]] bool parse_primary_expression(AbstractExpressionASTNodePtr &node);
+    [[nodiscard]] bool parse_invocation_expression(InvocationExpressionASTNodePtr &node);
+    [[nodiscard]] bool parse_parenthesized_expression(AbstractExpressionASTNodePtr &node);
+
+    [[nodiscard]] bool parse_precedence_climbing(AbstractExpressionASTNodePtr &result, AbstractExpressionASTNodePtr lhs, int min_precedence);
+
+    // The literals and the parameters end after their tokens
+    IntegerASTNodePtr make_literal_node(const lexer::TokenRef &token);
+    VariableDeclarationASTNodePtr make_parameter_node(const lexer::TokenRef &token);
+    AbstractExpressionASTNodePtr make_binary_expression(const lexer::TokenRef &op, SourceOffset offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right);
+};
+
+CLOSE_PARSER_NAMESPACE
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef ABSTRACT_PARSER_H
+#define ABSTRACT_PARSER_H
+
+#include <cstddef>
+#include <list>
+#include <string>
+
+#include "ErrorMessage.h"
+#include "lexer_global.h"
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+/**
+ * @brief The token stream and the error list the recursive descent parsers share, used by the macros in
+ * RecursiveDescentParser.Common.h.
+ */
+class AbstractParser {
+public:
+    virtual ~AbstractParser() = default;
+
+protected:
+    AbstractParser(const std::string &filename, const lexer::TokenBuffer &tokens)
+        : _tokens(tokens)
+        , _filename(filename)
+    {
+    }
+
+    const lexer::TokenBuffer &_tokens;
+    std::size_t _token_pointer = 0;
+
+    std::list<CompilerMessage> _errors;
+
+    [[nodiscard]] lexer::TokenRef lookahead(std::size_t distance = 0) const;
+    void consume();
+
+    void push_error(const std::string &expect, const lexer::TokenRef &got, int lineno = -1, int colno = -1, std::size_t width = 0);
+    void push_error(int errid, const std::string &message, int lineno, int colno, std::size_t width);
+    void pop_error();
+    void pop_error_till(std::list<CompilerMessage>::iterator till_exclusive);
+    void report_errors();
+
+private:
+    std::string _filename;
+};
+
+CLOSE_PARSER_NAMESPACE
+
+#endif
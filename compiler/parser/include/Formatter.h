@@ -4,6 +4,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "HRLToken.h"
@@ -19,7 +20,7 @@ OPEN_PARSER_NAMESPACE
 
 // it's either newline or comments
 struct CommentGroup {
-    std::vector<StringPtr> comments;
+    std::vector<std::string_view> comments;
     bool is_newline = false;
 };
 
@@ -97,12 +98,12 @@ protected:
     std::vector<FormatterLine> _lines;
     int _indent_level = 0;
 
-    std::string strip_comment(StringPtr comment);
-    std::string get_text_from_token(lexer::TokenPtr token);
+    std::string strip_comment(std::string_view comment);
+    std::string get_text_from_token(const lexer::TokenRef &token);
 
     virtual void create_line();
-    virtual void create_line(lexer::TokenPtr token, bool add_space_after);
-    virtual void append_line(lexer::TokenPtr token, bool add_space_before, bool add_space_after);
+    virtual void create_line(const lexer::TokenRef &token, bool add_space_after);
+    virtual void append_line(const lexer::TokenRef &token, bool add_space_before, bool add_space_after);
     virtual void create_line(const CommentGroup &comment_group);
 
     /**
@@ -111,7 +112,7 @@ protected:
      * @return true There are comments added
      * @return false There is no comments
      */
-    virtual bool process_preceding_metadata(lexer::TokenPtr token);
+    virtual bool process_preceding_metadata(const lexer::TokenRef &token);
 
     virtual void traverse_import_directives(const std::vector<ImportDirectivePTNodePtr> &imports);
     virtual void traverse_floor_inits(const std::vector<FloorBoxInitStatementPTNodePtr> &floor_inits);
@@ -73,9 +73,9 @@ public:
 // Terminal Nodes
 class IdentifierPTNode : public AbstractPrimaryExpressionPTNode {
 public:
-    explicit IdentifierPTNode(const lexer::IdentifierTokenPtr &token)
-        : AbstractPrimaryExpressionPTNode(token->lineno(), token->colno())
-        , _name(token->get_value())
+    explicit IdentifierPTNode(const lexer::TokenRef &token)
+        : AbstractPrimaryExpressionPTNode(token.lineno(), token.colno())
+        , _name(token.get_identifier_name())
         , _token(token)
     {
     }
@@ -86,19 +86,21 @@ public:
 
     StringPtr get_value() const { return _name; }
 
-    lexer::TokenPtr get_token() const { return _token; }
+    StringId get_value_id() const { return _token.get_identifier_id(); }
+
+    lexer::TokenRef get_token() const { return _token; }
 
 private:
     StringPtr _name;
-    lexer::TokenPtr _token;
+    lexer::TokenRef _token;
 };
 
 class IntegerLiteralPTNode : public AbstractPrimaryExpressionPTNode {
 public:
-    explicit IntegerLiteralPTNode(const lexer::IntegerTokenPtr &token)
-        : AbstractPrimaryExpressionPTNode(token->lineno(), token->colno())
-        , _value(token->get_value())
-        , _is_char(token->get_is_char())
+    explicit IntegerLiteralPTNode(const lexer::TokenRef &token)
+        : AbstractPrimaryExpressionPTNode(token.lineno(), token.colno())
+        , _value(token.get_integer())
+        , _is_char(token.get_is_char())
         , _token(token)
     {
     }
@@ -111,19 +113,19 @@ public:
 
     int get_is_char() const { return _is_char; }
 
-    lexer::TokenPtr get_token() const { return _token; }
+    lexer::TokenRef get_token() const { return _token; }
 
 private:
     int _value;
     bool _is_char;
-    lexer::TokenPtr _token;
+    lexer::TokenRef _token;
 };
 
 class BooleanLiteralPTNode : public AbstractPrimaryExpressionPTNode {
 public:
-    explicit BooleanLiteralPTNode(const lexer::BooleanTokenPtr &token)
-        : AbstractPrimaryExpressionPTNode(token->lineno(), token->colno())
-        , _value(token->get_value())
+    explicit BooleanLiteralPTNode(const lexer::TokenRef &token)
+        : AbstractPrimaryExpressionPTNode(token.lineno(), token.colno())
+        , _value(token.get_boolean())
         , _token(token)
     {
     }
@@ -134,18 +136,18 @@ public:
 
     bool get_value() const { return _value; }
 
-    lexer::TokenPtr get_token() const { return _token; }
+    lexer::TokenRef get_token() const { return _token; }
 
 private:
     bool _value;
-    lexer::TokenPtr _token;
+    lexer::TokenRef _token;
 };
 
 class BinaryOperatorPTNode : public ParseTreeNode {
 public:
-    explicit BinaryOperatorPTNode(const lexer::TokenPtr &token)
-        : ParseTreeNode(token->lineno(), token->colno())
-        , _op(get_binary_operator_from_token_id(token->token_id()))
+    explicit BinaryOperatorPTNode(const lexer::TokenRef &token)
+        : ParseTreeNode(token.lineno(), token.colno())
+        , _op(get_binary_operator_from_token_id(token.token_id()))
         , _token(token)
     {
     }
@@ -326,17 +328,17 @@ public:
 
     BinaryOperator get_op() const { return _op; }
 
-    lexer::TokenPtr get_token() const { return _token; }
+    lexer::TokenRef get_token() const { return _token; }
 
 private:
     BinaryOperator _op;
-    lexer::TokenPtr _token;
+    lexer::TokenRef _token;
 };
 
 // Variable and Function Nodes
 class VariableDeclarationPTNode : public ParseTreeNode {
 public:
-    VariableDeclarationPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, AbstractExpressionPTNodePtr expr, lexer::TokenPtr let_token, lexer::TokenPtr equals)
+    VariableDeclarationPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, AbstractExpressionPTNodePtr expr, lexer::TokenRef let_token, lexer::TokenRef equals)
         : ParseTreeNode(lineno, colno)
         , _var_name(std::move(var_name))
         , _expr(std::move(expr))
@@ -354,20 +356,20 @@ public:
     // the optional equals part
     AbstractExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_let_token() const { return _let_token; }
+    lexer::TokenRef get_let_token() const { return _let_token; }
 
-    lexer::TokenPtr get_equals() const { return _equals; }
+    lexer::TokenRef get_equals() const { return _equals; }
 
 private:
     IdentifierPTNodePtr _var_name;
     AbstractExpressionPTNodePtr _expr;
-    lexer::TokenPtr _let_token;
-    lexer::TokenPtr _equals;
+    lexer::TokenRef _let_token;
+    lexer::TokenRef _equals;
 };
 
 class VariableAssignmentPTNode : public ParseTreeNode {
 public:
-    VariableAssignmentPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, AbstractExpressionPTNodePtr expr, lexer::TokenPtr eq)
+    VariableAssignmentPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, AbstractExpressionPTNodePtr expr, lexer::TokenRef eq)
         : ParseTreeNode(lineno, colno)
         , _var_name(std::move(var_name))
         , _expr(std::move(expr))
@@ -383,17 +385,17 @@ public:
 
     AbstractExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_eq() const { return _eq; }
+    lexer::TokenRef get_eq() const { return _eq; }
 
 private:
     IdentifierPTNodePtr _var_name;
     AbstractExpressionPTNodePtr _expr;
-    lexer::TokenPtr _eq;
+    lexer::TokenRef _eq;
 };
 
 class FloorAssignmentPTNode : public ParseTreeNode {
 public:
-    FloorAssignmentPTNode(int lineno, int colno, FloorAccessPTNodePtr floor_access, AbstractExpressionPTNodePtr expr, lexer::TokenPtr eq)
+    FloorAssignmentPTNode(int lineno, int colno, FloorAccessPTNodePtr floor_access, AbstractExpressionPTNodePtr expr, lexer::TokenRef eq)
         : ParseTreeNode(lineno, colno)
         , _floor_access(std::move(floor_access))
         , _expr(std::move(expr))
@@ -409,12 +411,12 @@ public:
 
     AbstractExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_eq() const { return _eq; }
+    lexer::TokenRef get_eq() const { return _eq; }
 
 private:
     FloorAccessPTNodePtr _floor_access;
     AbstractExpressionPTNodePtr _expr;
-    lexer::TokenPtr _eq;
+    lexer::TokenRef _eq;
 };
 
 // Expression Nodes
@@ -446,7 +448,7 @@ private:
 
 class NotExpressionPTNode : public AbstractUnaryExpressionPTNode {
 public:
-    NotExpressionPTNode(int lineno, int colno, AbstractPrimaryExpressionPTNodePtr expr, lexer::TokenPtr not_token)
+    NotExpressionPTNode(int lineno, int colno, AbstractPrimaryExpressionPTNodePtr expr, lexer::TokenRef not_token)
         : AbstractUnaryExpressionPTNode(lineno, colno)
         , _expr(std::move(expr))
         , _not_token(std::move(not_token))
@@ -459,16 +461,16 @@ public:
 
     AbstractPrimaryExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_not() const { return _not_token; }
+    lexer::TokenRef get_not() const { return _not_token; }
 
 private:
     AbstractPrimaryExpressionPTNodePtr _expr;
-    lexer::TokenPtr _not_token;
+    lexer::TokenRef _not_token;
 };
 
 class PositiveExpressionPTNode : public AbstractUnaryExpressionPTNode {
 public:
-    PositiveExpressionPTNode(int lineno, int colno, AbstractPrimaryExpressionPTNodePtr expr, lexer::TokenPtr plus_token)
+    PositiveExpressionPTNode(int lineno, int colno, AbstractPrimaryExpressionPTNodePtr expr, lexer::TokenRef plus_token)
         : AbstractUnaryExpressionPTNode(lineno, colno)
         , _expr(std::move(expr))
         , _plus_token(std::move(plus_token))
@@ -481,16 +483,16 @@ public:
 
     AbstractPrimaryExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_plus_token() { return _plus_token; }
+    lexer::TokenRef get_plus_token() { return _plus_token; }
 
 private:
     AbstractPrimaryExpressionPTNodePtr _expr;
-    lexer::TokenPtr _plus_token;
+    lexer::TokenRef _plus_token;
 };
 
 class NegativeExpressionPTNode : public AbstractUnaryExpressionPTNode {
 public:
-    NegativeExpressionPTNode(int lineno, int colno, AbstractPrimaryExpressionPTNodePtr expr, lexer::TokenPtr minus_token)
+    NegativeExpressionPTNode(int lineno, int colno, AbstractPrimaryExpressionPTNodePtr expr, lexer::TokenRef minus_token)
         : AbstractUnaryExpressionPTNode(lineno, colno)
         , _expr(std::move(expr))
         , _minus_token(std::move(minus_token))
@@ -503,16 +505,16 @@ public:
 
     AbstractPrimaryExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_minus_token() const { return _minus_token; }
+    lexer::TokenRef get_minus_token() const { return _minus_token; }
 
 private:
     AbstractPrimaryExpressionPTNodePtr _expr;
-    lexer::TokenPtr _minus_token;
+    lexer::TokenRef _minus_token;
 };
 
 class IncrementExpressionPTNode : public AbstractUnaryExpressionPTNode {
 public:
-    IncrementExpressionPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, lexer::TokenPtr increment_token)
+    IncrementExpressionPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, lexer::TokenRef increment_token)
         : AbstractUnaryExpressionPTNode(lineno, colno)
         , _var_name(std::move(var_name))
         , _increment_token(std::move(increment_token))
@@ -525,16 +527,16 @@ public:
 
     IdentifierPTNodePtr get_var_name() const { return _var_name; }
 
-    lexer::TokenPtr get_increment_token() const { return _increment_token; }
+    lexer::TokenRef get_increment_token() const { return _increment_token; }
 
 private:
     IdentifierPTNodePtr _var_name;
-    lexer::TokenPtr _increment_token;
+    lexer::TokenRef _increment_token;
 };
 
 class DecrementExpressionPTNode : public AbstractUnaryExpressionPTNode {
 public:
-    DecrementExpressionPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, lexer::TokenPtr decrement_token)
+    DecrementExpressionPTNode(int lineno, int colno, IdentifierPTNodePtr var_name, lexer::TokenRef decrement_token)
         : AbstractUnaryExpressionPTNode(lineno, colno)
         , _var_name(std::move(var_name))
         , _decrement_token(std::move(decrement_token))
@@ -547,16 +549,16 @@ public:
 
     IdentifierPTNodePtr get_var_name() const { return _var_name; }
 
-    lexer::TokenPtr get_decrement_token() const { return _decrement_token; }
+    lexer::TokenRef get_decrement_token() const { return _decrement_token; }
 
 private:
     IdentifierPTNodePtr _var_name;
-    lexer::TokenPtr _decrement_token;
+    lexer::TokenRef _decrement_token;
 };
 
 class FloorAccessPTNode : public AbstractPrimaryExpressionPTNode {
 public:
-    FloorAccessPTNode(int lineno, int colno, AbstractExpressionPTNodePtr index_expr, lexer::TokenPtr floor, lexer::TokenPtr open_bracket, lexer::TokenPtr close_bracket)
+    FloorAccessPTNode(int lineno, int colno, AbstractExpressionPTNodePtr index_expr, lexer::TokenRef floor, lexer::TokenRef open_bracket, lexer::TokenRef close_bracket)
         : AbstractPrimaryExpressionPTNode(lineno, colno)
         , _index_expr(std::move(index_expr))
         , _floor(std::move(floor))
@@ -571,22 +573,22 @@ public:
 
     AbstractExpressionPTNodePtr get_index_expr() const { return _index_expr; }
 
-    lexer::TokenPtr get_floor() const { return _floor; }
+    lexer::TokenRef get_floor() const { return _floor; }
 
-    lexer::TokenPtr get_open_bracket() const { return _open_bracket; }
+    lexer::TokenRef get_open_bracket() const { return _open_bracket; }
 
-    lexer::TokenPtr get_close_bracket() const { return _close_bracket; }
+    lexer::TokenRef get_close_bracket() const { return _close_bracket; }
 
 private:
     AbstractExpressionPTNodePtr _index_expr;
-    lexer::TokenPtr _floor;
-    lexer::TokenPtr _open_bracket;
-    lexer::TokenPtr _close_bracket;
+    lexer::TokenRef _floor;
+    lexer::TokenRef _open_bracket;
+    lexer::TokenRef _close_bracket;
 };
 
 class ParenthesizedExpressionPTNode : public AbstractPrimaryExpressionPTNode {
 public:
-    ParenthesizedExpressionPTNode(int lineno, int colno, AbstractExpressionPTNodePtr expr, lexer::TokenPtr open_paren, lexer::TokenPtr close_paren)
+    ParenthesizedExpressionPTNode(int lineno, int colno, AbstractExpressionPTNodePtr expr, lexer::TokenRef open_paren, lexer::TokenRef close_paren)
         : AbstractPrimaryExpressionPTNode(lineno, colno)
         , _expr(std::move(expr))
         , _open_paren(std::move(open_paren))
@@ -600,19 +602,19 @@ public:
 
     AbstractExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_open_paren() const { return _open_paren; }
+    lexer::TokenRef get_open_paren() const { return _open_paren; }
 
-    lexer::TokenPtr get_close_paren() const { return _close_paren; }
+    lexer::TokenRef get_close_paren() const { return _close_paren; }
 
 private:
     AbstractExpressionPTNodePtr _expr;
-    lexer::TokenPtr _open_paren;
-    lexer::TokenPtr _close_paren;
+    lexer::TokenRef _open_paren;
+    lexer::TokenRef _close_paren;
 };
 
 class InvocationExpressionPTNode : public AbstractPrimaryExpressionPTNode {
 public:
-    InvocationExpressionPTNode(int lineno, int colno, IdentifierPTNodePtr func_name, AbstractExpressionPTNodePtr arg, lexer::TokenPtr open_paren, lexer::TokenPtr close_paren)
+    InvocationExpressionPTNode(int lineno, int colno, IdentifierPTNodePtr func_name, AbstractExpressionPTNodePtr arg, lexer::TokenRef open_paren, lexer::TokenRef close_paren)
         : AbstractPrimaryExpressionPTNode(lineno, colno)
         , _func_name(std::move(func_name))
         , _arg(std::move(arg))
@@ -629,15 +631,15 @@ public:
 
     AbstractExpressionPTNodePtr get_arg() const { return _arg; }
 
-    lexer::TokenPtr get_open_paren() const { return _open_paren; }
+    lexer::TokenRef get_open_paren() const { return _open_paren; }
 
-    lexer::TokenPtr get_close_paren() const { return _close_paren; }
+    lexer::TokenRef get_close_paren() const { return _close_paren; }
 
 private:
     IdentifierPTNodePtr _func_name;
     AbstractExpressionPTNodePtr _arg;
-    lexer::TokenPtr _open_paren;
-    lexer::TokenPtr _close_paren;
+    lexer::TokenRef _open_paren;
+    lexer::TokenRef _close_paren;
 };
 
 // Statement Nodes
@@ -676,7 +678,7 @@ public:
 class IfStatementPTNode : public AbstractSelectionStatementPTNode {
 public:
     IfStatementPTNode(int lineno, int colno, AbstractExpressionPTNodePtr condition, AbstractEmbeddedStatementPTNodePtr then_stmt, AbstractEmbeddedStatementPTNodePtr else_stmt,
-        lexer::TokenPtr if_token, lexer::TokenPtr cond_open_paren, lexer::TokenPtr cond_close_paren, lexer::TokenPtr else_token)
+        lexer::TokenRef if_token, lexer::TokenRef cond_open_paren, lexer::TokenRef cond_close_paren, lexer::TokenRef else_token)
         : AbstractSelectionStatementPTNode(lineno, colno)
         , _condition(std::move(condition))
         , _then_stmt(std::move(then_stmt))
@@ -698,29 +700,29 @@ public:
 
     AbstractEmbeddedStatementPTNodePtr get_else_stmt() const { return _else_stmt; }
 
-    lexer::TokenPtr get_if_token() const { return _if_token; }
+    lexer::TokenRef get_if_token() const { return _if_token; }
 
-    lexer::TokenPtr get_cond_open_paren() const { return _cond_open_paren; }
+    lexer::TokenRef get_cond_open_paren() const { return _cond_open_paren; }
 
-    lexer::TokenPtr get_cond_close_paren() const { return _cond_close_paren; }
+    lexer::TokenRef get_cond_close_paren() const { return _cond_close_paren; }
 
-    lexer::TokenPtr get_else_token() const { return _else_token; }
+    lexer::TokenRef get_else_token() const { return _else_token; }
 
 private:
     AbstractExpressionPTNodePtr _condition;
     AbstractEmbeddedStatementPTNodePtr _then_stmt;
     AbstractEmbeddedStatementPTNodePtr _else_stmt;
 
-    lexer::TokenPtr _if_token;
-    lexer::TokenPtr _cond_open_paren;
-    lexer::TokenPtr _cond_close_paren;
-    lexer::TokenPtr _else_token;
+    lexer::TokenRef _if_token;
+    lexer::TokenRef _cond_open_paren;
+    lexer::TokenRef _cond_close_paren;
+    lexer::TokenRef _else_token;
 };
 
 class WhileStatementPTNode : public AbstractIterationStatementPTNode {
 public:
     WhileStatementPTNode(int lineno, int colno, AbstractExpressionPTNodePtr condition, AbstractEmbeddedStatementPTNodePtr body,
-        lexer::TokenPtr while_token, lexer::TokenPtr while_open_paren, lexer::TokenPtr while_close_paren)
+        lexer::TokenRef while_token, lexer::TokenRef while_open_paren, lexer::TokenRef while_close_paren)
         : AbstractIterationStatementPTNode(lineno, colno)
         , _condition(std::move(condition))
         , _body(std::move(body))
@@ -738,18 +740,18 @@ public:
 
     AbstractEmbeddedStatementPTNodePtr get_body() const { return _body; }
 
-    lexer::TokenPtr get_while_token() const { return _while_token; }
+    lexer::TokenRef get_while_token() const { return _while_token; }
 
-    lexer::TokenPtr get_while_open_paren() const { return _while_open_paren; }
+    lexer::TokenRef get_while_open_paren() const { return _while_open_paren; }
 
-    lexer::TokenPtr get_while_close_paren() const { return _while_close_paren; }
+    lexer::TokenRef get_while_close_paren() const { return _while_close_paren; }
 
 private:
     AbstractExpressionPTNodePtr _condition;
     AbstractEmbeddedStatementPTNodePtr _body;
-    lexer::TokenPtr _while_token;
-    lexer::TokenPtr _while_open_paren;
-    lexer::TokenPtr _while_close_paren;
+    lexer::TokenRef _while_token;
+    lexer::TokenRef _while_open_paren;
+    lexer::TokenRef _while_close_paren;
 };
 
 class ForStatementPTNode : public AbstractIterationStatementPTNode {
@@ -760,7 +762,7 @@ public:
         AbstractExpressionPTNodePtr condition,
         AbstractExpressionPTNodePtr update_stmt,
         AbstractEmbeddedStatementPTNodePtr body,
-        lexer::TokenPtr for_token, lexer::TokenPtr open_paren, lexer::TokenPtr comma1, lexer::TokenPtr comma2, lexer::TokenPtr close_paren)
+        lexer::TokenRef for_token, lexer::TokenRef open_paren, lexer::TokenRef comma1, lexer::TokenRef comma2, lexer::TokenRef close_paren)
         : AbstractIterationStatementPTNode(lineno, colno)
         , _init_stmt_assignment(std::move(init_stmt))
         , _condition(std::move(condition))
@@ -781,7 +783,7 @@ public:
         AbstractExpressionPTNodePtr condition,
         AbstractExpressionPTNodePtr update_stmt,
         AbstractEmbeddedStatementPTNodePtr body,
-        lexer::TokenPtr for_token, lexer::TokenPtr open_paren, lexer::TokenPtr comma1, lexer::TokenPtr comma2, lexer::TokenPtr close_paren)
+        lexer::TokenRef for_token, lexer::TokenRef open_paren, lexer::TokenRef comma1, lexer::TokenRef comma2, lexer::TokenRef close_paren)
         : AbstractIterationStatementPTNode(lineno, colno)
         , _init_stmt_declaration(std::move(init_stmt))
         , _condition(std::move(condition))
@@ -816,15 +818,15 @@ public:
 
     AbstractEmbeddedStatementPTNodePtr get_body() const { return _body; }
 
-    lexer::TokenPtr get_for_token() const { return _for_token; }
+    lexer::TokenRef get_for_token() const { return _for_token; }
 
-    lexer::TokenPtr get_open_paren() const { return _open_paren; }
+    lexer::TokenRef get_open_paren() const { return _open_paren; }
 
-    lexer::TokenPtr get_comma1() const { return _comma1; }
+    lexer::TokenRef get_comma1() const { return _comma1; }
 
-    lexer::TokenPtr get_comma2() const { return _comma2; }
+    lexer::TokenRef get_comma2() const { return _comma2; }
 
-    lexer::TokenPtr get_close_paren() const { return _close_paren; }
+    lexer::TokenRef get_close_paren() const { return _close_paren; }
 
 private:
     VariableAssignmentPTNodePtr _init_stmt_assignment;
@@ -832,11 +834,11 @@ private:
     AbstractExpressionPTNodePtr _condition;
     AbstractExpressionPTNodePtr _update_stmt;
     AbstractEmbeddedStatementPTNodePtr _body;
-    lexer::TokenPtr _for_token;
-    lexer::TokenPtr _open_paren;
-    lexer::TokenPtr _comma1;
-    lexer::TokenPtr _comma2;
-    lexer::TokenPtr _close_paren;
+    lexer::TokenRef _for_token;
+    lexer::TokenRef _open_paren;
+    lexer::TokenRef _comma1;
+    lexer::TokenRef _comma2;
+    lexer::TokenRef _close_paren;
 };
 
 class BreakContinueStatementPTNode : public AbstractEmbeddedStatementPTNode {
@@ -861,7 +863,7 @@ private:
 
 class ReturnStatementPTNode : public AbstractEmbeddedStatementPTNode {
 public:
-    ReturnStatementPTNode(int lineno, int colno, AbstractExpressionPTNodePtr expr, lexer::TokenPtr return_token, lexer::TokenPtr semicolon)
+    ReturnStatementPTNode(int lineno, int colno, AbstractExpressionPTNodePtr expr, lexer::TokenRef return_token, lexer::TokenRef semicolon)
         : AbstractEmbeddedStatementPTNode(lineno, colno)
         , _expr(std::move(expr))
         , _return_token(std::move(return_token))
@@ -875,19 +877,19 @@ public:
 
     AbstractExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_return_token() const { return _return_token; }
+    lexer::TokenRef get_return_token() const { return _return_token; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     AbstractExpressionPTNodePtr _expr;
-    lexer::TokenPtr _return_token;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _return_token;
+    lexer::TokenRef _semicolon;
 };
 
 class InvocationStatementPTNode : public AbstractEmbeddedStatementPTNode {
 public:
-    InvocationStatementPTNode(int lineno, int colno, InvocationExpressionPTNodePtr expr, lexer::TokenPtr semicolon)
+    InvocationStatementPTNode(int lineno, int colno, InvocationExpressionPTNodePtr expr, lexer::TokenRef semicolon)
         : AbstractEmbeddedStatementPTNode(lineno, colno)
         , _expr(std::move(expr))
         , _semicolon(std::move(semicolon))
@@ -900,16 +902,16 @@ public:
 
     InvocationExpressionPTNodePtr get_expr() const { return _expr; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     InvocationExpressionPTNodePtr _expr;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _semicolon;
 };
 
 class FloorAssignmentStatementPTNode : public AbstractEmbeddedStatementPTNode {
 public:
-    FloorAssignmentStatementPTNode(int lineno, int colno, FloorAssignmentPTNodePtr assignment, lexer::TokenPtr semicolon)
+    FloorAssignmentStatementPTNode(int lineno, int colno, FloorAssignmentPTNodePtr assignment, lexer::TokenRef semicolon)
         : AbstractEmbeddedStatementPTNode(lineno, colno)
         , _assignment(std::move(assignment))
         , _semicolon(std::move(semicolon))
@@ -922,16 +924,16 @@ public:
 
     FloorAssignmentPTNodePtr get_floor_assignment() const { return _assignment; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     FloorAssignmentPTNodePtr _assignment;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _semicolon;
 };
 
 class VariableAssignmentStatementPTNode : public AbstractEmbeddedStatementPTNode {
 public:
-    VariableAssignmentStatementPTNode(int lineno, int colno, VariableAssignmentPTNodePtr assignment, lexer::TokenPtr semicolon)
+    VariableAssignmentStatementPTNode(int lineno, int colno, VariableAssignmentPTNodePtr assignment, lexer::TokenRef semicolon)
         : AbstractEmbeddedStatementPTNode(lineno, colno)
         , _assignment(std::move(assignment))
         , _semicolon(std::move(semicolon))
@@ -944,16 +946,16 @@ public:
 
     VariableAssignmentPTNodePtr get_variable_assignment() const { return _assignment; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     VariableAssignmentPTNodePtr _assignment;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _semicolon;
 };
 
 class VariableDeclarationStatementPTNode : public AbstractStatementPTNode {
 public:
-    VariableDeclarationStatementPTNode(int lineno, int colno, VariableDeclarationPTNodePtr decl, lexer::TokenPtr semicolon)
+    VariableDeclarationStatementPTNode(int lineno, int colno, VariableDeclarationPTNodePtr decl, lexer::TokenRef semicolon)
         : AbstractStatementPTNode(lineno, colno)
         , decl(std::move(decl))
         , _semicolon(std::move(semicolon))
@@ -966,19 +968,19 @@ public:
 
     VariableDeclarationPTNodePtr get_variable_decl() const { return decl; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     VariableDeclarationPTNodePtr decl;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _semicolon;
 };
 
 class FloorBoxInitStatementPTNode : public AbstractStatementPTNode {
 public:
     FloorBoxInitStatementPTNode(int lineno, int colno, IntegerLiteralPTNodePtr index, IntegerLiteralPTNodePtr value,
-        lexer::TokenPtr init_token, lexer::TokenPtr floor_token,
-        lexer::TokenPtr open_bracket, lexer::TokenPtr floor_index_token, lexer::TokenPtr close_bracket,
-        lexer::TokenPtr equal_token, lexer::TokenPtr value_token, lexer::TokenPtr semicolon)
+        lexer::TokenRef init_token, lexer::TokenRef floor_token,
+        lexer::TokenRef open_bracket, lexer::TokenRef floor_index_token, lexer::TokenRef close_bracket,
+        lexer::TokenRef equal_token, lexer::TokenRef value_token, lexer::TokenRef semicolon)
         : AbstractStatementPTNode(lineno, colno)
         , _index(std::move(index))
         , _value(std::move(value))
@@ -1001,39 +1003,39 @@ public:
 
     IntegerLiteralPTNodePtr get_value() const { return _value; }
 
-    lexer::TokenPtr get_init_token() const { return _init_token; }
+    lexer::TokenRef get_init_token() const { return _init_token; }
 
-    lexer::TokenPtr get_floor_token() const { return _floor_token; }
+    lexer::TokenRef get_floor_token() const { return _floor_token; }
 
-    lexer::TokenPtr get_open_bracket() const { return _open_bracket; }
+    lexer::TokenRef get_open_bracket() const { return _open_bracket; }
 
-    lexer::TokenPtr get_floor_index() const { return _floor_index_token; }
+    lexer::TokenRef get_floor_index() const { return _floor_index_token; }
 
-    lexer::TokenPtr get_close_bracket() const { return _close_bracket; }
+    lexer::TokenRef get_close_bracket() const { return _close_bracket; }
 
-    lexer::TokenPtr get_equal_token() const { return _equal_token; }
+    lexer::TokenRef get_equal_token() const { return _equal_token; }
 
-    lexer::TokenPtr get_value_token() const { return _value_token; }
+    lexer::TokenRef get_value_token() const { return _value_token; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     IntegerLiteralPTNodePtr _index;
     IntegerLiteralPTNodePtr _value;
-    lexer::TokenPtr _init_token;
-    lexer::TokenPtr _floor_token;
-    lexer::TokenPtr _open_bracket;
-    lexer::TokenPtr _floor_index_token;
-    lexer::TokenPtr _close_bracket;
-    lexer::TokenPtr _equal_token;
-    lexer::TokenPtr _value_token;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _init_token;
+    lexer::TokenRef _floor_token;
+    lexer::TokenRef _open_bracket;
+    lexer::TokenRef _floor_index_token;
+    lexer::TokenRef _close_bracket;
+    lexer::TokenRef _equal_token;
+    lexer::TokenRef _value_token;
+    lexer::TokenRef _semicolon;
 };
 
 class FloorMaxInitStatementPTNode : public AbstractStatementPTNode {
 public:
     FloorMaxInitStatementPTNode(int lineno, int colno, IntegerLiteralPTNodePtr value,
-        lexer::TokenPtr init_token, lexer::TokenPtr floor_max_token, lexer::TokenPtr equals, lexer::TokenPtr value_token, lexer::TokenPtr semicolon)
+        lexer::TokenRef init_token, lexer::TokenRef floor_max_token, lexer::TokenRef equals, lexer::TokenRef value_token, lexer::TokenRef semicolon)
         : AbstractStatementPTNode(lineno, colno)
         , _value(std::move(value))
         , _init_token(std::move(init_token))
@@ -1050,28 +1052,28 @@ public:
 
     IntegerLiteralPTNodePtr get_value() const { return _value; }
 
-    lexer::TokenPtr get_init_token() const { return _init_token; }
+    lexer::TokenRef get_init_token() const { return _init_token; }
 
-    lexer::TokenPtr get_floor_max_token() const { return _floor_max_token; }
+    lexer::TokenRef get_floor_max_token() const { return _floor_max_token; }
 
-    lexer::TokenPtr get_value_token() const { return _value_token; }
+    lexer::TokenRef get_value_token() const { return _value_token; }
 
-    lexer::TokenPtr get_equals() const { return _equals; }
+    lexer::TokenRef get_equals() const { return _equals; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     IntegerLiteralPTNodePtr _value;
-    lexer::TokenPtr _init_token;
-    lexer::TokenPtr _floor_max_token;
-    lexer::TokenPtr _equals;
-    lexer::TokenPtr _value_token;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _init_token;
+    lexer::TokenRef _floor_max_token;
+    lexer::TokenRef _equals;
+    lexer::TokenRef _value_token;
+    lexer::TokenRef _semicolon;
 };
 
 class EmptyStatementPTNode : public AbstractEmbeddedStatementPTNode {
 public:
-    EmptyStatementPTNode(int lineno, int colno, lexer::TokenPtr semicolon)
+    EmptyStatementPTNode(int lineno, int colno, lexer::TokenRef semicolon)
         : AbstractEmbeddedStatementPTNode(lineno, colno)
         , _semicolon(std::move(semicolon))
     {
@@ -1081,15 +1083,15 @@ public:
 
     void accept(ParseTreeNodeVisitor *visitor) override;
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _semicolon;
 };
 
 class StatementBlockPTNode : public AbstractEmbeddedStatementPTNode {
 public:
-    StatementBlockPTNode(int lineno, int colno, const std::vector<AbstractStatementPTNodePtr> &statements, lexer::TokenPtr open_brace, lexer::TokenPtr close_brace)
+    StatementBlockPTNode(int lineno, int colno, const std::vector<AbstractStatementPTNodePtr> &statements, lexer::TokenRef open_brace, lexer::TokenRef close_brace)
         : AbstractEmbeddedStatementPTNode(lineno, colno)
         , _statements(statements)
         , _open_brace(std::move(open_brace))
@@ -1103,14 +1105,14 @@ public:
 
     const std::vector<AbstractStatementPTNodePtr> &get_statements() const { return _statements; }
 
-    lexer::TokenPtr get_open_brace() const { return _open_brace; }
+    lexer::TokenRef get_open_brace() const { return _open_brace; }
 
-    lexer::TokenPtr get_close_brace() const { return _close_brace; }
+    lexer::TokenRef get_close_brace() const { return _close_brace; }
 
 private:
     std::vector<AbstractStatementPTNodePtr> _statements;
-    lexer::TokenPtr _open_brace;
-    lexer::TokenPtr _close_brace;
+    lexer::TokenRef _open_brace;
+    lexer::TokenRef _close_brace;
 };
 
 // Function and Subprocedure Nodes
@@ -1138,7 +1140,7 @@ protected:
 
 class FunctionDefinitionPTNode : public AbstractSubroutinePTNode {
 public:
-    FunctionDefinitionPTNode(int lineno, int colno, IdentifierPTNodePtr function_name, IdentifierPTNodePtr formal_parameter, StatementBlockPTNodePtr body, lexer::TokenPtr function_token, lexer::TokenPtr open_brace, lexer::TokenPtr close_brace)
+    FunctionDefinitionPTNode(int lineno, int colno, IdentifierPTNodePtr function_name, IdentifierPTNodePtr formal_parameter, StatementBlockPTNodePtr body, lexer::TokenRef function_token, lexer::TokenRef open_brace, lexer::TokenRef close_brace)
         : AbstractSubroutinePTNode(lineno, colno, std::move(function_name), std::move(formal_parameter), std::move(body))
         , _function_token(std::move(function_token))
         , _open_brace(std::move(open_brace))
@@ -1150,22 +1152,22 @@ public:
 
     void accept(ParseTreeNodeVisitor *visitor) override;
 
-    lexer::TokenPtr get_function_token() const { return _function_token; }
+    lexer::TokenRef get_function_token() const { return _function_token; }
 
-    lexer::TokenPtr get_open_brace() const { return _open_brace; }
+    lexer::TokenRef get_open_brace() const { return _open_brace; }
 
-    lexer::TokenPtr get_close_brace() const { return _close_brace; }
+    lexer::TokenRef get_close_brace() const { return _close_brace; }
 
 private:
-    lexer::TokenPtr _function_token;
-    lexer::TokenPtr _open_brace;
-    lexer::TokenPtr _close_brace;
+    lexer::TokenRef _function_token;
+    lexer::TokenRef _open_brace;
+    lexer::TokenRef _close_brace;
 };
 
 class SubprocDefinitionPTNode : public AbstractSubroutinePTNode {
 public:
     SubprocDefinitionPTNode(int lineno, int colno, IdentifierPTNodePtr function_name, IdentifierPTNodePtr formal_parameter, StatementBlockPTNodePtr body,
-        lexer::TokenPtr sub_token, lexer::TokenPtr open_brace, lexer::TokenPtr close_brace)
+        lexer::TokenRef sub_token, lexer::TokenRef open_brace, lexer::TokenRef close_brace)
         : AbstractSubroutinePTNode(lineno, colno, std::move(function_name), std::move(formal_parameter), std::move(body))
         , _sub_token(std::move(sub_token))
         , _open_brace(std::move(open_brace))
@@ -1177,21 +1179,21 @@ public:
 
     void accept(ParseTreeNodeVisitor *visitor) override;
 
-    lexer::TokenPtr get_sub_token() const { return _sub_token; }
+    lexer::TokenRef get_sub_token() const { return _sub_token; }
 
-    lexer::TokenPtr get_open_brace() const { return _open_brace; }
+    lexer::TokenRef get_open_brace() const { return _open_brace; }
 
-    lexer::TokenPtr get_close_brace() const { return _close_brace; }
+    lexer::TokenRef get_close_brace() const { return _close_brace; }
 
 private:
-    lexer::TokenPtr _sub_token;
-    lexer::TokenPtr _open_brace;
-    lexer::TokenPtr _close_brace;
+    lexer::TokenRef _sub_token;
+    lexer::TokenRef _open_brace;
+    lexer::TokenRef _close_brace;
 };
 
 class ImportDirectivePTNode : public ParseTreeNode {
 public:
-    ImportDirectivePTNode(int lineno, int colno, IdentifierPTNodePtr module_name, lexer::TokenPtr import_token, lexer::TokenPtr semicolon)
+    ImportDirectivePTNode(int lineno, int colno, IdentifierPTNodePtr module_name, lexer::TokenRef import_token, lexer::TokenRef semicolon)
         : ParseTreeNode(lineno, colno)
         , _module_name(std::move(module_name))
         , _import_token(std::move(import_token))
@@ -1205,14 +1207,14 @@ public:
 
     IdentifierPTNodePtr get_module_name() const { return _module_name; }
 
-    lexer::TokenPtr get_import_token() const { return _import_token; }
+    lexer::TokenRef get_import_token() const { return _import_token; }
 
-    lexer::TokenPtr get_semicolon() const { return _semicolon; }
+    lexer::TokenRef get_semicolon() const { return _semicolon; }
 
 private:
     IdentifierPTNodePtr _module_name;
-    lexer::TokenPtr _import_token;
-    lexer::TokenPtr _semicolon;
+    lexer::TokenRef _import_token;
+    lexer::TokenRef _semicolon;
 };
 
 // Compilation Unit Node
@@ -1,48 +1,76 @@
 #ifndef RECURSIVEDESCENTPARSER_COMMON_H
 #define RECURSIVEDESCENTPARSER_COMMON_H
 
+#include <cstddef>
+#include <memory>
+
+#include "HRLToken.h"
+#include "LL1Table.h" // generated from design/hrl.ebnf
 #include "RecursiveDescentParser.h" // IWYU pragma: keep
 #include "hrl_global.h"
 
 OPEN_PARSER_NAMESPACE
 
-#define LEAVE_PARSE_FRAME() \
-    leave_parse_frame();    \
+// The column of the token in the LL(1) table, or EBNF_TOKEN_COUNT if the grammar doesn't have the token
+constexpr std::size_t ll1_column(lexer::TokenId token_id)
+{
+    switch (token_id) {
+#define LL1_COLUMN_CASE(token) \
+    case lexer::token:         \
+        return static_cast<std::size_t>(EbnfToken::token);
+        EBNF_TOKENS(LL1_COLUMN_CASE)
+#undef LL1_COLUMN_CASE
+    case lexer::END:
+        return static_cast<std::size_t>(EbnfToken::EndOfInput);
+    default:
+        return EBNF_TOKEN_COUNT;
+    }
+}
+
+// The alternative of the production to take on the token, EBNF_NO_ALTERNATIVE or EBNF_CONFLICT
+constexpr int ll1_predict(EbnfProduction production, lexer::TokenId token_id)
+{
+    std::size_t column = ll1_column(token_id);
+    if (column == EBNF_TOKEN_COUNT) {
+        return EBNF_NO_ALTERNATIVE;
+    }
+    return __ebnf_ll1_prediction_table[static_cast<std::size_t>(production)][column];
+}
+
+static_assert(ll1_predict(EbnfProduction::statement, lexer::LET) == ebnf_alternatives::statement::variable_declaration_statement);
+static_assert(ll1_predict(EbnfProduction::primary_expression, lexer::IDENTIFIER) == EBNF_CONFLICT);
+
+#define END_PARSE() \
     return true
 
-#define ENTER_PARSE_FRAME()                                                          \
-    enter_parse_frame();                                                             \
-    lexer::TokenPtr token = lookahead();                                             \
-    int lineno = token->lineno();                                                    \
-    UNUSED(lineno);                                                                  \
-    int colno = token->colno();                                                      \
-    UNUSED(colno);                                                                   \
-    std::size_t width = token->width();                                              \
-    UNUSED(width);                                                                   \
+// The node of the rule takes the position of first_token
+#define BEGIN_PARSE()                                                                \
+    lexer::TokenRef token = lookahead();                                             \
+    lexer::TokenRef first_token = token;                                             \
+    UNUSED(first_token);                                                             \
     auto last_error_it = _errors.empty() ? _errors.end() : std::prev(_errors.end()); \
     UNUSED(last_error_it)
 
 #define CLEAR_ERROR_BEYOND() \
     pop_error_till(last_error_it)
 
-#define TO_IDENTIFIER_TOKEN() \
-    std::static_pointer_cast<hrl::lexer::IdentifierToken>(token)
-
 #define TO_IDENTIFIER_NODE() \
-    std::make_shared<IdentifierPTNode>(std::static_pointer_cast<hrl::lexer::IdentifierToken>(token))
+    std::make_shared<IdentifierPTNode>(token)
 
 #define TO_INTEGER_NODE() \
-    std::make_shared<IntegerLiteralPTNode>(std::static_pointer_cast<hrl::lexer::IntegerToken>(token))
+    std::make_shared<IntegerLiteralPTNode>(token)
 
 #define TO_BOOLEAN_NODE() \
-    std::make_shared<BooleanLiteralPTNode>(std::static_pointer_cast<hrl::lexer::BooleanToken>(token))
+    std::make_shared<BooleanLiteralPTNode>(token)
+
+#define TO_NAME() \
+    token.get_identifier_id()
 
 #define CHECK_TOKEN_AND_CONSUME(expected_token, expected_message, token_name) \
     token = lookahead();                                                      \
-    auto token_name = token;                                                  \
-    if (token->token_id() != (expected_token)) {                              \
+    [[maybe_unused]] auto token_name = token;                                 \
+    if (token.token_id() != (expected_token)) {                               \
         push_error((expected_message), token);                                \
-        revert_parse_frame();                                                 \
         return false;                                                         \
     }                                                                         \
     consume()
@@ -56,21 +84,34 @@ OPEN_PARSER_NAMESPACE
 #define CHECK_ERROR_MSG(ok, errid, msg, lineno, colno, width) \
     if (!(ok)) {                                              \
         push_error(errid, (msg), lineno, colno, width);       \
-        revert_parse_frame();                                 \
         return false;                                         \
     }
 
-#define CHECK_ERROR(ok)       \
-    if (!(ok)) {              \
-        revert_parse_frame(); \
-        return false;         \
+#define CHECK_ERROR(ok) \
+    if (!(ok)) {        \
+        return false;   \
     }
 
 #define TOKEN_IS(id) \
-    (token->token_id() == (id))
+    (token.token_id() == (id))
+
+// The alternative of the production the lookahead predicts
+#define PREDICT(production) \
+    ll1_predict(EbnfProduction::production, token.token_id())
+
+// Whether the production may start with the lookahead
+#define TOKEN_STARTS(production) \
+    (PREDICT(production) != EBNF_NO_ALTERNATIVE)
+
+#define ALTERNATIVE(production, alternative) \
+    ebnf_alternatives::production::alternative
 
 #define SET_NODE(...) \
-    node = std::make_shared<std::remove_reference_t<decltype(node)>::element_type>(lineno, colno, __VA_ARGS__)
+    node = std::make_shared<std::remove_reference_t<decltype(node)>::element_type>(first_token.lineno(), first_token.colno(), __VA_ARGS__)
+
+// The AST nodes have no last position when they're parsed
+#define SET_AST_NODE(...) \
+    node = _arena->make<std::remove_reference_t<decltype(node)>::element_type>(first_token.offset(), NO_SOURCE_OFFSET __VA_OPT__(, ) __VA_ARGS__)
 
 #define SET_NODE_FROM(ptr) \
     node = std::static_pointer_cast<std::remove_reference_t<decltype(node)>::element_type>(ptr)
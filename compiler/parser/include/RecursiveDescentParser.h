@@ -2,11 +2,10 @@
 #define RECURSIVE_DESCENT_PARSER_H
 
 #include <cstddef>
-#include <list>
-#include <stack>
 #include <string>
 #include <vector>
 
+#include "AbstractParser.h"
 #include "ErrorMessage.h"
 #include "ParseTreeNodeForward.h"
 #include "lexer_global.h"
@@ -14,26 +13,25 @@
 
 OPEN_PARSER_NAMESPACE
 
-class RecursiveDescentParser {
+/**
+ * @brief Parses HRL by predicting each alternative from the LL(1) table generated from design/hrl.ebnf.
+ *
+ * The only conflict the parser resolves by backtracking is the identifier starting either an invocation or a
+ * variable, see primary_expression and embedded_statement in the grammar.
+ */
+class RecursiveDescentParser : public AbstractParser {
 public:
-    explicit RecursiveDescentParser(const std::string &filename, const std::vector<lexer::TokenPtr> &token_list)
-        : _tokens(token_list)
-        , _filename(filename) {};
+    /**
+     * @brief The parse tree refers to the tokens in \p tokens, which must outlive it.
+     */
+    explicit RecursiveDescentParser(const std::string &filename, const lexer::TokenBuffer &tokens)
+        : AbstractParser(filename, tokens) {};
 
     virtual ~RecursiveDescentParser() = default;
 
     virtual bool parse(CompilationUnitPTNodePtr &result);
 
 protected:
-    std::vector<lexer::TokenPtr> _tokens;
-    std::size_t _token_pointer = 0;
-    std::stack<std::size_t> _parse_frame_token_pointer;
-
-    std::list<CompilerMessage> _errors;
-
-    [[nodiscard]] const lexer::TokenPtr &lookahead() const;
-    void consume();
-
     [[nodiscard]] bool parse_compilation_unit(CompilationUnitPTNodePtr &node);
     [[nodiscard]] bool parse_import_directive(ImportDirectivePTNodePtr &node);
     [[nodiscard]] bool parse_floor_box_init_statement(FloorBoxInitStatementPTNodePtr &node);
@@ -64,21 +62,6 @@ protected:
     [[nodiscard]] bool parse_parenthesized_expression(ParenthesizedExpressionPTNodePtr &node);
 
     [[nodiscard]] bool parse_precedence_climbing(AbstractExpressionPTNodePtr &result, AbstractExpressionPTNodePtr lhs, int min_precedence);
-
-    void push_error(const std::string &expect, const lexer::TokenPtr &got, int lineno = -1, int colno = -1, std::size_t width = 0);
-    void push_error(int errid, const std::string &message, int lineno, int colno, std::size_t width);
-    void pop_error();
-    void pop_error_till(std::list<CompilerMessage>::iterator till_exclusive);
-    void report_errors();
-
-    void enter_parse_frame();
-    void revert_parse_frame();
-    void leave_parse_frame();
-
-private:
-    const static lexer::TokenPtr NULL_TOKEN;
-
-    std::string _filename;
 };
 
 CLOSE_PARSER_NAMESPACE
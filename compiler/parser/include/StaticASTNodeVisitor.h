@@ -0,0 +1,260 @@
+#ifndef STATICASTNODEVISITOR_H
+#define STATICASTNODEVISITOR_H
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "ASTNode.h"
+#include "hrl_global.h"
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+/**
+ * @brief A visitor whose visits are resolved at compile time, for the hot traversals. It's an alternative to
+ * ASTNodeVisitor that a pass can opt in to on its own.
+ *
+ * Derived is the visitor itself. dispatch switches on the type of the node and calls the visit of Derived for it, so
+ * there's no virtual call but get_node_type, the visits can be inlined, and the nodes are passed by reference instead
+ * of as shared_ptr copies. The visits here traverse the children in the order of SemanticAnalysisPass: Derived
+ * defines the visits it needs and brings in the rest with `using StaticASTNodeVisitor<Derived>::visit;`. The children
+ * are dispatched through Derived too, so it can hook every node by hiding dispatch(ASTNode &).
+ *
+ * A visit can't replace or remove its node, and there's no ancestor stack, so the mutating passes stay on
+ * ASTNodeVisitor. Like there, the return value of 0 indicates success. A container stops at the first failure, and
+ * dispatch_multiple visits all and returns the last failure, as SemanticAnalysisPass::traverse does.
+ */
+template <typename Derived>
+class StaticASTNodeVisitor {
+public:
+    int dispatch(ASTNode &node)
+    {
+        switch (node.get_node_type()) {
+        case ASTNodeType::EmptyStatement:
+            return derived().visit(static_cast<EmptyStatementASTNode &>(node));
+        case ASTNodeType::Integer:
+            return derived().visit(static_cast<IntegerASTNode &>(node));
+        case ASTNodeType::Boolean:
+            return derived().visit(static_cast<BooleanASTNode &>(node));
+        case ASTNodeType::VariableDeclaration:
+            return derived().visit(static_cast<VariableDeclarationASTNode &>(node));
+        case ASTNodeType::VariableAssignment:
+            return derived().visit(static_cast<VariableAssignmentASTNode &>(node));
+        case ASTNodeType::VariableAccess:
+            return derived().visit(static_cast<VariableAccessASTNode &>(node));
+        case ASTNodeType::FloorBoxInitStatement:
+            return derived().visit(static_cast<FloorBoxInitStatementASTNode &>(node));
+        case ASTNodeType::FloorAssignment:
+            return derived().visit(static_cast<FloorAssignmentASTNode &>(node));
+        case ASTNodeType::FloorAccess:
+            return derived().visit(static_cast<FloorAccessASTNode &>(node));
+        case ASTNodeType::NegativeExpression:
+            return derived().visit(static_cast<NegativeExpressionASTNode &>(node));
+        case ASTNodeType::NotExpression:
+            return derived().visit(static_cast<NotExpressionASTNode &>(node));
+        case ASTNodeType::IncrementExpression:
+            return derived().visit(static_cast<IncrementExpressionASTNode &>(node));
+        case ASTNodeType::DecrementExpression:
+            return derived().visit(static_cast<DecrementExpressionASTNode &>(node));
+        case ASTNodeType::AddExpression:
+            return derived().visit(static_cast<AddExpressionASTNode &>(node));
+        case ASTNodeType::SubExpression:
+            return derived().visit(static_cast<SubExpressionASTNode &>(node));
+        case ASTNodeType::MulExpression:
+            return derived().visit(static_cast<MulExpressionASTNode &>(node));
+        case ASTNodeType::DivExpression:
+            return derived().visit(static_cast<DivExpressionASTNode &>(node));
+        case ASTNodeType::ModExpression:
+            return derived().visit(static_cast<ModExpressionASTNode &>(node));
+        case ASTNodeType::EqualExpression:
+            return derived().visit(static_cast<EqualExpressionASTNode &>(node));
+        case ASTNodeType::NotEqualExpression:
+            return derived().visit(static_cast<NotEqualExpressionASTNode &>(node));
+        case ASTNodeType::GreaterThanExpression:
+            return derived().visit(static_cast<GreaterThanExpressionASTNode &>(node));
+        case ASTNodeType::GreaterEqualExpression:
+            return derived().visit(static_cast<GreaterEqualExpressionASTNode &>(node));
+        case ASTNodeType::LessThanExpression:
+            return derived().visit(static_cast<LessThanExpressionASTNode &>(node));
+        case ASTNodeType::LessEqualExpression:
+            return derived().visit(static_cast<LessEqualExpressionASTNode &>(node));
+        case ASTNodeType::AndExpression:
+            return derived().visit(static_cast<AndExpressionASTNode &>(node));
+        case ASTNodeType::OrExpression:
+            return derived().visit(static_cast<OrExpressionASTNode &>(node));
+        case ASTNodeType::InvocationExpression:
+            return derived().visit(static_cast<InvocationExpressionASTNode &>(node));
+        case ASTNodeType::IfStatement:
+            return derived().visit(static_cast<IfStatementASTNode &>(node));
+        case ASTNodeType::WhileStatement:
+            return derived().visit(static_cast<WhileStatementASTNode &>(node));
+        case ASTNodeType::ForStatement:
+            return derived().visit(static_cast<ForStatementASTNode &>(node));
+        case ASTNodeType::ReturnStatement:
+            return derived().visit(static_cast<ReturnStatementASTNode &>(node));
+        case ASTNodeType::BreakStatement:
+            return derived().visit(static_cast<BreakStatementASTNode &>(node));
+        case ASTNodeType::ContinueStatement:
+            return derived().visit(static_cast<ContinueStatementASTNode &>(node));
+        case ASTNodeType::StatementBlock:
+            return derived().visit(static_cast<StatementBlockASTNode &>(node));
+        case ASTNodeType::SubprocDefinition:
+            return derived().visit(static_cast<SubprocDefinitionASTNode &>(node));
+        case ASTNodeType::FunctionDefinition:
+            return derived().visit(static_cast<FunctionDefinitionASTNode &>(node));
+        case ASTNodeType::CompilationUnit:
+            return derived().visit(static_cast<CompilationUnitASTNode &>(node));
+        }
+
+        return 0;
+    }
+
+    // A null node is skipped
+    template <typename NodeT>
+        requires std::is_base_of_v<ASTNode, NodeT>
+    int dispatch(const std::shared_ptr<NodeT> &node)
+    {
+        return node ? derived().dispatch(static_cast<ASTNode &>(*node)) : 0;
+    }
+
+    template <typename NodeT>
+    int dispatch(const std::vector<std::shared_ptr<NodeT>> &nodes)
+    {
+        for (const auto &node : nodes) {
+            int rc = derived().dispatch(node);
+            if (rc != 0) {
+                return rc;
+            }
+        }
+        return 0;
+    }
+
+    template <typename... T>
+    int dispatch_multiple(const T &...nodes)
+    {
+        int result = 0;
+        auto dispatch_one = [&](const auto &node) {
+            int rc = derived().dispatch(node);
+            if (rc != 0) {
+                result = rc;
+            }
+        };
+        (dispatch_one(nodes), ...);
+        return result;
+    }
+
+    // For all visit, the return value of 0 indicate success.
+    int visit(IntegerASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(BooleanASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(VariableDeclarationASTNode &node) { return derived().dispatch(node.get_assignment()); }
+
+    int visit(VariableAssignmentASTNode &node) { return derived().dispatch(node.get_value()); }
+
+    int visit(VariableAccessASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(FloorBoxInitStatementASTNode &node) { return derived().dispatch(node.get_assignment()); }
+
+    int visit(FloorAssignmentASTNode &node) { return derived().dispatch_multiple(node.get_floor_number(), node.get_value()); }
+
+    int visit(FloorAccessASTNode &node) { return derived().dispatch(node.get_index_expr()); }
+
+    int visit(NegativeExpressionASTNode &node) { return derived().dispatch(node.get_operand()); }
+
+    int visit(NotExpressionASTNode &node) { return derived().dispatch(node.get_operand()); }
+
+    int visit(IncrementExpressionASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(DecrementExpressionASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(AddExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(SubExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(MulExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(DivExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(ModExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(EqualExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(NotEqualExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(GreaterThanExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(GreaterEqualExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(LessThanExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(LessEqualExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(AndExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(OrExpressionASTNode &node) { return derived().dispatch_multiple(node.get_left(), node.get_right()); }
+
+    int visit(InvocationExpressionASTNode &node) { return derived().dispatch(node.get_argument()); }
+
+    int visit(EmptyStatementASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(IfStatementASTNode &node) { return derived().dispatch_multiple(node.get_condition(), node.get_then_branch(), node.get_else_branch()); }
+
+    int visit(WhileStatementASTNode &node) { return derived().dispatch_multiple(node.get_condition(), node.get_body()); }
+
+    int visit(ForStatementASTNode &node) { return derived().dispatch_multiple(node.get_init(), node.get_condition(), node.get_update(), node.get_body()); }
+
+    int visit(ReturnStatementASTNode &node) { return derived().dispatch(node.get_expression()); }
+
+    int visit(BreakStatementASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(ContinueStatementASTNode &node)
+    {
+        UNUSED(node);
+        return 0;
+    }
+
+    int visit(StatementBlockASTNode &node) { return derived().dispatch(node.get_statements()); }
+
+    int visit(SubprocDefinitionASTNode &node) { return derived().dispatch_multiple(node.get_parameter(), node.get_body()); }
+
+    int visit(FunctionDefinitionASTNode &node) { return derived().dispatch_multiple(node.get_parameter(), node.get_body()); }
+
+    int visit(CompilationUnitASTNode &node) { return derived().dispatch_multiple(node.get_floor_inits(), node.get_var_decls(), node.get_subroutines()); }
+
+private:
+    Derived &derived() { return static_cast<Derived &>(*this); }
+};
+
+CLOSE_PARSER_NAMESPACE
+
+#endif
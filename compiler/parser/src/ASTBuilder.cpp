@@ -16,11 +16,13 @@
 OPEN_PARSER_NAMESPACE
 
 #define SET_RESULT(NodeType, ...)                                                                                                                        \
-    _result_stack.push(std::static_pointer_cast<ASTNode>(std::make_shared<NodeType>(node->lineno(), node->colno(), -1, -1 __VA_OPT__(, ) __VA_ARGS__))); \
+    _result_stack.push(std::static_pointer_cast<ASTNode>(_arena->make<NodeType>(offset_of(node), NO_SOURCE_OFFSET __VA_OPT__(, ) __VA_ARGS__)));         \
     return
 
-ASTBuilder::ASTBuilder(CompilationUnitPTNodePtr root)
+ASTBuilder::ASTBuilder(CompilationUnitPTNodePtr root, SourceFilePtr source, StringInternerPtr strings)
     : _root(std::move(root))
+    , _source(std::move(source))
+    , _arena(ASTNodeArena::create(_source, std::move(strings)))
 {
     // Constructor implementation (if any)
 }
@@ -30,7 +32,7 @@ void ASTBuilder::visit(IdentifierPTNodePtr node)
     // Will be called when evaluating expression
     // In this case it's a variable access node
     // If it's not the case, the visit_and_cast will raise, since it's a bad cast.
-    SET_RESULT(VariableAccessASTNode, node->get_value());
+    SET_RESULT(VariableAccessASTNode, node->get_value_id());
 }
 
 void ASTBuilder::visit(IntegerLiteralPTNodePtr node)
@@ -52,13 +54,13 @@ void ASTBuilder::visit(BinaryOperatorPTNodePtr node)
 
 void ASTBuilder::visit(VariableDeclarationPTNodePtr node)
 {
-    StringPtr var_name = node->get_var_name()->get_value();
+    StringId var_name = node->get_var_name()->get_value_id();
 
     if (node->get_expr()) {
         auto value_expr = visit_and_cast<AbstractExpressionASTNodePtr>(node->get_expr());
 
-        VariableAssignmentASTNodePtr assignment = std::make_shared<VariableAssignmentASTNode>(
-            node->get_equals()->lineno(), node->get_equals()->colno(), -1, -1,
+        VariableAssignmentASTNodePtr assignment = _arena->make<VariableAssignmentASTNode>(
+            node->get_equals().offset(), NO_SOURCE_OFFSET,
             var_name, value_expr);
         SET_RESULT(VariableDeclarationASTNode, var_name, assignment);
     } else {
@@ -68,7 +70,7 @@ void ASTBuilder::visit(VariableDeclarationPTNodePtr node)
 
 void ASTBuilder::visit(VariableAssignmentPTNodePtr node)
 {
-    StringPtr var_name = node->get_var_name()->get_value();
+    StringId var_name = node->get_var_name()->get_value_id();
     auto value_expr = visit_and_cast<AbstractExpressionASTNodePtr>(node->get_expr());
 
     SET_RESULT(VariableAssignmentASTNode, var_name, value_expr);
@@ -142,14 +144,14 @@ void ASTBuilder::visit(NotExpressionPTNodePtr node)
 
 void ASTBuilder::visit(IncrementExpressionPTNodePtr node)
 {
-    StringPtr var_name = node->get_var_name()->get_value();
+    StringId var_name = node->get_var_name()->get_value_id();
 
     SET_RESULT(IncrementExpressionASTNode, var_name);
 }
 
 void ASTBuilder::visit(DecrementExpressionPTNodePtr node)
 {
-    StringPtr var_name = node->get_var_name()->get_value();
+    StringId var_name = node->get_var_name()->get_value_id();
 
     SET_RESULT(DecrementExpressionASTNode, var_name);
 }
@@ -170,7 +172,7 @@ void ASTBuilder::visit(ParenthesizedExpressionPTNodePtr node)
 void ASTBuilder::visit(InvocationExpressionPTNodePtr node)
 {
     auto expr = visit_and_cast<AbstractExpressionASTNodePtr>(node->get_arg());
-    SET_RESULT(InvocationExpressionASTNode, node->get_func_name()->get_value(), expr);
+    SET_RESULT(InvocationExpressionASTNode, node->get_func_name()->get_value_id(), expr);
 }
 
 void ASTBuilder::visit(IfStatementPTNodePtr node)
@@ -207,7 +209,7 @@ void ASTBuilder::visit(FloorBoxInitStatementPTNodePtr node)
 {
     IntegerASTNodePtr index = make_literal_node(node->get_index());
     IntegerASTNodePtr val_expr = make_literal_node(node->get_value());
-    FloorAssignmentASTNodePtr assignment = std::make_shared<FloorAssignmentASTNode>(node->lineno(), node->colno(), -1, -1, index, val_expr);
+    FloorAssignmentASTNodePtr assignment = _arena->make<FloorAssignmentASTNode>(offset_of(node), NO_SOURCE_OFFSET, index, val_expr);
     SET_RESULT(FloorBoxInitStatementASTNode, assignment);
 }
 
@@ -260,15 +262,15 @@ void ASTBuilder::visit(InvocationStatementPTNodePtr node)
 
 void ASTBuilder::visit(SubprocDefinitionPTNodePtr node)
 {
-    StringPtr func_name = node->get_function_name()->get_value();
+    StringId func_name = node->get_function_name()->get_value_id();
     auto param = node->get_formal_parameter();
     VariableDeclarationASTNodePtr param_node;
 
     if (param) {
-        auto param_name = param->get_value();
+        StringId param_name = param->get_value_id();
 
-        param_node = std::make_shared<VariableDeclarationASTNode>(
-            param->lineno(), param->colno(), param->lineno(), param->colno() + static_cast<int>(param->get_token()->width()),
+        param_node = _arena->make<VariableDeclarationASTNode>(
+            param->get_token().offset(), static_cast<SourceOffset>(param->get_token().offset() + param->get_token().width()),
             param_name,
             nullptr);
     }
@@ -280,15 +282,15 @@ void ASTBuilder::visit(SubprocDefinitionPTNodePtr node)
 
 void ASTBuilder::visit(FunctionDefinitionPTNodePtr node)
 {
-    StringPtr func_name = node->get_function_name()->get_value();
+    StringId func_name = node->get_function_name()->get_value_id();
     auto param = node->get_formal_parameter();
     VariableDeclarationASTNodePtr param_node;
 
     if (param) {
-        auto param_name = param->get_value();
+        StringId param_name = param->get_value_id();
 
-        param_node = std::make_shared<VariableDeclarationASTNode>(
-            param->lineno(), param->colno(), param->lineno(), param->colno() + static_cast<int>(param->get_token()->width()),
+        param_node = _arena->make<VariableDeclarationASTNode>(
+            param->get_token().offset(), static_cast<SourceOffset>(param->get_token().offset() + param->get_token().width()),
             param_name,
             nullptr);
     }
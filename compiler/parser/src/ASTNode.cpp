@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 
 #include "ASTNode.h"
+#include "ASTNodeArena.h"
 #include "ASTNodeVisitor.h"
 #include "parser_global.h"
 
@@ -87,36 +88,72 @@ int BreakStatementASTNode::accept(ASTNodeVisitor *visitor) { VISIT_NODE(); }
 
 int ContinueStatementASTNode::accept(ASTNodeVisitor *visitor) { VISIT_NODE(); }
 
+int ASTNode::lineno() const
+{
+    return _arena && _arena->source() ? _arena->source()->lineno_at(_offset) : -1;
+}
+
+int ASTNode::colno() const
+{
+    return _arena && _arena->source() ? _arena->source()->colno_at(_offset) : -1;
+}
+
+int ASTNode::last_lineno() const
+{
+    return _arena && _arena->source() ? _arena->source()->lineno_at(_last_offset) : -1;
+}
+
+int ASTNode::last_colno() const
+{
+    return _arena && _arena->source() ? _arena->source()->colno_at(_last_offset) : -1;
+}
+
+const StringPtr &ASTNode::name_of(StringId id) const
+{
+    return _arena->strings()->shared(id);
+}
+
 bool ASTNode::get_attribute(int attribute_id, ASTNodeAttributePtr &out) const
 {
-    auto it = _attributes.find(attribute_id);
-    if (it == _attributes.end()) {
+    if (!_arena) {
         return false;
-    } else {
-        if (it->second) {
-            out = it->second;
-            return true;
-        } else {
-            return false;
-        }
     }
-}
 
-void ASTNode::set_attribute(int attribute_id, ASTNodeAttributePtr attr)
-{
+    AbstractASTNodeAttributeTable *table = _arena->find_attribute_table(attribute_id);
+    if (!table) {
+        return false;
+    }
+
+    ASTNodeAttributePtr attr = table->get_attribute(_node_id);
     if (attr) {
-        _attributes[attribute_id] = attr;
+        out = attr;
+        return true;
+    } else {
+        return false;
     }
 }
 
 void ASTNode::remove_attribute(int attribute_id)
 {
-    _attributes.erase(attribute_id);
+    if (!_arena) {
+        return;
+    }
+
+    AbstractASTNodeAttributeTable *table = _arena->find_attribute_table(attribute_id);
+    if (table) {
+        table->remove(_node_id);
+    }
 }
 
 void ASTNode::copy_attributes_from(const ASTNodePtr &node)
 {
-    _attributes = node->_attributes;
+    if (_arena != node->_arena) {
+        spdlog::critical("Copying attributes across AST node arenas. {}", __PRETTY_FUNCTION__);
+        throw;
+    }
+    if (_arena) {
+        _arena->copy_attributes(node->_node_id, _node_id);
+    }
 }
 
 const char *ast_node_type_to_string(ASTNodeType type)
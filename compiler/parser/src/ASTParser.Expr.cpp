@@ -0,0 +1,280 @@
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "ASTNode.h"
+#include "ASTNodeForward.h"
+#include "ASTParser.h"
+#include "HRLToken.h"
+#include "ParseTreeNode.h"
+#include "RecursiveDescentParser.Common.h"
+
+OPEN_PARSER_NAMESPACE
+
+bool ASTParser::parse_expression(AbstractExpressionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+    bool ok;
+
+    AbstractExpressionASTNodePtr lhs;
+    ok = parse_unary_expression(lhs);
+    CHECK_ERROR(ok);
+
+    ok = parse_precedence_climbing(node, lhs, 0);
+    CHECK_ERROR(ok);
+
+    END_PARSE();
+}
+
+// Same as RecursiveDescentParser::parse_precedence_climbing, including the position of the binary expression
+bool ASTParser::parse_precedence_climbing(AbstractExpressionASTNodePtr &result, AbstractExpressionASTNodePtr lhs, int min_precedence)
+{
+    BEGIN_PARSE();
+
+    while (lexer::is_token_binary_operator(token.token_id())
+        && BinaryOperatorPTNode::get_operator_precedence(token.token_id()) >= min_precedence) {
+
+        bool ok;
+        lexer::TokenRef op = token;
+        int current_precedence = BinaryOperatorPTNode::get_operator_precedence(token.token_id());
+        CONSUME_TOKEN();
+
+        AbstractExpressionASTNodePtr rhs;
+        ok = parse_unary_expression(rhs);
+        CHECK_ERROR(ok);
+
+        UPDATE_TOKEN_LOOKAHEAD();
+
+        while (lexer::is_token_binary_operator(token.token_id())) {
+            bool is_left_assoc = BinaryOperatorPTNode::get_operator_associativity(token.token_id()) == BinaryOperatorPTNode::LEFT_TO_RIGHT;
+            bool is_right_assoc = !is_left_assoc;
+            int lookahead_precedence = BinaryOperatorPTNode::get_operator_precedence(token.token_id());
+
+            if ((is_left_assoc && lookahead_precedence > current_precedence) || (is_right_assoc && lookahead_precedence >= current_precedence)) {
+                AbstractExpressionASTNodePtr rhs_result;
+                ok = parse_precedence_climbing(
+                    rhs_result,
+                    rhs,
+                    current_precedence == lookahead_precedence ? current_precedence : current_precedence + 1);
+                CHECK_ERROR(ok);
+
+                rhs = rhs_result;
+
+                UPDATE_TOKEN_LOOKAHEAD();
+            } else {
+                break;
+            }
+        }
+        lhs = make_binary_expression(op, token.offset(), lhs, rhs);
+    }
+
+    result = lhs;
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_unary_expression(AbstractExpressionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    bool ok;
+    AbstractExpressionASTNodePtr primary;
+
+    switch (PREDICT(unary_expression)) {
+    case ALTERNATIVE(unary_expression, positive_expression):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::ADD, "'+'", add_token);
+        ok = parse_primary_expression(primary);
+        CHECK_ERROR(ok);
+        node = primary;
+        break;
+    }
+
+    case ALTERNATIVE(unary_expression, negative_expression):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::SUB, "'-'", sub_token);
+        ok = parse_primary_expression(primary);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(_arena->make<NegativeExpressionASTNode>(first_token.offset(), NO_SOURCE_OFFSET, primary));
+        break;
+    }
+
+    case ALTERNATIVE(unary_expression, increment_expression):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::ADDADD, "'++'", inc_token);
+        CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", id_token);
+        SET_NODE_FROM(_arena->make<IncrementExpressionASTNode>(first_token.offset(), NO_SOURCE_OFFSET, TO_NAME()));
+        break;
+    }
+
+    case ALTERNATIVE(unary_expression, decrement_expression):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::SUBSUB, "'--'", dec_token);
+        CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", id_token);
+        SET_NODE_FROM(_arena->make<DecrementExpressionASTNode>(first_token.offset(), NO_SOURCE_OFFSET, TO_NAME()));
+        break;
+    }
+
+    case ALTERNATIVE(unary_expression, not_expression):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::NOT, "'!'", not_token);
+        ok = parse_primary_expression(primary);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(_arena->make<NotExpressionASTNode>(first_token.offset(), NO_SOURCE_OFFSET, primary));
+        break;
+    }
+
+    case ALTERNATIVE(unary_expression, primary_expression):
+        ok = parse_primary_expression(primary);
+        CHECK_ERROR(ok);
+        node = primary;
+        break;
+
+    default:
+        CHECK_ERROR_MSG(false, 2007, "Expect a unary expression but got '" + std::string(token.token_text()), token.lineno(), token.colno(), token.width());
+    }
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_primary_expression(AbstractExpressionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    bool ok;
+    FloorAccessASTNodePtr floor_access;
+    AbstractExpressionASTNodePtr parenthesized_expr;
+    InvocationExpressionASTNodePtr invocation;
+
+    switch (PREDICT(primary_expression)) {
+    case ALTERNATIVE(primary_expression, literal):
+        if (PREDICT(literal) == ALTERNATIVE(literal, BOOLEAN)) {
+            SET_NODE_FROM(_arena->make<BooleanASTNode>(first_token.offset(), NO_SOURCE_OFFSET, token.get_boolean()));
+        } else {
+            SET_NODE_FROM(_arena->make<IntegerASTNode>(first_token.offset(), NO_SOURCE_OFFSET, token.get_integer(), token.get_is_char()));
+        }
+        CONSUME_TOKEN();
+        break;
+    case ALTERNATIVE(primary_expression, floor_access):
+        ok = parse_floor_access(floor_access);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(floor_access);
+        break;
+    case EBNF_CONFLICT: // invocation_expression, variable_name. Both start with an identifier.
+    {
+        std::size_t backtrack_point = _token_pointer;
+        ok = parse_invocation_expression(invocation);
+        if (ok) {
+            SET_NODE_FROM(invocation);
+        } else {
+            _token_pointer = backtrack_point;
+            CLEAR_ERROR_BEYOND();
+            SET_NODE_FROM(_arena->make<VariableAccessASTNode>(first_token.offset(), NO_SOURCE_OFFSET, TO_NAME()));
+            CONSUME_TOKEN();
+        }
+        break;
+    }
+    case ALTERNATIVE(primary_expression, parenthesized_expression):
+        ok = parse_parenthesized_expression(parenthesized_expr);
+        CHECK_ERROR(ok);
+        node = parenthesized_expr;
+        break;
+    default:
+        CHECK_ERROR_MSG(false, 2008, "Expect a primary expression (literal/floor access/invocation/parenthesized) but got '" + std::string(token.token_text()) + "'", token.lineno(), token.colno(), token.width());
+    }
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_invocation_expression(InvocationExpressionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    StringId func_name;
+    AbstractExpressionASTNodePtr arg;
+
+    CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (function or subprocedure)", id_token);
+    func_name = TO_NAME();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'(", open_paren);
+    UPDATE_TOKEN_LOOKAHEAD();
+    // optional expr
+    if (!TOKEN_IS(lexer::CLOSE_PAREN)) {
+        bool ok = parse_expression(arg);
+        CHECK_ERROR(ok);
+
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_paren);
+
+    SET_AST_NODE(func_name, arg);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_parenthesized_expression(AbstractExpressionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
+
+    bool ok = parse_expression(node);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_paren);
+
+    END_PARSE();
+}
+
+IntegerASTNodePtr ASTParser::make_literal_node(const lexer::TokenRef &token)
+{
+    return _arena->make<IntegerASTNode>(token.offset(), static_cast<SourceOffset>(token.offset() + token.width()), token.get_integer(), token.get_is_char());
+}
+
+VariableDeclarationASTNodePtr ASTParser::make_parameter_node(const lexer::TokenRef &token)
+{
+    return _arena->make<VariableDeclarationASTNode>(
+        token.offset(), static_cast<SourceOffset>(token.offset() + token.width()),
+        token.get_identifier_id(),
+        nullptr);
+}
+
+AbstractExpressionASTNodePtr ASTParser::make_binary_expression(const lexer::TokenRef &op, SourceOffset offset, AbstractExpressionASTNodePtr left, AbstractExpressionASTNodePtr right)
+{
+    switch (op.token_id()) {
+    case lexer::GE:
+        return _arena->make<GreaterEqualExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::LE:
+        return _arena->make<LessEqualExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::EE:
+        return _arena->make<EqualExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::NE:
+        return _arena->make<NotEqualExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::GT:
+        return _arena->make<GreaterThanExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::LT:
+        return _arena->make<LessThanExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::AND:
+        return _arena->make<AndExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::OR:
+        return _arena->make<OrExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::ADD:
+        return _arena->make<AddExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::SUB:
+        return _arena->make<SubExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::MUL:
+        return _arena->make<MulExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::DIV:
+        return _arena->make<DivExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    case lexer::MOD:
+        return _arena->make<ModExpressionASTNode>(offset, NO_SOURCE_OFFSET, left, right);
+    default:
+        spdlog::critical("unrecognized binary operator {}. {}", static_cast<int>(op.token_id()), __PRETTY_FUNCTION__);
+        throw;
+    }
+}
+
+CLOSE_PARSER_NAMESPACE
+
+// end
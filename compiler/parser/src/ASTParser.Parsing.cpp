@@ -0,0 +1,664 @@
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "ASTNode.h"
+#include "ASTNodeForward.h"
+#include "ASTParser.h"
+#include "HRLToken.h"
+#include "RecursiveDescentParser.Common.h"
+
+OPEN_PARSER_NAMESPACE
+
+bool ASTParser::parse_compilation_unit(CompilationUnitASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    std::vector<StringPtr> imports;
+    std::vector<FloorBoxInitStatementASTNodePtr> floor_inits;
+    std::optional<int> floor_max;
+
+    std::vector<VariableDeclarationASTNodePtr> variable_declarations;
+    std::vector<AbstractSubroutineASTNodePtr> subroutine_definitions;
+
+    // There must be 0 to any import directives at the beginning of the file
+    while (TOKEN_IS(lexer::IMPORT)) {
+        StringPtr import;
+        bool ok = parse_import_directive(import);
+        CHECK_ERROR(ok);
+        imports.push_back(import);
+
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+
+    // Then floor_box_init_statement and floor_max_init_statement in any order
+    // They both starts with 'init', the token after it tells which
+    while (TOKEN_IS(lexer::INIT)) {
+        lexer::TokenId next = lookahead(1).token_id();
+        if (next == lexer::FLOOR) {
+            FloorBoxInitStatementASTNodePtr init;
+            bool ok = parse_floor_box_init_statement(init);
+            CHECK_ERROR(ok);
+            floor_inits.push_back(init);
+        } else {
+            // It's either floor init or floor max
+            CHECK_ERROR_MSG(
+                next == lexer::FLOOR_MAX,
+                2002,
+                "Expect either 'init floor' or 'init floor_max' statement.",
+                token.lineno(), token.colno(), token.width());
+
+            int max;
+            bool ok = parse_floor_max_statement(max);
+            CHECK_ERROR(ok);
+
+            // floor max already set? there can be only one.
+            CHECK_ERROR_MSG(
+                !floor_max, // cannot be true. true means set already
+                2003,
+                "Maximum one 'init floor_max' allowed",
+                token.lineno(), token.colno(), token.width());
+
+            floor_max = max;
+        }
+
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+
+    // Then variable_declaration_statement and function_definition and subproc_definition in any order
+    bool ok = false;
+    while (TOKEN_STARTS(variable_declaration_statement) || TOKEN_STARTS(function_definition) || TOKEN_STARTS(subproc_definition)) {
+        if (TOKEN_STARTS(variable_declaration_statement)) {
+            VariableDeclarationASTNodePtr var;
+            ok = parse_variable_declaration_statement(var);
+            CHECK_ERROR(ok);
+
+            variable_declarations.push_back(var);
+        } else if (TOKEN_STARTS(function_definition)) {
+            FunctionDefinitionASTNodePtr func;
+            ok = parse_function_definition(func);
+            CHECK_ERROR(ok);
+
+            subroutine_definitions.push_back(func);
+        } else {
+            SubprocDefinitionASTNodePtr sub;
+            ok = parse_subproc_definition(sub);
+            CHECK_ERROR(ok);
+
+            subroutine_definitions.push_back(sub);
+        }
+
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+
+    CHECK_TOKEN_AND_CONSUME(lexer::END, "a variable, function/subproc declaration or end of file", eof);
+
+    SET_AST_NODE(imports, floor_inits, floor_max, variable_declarations, subroutine_definitions);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse(CompilationUnitASTNodePtr &result)
+{
+    bool success = parse_compilation_unit(result);
+
+    if (!success) {
+        report_errors();
+    }
+
+    return success;
+}
+
+bool ASTParser::parse_import_directive(StringPtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::IMPORT, "'import'", import_token);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier", _);
+    node = token.get_identifier_name();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_floor_box_init_statement(FloorBoxInitStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::INIT, "'init'", init_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::FLOOR, "'floor'", floor_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_BRACKET, "'['", open_bracket);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::INTEGER, "an integer (floor index)", floor_index);
+    IntegerASTNodePtr index = make_literal_node(floor_index);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_BRACKET, "']'", close_bracket);
+    CHECK_TOKEN_AND_CONSUME(lexer::EQ, "'='", equals);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::INTEGER, "an integer (value)", value_token);
+    IntegerASTNodePtr value = make_literal_node(value_token);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    auto assignment = _arena->make<FloorAssignmentASTNode>(first_token.offset(), NO_SOURCE_OFFSET, index, value);
+    SET_AST_NODE(assignment);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_floor_max_statement(int &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::INIT, "'init'", init_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::FLOOR_MAX, "'floor_max'", floor_max_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::EQ, "'='", equals);
+    CHECK_TOKEN_AND_CONSUME(lexer::INTEGER, "an integer (floor max value)", value_token);
+    node = value_token.get_integer();
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_subproc_definition(SubprocDefinitionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    StringId subproc_name;
+    VariableDeclarationASTNodePtr formal_parameter;
+    StatementBlockASTNodePtr body;
+
+    CHECK_TOKEN_AND_CONSUME(lexer::SUBWORD, "'sub'", sub_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (subproc name)", _);
+    subproc_name = TO_NAME();
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
+
+    UPDATE_TOKEN_LOOKAHEAD();
+    if (TOKEN_IS(lexer::IDENTIFIER)) {
+        CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (formal parameter)", parameter_token);
+        formal_parameter = make_parameter_node(parameter_token);
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_paren);
+    bool ok = parse_statement_block(body);
+    CHECK_ERROR(ok);
+
+    SET_AST_NODE(subproc_name, formal_parameter, body);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_function_definition(FunctionDefinitionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    StringId function_name;
+    VariableDeclarationASTNodePtr formal_parameter;
+    StatementBlockASTNodePtr body;
+
+    CHECK_TOKEN_AND_CONSUME(lexer::FUNCTION, "'function'", func_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (function name)", _);
+    function_name = TO_NAME();
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
+
+    UPDATE_TOKEN_LOOKAHEAD();
+    while (TOKEN_IS(lexer::IDENTIFIER)) {
+        CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (formal parameter)", parameter_token);
+        formal_parameter = make_parameter_node(parameter_token);
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_paren);
+    bool ok = parse_statement_block(body);
+    CHECK_ERROR(ok);
+
+    SET_AST_NODE(function_name, formal_parameter, body);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_statement_block(StatementBlockASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    StatementsVector statements;
+
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_BRACE, "'{'", open_brace);
+
+    // zero or more statements
+    UPDATE_TOKEN_LOOKAHEAD();
+
+    while (!TOKEN_IS(lexer::CLOSE_BRACE)) {
+        AbstractStatementASTNodePtr stmt;
+        bool ok = parse_statement(stmt);
+        CHECK_ERROR(ok);
+        statements.push_back(stmt);
+
+        UPDATE_TOKEN_LOOKAHEAD();
+    }
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_BRACE, "'}'", close_brace);
+
+    SET_AST_NODE(statements);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_variable_declaration_statement(VariableDeclarationASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    bool ok = parse_variable_declaration(node);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_statement(AbstractStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    bool ok;
+    // statement
+    //        = variable_declaration_statement
+    //        | embedded_statement;
+
+    VariableDeclarationASTNodePtr var_decl;
+    AbstractEmbeddedStatementASTNodePtr embedded_statement;
+
+    switch (PREDICT(statement)) {
+    case ALTERNATIVE(statement, variable_declaration_statement):
+        ok = parse_variable_declaration_statement(var_decl);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(var_decl);
+        break;
+    case ALTERNATIVE(statement, embedded_statement):
+        ok = parse_embedded_statement(embedded_statement);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(embedded_statement);
+        break;
+    default:
+        CHECK_ERROR_MSG(false, 2004, "Expect a statement but got '" + std::string(token.token_text()) + "'", first_token.lineno(), first_token.colno(), first_token.width());
+    }
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_variable_declaration(VariableDeclarationASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    StringId var_name;
+    VariableAssignmentASTNodePtr assignment;
+
+    CHECK_TOKEN_AND_CONSUME(lexer::LET, "let", let_token);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", _);
+    var_name = TO_NAME();
+
+    UPDATE_TOKEN_LOOKAHEAD();
+    // optional assignment?
+    if (TOKEN_IS(lexer::EQ)) {
+        CHECK_TOKEN_AND_CONSUME(lexer::EQ, "'='", equals);
+        AbstractExpressionASTNodePtr expr;
+        bool ok = parse_expression(expr);
+        CHECK_ERROR(ok);
+        assignment = _arena->make<VariableAssignmentASTNode>(equals.offset(), NO_SOURCE_OFFSET, var_name, expr);
+    }
+
+    SET_AST_NODE(var_name, assignment);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_floor_assignment_statement(FloorAssignmentASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    bool ok = parse_floor_assignment(node);
+    CHECK_ERROR(ok);
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_floor_assignment(FloorAssignmentASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    FloorAccessASTNodePtr floor_access;
+    AbstractExpressionASTNodePtr expr;
+
+    bool ok;
+    ok = parse_floor_access(floor_access);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::EQ, "'='", equals);
+
+    ok = parse_expression(expr);
+    CHECK_ERROR(ok);
+
+    SET_AST_NODE(floor_access->get_index_expr(), expr);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_variable_assignment_statement(VariableAssignmentASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    bool ok;
+    ok = parse_variable_assignment(node);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_variable_assignment(VariableAssignmentASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", _);
+    StringId variable = TO_NAME();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::EQ, "'='", equals);
+
+    AbstractExpressionASTNodePtr expr;
+    bool ok = parse_expression(expr);
+    CHECK_ERROR(ok);
+
+    SET_AST_NODE(variable, expr);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_embedded_statement(AbstractEmbeddedStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    ForStatementASTNodePtr for_statement;
+    IfStatementASTNodePtr if_statement;
+    ReturnStatementASTNodePtr return_statement;
+    StatementBlockASTNodePtr statement_block;
+    EmptyStatementASTNodePtr empty_statement;
+    WhileStatementASTNodePtr while_statement;
+    FloorAssignmentASTNodePtr floor_assignment;
+    VariableAssignmentASTNodePtr var_assignment;
+    InvocationExpressionASTNodePtr invocation;
+    bool ok;
+
+    switch (PREDICT(embedded_statement)) {
+    case ALTERNATIVE(embedded_statement, floor_assignment_statement):
+        ok = parse_floor_assignment_statement(floor_assignment);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(floor_assignment);
+        break;
+    case EBNF_CONFLICT: // invocation_statement, variable_assignment_statement. Both start with an identifier.
+    {
+        std::size_t backtrack_point = _token_pointer;
+        ok = parse_invocation_statement(invocation);
+        if (ok) {
+            SET_NODE_FROM(invocation);
+        } else {
+            _token_pointer = backtrack_point;
+            ok = parse_variable_assignment_statement(var_assignment);
+            CHECK_ERROR(ok);
+            CLEAR_ERROR_BEYOND();
+            SET_NODE_FROM(var_assignment);
+        }
+        break;
+    }
+    case ALTERNATIVE(embedded_statement, iteration_statement):
+        if (PREDICT(iteration_statement) == ALTERNATIVE(iteration_statement, for_statement)) {
+            ok = parse_for_statement(for_statement);
+            CHECK_ERROR(ok);
+            SET_NODE_FROM(for_statement);
+        } else {
+            ok = parse_while_statement(while_statement);
+            CHECK_ERROR(ok);
+            SET_NODE_FROM(while_statement);
+        }
+        break;
+    case ALTERNATIVE(embedded_statement, selection_statement):
+        ok = parse_if_statement(if_statement);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(if_statement);
+        break;
+    case ALTERNATIVE(embedded_statement, statement_block):
+        ok = parse_statement_block(statement_block);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(statement_block);
+        break;
+    case ALTERNATIVE(embedded_statement, return_statement):
+        ok = parse_return_statement(return_statement);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(return_statement);
+        break;
+    case ALTERNATIVE(embedded_statement, break_statement):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::BREAK, "'break'", break_token);
+        CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+        SET_NODE_FROM(_arena->make<BreakStatementASTNode>(break_token.offset(), NO_SOURCE_OFFSET));
+        break;
+    }
+    case ALTERNATIVE(embedded_statement, continue_statement):
+    {
+        CHECK_TOKEN_AND_CONSUME(lexer::CONTINUE, "'continue'", cont_token);
+        CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+        SET_NODE_FROM(_arena->make<ContinueStatementASTNode>(cont_token.offset(), NO_SOURCE_OFFSET));
+        break;
+    }
+    case ALTERNATIVE(embedded_statement, empty_statement):
+        ok = parse_empty_statement(empty_statement);
+        CHECK_ERROR(ok);
+        SET_NODE_FROM(empty_statement);
+        break;
+    default:
+        CHECK_ERROR_MSG(false,
+            2005,
+            "Expect an embedded statement but got '"
+                + std::string(token.token_text())
+                + "'. (Embedded statement is iteration/selection/return/empty/break/continue statement or a statement block).",
+            first_token.lineno(), first_token.colno(), first_token.width());
+    }
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_floor_access(FloorAccessASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::FLOOR, "'floor'", floor_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_BRACKET, "'['", open_bracket);
+
+    AbstractExpressionASTNodePtr expr;
+    bool ok = parse_expression(expr);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_BRACKET, "']'", close_bracket);
+
+    SET_AST_NODE(expr);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_if_statement(IfStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::IF, "'if'", if_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_bracket);
+
+    bool ok;
+    AbstractExpressionASTNodePtr cond;
+    AbstractEmbeddedStatementASTNodePtr then_stmt;
+    AbstractEmbeddedStatementASTNodePtr else_stmt;
+
+    ok = parse_expression(cond);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_bracket);
+
+    ok = parse_embedded_statement(then_stmt);
+    CHECK_ERROR(ok);
+
+    UPDATE_TOKEN_LOOKAHEAD();
+    if (TOKEN_IS(lexer::ELSE)) {
+        CHECK_TOKEN_AND_CONSUME(lexer::ELSE, "'else'", else_token);
+
+        ok = parse_embedded_statement(else_stmt);
+        CHECK_ERROR(ok);
+    }
+
+    SET_AST_NODE(cond, then_stmt, else_stmt);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_while_statement(WhileStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::WHILE, "'while'", while_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
+
+    bool ok;
+    AbstractExpressionASTNodePtr expr;
+    AbstractEmbeddedStatementASTNodePtr body;
+
+    ok = parse_expression(expr);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_paren);
+
+    ok = parse_embedded_statement(body);
+    CHECK_ERROR(ok);
+
+    SET_AST_NODE(expr, body);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_for_statement(ForStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::FOR, "'for'", for_token);
+    CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
+
+    bool ok;
+
+    VariableAssignmentASTNodePtr init_var_assignment;
+    VariableDeclarationASTNodePtr init_var_declaration;
+    AbstractExpressionASTNodePtr cond;
+    AbstractExpressionASTNodePtr update;
+    AbstractEmbeddedStatementASTNodePtr body;
+
+    // optional init stmt
+    UPDATE_TOKEN_LOOKAHEAD();
+    if (TOKEN_STARTS(variable_assignment)) {
+        ok = parse_variable_assignment(init_var_assignment);
+        CHECK_ERROR(ok);
+    } else if (TOKEN_STARTS(variable_declaration)) {
+        ok = parse_variable_declaration(init_var_declaration);
+        CHECK_ERROR(ok);
+    } else if (token.token_id() != lexer::COMMA) {
+        CHECK_ERROR_MSG(
+            false, 2006,
+            "Init statement of 'for' loop should either be variable assignment or variable declaration",
+            token.lineno(), token.colno(), token.width());
+    }
+
+    CHECK_TOKEN_AND_CONSUME(lexer::COMMA, "','", comma1);
+
+    // optional cond stmt
+    UPDATE_TOKEN_LOOKAHEAD();
+    if (token.token_id() != lexer::COMMA) {
+        ok = parse_expression(cond);
+        CHECK_ERROR(ok);
+    }
+
+    CHECK_TOKEN_AND_CONSUME(lexer::COMMA, "','", comma2);
+
+    // optional update stmt
+    UPDATE_TOKEN_LOOKAHEAD();
+    if (token.token_id() != lexer::COMMA) {
+        ok = parse_expression(update);
+        CHECK_ERROR(ok);
+    }
+
+    CHECK_TOKEN_AND_CONSUME(lexer::CLOSE_PAREN, "')'", close_paren);
+
+    ok = parse_embedded_statement(body);
+    CHECK_ERROR(ok);
+
+    AbstractStatementASTNodePtr init;
+    if (init_var_assignment) {
+        init = init_var_assignment;
+    } else if (init_var_declaration) {
+        init = init_var_declaration;
+    } else {
+        spdlog::critical("unexpected code reached, neither var asgn nor var decl. {}", __PRETTY_FUNCTION__);
+        throw; // not supposed to be here
+    }
+
+    SET_AST_NODE(init, cond, update, body);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_return_statement(ReturnStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::RETURN, "'return'", return_token);
+    AbstractExpressionASTNodePtr expr;
+
+    UPDATE_TOKEN_LOOKAHEAD();
+    if (token.token_id() != lexer::T) {
+        bool ok;
+        ok = parse_expression(expr);
+        CHECK_ERROR(ok);
+    }
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    SET_AST_NODE(expr);
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_empty_statement(EmptyStatementASTNodePtr &node)
+{
+    BEGIN_PARSE();
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    SET_AST_NODE();
+
+    END_PARSE();
+}
+
+bool ASTParser::parse_invocation_statement(InvocationExpressionASTNodePtr &node)
+{
+    BEGIN_PARSE();
+    bool ok = parse_invocation_expression(node);
+    CHECK_ERROR(ok);
+
+    CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
+
+    END_PARSE();
+}
+
+CLOSE_PARSER_NAMESPACE
+
+// end
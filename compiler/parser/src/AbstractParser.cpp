@@ -0,0 +1,70 @@
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include "ErrorManager.h"
+#include "HRLToken.h" // IWYU pragma: keep
+#include "AbstractParser.h"
+#include "parser_global.h"
+
+OPEN_PARSER_NAMESPACE
+
+void AbstractParser::push_error(const std::string &expect, const lexer::TokenRef &got, int lineno, int colno, std::size_t width)
+{
+    auto err_str = boost::format("Expect %1% but got '%2%'") % expect % got.token_text();
+    _errors.emplace_back(
+        2001,
+        ErrorSeverity::Error,
+        ErrorLocation(_filename,
+            lineno != -1 ? lineno : got.lineno(),
+            colno != -1 ? colno : got.colno(),
+            width == 0 ? got.width() : 0),
+        err_str.str());
+}
+
+void AbstractParser::report_errors()
+{
+    auto &errmgr = ErrorManager::instance();
+    for (const auto &err : _errors) {
+        errmgr.report(err);
+    }
+
+    _errors.clear();
+}
+
+void AbstractParser::push_error(int errid, const std::string &message, int lineno, int colno, std::size_t width)
+{
+    _errors.emplace_back(errid, ErrorSeverity::Error, ErrorLocation(_filename, lineno, colno, width), message);
+}
+
+void AbstractParser::pop_error()
+{
+    _errors.pop_back();
+}
+
+void AbstractParser::pop_error_till(std::list<CompilerMessage>::iterator till_exclusive)
+{
+    while (!_errors.empty() && std::prev(_errors.end()) != till_exclusive) {
+        _errors.pop_back();
+    }
+}
+
+lexer::TokenRef AbstractParser::lookahead(std::size_t distance) const
+{
+    if (_token_pointer + distance < _tokens.size()) {
+        return _tokens[_token_pointer + distance];
+    } else {
+        return lexer::TokenRef();
+    }
+}
+
+void AbstractParser::consume()
+{
+    ++_token_pointer;
+}
+
+CLOSE_PARSER_NAMESPACE
+// end
@@ -4,6 +4,7 @@
 #include <iterator>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -302,15 +303,15 @@ void ParseTreeNodeFormatterVisitor::visit(CompilationUnitPTNodePtr node)
     traverse_subroutines(node->get_subroutines());
 }
 
-bool ParseTreeNodeFormatterVisitor::process_preceding_metadata(lexer::TokenPtr token)
+bool ParseTreeNodeFormatterVisitor::process_preceding_metadata(const lexer::TokenRef &token)
 {
-    const std::vector<lexer::TokenMetadata> &token_metadata = token->metadata();
+    std::span<const lexer::TokenMetadata> token_metadata = token.metadata();
 
     if (token_metadata.empty()) {
         return false;
     }
 
-    auto list = token_metadata;
+    std::vector<lexer::TokenMetadata> list(token_metadata.begin(), token_metadata.end());
     auto last = std::unique(list.begin(), list.end(),
         [](const lexer::TokenMetadata &first, const lexer::TokenMetadata &second) {
             return first.type == lexer::TokenMetadata::Newline && second.type == lexer::TokenMetadata::Newline;
@@ -368,7 +369,7 @@ bool ParseTreeNodeFormatterVisitor::process_preceding_metadata(lexer::TokenPtr t
     return true;
 }
 
-void ParseTreeNodeFormatterVisitor::create_line(lexer::TokenPtr token, bool add_space_after)
+void ParseTreeNodeFormatterVisitor::create_line(const lexer::TokenRef &token, bool add_space_after)
 {
     if (token) {
         _lines.emplace_back(_indent_level, get_text_from_token(token));
@@ -380,7 +381,7 @@ void ParseTreeNodeFormatterVisitor::create_line(lexer::TokenPtr token, bool add_
     }
 }
 
-void ParseTreeNodeFormatterVisitor::append_line(lexer::TokenPtr token, bool add_space_before, bool add_space_after)
+void ParseTreeNodeFormatterVisitor::append_line(const lexer::TokenRef &token, bool add_space_before, bool add_space_after)
 {
     if (token) {
         if (_lines.empty()) {
@@ -464,17 +465,17 @@ void ParseTreeNodeFormatterVisitor::traverse_statements(const std::vector<Abstra
     }
 }
 
-std::string ParseTreeNodeFormatterVisitor::strip_comment(StringPtr comment)
+std::string ParseTreeNodeFormatterVisitor::strip_comment(std::string_view comment)
 {
-    std::string str = *comment;
+    std::string str(comment);
     boost::algorithm::trim(str);
     return str;
 }
 
-std::string ParseTreeNodeFormatterVisitor::get_text_from_token(lexer::TokenPtr token)
+std::string ParseTreeNodeFormatterVisitor::get_text_from_token(const lexer::TokenRef &token)
 {
-    if (!(token->token_text()) || token->token_text()->empty()) {
-        switch (token->token_id()) {
+    if (token.token_text().empty()) {
+        switch (token.token_id()) {
         case lexer::END:
             return "<EOF>";
         case lexer::IMPORT:
@@ -561,7 +562,7 @@ std::string ParseTreeNodeFormatterVisitor::get_text_from_token(lexer::TokenPtr t
             return "<unknown>";
         }
     } else {
-        return *token->token_text();
+        return std::string(token.token_text());
     }
 }
 
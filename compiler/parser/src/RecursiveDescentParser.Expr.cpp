@@ -13,7 +13,7 @@ OPEN_PARSER_NAMESPACE
 
 bool RecursiveDescentParser::parse_expression(AbstractExpressionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
     bool ok;
 
     AbstractUnaryExpressionPTNodePtr lhs;
@@ -23,20 +23,20 @@ bool RecursiveDescentParser::parse_expression(AbstractExpressionPTNodePtr &node)
     ok = parse_precedence_climbing(node, lhs, 0);
     CHECK_ERROR(ok);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 // Precedence climbing works both for binary and unary expression
 bool RecursiveDescentParser::parse_precedence_climbing(AbstractExpressionPTNodePtr &result, AbstractExpressionPTNodePtr lhs, int min_precedence)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
-    while (lexer::is_token_binary_operator(token->token_id())
-        && BinaryOperatorPTNode::get_operator_precedence(token->token_id()) >= min_precedence) {
+    while (lexer::is_token_binary_operator(token.token_id())
+        && BinaryOperatorPTNode::get_operator_precedence(token.token_id()) >= min_precedence) {
 
         bool ok;
         BinaryOperatorPTNodePtr op = std::make_shared<BinaryOperatorPTNode>(token);
-        int current_precedence = BinaryOperatorPTNode::get_operator_precedence(token->token_id());
+        int current_precedence = BinaryOperatorPTNode::get_operator_precedence(token.token_id());
         CONSUME_TOKEN();
 
         AbstractUnaryExpressionPTNodePtr rhs_unary;
@@ -47,10 +47,10 @@ bool RecursiveDescentParser::parse_precedence_climbing(AbstractExpressionPTNodeP
 
         UPDATE_TOKEN_LOOKAHEAD();
 
-        while (lexer::is_token_binary_operator(token->token_id())) {
-            bool is_left_assoc = BinaryOperatorPTNode::get_operator_associativity(token->token_id()) == BinaryOperatorPTNode::LEFT_TO_RIGHT;
+        while (lexer::is_token_binary_operator(token.token_id())) {
+            bool is_left_assoc = BinaryOperatorPTNode::get_operator_associativity(token.token_id()) == BinaryOperatorPTNode::LEFT_TO_RIGHT;
             bool is_right_assoc = !is_left_assoc;
-            int lookahead_precedence = BinaryOperatorPTNode::get_operator_precedence(token->token_id());
+            int lookahead_precedence = BinaryOperatorPTNode::get_operator_precedence(token.token_id());
 
             if ((is_left_assoc && lookahead_precedence > current_precedence) || (is_right_assoc && lookahead_precedence >= current_precedence)) {
                 AbstractExpressionPTNodePtr rhs_result;
@@ -67,86 +67,82 @@ bool RecursiveDescentParser::parse_precedence_climbing(AbstractExpressionPTNodeP
                 break;
             }
         }
-        lhs = std::make_shared<BinaryExpressionPTNode>(token->lineno(), token->colno(), lhs, op, rhs);
+        lhs = std::make_shared<BinaryExpressionPTNode>(token.lineno(), token.colno(), lhs, op, rhs);
     }
 
     result = lhs;
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_unary_expression(AbstractUnaryExpressionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     bool ok;
     AbstractPrimaryExpressionPTNodePtr primary;
 
-    switch (token->token_id()) {
-    case lexer::ADD: // positive_expression
+    switch (PREDICT(unary_expression)) {
+    case ALTERNATIVE(unary_expression, positive_expression):
     {
         CHECK_TOKEN_AND_CONSUME(lexer::ADD, "'+'", add_token);
         ok = parse_primary_expression(primary);
         CHECK_ERROR(ok);
-        SET_NODE_FROM(std::make_shared<PositiveExpressionPTNode>(lineno, colno, primary, add_token));
+        SET_NODE_FROM(std::make_shared<PositiveExpressionPTNode>(first_token.lineno(), first_token.colno(), primary, add_token));
         break;
     }
 
-    case lexer::SUB: // negative_expression
+    case ALTERNATIVE(unary_expression, negative_expression):
     {
         CHECK_TOKEN_AND_CONSUME(lexer::SUB, "'-'", sub_token);
         ok = parse_primary_expression(primary);
         CHECK_ERROR(ok);
-        SET_NODE_FROM(std::make_shared<NegativeExpressionPTNode>(lineno, colno, primary, sub_token));
+        SET_NODE_FROM(std::make_shared<NegativeExpressionPTNode>(first_token.lineno(), first_token.colno(), primary, sub_token));
         break;
     }
 
-    case lexer::ADDADD: // increment_expression
+    case ALTERNATIVE(unary_expression, increment_expression):
     {
         CHECK_TOKEN_AND_CONSUME(lexer::ADDADD, "'++'", inc_token);
         CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", id_token);
-        SET_NODE_FROM(std::make_shared<IncrementExpressionPTNode>(lineno, colno, TO_IDENTIFIER_NODE(), inc_token));
+        SET_NODE_FROM(std::make_shared<IncrementExpressionPTNode>(first_token.lineno(), first_token.colno(), TO_IDENTIFIER_NODE(), inc_token));
         break;
     }
 
-    case lexer::SUBSUB: // decrement_expression
+    case ALTERNATIVE(unary_expression, decrement_expression):
     {
         DecrementExpressionPTNodePtr decrement;
         CHECK_TOKEN_AND_CONSUME(lexer::SUBSUB, "'--'", dec_token);
         CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", id_token);
-        SET_NODE_FROM(std::make_shared<DecrementExpressionPTNode>(lineno, colno, TO_IDENTIFIER_NODE(), dec_token));
+        SET_NODE_FROM(std::make_shared<DecrementExpressionPTNode>(first_token.lineno(), first_token.colno(), TO_IDENTIFIER_NODE(), dec_token));
         break;
     }
 
-    case lexer::NOT: // not_expression
+    case ALTERNATIVE(unary_expression, not_expression):
     {
         CHECK_TOKEN_AND_CONSUME(lexer::NOT, "'!'", not_token);
         ok = parse_primary_expression(primary);
         CHECK_ERROR(ok);
-        SET_NODE_FROM(std::make_shared<NotExpressionPTNode>(lineno, colno, primary, not_token));
+        SET_NODE_FROM(std::make_shared<NotExpressionPTNode>(first_token.lineno(), first_token.colno(), primary, not_token));
         break;
     }
 
-    case lexer::BOOLEAN: // primary_expression
-    case lexer::FLOOR: // primary_expression
-    case lexer::IDENTIFIER: // primary_expression
-    case lexer::INTEGER: // primary_expression
-    case lexer::OPEN_PAREN: // primary_expression
+    case ALTERNATIVE(unary_expression, primary_expression):
         ok = parse_primary_expression(primary);
         CHECK_ERROR(ok);
         SET_NODE_FROM(primary);
         break;
 
     default:
-        CHECK_ERROR_MSG(false, 2007, "Expect a unary expression but got '" + *token->token_text(), token->lineno(), token->colno(), token->width());
+        CHECK_ERROR_MSG(false, 2007, "Expect a unary expression but got '" + std::string(token.token_text()), token.lineno(), token.colno(), token.width());
     }
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_primary_expression(AbstractPrimaryExpressionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     bool ok;
     BooleanLiteralPTNodePtr bool_literal;
@@ -156,49 +152,53 @@ bool RecursiveDescentParser::parse_primary_expression(AbstractPrimaryExpressionP
     ParenthesizedExpressionPTNodePtr parenthesized_expr;
     InvocationExpressionPTNodePtr invocation;
 
-    switch (token->token_id()) {
-    case lexer::BOOLEAN: // literal
-        bool_literal = TO_BOOLEAN_NODE();
-        CONSUME_TOKEN();
-        SET_NODE_FROM(bool_literal);
+    switch (PREDICT(primary_expression)) {
+    case ALTERNATIVE(primary_expression, literal):
+        if (PREDICT(literal) == ALTERNATIVE(literal, BOOLEAN)) {
+            bool_literal = TO_BOOLEAN_NODE();
+            CONSUME_TOKEN();
+            SET_NODE_FROM(bool_literal);
+        } else {
+            int_literal = TO_INTEGER_NODE();
+            CONSUME_TOKEN();
+            SET_NODE_FROM(int_literal);
+        }
         break;
-    case lexer::FLOOR: // floor_access
+    case ALTERNATIVE(primary_expression, floor_access):
         ok = parse_floor_access(floor_access);
         CHECK_ERROR(ok);
         node = std::static_pointer_cast<AbstractPrimaryExpressionPTNode>(floor_access);
         break;
-    case lexer::IDENTIFIER: // invocation_expression, variable
-        // it's either an invocation or a variable
+    case EBNF_CONFLICT: // invocation_expression, variable_name. Both start with an identifier.
+    {
+        std::size_t backtrack_point = _token_pointer;
         ok = parse_invocation_expression(invocation);
         if (ok) {
             SET_NODE_FROM(invocation);
         } else {
+            _token_pointer = backtrack_point;
             CLEAR_ERROR_BEYOND();
             id = TO_IDENTIFIER_NODE();
             CONSUME_TOKEN();
             SET_NODE_FROM(id);
         }
         break;
-    case lexer::INTEGER: // literal
-        int_literal = TO_INTEGER_NODE();
-        CONSUME_TOKEN();
-        SET_NODE_FROM(int_literal);
-        break;
-    case lexer::OPEN_PAREN: // parenthesized_expression
+    }
+    case ALTERNATIVE(primary_expression, parenthesized_expression):
         ok = parse_parenthesized_expression(parenthesized_expr);
         CHECK_ERROR(ok);
         SET_NODE_FROM(parenthesized_expr);
         break;
     default:
-        CHECK_ERROR_MSG(false, 2008, "Expect a primary expression (literal/floor access/invocation/parenthesized) but got '" + *token->token_text() + "'", token->lineno(), token->colno(), token->width());
+        CHECK_ERROR_MSG(false, 2008, "Expect a primary expression (literal/floor access/invocation/parenthesized) but got '" + std::string(token.token_text()) + "'", token.lineno(), token.colno(), token.width());
     }
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_invocation_expression(InvocationExpressionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IdentifierPTNodePtr func_name;
     AbstractExpressionPTNodePtr arg;
@@ -219,12 +219,12 @@ bool RecursiveDescentParser::parse_invocation_expression(InvocationExpressionPTN
 
     SET_NODE(func_name, arg, open_paren, close_paren);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_parenthesized_expression(ParenthesizedExpressionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
 
@@ -236,7 +236,7 @@ bool RecursiveDescentParser::parse_parenthesized_expression(ParenthesizedExpress
 
     SET_NODE(expr, open_paren, close_paren);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 CLOSE_PARSER_NAMESPACE
@@ -14,7 +14,7 @@ OPEN_PARSER_NAMESPACE
 
 bool RecursiveDescentParser::parse_compilation_unit(CompilationUnitPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     std::vector<ImportDirectivePTNodePtr> imports;
     std::vector<FloorBoxInitStatementPTNodePtr> floor_inits;
@@ -34,33 +34,32 @@ bool RecursiveDescentParser::parse_compilation_unit(CompilationUnitPTNodePtr &no
     }
 
     // Then floor_box_init_statement and floor_max_init_statement in any order
-    // They both starts with 'init'
+    // They both starts with 'init', the token after it tells which
     while (TOKEN_IS(lexer::INIT)) {
-        FloorBoxInitStatementPTNodePtr init;
-        bool ok = parse_floor_box_init_statement(init);
-        if (ok) {
+        lexer::TokenId next = lookahead(1).token_id();
+        if (next == lexer::FLOOR) {
+            FloorBoxInitStatementPTNodePtr init;
+            bool ok = parse_floor_box_init_statement(init);
+            CHECK_ERROR(ok);
             floor_inits.push_back(init);
         } else {
             // It's either floor init or floor max
-            FloorMaxInitStatementPTNodePtr max;
-            ok = parse_floor_max_statement(max);
-
-            // if !ok
             CHECK_ERROR_MSG(
-                ok,
+                next == lexer::FLOOR_MAX,
                 2002,
                 "Expect either 'init floor' or 'init floor_max' statement.",
-                token->lineno(), token->colno(), token->width());
+                token.lineno(), token.colno(), token.width());
 
-            // clear the error of parse floor box init failure
-            CLEAR_ERROR_BEYOND();
+            FloorMaxInitStatementPTNodePtr max;
+            bool ok = parse_floor_max_statement(max);
+            CHECK_ERROR(ok);
 
             // floor max already set? there can be only one.
             CHECK_ERROR_MSG(
                 !floor_max, // cannot be true. true means set already
                 2003,
                 "Maximum one 'init floor_max' allowed",
-                token->lineno(), token->colno(), token->width());
+                token.lineno(), token.colno(), token.width());
 
             floor_max.swap(max);
         }
@@ -70,39 +69,36 @@ bool RecursiveDescentParser::parse_compilation_unit(CompilationUnitPTNodePtr &no
 
     // Then variable_declaration_statement and function_definition and subproc_definition in any order
     bool ok = false;
-    do {
-        if (TOKEN_IS(lexer::LET)) {
+    while (TOKEN_STARTS(variable_declaration_statement) || TOKEN_STARTS(function_definition) || TOKEN_STARTS(subproc_definition)) {
+        if (TOKEN_STARTS(variable_declaration_statement)) {
             VariableDeclarationStatementPTNodePtr var;
             ok = parse_variable_declaration_statement(var);
             CHECK_ERROR(ok);
 
             variable_declarations.push_back(var);
-        } else if (TOKEN_IS(lexer::FUNCTION)) {
+        } else if (TOKEN_STARTS(function_definition)) {
             FunctionDefinitionPTNodePtr func;
             ok = parse_function_definition(func);
             CHECK_ERROR(ok);
 
             subroutine_definitions.push_back(func);
-        } else if (TOKEN_IS(lexer::SUBWORD)) {
+        } else {
             SubprocDefinitionPTNodePtr sub;
             ok = parse_subproc_definition(sub);
             CHECK_ERROR(ok);
 
             subroutine_definitions.push_back(sub);
-        } else {
-            spdlog::critical("unexpected code reached, the token is {}. {}", static_cast<int>(token->token_id()), __PRETTY_FUNCTION__);
-            throw; // won't be here
         }
 
         UPDATE_TOKEN_LOOKAHEAD();
-    } while (TOKEN_IS(lexer::LET) || TOKEN_IS(lexer::FUNCTION) || TOKEN_IS(lexer::SUBWORD));
+    }
 
     CHECK_TOKEN_AND_CONSUME(lexer::END, "a variable, function/subproc declaration or end of file", eof);
 
     SET_NODE(imports, floor_inits, floor_max,
         variable_declarations, subroutine_definitions);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse(CompilationUnitPTNodePtr &result)
@@ -118,7 +114,7 @@ bool RecursiveDescentParser::parse(CompilationUnitPTNodePtr &result)
 
 bool RecursiveDescentParser::parse_import_directive(ImportDirectivePTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IdentifierPTNodePtr identifier;
 
@@ -131,12 +127,12 @@ bool RecursiveDescentParser::parse_import_directive(ImportDirectivePTNodePtr &no
 
     SET_NODE(identifier, import_token, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_floor_box_init_statement(FloorBoxInitStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IntegerLiteralPTNodePtr index, value;
 
@@ -157,12 +153,12 @@ bool RecursiveDescentParser::parse_floor_box_init_statement(FloorBoxInitStatemen
 
     SET_NODE(index, value, init_token, floor_token, open_bracket, floor_index, close_bracket, equals, value_token, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_floor_max_statement(FloorMaxInitStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IntegerLiteralPTNodePtr max;
 
@@ -175,12 +171,12 @@ bool RecursiveDescentParser::parse_floor_max_statement(FloorMaxInitStatementPTNo
 
     SET_NODE(max, init_token, floor_max_token, equals, value_token, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_subproc_definition(SubprocDefinitionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IdentifierPTNodePtr subproc_name;
     IdentifierPTNodePtr formal_parameter;
@@ -203,12 +199,12 @@ bool RecursiveDescentParser::parse_subproc_definition(SubprocDefinitionPTNodePtr
 
     SET_NODE(subproc_name, formal_parameter, body, sub_token, open_paren, close_paren);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_function_definition(FunctionDefinitionPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IdentifierPTNodePtr function_name;
     IdentifierPTNodePtr formal_parameter;
@@ -231,12 +227,12 @@ bool RecursiveDescentParser::parse_function_definition(FunctionDefinitionPTNodeP
 
     SET_NODE(function_name, formal_parameter, body, func_token, open_paren, close_paren);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_statement_block(StatementBlockPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     std::vector<AbstractStatementPTNodePtr> statements;
 
@@ -258,12 +254,12 @@ bool RecursiveDescentParser::parse_statement_block(StatementBlockPTNodePtr &node
 
     SET_NODE(statements, open_brace, close_brace);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_variable_declaration_statement(VariableDeclarationStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     VariableDeclarationPTNodePtr decl;
     bool ok = parse_variable_declaration(decl);
@@ -273,12 +269,12 @@ bool RecursiveDescentParser::parse_variable_declaration_statement(VariableDeclar
 
     SET_NODE(decl, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_statement(AbstractStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     bool ok;
     // statement
@@ -288,40 +284,31 @@ bool RecursiveDescentParser::parse_statement(AbstractStatementPTNodePtr &node)
     VariableDeclarationStatementPTNodePtr var_decl;
     AbstractEmbeddedStatementPTNodePtr embedded_statement;
 
-    switch (token->token_id()) {
-    case lexer::LET: // variable_declaration_statement
+    switch (PREDICT(statement)) {
+    case ALTERNATIVE(statement, variable_declaration_statement):
         ok = parse_variable_declaration_statement(var_decl);
         CHECK_ERROR(ok);
         SET_NODE_FROM(var_decl);
         break;
-    case lexer::RETURN: // embedded_statement
-    case lexer::T: // embedded_statement
-    case lexer::IF: // embedded_statement
-    case lexer::FOR: // embedded_statement
-    case lexer::WHILE: // embedded_statement
-    case lexer::OPEN_BRACE: // embedded_statement
-    case lexer::FLOOR: // embedded_statement
-    case lexer::IDENTIFIER: // embedded_statement
-    case lexer::BREAK: // embedded_statement
-    case lexer::CONTINUE: // embedded_statement
+    case ALTERNATIVE(statement, embedded_statement):
         ok = parse_embedded_statement(embedded_statement);
         CHECK_ERROR(ok);
         SET_NODE_FROM(embedded_statement);
         break;
     default:
-        CHECK_ERROR_MSG(false, 2004, "Expect a statement but got '" + *token->token_text() + "'", lineno, colno, width);
+        CHECK_ERROR_MSG(false, 2004, "Expect a statement but got '" + std::string(token.token_text()) + "'", first_token.lineno(), first_token.colno(), first_token.width());
     }
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_variable_declaration(VariableDeclarationPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     IdentifierPTNodePtr var_name;
     AbstractExpressionPTNodePtr expr;
-    lexer::TokenPtr eq;
+    lexer::TokenRef eq;
 
     CHECK_TOKEN_AND_CONSUME(lexer::LET, "let", let_token);
 
@@ -339,12 +326,12 @@ bool RecursiveDescentParser::parse_variable_declaration(VariableDeclarationPTNod
 
     SET_NODE(var_name, expr, let_token, eq);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_floor_assignment_statement(FloorAssignmentStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     FloorAssignmentPTNodePtr floor_assignment;
     bool ok = parse_floor_assignment(floor_assignment);
@@ -353,12 +340,12 @@ bool RecursiveDescentParser::parse_floor_assignment_statement(FloorAssignmentSta
 
     SET_NODE(floor_assignment, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_floor_assignment(FloorAssignmentPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     FloorAccessPTNodePtr floor_access;
     AbstractExpressionPTNodePtr expr;
@@ -374,12 +361,12 @@ bool RecursiveDescentParser::parse_floor_assignment(FloorAssignmentPTNodePtr &no
 
     SET_NODE(floor_access, expr, equals);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_variable_assignment_statement(VariableAssignmentStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     VariableAssignmentPTNodePtr variable_assignment;
 
@@ -391,12 +378,12 @@ bool RecursiveDescentParser::parse_variable_assignment_statement(VariableAssignm
 
     SET_NODE(variable_assignment, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_variable_assignment(VariableAssignmentPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::IDENTIFIER, "an identifier (variable name)", _);
     IdentifierPTNodePtr variable = TO_IDENTIFIER_NODE();
@@ -409,12 +396,12 @@ bool RecursiveDescentParser::parse_variable_assignment(VariableAssignmentPTNodeP
 
     SET_NODE(variable, expr, equals);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_embedded_statement(AbstractEmbeddedStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     ForStatementPTNodePtr for_statement;
     IfStatementPTNodePtr if_statement;
@@ -428,65 +415,70 @@ bool RecursiveDescentParser::parse_embedded_statement(AbstractEmbeddedStatementP
     BreakContinueStatementPTNodePtr breakcont;
     bool ok;
 
-    switch (token->token_id()) {
-    case lexer::FLOOR: // floor_assignment_statement
+    switch (PREDICT(embedded_statement)) {
+    case ALTERNATIVE(embedded_statement, floor_assignment_statement):
         ok = parse_floor_assignment_statement(floor_assignment);
         CHECK_ERROR(ok);
         SET_NODE_FROM(floor_assignment);
         break;
-    case lexer::IDENTIFIER: // invocation_statement, variable_assignment_statement
+    case EBNF_CONFLICT: // invocation_statement, variable_assignment_statement. Both start with an identifier.
+    {
+        std::size_t backtrack_point = _token_pointer;
         ok = parse_invocation_statement(invocation);
         if (ok) {
             SET_NODE_FROM(invocation);
         } else {
+            _token_pointer = backtrack_point;
             ok = parse_variable_assignment_statement(var_assignment);
             CHECK_ERROR(ok);
             CLEAR_ERROR_BEYOND();
             SET_NODE_FROM(var_assignment);
         }
         break;
-    case lexer::FOR: // iteration_statement
-        ok = parse_for_statement(for_statement);
-        CHECK_ERROR(ok);
-        SET_NODE_FROM(for_statement);
-        break;
-    case lexer::WHILE: // iteration_statement
-        ok = parse_while_statement(while_statement);
-        CHECK_ERROR(ok);
-        SET_NODE_FROM(while_statement);
+    }
+    case ALTERNATIVE(embedded_statement, iteration_statement):
+        if (PREDICT(iteration_statement) == ALTERNATIVE(iteration_statement, for_statement)) {
+            ok = parse_for_statement(for_statement);
+            CHECK_ERROR(ok);
+            SET_NODE_FROM(for_statement);
+        } else {
+            ok = parse_while_statement(while_statement);
+            CHECK_ERROR(ok);
+            SET_NODE_FROM(while_statement);
+        }
         break;
-    case lexer::IF: // selection_statement
+    case ALTERNATIVE(embedded_statement, selection_statement):
         ok = parse_if_statement(if_statement);
         CHECK_ERROR(ok);
         SET_NODE_FROM(if_statement);
         break;
-    case lexer::OPEN_BRACE: // statement_block
+    case ALTERNATIVE(embedded_statement, statement_block):
         ok = parse_statement_block(statement_block);
         CHECK_ERROR(ok);
         SET_NODE_FROM(statement_block);
         break;
-    case lexer::RETURN: // return_statement
+    case ALTERNATIVE(embedded_statement, return_statement):
         ok = parse_return_statement(return_statement);
         CHECK_ERROR(ok);
         SET_NODE_FROM(return_statement);
         break;
-    case lexer::BREAK: // break_statement
+    case ALTERNATIVE(embedded_statement, break_statement):
     {
         CHECK_TOKEN_AND_CONSUME(lexer::BREAK, "'break'", break_token);
         CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
-        breakcont = std::make_shared<BreakContinueStatementPTNode>(break_token->lineno(), break_token->colno(), true);
+        breakcont = std::make_shared<BreakContinueStatementPTNode>(break_token.lineno(), break_token.colno(), true);
         SET_NODE_FROM(breakcont);
         break;
     }
-    case lexer::CONTINUE: // continue_statement
+    case ALTERNATIVE(embedded_statement, continue_statement):
     {
         CHECK_TOKEN_AND_CONSUME(lexer::CONTINUE, "'continue'", cont_token);
         CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
-        breakcont = std::make_shared<BreakContinueStatementPTNode>(cont_token->lineno(), cont_token->colno(), false);
+        breakcont = std::make_shared<BreakContinueStatementPTNode>(cont_token.lineno(), cont_token.colno(), false);
         SET_NODE_FROM(breakcont);
         break;
     }
-    case lexer::T: // empty_statement
+    case ALTERNATIVE(embedded_statement, empty_statement):
         ok = parse_empty_statement(empty_statement);
         CHECK_ERROR(ok);
         SET_NODE_FROM(empty_statement);
@@ -495,17 +487,17 @@ bool RecursiveDescentParser::parse_embedded_statement(AbstractEmbeddedStatementP
         CHECK_ERROR_MSG(false,
             2005,
             "Expect an embedded statement but got '"
-                + *token->token_text()
+                + std::string(token.token_text())
                 + "'. (Embedded statement is iteration/selection/return/empty/break/continue statement or a statement block).",
-            lineno, colno, width);
+            first_token.lineno(), first_token.colno(), first_token.width());
     }
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_floor_access(FloorAccessPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::FLOOR, "'floor'", floor_token);
     CHECK_TOKEN_AND_CONSUME(lexer::OPEN_BRACKET, "'['", open_bracket);
@@ -518,12 +510,12 @@ bool RecursiveDescentParser::parse_floor_access(FloorAccessPTNodePtr &node)
 
     SET_NODE(expr, floor_token, open_bracket, close_bracket);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_if_statement(IfStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::IF, "'if'", if_token);
     CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_bracket);
@@ -541,7 +533,7 @@ bool RecursiveDescentParser::parse_if_statement(IfStatementPTNodePtr &node)
     ok = parse_embedded_statement(then_stmt);
     CHECK_ERROR(ok);
 
-    lexer::TokenPtr else_token;
+    lexer::TokenRef else_token;
     UPDATE_TOKEN_LOOKAHEAD();
     if (TOKEN_IS(lexer::ELSE)) {
         CHECK_TOKEN_AND_CONSUME(lexer::ELSE, "'else'", else_token_t);
@@ -553,12 +545,12 @@ bool RecursiveDescentParser::parse_if_statement(IfStatementPTNodePtr &node)
 
     SET_NODE(cond, then_stmt, else_stmt, if_token, open_bracket, close_bracket, else_token);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_while_statement(WhileStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::WHILE, "'while'", while_token);
     CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
@@ -577,12 +569,12 @@ bool RecursiveDescentParser::parse_while_statement(WhileStatementPTNodePtr &node
 
     SET_NODE(expr, body, while_token, open_paren, close_paren);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_for_statement(ForStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::FOR, "'for'", for_token);
     CHECK_TOKEN_AND_CONSUME(lexer::OPEN_PAREN, "'('", open_paren);
@@ -597,27 +589,24 @@ bool RecursiveDescentParser::parse_for_statement(ForStatementPTNodePtr &node)
 
     // optional init stmt
     UPDATE_TOKEN_LOOKAHEAD();
-    if (token->token_id() != lexer::COMMA) {
+    if (TOKEN_STARTS(variable_assignment)) {
         ok = parse_variable_assignment(init_var_assignment);
-        // if it's not var assignment, it should be var decl
-        if (!ok) {
-            ok = parse_variable_declaration(init_var_declaration);
-            if (ok) {
-                CLEAR_ERROR_BEYOND();
-            } else {
-                CHECK_ERROR_MSG(
-                    false, 2006,
-                    "Init statement of 'for' loop should either be variable assignment or variable declaration",
-                    token->lineno(), token->colno(), token->width());
-            }
-        }
+        CHECK_ERROR(ok);
+    } else if (TOKEN_STARTS(variable_declaration)) {
+        ok = parse_variable_declaration(init_var_declaration);
+        CHECK_ERROR(ok);
+    } else if (token.token_id() != lexer::COMMA) {
+        CHECK_ERROR_MSG(
+            false, 2006,
+            "Init statement of 'for' loop should either be variable assignment or variable declaration",
+            token.lineno(), token.colno(), token.width());
     }
 
     CHECK_TOKEN_AND_CONSUME(lexer::COMMA, "','", comma1);
 
     // optional cond stmt
     UPDATE_TOKEN_LOOKAHEAD();
-    if (token->token_id() != lexer::COMMA) {
+    if (token.token_id() != lexer::COMMA) {
         ok = parse_expression(cond);
         CHECK_ERROR(ok);
     }
@@ -626,7 +615,7 @@ bool RecursiveDescentParser::parse_for_statement(ForStatementPTNodePtr &node)
 
     // optional update stmt
     UPDATE_TOKEN_LOOKAHEAD();
-    if (token->token_id() != lexer::COMMA) {
+    if (token.token_id() != lexer::COMMA) {
         ok = parse_expression(update);
         CHECK_ERROR(ok);
     }
@@ -645,18 +634,18 @@ bool RecursiveDescentParser::parse_for_statement(ForStatementPTNodePtr &node)
         throw; // not supposed to be here
     }
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_return_statement(ReturnStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::RETURN, "'return'", return_token);
     AbstractExpressionPTNodePtr expr;
 
     UPDATE_TOKEN_LOOKAHEAD();
-    if (token->token_id() != lexer::T) {
+    if (token.token_id() != lexer::T) {
         bool ok;
         ok = parse_expression(expr);
         CHECK_ERROR(ok);
@@ -666,23 +655,23 @@ bool RecursiveDescentParser::parse_return_statement(ReturnStatementPTNodePtr &no
 
     SET_NODE(expr, return_token, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_empty_statement(EmptyStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
 
     CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
 
     SET_NODE(semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 bool RecursiveDescentParser::parse_invocation_statement(InvocationStatementPTNodePtr &node)
 {
-    ENTER_PARSE_FRAME();
+    BEGIN_PARSE();
     InvocationExpressionPTNodePtr invocation;
     bool ok = parse_invocation_expression(invocation);
     CHECK_ERROR(ok);
@@ -690,7 +679,7 @@ bool RecursiveDescentParser::parse_invocation_statement(InvocationStatementPTNod
     CHECK_TOKEN_AND_CONSUME(lexer::T, "';'", semicolon);
     SET_NODE(invocation, semicolon);
 
-    LEAVE_PARSE_FRAME();
+    END_PARSE();
 }
 
 CLOSE_PARSER_NAMESPACE
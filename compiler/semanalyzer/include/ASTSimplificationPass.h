@@ -0,0 +1,50 @@
+#ifndef ASTSIMPLIFICATIONPASS_H
+#define ASTSIMPLIFICATIONPASS_H
+
+#include "ConstantFoldingPass.h"
+#include "DeadCodeEliminationPass.h"
+#include "SemanticAnalysisPass.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+/**
+ * @brief Constant folding and dead code elimination iterated to a fixpoint.
+ *
+ * The first round runs both passes over the whole AST, as they'd run one after another. Each further round runs them
+ * again only on the globals and the subroutines the last round changed, since folding can expose dead branches and
+ * removing code can expose folding. It stops once a round changes nothing, or after MAX_EXTRA_ROUNDS.
+ */
+class ASTSimplificationPass : public SemanticAnalysisPass {
+public:
+    // The most rounds after the first, which bounds the cost on a large AST
+    static constexpr int MAX_EXTRA_ROUNDS = 4;
+
+    ASTSimplificationPass(StringPtr filename, parser::CompilationUnitASTNodePtr root);
+    ~ASTSimplificationPass() override;
+
+    int run() override;
+
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = false,
+            .required_attributes = {},
+            .produced_attributes = { ATTR_SEMANALYZER_CONST_FOLDING_VALUE },
+            .invalidated_attributes = {},
+        };
+    }
+
+private:
+    ConstantFoldingPass _constant_folding;
+    DeadCodeEliminationPass _dead_code_elimination;
+
+    // Run both passes on the parts of the AST in \p region
+    int simplify(const ASTChanges &region);
+    // The changes of both passes since the last call, which are recorded as the changes of this pass too
+    ASTChanges take_round_changes();
+};
+
+CLOSE_SEMANALYZER_NAMESPACE
+
+#endif
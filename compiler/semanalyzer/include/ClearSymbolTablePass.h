@@ -14,6 +14,17 @@ public:
 
     int run() override;
 
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = true,
+            .required_attributes = {},
+            .produced_attributes = {},
+            // the symbols attached to the nodes are gone from the table
+            .invalidated_attributes = { ATTR_SEMANALYZER_SYMBOL },
+        };
+    }
+
 private:
 };
 
@@ -102,6 +102,16 @@ public:
 
     int run() override;
 
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = false,
+            .required_attributes = {},
+            .produced_attributes = { ATTR_SEMANALYZER_CONST_FOLDING_VALUE },
+            .invalidated_attributes = {},
+        };
+    }
+
 protected:
 private:
     void attach_constant(const ASTNodePtr &node, int value, bool is_char);
@@ -1,14 +1,18 @@
 #ifndef CONTROLFLOWVERIFICATIONPASS_H
 #define CONTROLFLOWVERIFICATIONPASS_H
 
+#include <optional>
 #include <stack>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/format.hpp>
 #include <spdlog/spdlog.h>
 
 #include "ASTNode.h"
 #include "ASTNodeAttribute.h"
+#include "FusedPass.h"
 #include "SemanticAnalysisPass.h"
 #include "semanalyzer_global.h"
 
@@ -62,29 +66,33 @@ private:
     parser::ASTNodePtr _context;
 };
 
-class ControlFlowVerificationPass : public SemanticAnalysisPass {
+class ControlFlowVerificationPass : public FusablePass {
 public:
     ControlFlowVerificationPass(StringPtr filename, parser::CompilationUnitASTNodePtr root);
 
     ~ControlFlowVerificationPass() = default;
 
-    int run() override;
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = true,
+            .required_attributes = {},
+            .produced_attributes = { ATTR_SEMANALYZER_CONTROL_CONTEXT_INFO },
+            .invalidated_attributes = {},
+        };
+    }
 
-    // For all visit, the return value of 0 indicate success.
-    int visit(const parser::IfStatementASTNodePtr &node) override;
-    int visit(const parser::WhileStatementASTNodePtr &node) override;
-    int visit(const parser::ForStatementASTNodePtr &node) override;
-    int visit(const parser::ReturnStatementASTNodePtr &node) override;
-    int visit(const parser::BreakStatementASTNodePtr &node) override;
-    int visit(const parser::ContinueStatementASTNodePtr &node) override;
-    // int visit(const parser::StatementBlockASTNodePtr &node) override;
-    int visit(const parser::SubprocDefinitionASTNodePtr &node) override;
-    int visit(const parser::FunctionDefinitionASTNodePtr &node) override;
-    // int visit(const parser::CompilationUnitASTNodePtr &node) override;
+protected:
+    void begin_traversal() override;
+    // For all hooks, the return value of 0 indicate success.
+    int on_node_enter(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors) override;
+    int on_node_leave(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors) override;
 
 private:
     std::stack<bool> _subroutine_requires_return;
     std::stack<bool> _returned_record_stack;
+    // stack<pair<then returned, else returned>> of the if statements entered
+    std::stack<std::pair<std::optional<bool>, std::optional<bool>>> _if_returned_stack;
     void push_return_record();
     void set_return_record(bool returned);
     bool get_return_record();
@@ -101,9 +109,19 @@ private:
      */
     bool _expected_return; // subproc? function?
 
-    int visit_subroutine(const parser::AbstractSubroutineASTNodePtr &node, bool expect_return);
+    int check_return_statement(const parser::ReturnStatementASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors);
+    int check_subroutine_returned(const parser::AbstractSubroutineASTNodePtr &node);
+
+    enum class IfBranch {
+        None,
+        Then,
+        Else,
+    };
+
+    // Which branch of its parent if statement \p node is
+    static IfBranch get_if_branch(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors);
 
-    int check_loop_control_statements(const parser::ASTNodePtr &node);
+    int check_loop_control_statements(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors);
 
     int log_invalid_loop_control_context_error(const parser::ASTNodePtr &node);
     int log_invalid_return_context_error(const parser::ASTNodePtr &node);
@@ -0,0 +1,96 @@
+#ifndef FUSEDPASS_H
+#define FUSEDPASS_H
+
+#include <vector>
+
+#include "ASTNodeForward.h"
+#include "SemanticAnalysisPass.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+/**
+ * @brief A read-only pass which does its work in hooks called on entering and leaving each node, instead of visits
+ * of its own. Since it doesn't decide how the AST is traversed, several of them can share one traversal of FusedPass.
+ *
+ * Returning non-zero from a hook fails the pass, and it sees no more nodes, like a visit returning non-zero.
+ */
+class FusablePass : public SemanticAnalysisPass {
+public:
+    FusablePass(StringPtr filename, parser::CompilationUnitASTNodePtr root)
+        : SemanticAnalysisPass(std::move(filename), std::move(root))
+    {
+    }
+
+    ~FusablePass() override = default;
+
+    // Traverse the AST for this pass alone
+    int run() override;
+
+protected:
+    friend class FusedPass;
+
+    // Reset the state before a traversal
+    virtual void begin_traversal() { }
+
+    // Called in pre-order. \p ancestors are the ancestors of \p node, with the parent at the back.
+    virtual int on_node_enter(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors) = 0;
+
+    // Called in post-order
+    virtual int on_node_leave(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors) = 0;
+};
+
+/**
+ * @brief Runs several fusable passes in one traversal of the AST. It multiplexes each node entered and left to the
+ * hooks of the passes in the order they're added.
+ *
+ * The passes are not owned. Their diagnostics are reported in the order of the nodes instead of pass after pass.
+ */
+class FusedPass : public SemanticAnalysisPass {
+public:
+    FusedPass(StringPtr filename, parser::CompilationUnitASTNodePtr root)
+        : SemanticAnalysisPass(std::move(filename), std::move(root))
+    {
+    }
+
+    ~FusedPass() override = default;
+
+    void add_pass(FusablePass *pass);
+
+    /**
+     * @brief Stop the passes after a failed one, as if they ran one after another and stopped at the failure
+     *
+     * @param fail_fast
+     */
+    void set_fail_fast(bool fail_fast) { _fail_fast = fail_fast; }
+
+    /**
+     * @brief Run all passes in one traversal.
+     *
+     * @return int The result of the first failed pass, or 0
+     */
+    int run() override;
+
+    // The result of the ith pass added
+    int get_result(std::size_t i) const { return _results.at(i); }
+
+    PassTraits get_traits() const override;
+
+protected:
+    void enter_node(const parser::ASTNodePtr &node) override;
+    void leave_node() override;
+
+private:
+    std::vector<FusablePass *> _passes;
+    // the result of each pass. The pass sees no more nodes once it's non-zero.
+    std::vector<int> _results;
+    // the passes after this one are not run. It's _passes.size() unless a pass failed in fail fast
+    std::size_t _active_end = 0;
+    bool _fail_fast = true;
+
+    void set_result(std::size_t i, int rc);
+};
+
+CLOSE_SEMANALYZER_NAMESPACE
+
+#endif
@@ -2,36 +2,18 @@
 #define SCOPEMANAGER_H
 
 #include <memory>
-#include <set>
 #include <stack>
 #include <string>
 #include <vector>
 
 #include "ASTNode.h"
 #include "ASTNodeAttribute.h"
+#include "ScopeTree.h"
 #include "hrl_global.h"
 #include "semanalyzer_global.h"
 
 OPEN_SEMANALYZER_NAMESPACE
 
-enum class ScopeType : int {
-    /**
-     * @brief The global scope, which is at the root of compilation unit.
-     *
-     */
-    Global,
-    /**
-     * @brief The subroutine scope, which is at the root of subroutine.
-     *
-     */
-    Subroutine,
-    /**
-     * @brief The block scope.
-     *
-     */
-    Block,
-};
-
 class ScopeInfoAttribute;
 using ScopeInfoAttributePtr = std::shared_ptr<ScopeInfoAttribute>;
 
@@ -45,7 +27,7 @@ using ScopeInfoAttributePtr = std::shared_ptr<ScopeInfoAttribute>;
  */
 class ScopeInfoAttribute : public parser::ASTNodeAttribute, public parser::GetSetAttribute<ScopeInfoAttribute> {
 public:
-    ScopeInfoAttribute(const std::string &scope_id, ScopeType scope_type)
+    ScopeInfoAttribute(ScopeId scope_id, ScopeType scope_type)
         : _scope_id(scope_id)
         , _type(scope_type)
     {
@@ -53,36 +35,22 @@ public:
 
     ~ScopeInfoAttribute() override = default;
 
-    static int get_attribute_id() { return SemAnalzyerASTNodeAttributeId::ATTR_SEMANALYZER_SYMBOL; }
+    static int get_attribute_id() { return SemAnalzyerASTNodeAttributeId::ATTR_SEMANALYZER_SCOPE_INFO; }
 
     std::string to_string() override;
 
-    const std::string &get_scope_id() const { return _scope_id; }
+    ScopeId get_scope_id() const { return _scope_id; }
 
     ScopeType get_scope_type() const { return _type; }
 
-    static ScopeInfoAttributePtr get_scope(const parser::ASTNodePtr &node)
-    {
-        parser::ASTNodeAttributePtr out;
-        if (node->get_attribute(ATTR_SEMANALYZER_SCOPE_INFO, out)) {
-            return std::static_pointer_cast<ScopeInfoAttribute>(out);
-        } else {
-            return nullptr;
-        }
-    }
+    static ScopeInfoAttributePtr get_scope(const parser::ASTNodePtr &node) { return get_from(node); }
 
-    static void set_scope(const parser::ASTNodePtr &node, const ScopeInfoAttributePtr &scope_info)
-    {
-        node->set_attribute(ATTR_SEMANALYZER_SCOPE_INFO, scope_info);
-    }
+    static void set_scope(const parser::ASTNodePtr &node, const ScopeInfoAttributePtr &scope_info) { set_to(node, scope_info); }
 
-    void attach(const parser::ASTNodePtr &node)
-    {
-        node->set_attribute(ATTR_SEMANALYZER_SCOPE_INFO, shared_from_this());
-    }
+    void attach(const parser::ASTNodePtr &node) { set_to(node); }
 
 private:
-    std::string _scope_id;
+    ScopeId _scope_id;
     ScopeType _type;
 };
 
@@ -93,7 +61,9 @@ private:
  * level, tracking the current scope and its type during the compilation process. It
  * facilitates entering named or anonymous scopes, exiting scopes, and checking for
  * conflicts in scope names. Additionally, it provides utility functions to retrieve
- * the current scope's ID, type, and ancestor scopes.
+ * the current scope's ID and type.
+ *
+ * The scopes entered are added to a ScopeTree, which is usually the one of the symbol table.
  *
  */
 class ScopeManager {
@@ -101,17 +71,16 @@ public:
     ScopeManager();
     ~ScopeManager();
 
-    std::string get_current_scope_id() const;
-
-    ScopeType get_current_scope_type() const { return _current_scopes.back().second; }
-
     /**
-     * @brief Get the ancestor scopes of \p scope_id.
+     * @brief Start over from the global scope of \p tree
      *
-     * @param scope_id
-     * @return std::vector<std::string> Suppose scope_id is a.b.c.d, the function returns { "a.b.c.d", "a.b.c", "a.b", "a", "" }
+     * @param tree The tree the entered scopes are added to. It must outlive the manager or the next reset.
      */
-    static std::vector<std::string> get_ancestor_scopes(const std::string &scope_id);
+    void reset(ScopeTree *tree);
+
+    ScopeId get_current_scope_id() const { return _current_scopes.back(); }
+
+    ScopeType get_current_scope_type() const { return _tree->get_type(_current_scopes.back()); }
 
     /**
      * @brief Enter a scope with \p name.
@@ -140,12 +109,11 @@ public:
      */
     void exit_scope();
 
-    static const char DELIMITER = '.';
-
 private:
-    std::vector<std::pair<std::string, ScopeType>> _current_scopes;
+    ScopeTree *_tree = nullptr;
+    std::vector<ScopeId> _current_scopes;
+    // the next anonymous scope of each scope entered
     std::stack<int> _scope_id;
-    std::set<std::string> _all_scopes;
 };
 
 CLOSE_SEMANALYZER_NAMESPACE
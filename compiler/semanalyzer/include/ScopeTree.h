@@ -0,0 +1,101 @@
+#ifndef SCOPETREE_H
+#define SCOPETREE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+enum class ScopeType : int {
+    /**
+     * @brief The global scope, which is at the root of compilation unit.
+     *
+     */
+    Global,
+    /**
+     * @brief The subroutine scope, which is at the root of subroutine.
+     *
+     */
+    Subroutine,
+    /**
+     * @brief The block scope.
+     *
+     */
+    Block,
+};
+
+/**
+ * @brief The index of a scope in its ScopeTree
+ */
+using ScopeId = std::uint32_t;
+
+constexpr ScopeId NO_SCOPE_ID = UINT32_MAX;
+
+/**
+ * @brief The scopes of a compilation as a tree of integer ids with parent links.
+ *
+ * The library scope is the root, and the global scope is its only child. The ancestors of a scope are found by
+ * following the parents, so a lookup walks a few entries of a vector instead of splitting a scope path.
+ */
+class ScopeTree {
+public:
+    // The scope of the library functions, which is the ancestor of every scope
+    static constexpr ScopeId LIBRARY_SCOPE = 0;
+    // The scope at the root of the compilation unit
+    static constexpr ScopeId GLOBAL_SCOPE = 1;
+
+    ScopeTree();
+
+    /**
+     * @brief Add the scope \p name under \p parent.
+     *
+     * @param parent
+     * @param name The name of the scope. It's unique among the children of \p parent.
+     * @param type
+     * @return ScopeId The id of the new scope, or NO_SCOPE_ID if \p parent has a child named \p name already
+     */
+    ScopeId add_scope(ScopeId parent, const std::string &name, ScopeType type);
+
+    // NO_SCOPE_ID for the library scope
+    ScopeId get_parent(ScopeId scope) const { return _scopes[scope].parent; }
+
+    // The library scope is at depth 0
+    unsigned int get_depth(ScopeId scope) const { return _scopes[scope].depth; }
+
+    ScopeType get_type(ScopeId scope) const { return _scopes[scope].type; }
+
+    // \p ancestor is \p scope or one of its ancestors
+    bool is_ancestor_of(ScopeId ancestor, ScopeId scope) const;
+
+    /**
+     * @brief The scope names from the global scope joined by '.', such as glb.main.0. It's built on every call and is
+     * only for printing.
+     */
+    std::string get_path(ScopeId scope) const;
+
+    std::size_t size() const { return _scopes.size(); }
+
+    // Remove every scope except the library and the global scope
+    void clear();
+
+private:
+    struct Scope {
+        ScopeId parent;
+        unsigned int depth;
+        ScopeType type;
+        std::string name;
+    };
+
+    std::vector<Scope> _scopes;
+    // map<pair<parent, name>, scope>
+    std::map<std::pair<ScopeId, std::string>, ScopeId> _children;
+};
+
+CLOSE_SEMANALYZER_NAMESPACE
+
+#endif
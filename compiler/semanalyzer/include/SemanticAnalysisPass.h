@@ -7,6 +7,7 @@
 #include <memory>
 #include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "ASTNode.h"
@@ -16,6 +17,51 @@
 
 OPEN_SEMANALYZER_NAMESPACE
 
+/**
+ * @brief What a pass does to the AST. The pass manager tells from it which passes can share a traversal.
+ *
+ */
+struct PassTraits {
+    /**
+     * @brief The pass doesn't add, remove or replace nodes. It may attach the attributes it produces.
+     *
+     */
+    bool read_only = false;
+    /**
+     * @brief The ids of the attributes the pass reads, which an earlier pass must have attached
+     *
+     */
+    std::set<int> required_attributes;
+    /**
+     * @brief The ids of the attributes the pass attaches
+     *
+     */
+    std::set<int> produced_attributes;
+    /**
+     * @brief The ids of the attributes the pass throws away, so that a later pass produces them again
+     *
+     */
+    std::set<int> invalidated_attributes;
+};
+
+/**
+ * @brief The parts of the AST a pass added, removed or replaced nodes in
+ *
+ */
+struct ASTChanges {
+    // a floor init or a global variable declaration is changed
+    bool globals = false;
+    std::set<parser::AbstractSubroutineASTNodePtr> subroutines;
+
+    bool empty() const { return !globals && subroutines.empty(); }
+
+    void merge(const ASTChanges &other)
+    {
+        globals = globals || other.globals;
+        subroutines.insert(other.subroutines.begin(), other.subroutines.end());
+    }
+};
+
 // Others don't need to know that this pass is a visitor
 class SemanticAnalysisPass : protected parser::ASTNodeVisitor {
 public:
@@ -29,6 +75,29 @@ public:
 
     virtual int run() = 0;
 
+    // A pass mutates the AST unless it tells otherwise
+    virtual PassTraits get_traits() const { return PassTraits(); }
+
+    // The changes made to the AST since the last call
+    ASTChanges take_changes() { return std::exchange(_changes, ASTChanges()); }
+
+    /**
+     * @brief Visit the floor inits and the global variables only, as a run would. It's for the passes which keep no
+     * state from the rest of the AST, such as ConstantFoldingPass and DeadCodeEliminationPass.
+     *
+     * @return int 0 for success
+     */
+    int run_on_globals();
+
+    /**
+     * @brief Visit \p subroutine only, as a run would. It's for the passes which keep no state from the rest of the
+     * AST.
+     *
+     * @param subroutine
+     * @return int 0 for success
+     */
+    int run_on_subroutine(parser::AbstractSubroutineASTNodePtr &subroutine);
+
 protected:
     // For all visit, the return value of 0 indicate success.
     int visit(const parser::IntegerASTNodePtr &node) override;
@@ -98,6 +167,12 @@ protected:
 
     void request_to_remove_self();
 
+    // Record a change to the subtree of the topmost node. The requests to replace or to remove are recorded already.
+    void mark_modified();
+
+    // Record the changes made by another pass on behalf of this one
+    void add_changes(const ASTChanges &changes) { _changes.merge(changes); }
+
     template <typename PostProcessFunc = std::function<void(const parser::ASTNodePtr &)>>
     void set_global_postprocess_function(PostProcessFunc postproc)
     {
@@ -202,6 +277,8 @@ private:
 
     std::map<parser::ASTNodePtr, parser::ASTNodePtr> _node_replacement_requests;
     std::set<parser::ASTNodePtr> _node_removal_requests;
+
+    ASTChanges _changes;
 };
 
 using SemanticAnalysisPassPtr = std::shared_ptr<SemanticAnalysisPass>;
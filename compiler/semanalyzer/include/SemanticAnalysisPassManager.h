@@ -1,14 +1,19 @@
 #ifndef SEMANTICANALYSISPASSMANAGER_H
 #define SEMANTICANALYSISPASSMANAGER_H
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <typeindex>
 #include <utility>
 #include <vector>
 
+#include "ASTNodeArena.h"
 #include "SemanticAnalysisPass.h"
 #include "SymbolTable.h"
+#include "WithSubroutineSplit.h"
 #include "WithSymbolTable.h"
 #include "hrl_global.h"
 #include "semanalyzer_global.h"
@@ -20,7 +25,7 @@ public:
     SemanticAnalysisPassManager(parser::CompilationUnitASTNodePtr root, StringPtr filename)
         : _root(std::move(root))
         , _filename(std::move(filename))
-        , _symbol_table(std::make_shared<SymbolTable>())
+        , _symbol_table(std::make_shared<SymbolTable>(_root->get_arena()->strings()))
     {
     }
 
@@ -39,30 +44,103 @@ public:
             pass->set_symbol_table(_symbol_table);
         }
 
-        add_pass(pass, pass_name, after_pass_graph_path, enabled_attributes);
+        SplitPassFactory factory;
+        if constexpr (std::is_base_of_v<WithSubroutineSplit, PassT>) {
+            // the other instances share the symbol table of the pass
+            factory = [this, symbol_table = _symbol_table]() -> SemanticAnalysisPassPtr {
+                std::shared_ptr<PassT> instance = std::make_shared<PassT>(_filename, _root);
+                if constexpr (std::is_base_of_v<WithSymbolTable, PassT>) {
+                    instance->set_symbol_table(symbol_table);
+                }
+                return instance;
+            };
+        }
+
+        add_pass(pass, pass_name, after_pass_graph_path, enabled_attributes, std::move(factory));
         return pass;
     }
 
     int run(bool fail_fast = true);
 
+    /**
+     * @brief Run the consecutive fusable passes in one traversal, as long as none requires an attribute produced by
+     * another of them. It's off by default.
+     *
+     * @param enabled
+     */
+    void set_fusion_enabled(bool enabled) { _fusion_enabled = enabled; }
+
+    /**
+     * @brief Analyze the subroutines on \p thread_count threads, for the passes which can split their work by
+     * subroutine. The diagnostics are the same as a run on one thread, which is the default.
+     *
+     * @param thread_count
+     */
+    void set_thread_count(unsigned int thread_count) { _thread_count = thread_count; }
+
+    /**
+     * @brief Skip a pass which would redo an earlier run of its type on an unchanged AST, or of a pass which throws
+     * away attributes nothing changed since they were produced. A pass which can split its work by subroutine only
+     * reanalyzes the changed subroutines. It's off by default.
+     *
+     * The passes of one type are taken to compute the same result on the same AST.
+     *
+     * @param enabled
+     */
+    void set_change_tracking_enabled(bool enabled) { _change_tracking_enabled = enabled; }
+
     void set_symbol_table(const SymbolTablePtr symtbl);
 
     const SymbolTablePtr &get_symbol_table() const;
 
 private:
+    // Make another instance of a pass which supports WithSubroutineSplit
+    using SplitPassFactory = std::function<SemanticAnalysisPassPtr()>;
+
     parser::CompilationUnitASTNodePtr _root;
     StringPtr _filename;
     std::vector<std::string> _pass_graph_filepaths;
     std::vector<std::set<int>> _pass_graph_enabled_attrs;
     std::vector<std::string> _pass_names;
     std::vector<SemanticAnalysisPassPtr> _passes;
+    // empty for the passes which don't support WithSubroutineSplit
+    std::vector<SplitPassFactory> _split_pass_factories;
     SymbolTablePtr _symbol_table;
+    bool _fusion_enabled = false;
+    unsigned int _thread_count = 1;
+    bool _change_tracking_enabled = false;
+
+    // The changes reported by the mutating passes. The AST is at revision _changes.size().
+    std::vector<ASTChanges> _changes;
+    // The revision of the last successful run of each read-only pass type
+    std::map<std::type_index, std::size_t> _pass_revisions;
+    // The revision each attribute was last produced at, for the attributes which haven't been thrown away
+    std::map<int, std::size_t> _attribute_revisions;
+
+    // The end of the fusable passes from \p begin which can share a traversal
+    std::size_t find_fusion_end(std::size_t begin) const;
+    int run_fused(std::size_t begin, std::size_t end, bool fail_fast);
+    int run_split(std::size_t i, const std::vector<parser::AbstractSubroutineASTNodePtr> &subroutines);
+
+    /**
+     * @brief Find whether the pass would redo the work of an earlier run, which is the case for a read-only pass which
+     * ran before with its attributes kept, and for a pass which throws away attributes still kept.
+     *
+     * @param i
+     * @param traits
+     * @param changes The changes made to the AST since that run
+     * @return true if the pass redoes an earlier run
+     */
+    bool find_changes_since_last_run(std::size_t i, const PassTraits &traits, ASTChanges &changes) const;
+    void record_run(std::size_t i, const PassTraits &traits, int rc);
+    void generate_graphviz(std::size_t i);
 
     void add_pass(
         SemanticAnalysisPassPtr pass,
         const std::string &pass_name,
         const std::string &after_pass_graph_path = "",
-        const std::set<int> enabled_attributes = std::set<int>());
+        const std::set<int> enabled_attributes = std::set<int>(),
+        SplitPassFactory split_pass_factory = SplitPassFactory());
 };
 
 CLOSE_SEMANALYZER_NAMESPACE
@@ -21,8 +21,15 @@ public:
 
     int run() override;
 
-protected:
-    void enter_node(const parser::ASTNodePtr &node) override;
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = true,
+            .required_attributes = {},
+            .produced_attributes = {},
+            .invalidated_attributes = _attributes,
+        };
+    }
 
 private:
     std::set<int> _attributes;
@@ -31,10 +31,16 @@ public:
     SymbolType type;
 
     /**
-     * @brief The symbol name
+     * @brief The symbol name, shared with the interner of the compilation
      *
      */
-    std::string name;
+    StringPtr name;
+
+    /**
+     * @brief The id of the name in the interner. The symbol table looks the symbols up by it.
+     *
+     */
+    StringId name_id;
 
     /**
      * @brief The filename of which this symbol is defined.
@@ -50,17 +56,10 @@ public:
     WEAK(parser::ASTNodePtr)
     definition;
 
-    Symbol(SymbolType type, const std::string &name, StringPtr filename, WEAK(parser::ASTNodePtr) definition)
-        : type(type)
-        , name(name)
-        , filename(std::move(filename))
-        , definition(std::move(definition))
-    {
-    }
-
-    Symbol(SymbolType type, StringPtr name, StringPtr filename, WEAK(parser::ASTNodePtr) definition)
+    Symbol(SymbolType type, StringId name_id, StringPtr name, StringPtr filename, WEAK(parser::ASTNodePtr) definition)
         : type(type)
-        , name(*name)
+        , name(std::move(name))
+        , name_id(name_id)
         , filename(std::move(filename))
         , definition(std::move(definition))
     {
@@ -35,6 +35,16 @@ public:
 
     int run() override;
 
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = true,
+            .required_attributes = {},
+            .produced_attributes = { ATTR_SEMANALYZER_SYMBOL, ATTR_SEMANALYZER_SCOPE_INFO },
+            .invalidated_attributes = {},
+        };
+    }
+
     // For all visit, the return value of 0 indicate success.
     int visit(const IntegerASTNodePtr &node) override;
     int visit(const BooleanASTNodePtr &node) override;
@@ -98,19 +108,19 @@ private:
     // [End]
 
     // [Group] Attaching node metadata
-    int attach_symbol_or_log_error(const StringPtr &name, SymbolType type, const ASTNodePtr &node);
-    int add_subroutine_symbol_or_log_error(const StringPtr &name, bool has_param, bool has_return, const ASTNodePtr &node);
-    int add_variable_symbol_or_log_error(const StringPtr &name, const ASTNodePtr &node);
+    int attach_symbol_or_log_error(StringId name, SymbolType type, const ASTNodePtr &node);
+    int add_subroutine_symbol_or_log_error(StringId name, bool has_param, bool has_return, const ASTNodePtr &node);
+    int add_variable_symbol_or_log_error(StringId name, const ASTNodePtr &node);
     void attach_scope_id(const ASTNodePtr &node);
     // [End]
 
     // [Group] Log errors
-    void log_redefinition_error(const StringPtr &name, SymbolType type, const ASTNodePtr &node);
-    void log_undefined_error(const StringPtr &name, SymbolType type, const ASTNodePtr &node);
+    void log_redefinition_error(StringId name, SymbolType type, const ASTNodePtr &node);
+    void log_undefined_error(StringId name, SymbolType type, const ASTNodePtr &node);
     // [End]
 
-    bool lookup_symbol_with_ancestors(const StringPtr &name, SymbolPtr &out_symbol, std::string &out_def_scope);
-    bool lookup_symbol_with_ancestors(const StringPtr &name, SymbolPtr &out_symbol);
+    bool lookup_symbol_with_ancestors(StringId name, SymbolPtr &out_symbol, ScopeId &out_def_scope);
+    bool lookup_symbol_with_ancestors(StringId name, SymbolPtr &out_symbol);
 
 private:
 };
@@ -1,21 +1,30 @@
 #ifndef SYMBOLTABLE_H
 #define SYMBOLTABLE_H
 
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "ScopeTree.h"
+#include "StringInterner.h"
 #include "Symbol.h"
 #include "hrl_global.h"
 #include "semanalyzer_global.h"
 
 OPEN_SEMANALYZER_NAMESPACE
 
+/**
+ * @brief The symbols of a compilation by scope. The names are the ids of the interner of the compilation, so a lookup
+ * hashes an integer instead of the name. The scopes are the ids of the scope tree it owns, and the ancestors of a scope
+ * are looked up by following the parents.
+ *
+ * The symbols are kept in one array in the order they're added. Each scope has a small open addressing index from the
+ * name to the position of the symbol, so a lookup probes a few adjacent slots, and a miss changes nothing.
+ */
 class SymbolTable {
 public:
-    SymbolTable();
+    explicit SymbolTable(StringInternerPtr strings);
     ~SymbolTable() = default;
 
     /**
@@ -26,13 +35,13 @@ public:
      * @return true The symbol is successfully added
      * @return false The symbol failed to add. There is a conflict.
      */
-    bool add_symbol(const std::string &scope_id, SymbolPtr symbol);
+    bool add_symbol(ScopeId scope_id, SymbolPtr symbol);
 
     /**
      * @brief Add a function to symbol table
      *
      * @param scope_id The scope id
-     * @param function_name The function name
+     * @param function_name The function name, interned
      * @param has_param If the function has the pramater
      * @param has_return If the function has return value
      * @param filename The file where the symbol was defined
@@ -40,51 +49,85 @@ public:
      * @return true The symbol is successfully added
      * @return false The symbol failed to add. There is a conflict.
      */
-    bool add_function_symbol(const std::string &scope_id, StringPtr function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out);
-    bool add_function_symbol(const std::string &scope_id, StringPtr function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition);
+    bool add_function_symbol(ScopeId scope_id, StringId function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out);
+    bool add_function_symbol(ScopeId scope_id, StringId function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition);
 
     /**
      * @brief Add a variable to symbol table
      *
      * @param scope_id The scope id
-     * @param variable_name The variable name
+     * @param variable_name The variable name, interned
      * @param filename The file where the symbol was defined
      * @param definition The variable definition ASTNode
      * @return true The symbol is successfully added
      * @return false The symbol failed to add. There is a conflict.
      */
-    bool add_variable_symbol(const std::string &scope_id, StringPtr variable_name, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out);
-    bool add_variable_symbol(const std::string &scope_id, StringPtr variable_name, StringPtr filename, const parser::ASTNodePtr &definition);
+    bool add_variable_symbol(ScopeId scope_id, StringId variable_name, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out);
+    bool add_variable_symbol(ScopeId scope_id, StringId variable_name, StringPtr filename, const parser::ASTNodePtr &definition);
 
     /**
      * @brief Look up the symbol \p name in the symbol table.
      *
      * @param scope_id The current scope id
-     * @param name The symbol name
+     * @param name The interned symbol name
      * @param lookup_ancestors True if look up the ancestor scopes of scope_id. False to look up only the \p scope_id
      * @param symbol_out [out] The result symbol
      * @param defined_scope_out [out] The symbol defined scope
      * @return true The symbol was found, and \p symbol_out is set
      * @return false The symbol was not found
      */
-    bool lookup_symbol(const std::string &scope_id, const std::string &name, bool lookup_ancestors, SymbolPtr &symbol_out, std::string &defined_scope_out);
-    bool lookup_symbol(const std::string &scope_id, const StringPtr &name, bool lookup_ancestors, SymbolPtr &symbol_out, std::string &defined_scope_out);
+    bool lookup_symbol(ScopeId scope_id, StringId name, bool lookup_ancestors, SymbolPtr &symbol_out, ScopeId &defined_scope_out) const;
+    // A name never interned is not found
+    bool lookup_symbol(ScopeId scope_id, const std::string &name, bool lookup_ancestors, SymbolPtr &symbol_out, ScopeId &defined_scope_out) const;
 
     // vector<pair<Symbol, sym_defined_scope>>
-    void get_symbols_include_ancestors(const std::string &scope_id, std::vector<std::pair<SymbolPtr, std::string>> &out);
-    void get_symbols_exclude_ancestors(const std::string &scope_id, std::vector<SymbolPtr> &out);
-    void get_all_symbols(std::vector<std::pair<SymbolPtr, std::string>> &out);
+    void get_symbols_include_ancestors(ScopeId scope_id, std::vector<std::pair<SymbolPtr, ScopeId>> &out) const;
+    void get_symbols_exclude_ancestors(ScopeId scope_id, std::vector<SymbolPtr> &out) const;
+    void get_all_symbols(std::vector<std::pair<SymbolPtr, ScopeId>> &out) const;
 
     // include parent scopes
-    bool is_symbol_in_scope(const SymbolPtr &symbol, const std::string &scope_id);
-    bool is_library_function(const SymbolPtr &symbol);
+    bool is_symbol_in_scope(const SymbolPtr &symbol, ScopeId scope_id) const;
+    bool is_library_function(const SymbolPtr &symbol) const;
+
+    // Remove the symbols defined in \p filename all at once, and rebuild the indexes of the scopes
     void strip_symbols_from_file(const StringPtr &filename);
 
+    // Remove every symbol and scope, and create the library symbols again
     void clear_symbols();
 
+    const StringInternerPtr &get_strings() const { return _strings; }
+
+    ScopeTree &get_scope_tree() { return _scope_tree; }
+    const ScopeTree &get_scope_tree() const { return _scope_tree; }
+
 private:
-    // map<scope id, hash<symbol name, symbol>>
-    std::map<std::string, std::unordered_map<std::string, SymbolPtr>> _scopes;
+    static constexpr std::uint32_t NO_SYMBOL = UINT32_MAX;
+
+    struct IndexSlot {
+        // NO_STRING_ID if the slot is free
+        StringId name = NO_STRING_ID;
+        // the position in _symbols
+        std::uint32_t symbol = NO_SYMBOL;
+    };
+
+    // Probed linearly. The size is 0 or a power of 2, and it's at most 3/4 full.
+    struct ScopeIndex {
+        std::vector<IndexSlot> slots;
+        std::uint32_t count = 0;
+    };
+
+    StringInternerPtr _strings;
+    ScopeTree _scope_tree;
+    std::vector<SymbolPtr> _symbols;
+    // the defined scope of each of _symbols
+    std::vector<ScopeId> _symbol_scopes;
+    // indexed by scope id. The scopes without symbols may be missing.
+    std::vector<ScopeIndex> _scope_indexes;
+
+    // The position in _symbols, or NO_SYMBOL
+    std::uint32_t find_symbol(ScopeId scope_id, StringId name) const;
+    void index_symbol(ScopeId scope_id, std::uint32_t position);
+    static void insert_slot(ScopeIndex &index, StringId name, std::uint32_t position);
 
     /**
      * @brief Create outbox/inbox symbols
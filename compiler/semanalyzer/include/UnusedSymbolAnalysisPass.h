@@ -19,6 +19,16 @@ public:
     ~UnusedSymbolAnalysisPass() = default;
 
     int run() override;
+
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = false,
+            .required_attributes = { ATTR_SEMANALYZER_SYMBOL },
+            .produced_attributes = {},
+            .invalidated_attributes = {},
+        };
+    }
     int visit(const parser::VariableAccessASTNodePtr &node) override;
     int visit(const parser::IncrementExpressionASTNodePtr &node) override;
     int visit(const parser::DecrementExpressionASTNodePtr &node) override;
@@ -26,8 +36,6 @@ public:
     int visit(const parser::VariableAssignmentASTNodePtr &node) override;
     // Don't strip out unused function calls. It can be exported
     // int visit(const parser::SubprocDefinitionASTNodePtr &node) override;
-    // special handling for param
-    int visit(const parser::FunctionDefinitionASTNodePtr &node) override;
     // int visit(const parser::InvocationExpressionASTNodePtr &node) override;
     int visit(const parser::CompilationUnitASTNodePtr &node) override;
 
@@ -35,13 +43,7 @@ protected:
     void enter_node(const parser::ASTNodePtr &node) override;
 
 private:
-    enum class VisitState {
-        CollectionPass,
-        MutationPass,
-    };
-    VisitState _visit_state = VisitState::CollectionPass;
-
-    // Pass 1: collect all symbols
+    // Pass 1: collect all symbols, which is statically dispatched since it only reads the AST
     // Pass 2: remove the node
     std::set<SymbolPtr> _unused_symbols;
 
@@ -1,19 +1,32 @@
 #ifndef USEBEFOREINITIALIZATIONPASS_H
 #define USEBEFOREINITIALIZATIONPASS_H
 
-#include <set>
-#include <stack>
-#include <string>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
+#include "BitVector.h"
 #include "SemanticAnalysisPass.h"
 #include "Symbol.h"
-#include "WithScopeTracker.h"
+#include "WithSubroutineSplit.h"
 #include "WithSymbolTable.h"
 #include "semanalyzer_global.h"
 
 OPEN_SEMANALYZER_NAMESPACE
 
-class UseBeforeInitializationCheckPass : public SemanticAnalysisPass, public WithSymbolTable, public WithScopeTracker {
+/**
+ * @brief Check that every variable is assigned on all paths before it's used, as a forward dataflow analysis.
+ *
+ * The variables are numbered densely: the globals first, then the locals of the subroutine being checked. A first
+ * traversal splits the globals and each subroutine into blocks of declarations and assignments, and a worklist solves
+ * the set of assigned variables at the entry of each block as a bitvector. A second traversal goes through the same
+ * blocks with their entry sets and checks the uses, stopping where the visits fail.
+ *
+ * A loop may run no times, so its body and the init of a for loop don't assign anything after it. Returns, breaks and
+ * continues don't end a path.
+ */
+class UseBeforeInitializationCheckPass : public SemanticAnalysisPass, public WithSymbolTable, public WithSubroutineSplit {
 public:
     UseBeforeInitializationCheckPass(StringPtr filename, parser::CompilationUnitASTNodePtr root)
         : SemanticAnalysisPass(std::move(filename), std::move(root))
@@ -24,6 +37,20 @@ public:
 
     int run() override;
 
+    int run_globals() override;
+    int run_subroutine(const parser::AbstractSubroutineASTNodePtr &node) override;
+    void end_subroutines() override;
+
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = true,
+            .required_attributes = { ATTR_SEMANALYZER_SYMBOL },
+            .produced_attributes = {},
+            .invalidated_attributes = {},
+        };
+    }
+
     // For all visit, the return value of 0 indicate success.
     int visit(const parser::VariableDeclarationASTNodePtr &node) override;
     int visit(const parser::VariableAssignmentASTNodePtr &node) override;
@@ -33,46 +60,81 @@ public:
     int visit(const parser::IfStatementASTNodePtr &node) override;
     int visit(const parser::WhileStatementASTNodePtr &node) override;
     int visit(const parser::ForStatementASTNodePtr &node) override;
-    int visit(const parser::StatementBlockASTNodePtr &node) override;
     int visit(const parser::SubprocDefinitionASTNodePtr &node) override;
     int visit(const parser::FunctionDefinitionASTNodePtr &node) override;
 
-protected:
-    void enter_node(const parser::ASTNodePtr &node) override;
-    void leave_node() override;
-
 private:
-    // [Group] var use before init check
-    using NodeResult = std::map<SymbolPtr, int>;
-    // map<symbol, stack<initialized_in_scope>>
-    std::map<SymbolPtr, std::stack<int>> _varinit_record_stacks;
-    // map<node, result>
-    std::map<parser::ASTNodePtr, NodeResult> _varinit_record_results;
-    // scope stack<seen symbols>
-    std::stack<std::set<SymbolPtr>> _var_occured;
-
-    void create_var_init_at_current_scope(const SymbolPtr &symbol);
-    void set_var_init_at_current_scope(const SymbolPtr &symbol, int initialized);
-    void set_var_init_at_current_scope(const NodeResult &result);
-    int get_var_init_at_current_scope(const SymbolPtr &symbol);
-    NodeResult get_var_init_at_current_scope();
-    void get_var_init_result(const parser::ASTNodePtr &node_to_get_result, NodeResult &result);
-
-    void strip_symbols_beyond_scope(NodeResult &results, const std::string &scope_id);
-
-    void log_use_before_initialization_error(const SymbolPtr &symbol, const parser::ASTNodePtr &node);
-    // [End]
+    enum class EventType {
+        // the variable is not assigned since it's declared again
+        Declare,
+        Assign,
+        Use,
+    };
+
+    // A declaration or an assignment. The uses aren't kept, since they're checked on the second traversal.
+    struct Event {
+        EventType type;
+        std::uint32_t variable;
+    };
+
+    // A block of events with a single entry and a single exit
+    struct Block {
+        // the events of the block are [events_begin, events_end) in _events
+        std::uint32_t events_begin;
+        std::uint32_t events_end;
+        std::vector<std::uint32_t> predecessors;
+        std::vector<std::uint32_t> successors;
+        // the variables assigned on every path to the entry and to the exit
+        BitVector in;
+        BitVector out;
+    };
+
+    // The dense index of each variable declared in the globals or in the subroutine being checked
+    std::unordered_map<const Symbol *, std::uint32_t> _variable_indexes;
+    // indexed by the dense index
+    std::vector<SymbolPtr> _variables;
+    std::uint32_t _global_variable_count = 0;
+    // the variables assigned after the globals
+    BitVector _globals_out;
+
+    // The blocks of the region being checked, which is the floor inits, the global variables or a subroutine.
+    // They're in the order of the AST, so are their events.
+    std::vector<Block> _blocks;
+    std::vector<Event> _events;
+    std::uint32_t _current_block = 0;
+    // whether the traversal checks the uses, instead of building the blocks
+    bool _checking = false;
+    // the variables assigned at the node being checked
+    BitVector _assigned;
+
+    /**
+     * @brief Build the blocks of a region with \p traverse_region, solve them from \p entry, and check the uses with
+     * \p traverse_region again.
+     *
+     * @param entry The variables assigned before the region
+     * @param exit The variables assigned at the end of the region
+     * @param traverse_region
+     * @return int 0 for success
+     */
+    int check_region(const BitVector &entry, BitVector &exit, const std::function<int()> &traverse_region);
+
+    // Start a block after the current one, which is added as its predecessor unless \p fallthrough is false
+    std::uint32_t begin_block(bool fallthrough = true);
+    void add_edge(std::uint32_t from, std::uint32_t to);
+
+    // Record the event in building, and apply or check it in checking
+    int add_event(EventType type, const SymbolPtr &symbol, const parser::ASTNodePtr &node);
+    std::uint32_t get_variable_index(const SymbolPtr &symbol);
+
+    void solve(const BitVector &entry);
+    // Apply the declarations and assignments of \p block to \p assigned
+    void transfer(const Block &block, BitVector &assigned) const;
 
     int visit_subroutine(parser::AbstractSubroutineASTNodePtr node);
-    int check_node_symbol_assigned_or_report(const parser::ASTNodePtr &node);
 
-    // if the entered a scope: copy all elements from parent's scope
-    // if left the scope: return result to parent's scope
-    // if scope is not changed: do nothing
-    void on_scope_enter(const parser::ASTNodePtr &node, const std::string &current_scope_id) override;
-    void on_scope_exit(const parser::ASTNodePtr &node, const std::string &current_scope_id) override;
+    void log_use_before_initialization_error(const SymbolPtr &symbol, const parser::ASTNodePtr &node);
 };
 
 CLOSE_SEMANALYZER_NAMESPACE
 
-#endif
\ No newline at end of file
+#endif
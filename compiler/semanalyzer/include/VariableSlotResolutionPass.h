@@ -0,0 +1,126 @@
+#ifndef VARIABLESLOTRESOLUTIONPASS_H
+#define VARIABLESLOTRESOLUTIONPASS_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ASTNode.h"
+#include "ASTNodeAttribute.h"
+#include "FusedPass.h"
+#include "SemanticAnalysisPass.h"
+#include "Symbol.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+enum class VariableStorage {
+    Global,
+    Local,
+};
+
+/**
+ * @brief The storage slot of a variable. It's attached to every node referring a variable: declarations (including
+ * subroutine parameters), assignments, accesses, increments and decrements.
+ *
+ * Global slots index the global variables of the compilation unit. Local slots index the frame of the enclosing
+ * subroutine, whose size is in the FrameLayoutAttribute of the subroutine node.
+ */
+class VariableSlotAttribute : public parser::ASTNodeAttribute, public parser::GetSetAttribute<VariableSlotAttribute> {
+public:
+    VariableSlotAttribute(VariableStorage storage, unsigned int slot)
+        : _storage(storage)
+        , _slot(slot)
+    {
+    }
+
+    ~VariableSlotAttribute() override = default;
+
+    static int get_attribute_id() { return SemAnalzyerASTNodeAttributeId::ATTR_SEMANALYZER_VARIABLE_SLOT; }
+
+    std::string to_string() override;
+
+    VariableStorage get_storage() const { return _storage; }
+
+    bool is_global() const { return _storage == VariableStorage::Global; }
+
+    unsigned int get_slot() const { return _slot; }
+
+private:
+    VariableStorage _storage;
+    unsigned int _slot;
+};
+
+using VariableSlotAttributePtr = std::shared_ptr<VariableSlotAttribute>;
+
+/**
+ * @brief The number of slots of a frame. It's attached to the compilation unit for the globals and to every
+ * subroutine for its locals.
+ */
+class FrameLayoutAttribute : public parser::ASTNodeAttribute, public parser::GetSetAttribute<FrameLayoutAttribute> {
+public:
+    explicit FrameLayoutAttribute(unsigned int slot_count)
+        : _slot_count(slot_count)
+    {
+    }
+
+    ~FrameLayoutAttribute() override = default;
+
+    static int get_attribute_id() { return SemAnalzyerASTNodeAttributeId::ATTR_SEMANALYZER_FRAME_LAYOUT; }
+
+    std::string to_string() override;
+
+    unsigned int get_slot_count() const { return _slot_count; }
+
+private:
+    unsigned int _slot_count;
+};
+
+using FrameLayoutAttributePtr = std::shared_ptr<FrameLayoutAttribute>;
+
+// depends: Symbol
+/**
+ * @brief Assigns each variable symbol a slot in the globals or in the frame of its subroutine, so the variables can be
+ * stored in arrays instead of being looked up by symbol.
+ *
+ * Every variable gets its own slot in its subroutine. Slots are not shared between sibling scopes.
+ * The pass must run after the last pass that mutates the AST.
+ */
+class VariableSlotResolutionPass : public FusablePass {
+public:
+    VariableSlotResolutionPass(StringPtr filename, parser::CompilationUnitASTNodePtr root)
+        : FusablePass(std::move(filename), std::move(root))
+    {
+    }
+
+    ~VariableSlotResolutionPass() = default;
+
+    PassTraits get_traits() const override
+    {
+        return PassTraits {
+            .read_only = true,
+            .required_attributes = { ATTR_SEMANALYZER_SYMBOL },
+            .produced_attributes = { ATTR_SEMANALYZER_VARIABLE_SLOT, ATTR_SEMANALYZER_FRAME_LAYOUT },
+            .invalidated_attributes = {},
+        };
+    }
+
+protected:
+    void begin_traversal() override;
+    int on_node_enter(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors) override;
+    int on_node_leave(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors) override;
+
+private:
+    std::map<SymbolPtr, VariableSlotAttributePtr> _slots;
+    unsigned int _global_slot_count = 0;
+    unsigned int _local_slot_count = 0;
+    bool _in_subroutine = false;
+
+    void begin_frame();
+    void end_frame(const parser::AbstractSubroutineASTNodePtr &node);
+};
+
+CLOSE_SEMANALYZER_NAMESPACE
+
+#endif
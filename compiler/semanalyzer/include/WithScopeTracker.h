@@ -5,6 +5,7 @@
 #include <string>
 
 #include "ASTNodeForward.h"
+#include "ScopeTree.h"
 #include "semanalyzer_global.h"
 
 OPEN_SEMANALYZER_NAMESPACE
@@ -15,25 +16,27 @@ public:
     virtual ~WithScopeTracker();
 
 protected:
-    virtual void on_scope_enter(const parser::ASTNodePtr &node, const std::string &scope_id) = 0;
-    virtual void on_scope_exit(const parser::ASTNodePtr &node, const std::string &scope_id) = 0;
+    virtual void on_scope_enter(const parser::ASTNodePtr &node, ScopeId scope_id) = 0;
+    virtual void on_scope_exit(const parser::ASTNodePtr &node, ScopeId scope_id) = 0;
 
     void track_scope_node_enter(const parser::ASTNodePtr &node);
     void track_scope_node_leave(const parser::ASTNodePtr &node);
 
-    void track_scope_enter_manually(const parser::ASTNodePtr &node, const std::string &scope_id);
+    void track_scope_enter_manually(const parser::ASTNodePtr &node, ScopeId scope_id);
     void track_scope_enter_manually(const parser::ASTNodePtr &node);
     void track_scope_leave_manually(const parser::ASTNodePtr &node);
 
-    const std::string &get_current_scope_id() const;
+    ScopeId get_current_scope_id() const;
 
-    void clear_scope_tracker();
+    // Start over from the library scope. The scopes of the nodes visited are in \p scope_tree.
+    void clear_scope_tracker(const ScopeTree &scope_tree);
 
 private:
-    void check_scope_enter(const parser::ASTNodePtr &node, const std::string scope_id);
-    void check_scope_leave(const parser::ASTNodePtr &node, const std::string scope_id);
+    void check_scope_enter(const parser::ASTNodePtr &node, ScopeId scope_id);
+    void check_scope_leave(const parser::ASTNodePtr &node, ScopeId scope_id);
 
-    std::stack<std::string> _scope_tracker;
+    const ScopeTree *_scope_tree = nullptr;
+    std::stack<ScopeId> _scope_tracker;
 };
 
 CLOSE_SEMANALYZER_NAMESPACE
@@ -0,0 +1,44 @@
+#ifndef WITHSUBROUTINESPLIT_H
+#define WITHSUBROUTINESPLIT_H
+
+#include "ASTNodeForward.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+/**
+ * @brief A pass which analyzes each subroutine on its own, once the globals are analyzed. The pass manager can then
+ * give the subroutines to several instances of the pass on different threads.
+ *
+ * Analyzing a subroutine must only read what's shared between the instances: the AST, the symbol table and the
+ * attributes of other passes. It cannot attach attributes, since setting one may grow a table shared by all threads.
+ * The diagnostics of each subroutine are reported as if the subroutines were analyzed in order.
+ */
+class WithSubroutineSplit {
+public:
+    WithSubroutineSplit() = default;
+    virtual ~WithSubroutineSplit() = default;
+
+    /**
+     * @brief Prepare the pass and analyze the floor inits and the global variables. Every instance runs it before
+     * any subroutine.
+     *
+     * @return int 0 for success
+     */
+    virtual int run_globals() = 0;
+
+    /**
+     * @brief Analyze one subroutine, as a run of the pass would after run_globals().
+     *
+     * @param node
+     * @return int 0 for success
+     */
+    virtual int run_subroutine(const parser::AbstractSubroutineASTNodePtr &node) = 0;
+
+    // Called after the last subroutine given to this instance
+    virtual void end_subroutines() = 0;
+};
+
+CLOSE_SEMANALYZER_NAMESPACE
+
+#endif
@@ -21,10 +21,10 @@ public:
     const SymbolTablePtr &get_symbol_table() const { return _symbol_table; }
 
 protected:
-    void init_symbol_table()
+    void init_symbol_table(const StringInternerPtr &strings)
     {
         if (!_symbol_table) {
-            _symbol_table = std::make_shared<SymbolTable>();
+            _symbol_table = std::make_shared<SymbolTable>(strings);
         }
     }
 
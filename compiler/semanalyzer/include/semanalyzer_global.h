@@ -20,6 +20,8 @@ enum SemAnalzyerASTNodeAttributeId : int {
     ATTR_SEMANALYZER_SCOPE_INFO = 1001,
     ATTR_SEMANALYZER_CONST_FOLDING_VALUE = 1002,
     ATTR_SEMANALYZER_CONTROL_CONTEXT_INFO = 1003,
+    ATTR_SEMANALYZER_VARIABLE_SLOT = 1004,
+    ATTR_SEMANALYZER_FRAME_LAYOUT = 1005,
     ATTR_SEMANALYZER_END = 1999,
 };
 
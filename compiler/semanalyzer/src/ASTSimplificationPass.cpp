@@ -0,0 +1,86 @@
+#include <spdlog/spdlog.h>
+
+#include "ASTSimplificationPass.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+ASTSimplificationPass::ASTSimplificationPass(StringPtr filename, parser::CompilationUnitASTNodePtr root)
+    : SemanticAnalysisPass(filename, root)
+    , _constant_folding(filename, root)
+    , _dead_code_elimination(std::move(filename), std::move(root))
+{
+}
+
+ASTSimplificationPass::~ASTSimplificationPass()
+{
+}
+
+int ASTSimplificationPass::run()
+{
+    int rc = _constant_folding.run();
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = _dead_code_elimination.run();
+    if (rc != 0) {
+        return rc;
+    }
+
+    ASTChanges changed = take_round_changes();
+    for (int round = 0; round < MAX_EXTRA_ROUNDS && !changed.empty(); ++round) {
+        spdlog::debug("Simplifying {} changed subroutines{} again", changed.subroutines.size(), changed.globals ? " and the globals" : "");
+        rc = simplify(changed);
+        if (rc != 0) {
+            return rc;
+        }
+        changed = take_round_changes();
+    }
+
+    return 0;
+}
+
+int ASTSimplificationPass::simplify(const ASTChanges &region)
+{
+    int rc;
+    if (region.globals) {
+        rc = _constant_folding.run_on_globals();
+        if (rc != 0) {
+            return rc;
+        }
+        rc = _dead_code_elimination.run_on_globals();
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    // in the order of the AST, for the diagnostics
+    for (auto &subroutine : _root->get_subroutines()) {
+        if (!region.subroutines.contains(subroutine)) {
+            continue;
+        }
+
+        rc = _constant_folding.run_on_subroutine(subroutine);
+        if (rc != 0) {
+            return rc;
+        }
+        rc = _dead_code_elimination.run_on_subroutine(subroutine);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    return 0;
+}
+
+ASTChanges ASTSimplificationPass::take_round_changes()
+{
+    ASTChanges changes = _constant_folding.take_changes();
+    changes.merge(_dead_code_elimination.take_changes());
+    add_changes(changes);
+    return changes;
+}
+
+CLOSE_SEMANALYZER_NAMESPACE
+// end
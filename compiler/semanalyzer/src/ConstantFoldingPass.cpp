@@ -3,6 +3,7 @@
 #include <boost/format.hpp>
 
 #include "ASTNode.h"
+#include "ASTNodeArena.h"
 #include "ASTNodeForward.h"
 #include "ConstantFoldingPass.h"
 #include "ErrorManager.h"
@@ -134,12 +135,11 @@ int ConstantFoldingPass::visit(const AddExpressionASTNodePtr &node)
     // visit 2: add 0 and 0 add opt
     auto left = node->get_left();
     auto right = node->get_right();
-    ASTNodeAttributePtr lattr, rattr;
-    left->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, lattr);
-    right->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, rattr);
+    auto lattr = ConstantFoldingAttribute::get_from(left);
+    auto rattr = ConstantFoldingAttribute::get_from(right);
     do {
         if (rattr && !lattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(rattr)->get_value();
+            int value = rattr->get_value();
             if (value == 0) {
                 request_to_replace_self(left);
                 break;
@@ -147,7 +147,7 @@ int ConstantFoldingPass::visit(const AddExpressionASTNodePtr &node)
         }
 
         if (lattr && !rattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(lattr)->get_value();
+            int value = lattr->get_value();
             if (value == 0) {
                 request_to_replace_self(right);
                 break;
@@ -167,12 +167,11 @@ int ConstantFoldingPass::visit(const SubExpressionASTNodePtr &node)
     // visit 2: sub 0 and 0 sub opt
     auto left = node->get_left();
     auto right = node->get_right();
-    ASTNodeAttributePtr lattr, rattr;
-    left->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, lattr);
-    right->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, rattr);
+    auto lattr = ConstantFoldingAttribute::get_from(left);
+    auto rattr = ConstantFoldingAttribute::get_from(right);
     do {
         if (rattr && !lattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(rattr)->get_value();
+            int value = rattr->get_value();
             if (value == 0) {
                 request_to_replace_self(left);
                 break;
@@ -180,9 +179,9 @@ int ConstantFoldingPass::visit(const SubExpressionASTNodePtr &node)
         }
 
         if (lattr && !rattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(lattr)->get_value();
+            int value = lattr->get_value();
             if (value == 0) {
-                auto negative = std::make_shared<NegativeExpressionASTNode>(node->lineno(), node->colno(), node->last_lineno(), node->last_colno(), right);
+                auto negative = _root->get_arena()->make<NegativeExpressionASTNode>(node->offset(), node->last_offset(), right);
                 negative->copy_attributes_from(right);
                 request_to_replace_self(negative);
                 break;
@@ -204,15 +203,14 @@ int ConstantFoldingPass::visit(const MulExpressionASTNodePtr &node)
     // visit 2: mul 0 and mul 1 opt
     auto left = node->get_left();
     auto right = node->get_right();
-    ASTNodeAttributePtr lattr, rattr;
-    left->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, lattr);
-    right->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, rattr);
+    auto lattr = ConstantFoldingAttribute::get_from(left);
+    auto rattr = ConstantFoldingAttribute::get_from(right);
     do {
         if (lattr && !rattr) {
-            int lvalue = std::static_pointer_cast<ConstantFoldingAttribute>(lattr)->get_value();
+            int lvalue = lattr->get_value();
             if (lvalue == 0) {
                 // 0 * 'A' = 0
-                auto zero = std::make_shared<IntegerASTNode>(node->lineno(), node->colno(), node->last_lineno(), node->last_colno(), 0, false);
+                auto zero = _root->get_arena()->make<IntegerASTNode>(node->offset(), node->last_offset(), 0, false);
                 zero->copy_attributes_from(node);
                 attach_constant(zero, 0, false);
                 request_to_replace_self(zero);
@@ -224,9 +222,9 @@ int ConstantFoldingPass::visit(const MulExpressionASTNodePtr &node)
         }
 
         if (rattr && !lattr) {
-            int rvalue = std::static_pointer_cast<ConstantFoldingAttribute>(rattr)->get_value();
+            int rvalue = rattr->get_value();
             if (rvalue == 0) {
-                auto zero = std::make_shared<IntegerASTNode>(node->lineno(), node->colno(), node->last_lineno(), node->last_colno(), 0, false);
+                auto zero = _root->get_arena()->make<IntegerASTNode>(node->offset(), node->last_offset(), 0, false);
                 zero->copy_attributes_from(node);
                 attach_constant(zero, 0, false);
                 request_to_replace_self(zero);
@@ -267,13 +265,12 @@ int ConstantFoldingPass::visit(const DivExpressionASTNodePtr &node)
     // visit 2: div 0 check, div 1 opt, 0 div opt
     auto right = node->get_right();
     auto left = node->get_left();
-    ASTNodeAttributePtr lattr, rattr;
-    right->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, rattr);
-    left->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, lattr);
+    auto rattr = ConstantFoldingAttribute::get_from(right);
+    auto lattr = ConstantFoldingAttribute::get_from(left);
 
     do {
         if (rattr && !lattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(rattr)->get_value();
+            int value = rattr->get_value();
             // div 0
             if (value == 0) {
                 ErrorManager::instance().report(
@@ -290,9 +287,9 @@ int ConstantFoldingPass::visit(const DivExpressionASTNodePtr &node)
         }
 
         if (lattr && !rattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(lattr)->get_value();
+            int value = lattr->get_value();
             if (value == 0) { // 0 div
-                auto zero = std::make_shared<IntegerASTNode>(node->lineno(), node->colno(), node->last_lineno(), node->last_colno(), 0, false);
+                auto zero = _root->get_arena()->make<IntegerASTNode>(node->offset(), node->last_offset(), 0, false);
                 zero->copy_attributes_from(node);
                 attach_constant(zero, 0, false);
                 request_to_replace_self(zero);
@@ -331,13 +328,12 @@ int ConstantFoldingPass::visit(const ModExpressionASTNodePtr &node)
     // visit 2: mod 0 check, mod 1 opt, 0 mod opt
     auto left = node->get_left();
     auto right = node->get_right();
-    ASTNodeAttributePtr lattr, rattr;
-    right->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, rattr);
-    left->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, lattr);
+    auto rattr = ConstantFoldingAttribute::get_from(right);
+    auto lattr = ConstantFoldingAttribute::get_from(left);
 
     do {
         if (rattr && !lattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(rattr)->get_value();
+            int value = rattr->get_value();
             // mod 0
             if (value == 0) {
                 ErrorManager::instance().report(
@@ -354,9 +350,9 @@ int ConstantFoldingPass::visit(const ModExpressionASTNodePtr &node)
         }
 
         if (lattr && !rattr) {
-            int value = std::static_pointer_cast<ConstantFoldingAttribute>(lattr)->get_value();
+            int value = lattr->get_value();
             if (value == 0) { // 0 mod
-                auto zero = std::make_shared<IntegerASTNode>(node->lineno(), node->colno(), node->last_lineno(), node->last_colno(), 0, false);
+                auto zero = _root->get_arena()->make<IntegerASTNode>(node->offset(), node->last_offset(), 0, false);
                 zero->copy_attributes_from(node);
                 attach_constant(zero, 0, false);
                 request_to_replace_self(zero);
@@ -500,8 +496,7 @@ int ConstantFoldingPass::run()
 
 void ConstantFoldingPass::attach_constant(const ASTNodePtr &node, int value, bool is_char)
 {
-    auto attr = std::make_shared<ConstantFoldingAttribute>(value, is_char);
-    node->set_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, attr);
+    ConstantFoldingAttribute::set_to(node, std::make_shared<ConstantFoldingAttribute>(value, is_char));
 }
 
 int ConstantFoldingPass::fold_binary_expression(const AbstractBinaryExpressionASTNodePtr &node, BinaryIntOperation auto op_func)
@@ -514,14 +509,10 @@ int ConstantFoldingPass::fold_binary_expression(const AbstractBinaryExpressionAS
     rc = traverse(node->get_right());
     RETURN_IF_FAIL();
 
-    ASTNodeAttributePtr left_const_fld;
-    ASTNodeAttributePtr right_const_fld;
-    bool left_const = node->get_left()->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, left_const_fld);
-    bool right_const = node->get_right()->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, right_const_fld);
+    auto left_attr = ConstantFoldingAttribute::get_from(node->get_left());
+    auto right_attr = ConstantFoldingAttribute::get_from(node->get_right());
 
-    if (left_const && right_const) {
-        auto left_attr = std::static_pointer_cast<ConstantFoldingAttribute>(left_const_fld);
-        auto right_attr = std::static_pointer_cast<ConstantFoldingAttribute>(right_const_fld);
+    if (left_attr && right_attr) {
 
         // only perform folding when two types are equal
         if (left_attr->get_is_char() == right_attr->get_is_char()) {
@@ -537,7 +528,7 @@ int ConstantFoldingPass::fold_binary_expression(const AbstractBinaryExpressionAS
 
             attach_constant(node, val, left_attr->get_is_char());
 
-            auto const_node = std::make_shared<IntegerASTNode>(node->lineno(), node->colno(), node->last_lineno(), node->last_colno(), val, left_attr->get_is_char());
+            auto const_node = _root->get_arena()->make<IntegerASTNode>(node->offset(), node->last_offset(), val, left_attr->get_is_char());
             const_node->copy_attributes_from(node);
             attach_constant(const_node, val, left_attr->get_is_char());
 
@@ -554,11 +545,9 @@ int ConstantFoldingPass::fold_unary_expression(const AbstractUnaryExpressionASTN
     rc = traverse(node->get_operand());
     RETURN_IF_FAIL();
 
-    ASTNodeAttributePtr const_fld;
-    bool is_const = node->get_operand()->get_attribute(ATTR_SEMANALYZER_CONST_FOLDING_VALUE, const_fld);
+    auto attr = ConstantFoldingAttribute::get_from(node->get_operand());
 
-    if (is_const) {
-        auto attr = std::static_pointer_cast<ConstantFoldingAttribute>(const_fld);
+    if (attr) {
         int operand = attr->get_value();
         int val;
         rc = op_func(operand, val);
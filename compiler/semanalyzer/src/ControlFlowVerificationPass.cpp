@@ -2,6 +2,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -16,27 +17,12 @@
 
 OPEN_SEMANALYZER_NAMESPACE
 
-#define BEGIN_VISIT()       \
-    enter_node(node);       \
-    int result = 0, rc = 0; \
-    UNUSED(rc);
-
-#define END_VISIT() \
-    leave_node();   \
-    return result
-
-#define RETURN_IF_FAIL_IN_VISIT() \
-    if (rc != 0) {                \
-        result = rc;              \
-        END_VISIT();              \
-    }
-
 ControlFlowVerificationPass::ControlFlowVerificationPass(StringPtr filename, parser::CompilationUnitASTNodePtr root)
-    : SemanticAnalysisPass(std::move(filename), std::move(root))
+    : FusablePass(std::move(filename), std::move(root))
 {
 }
 
-int ControlFlowVerificationPass::run()
+void ControlFlowVerificationPass::begin_traversal()
 {
     while (!_subroutine_requires_return.empty()) {
         _subroutine_requires_return.pop();
@@ -46,82 +32,110 @@ int ControlFlowVerificationPass::run()
         _returned_record_stack.pop();
     }
 
-    return SemanticAnalysisPass::visit(_root);
+    while (!_if_returned_stack.empty()) {
+        _if_returned_stack.pop();
+    }
 }
 
-int ControlFlowVerificationPass::visit(const parser::IfStatementASTNodePtr &node)
+int ControlFlowVerificationPass::on_node_enter(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
 {
-    BEGIN_VISIT();
-
-    auto then_branch = node->get_then_branch();
-    auto else_branch = node->get_else_branch();
-
-    std::optional<bool> then_returned, else_returned;
-
-    if (then_branch) {
+    // each branch of an if statement has its own record, which is checked when the if statement is left
+    if (get_if_branch(node, ancestors) != IfBranch::None) {
         push_return_record();
-        rc = traverse(then_branch);
-        RETURN_IF_FAIL_IN_VISIT();
-        then_returned = get_return_record();
-        pop_return_record();
     }
 
-    if (else_branch) {
+    switch (node->get_node_type()) {
+    case parser::ASTNodeType::SubprocDefinition:
+    case parser::ASTNodeType::FunctionDefinition:
+        _expected_return = node->get_node_type() == parser::ASTNodeType::FunctionDefinition;
         push_return_record();
-        rc = traverse(else_branch);
-        RETURN_IF_FAIL_IN_VISIT();
-        else_returned = get_return_record();
-        pop_return_record();
-    }
-
-    if (then_returned == true && else_returned == true) {
-        set_return_record(true);
+        break;
+    case parser::ASTNodeType::WhileStatement:
+    case parser::ASTNodeType::ForStatement:
+        // the condition and the other stages cannot return nor break/continue, so the loop shares the record of its body
+        push_return_record();
+        break;
+    case parser::ASTNodeType::IfStatement:
+        _if_returned_stack.push(std::make_pair(std::nullopt, std::nullopt));
+        break;
+    case parser::ASTNodeType::ReturnStatement:
+        return check_return_statement(std::static_pointer_cast<parser::ReturnStatementASTNode>(node), ancestors);
+    case parser::ASTNodeType::BreakStatement:
+    case parser::ASTNodeType::ContinueStatement:
+        return check_loop_control_statements(node, ancestors);
+    default:
+        break;
     }
 
-    END_VISIT();
+    return 0;
 }
 
-int ControlFlowVerificationPass::visit(const parser::WhileStatementASTNodePtr &node)
+int ControlFlowVerificationPass::on_node_leave(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
 {
-    BEGIN_VISIT();
+    int rc = 0;
+
+    switch (node->get_node_type()) {
+    case parser::ASTNodeType::SubprocDefinition:
+    case parser::ASTNodeType::FunctionDefinition:
+        rc = check_subroutine_returned(std::static_pointer_cast<parser::AbstractSubroutineASTNode>(node));
+        break;
+    case parser::ASTNodeType::WhileStatement:
+    case parser::ASTNodeType::ForStatement:
+        // we don't even care if the loop returns. a return is required outside the loop anyway
+        pop_return_record();
+        break;
+    case parser::ASTNodeType::IfStatement: {
+        auto [then_returned, else_returned] = _if_returned_stack.top();
+        _if_returned_stack.pop();
+        if (then_returned == true && else_returned == true) {
+            set_return_record(true);
+        }
+    } break;
+    default:
+        break;
+    }
 
-    push_return_record();
-    // condition cannot return nor break/continue
-    rc = traverse(node->get_body());
-    RETURN_IF_FAIL_IN_VISIT();
-    // we don't even care if the while returns. a return is required outside while anyway
-    pop_return_record();
+    IfBranch branch = get_if_branch(node, ancestors);
+    if (branch != IfBranch::None) {
+        bool returned = get_return_record();
+        pop_return_record();
+        if (branch == IfBranch::Then) {
+            _if_returned_stack.top().first = returned;
+        } else {
+            _if_returned_stack.top().second = returned;
+        }
+    }
 
-    END_VISIT();
+    return rc;
 }
 
-int ControlFlowVerificationPass::visit(const parser::ForStatementASTNodePtr &node)
+ControlFlowVerificationPass::IfBranch ControlFlowVerificationPass::get_if_branch(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
 {
-    BEGIN_VISIT();
-
-    push_return_record();
-    // init/cond/update cannot return nor break/continue
-    rc = traverse(node->get_body());
-    RETURN_IF_FAIL_IN_VISIT();
-    // we don't even care if the for returns. a return is required outside while anyway
-    pop_return_record();
+    if (ancestors.empty() || ancestors.back()->get_node_type() != parser::ASTNodeType::IfStatement) {
+        return IfBranch::None;
+    }
 
-    END_VISIT();
+    auto if_node = std::static_pointer_cast<parser::IfStatementASTNode>(ancestors.back());
+    if (node == if_node->get_then_branch()) {
+        return IfBranch::Then;
+    } else if (node == if_node->get_else_branch()) {
+        return IfBranch::Else;
+    } else {
+        return IfBranch::None;
+    }
 }
 
 // Three checks:
 // Add return context info.
 // Mark returned.
 // Check return type.
-int ControlFlowVerificationPass::visit(const parser::ReturnStatementASTNodePtr &node)
+int ControlFlowVerificationPass::check_return_statement(const parser::ReturnStatementASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
 {
-    BEGIN_VISIT();
-
     // 1. Add context info.
     // Search the ancestors from top to bottom. The first sub or function is what we return
     parser::AbstractSubroutineASTNodePtr subroutine_node = nullptr;
 
-    for (auto it = _ancestors.rbegin(); it != _ancestors.rend(); ++it) {
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
         const parser::ASTNodePtr &ancestor_node = *it;
         auto ancestor_type = ancestor_node->get_node_type();
         if (ancestor_type == parser::ASTNodeType::FunctionDefinition || ancestor_type == parser::ASTNodeType::SubprocDefinition) {
@@ -134,8 +148,7 @@ int ControlFlowVerificationPass::visit(const parser::ReturnStatementASTNodePtr &
 
     // no context found?
     if (!subroutine_node) {
-        rc = log_invalid_return_context_error(node);
-        RETURN_IF_FAIL_IN_VISIT();
+        return log_invalid_return_context_error(node);
     }
 
     // 2. Mark return graph's node's color
@@ -144,48 +157,30 @@ int ControlFlowVerificationPass::visit(const parser::ReturnStatementASTNodePtr &
     // 3. Check if returns a value
     bool has_return = node->get_expression().operator bool();
     if (_expected_return != has_return) {
-        rc = log_invalid_return_value_error(*subroutine_node->get_name(), node, _expected_return);
-        RETURN_IF_FAIL_IN_VISIT();
+        return log_invalid_return_value_error(*subroutine_node->get_name(), node, _expected_return);
     }
 
-    END_VISIT();
-}
-
-int ControlFlowVerificationPass::visit(const parser::BreakStatementASTNodePtr &node)
-{
-    BEGIN_VISIT();
-
-    rc = check_loop_control_statements(node);
-    RETURN_IF_FAIL_IN_VISIT();
-
-    END_VISIT();
+    return 0;
 }
 
-int ControlFlowVerificationPass::visit(const parser::ContinueStatementASTNodePtr &node)
+int ControlFlowVerificationPass::check_subroutine_returned(const parser::AbstractSubroutineASTNodePtr &node)
 {
-    BEGIN_VISIT();
-
-    rc = check_loop_control_statements(node);
-    RETURN_IF_FAIL_IN_VISIT();
+    auto returned = get_return_record();
+    pop_return_record();
 
-    END_VISIT();
-}
+    // only check the function (which expects return)
+    if (_expected_return && !returned) {
+        return log_not_all_path_return_error(*node->get_name(), node);
+    }
 
-int ControlFlowVerificationPass::visit(const parser::SubprocDefinitionASTNodePtr &node)
-{
-    return visit_subroutine(node, false);
+    return 0;
 }
 
-int ControlFlowVerificationPass::visit(const parser::FunctionDefinitionASTNodePtr &node)
-{
-    return visit_subroutine(node, true);
-}
-
-int ControlFlowVerificationPass::check_loop_control_statements(const parser::ASTNodePtr &node)
+int ControlFlowVerificationPass::check_loop_control_statements(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
 {
     // Search the ancestors from top to bottom. The first for/while is what we break or continue
     // Ensure there's no function/sub in our search.
-    for (auto it = _ancestors.rbegin(); it != _ancestors.rend(); ++it) {
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
         const parser::ASTNodePtr &ancestor_node = *it;
         auto ancestor_type = ancestor_node->get_node_type();
         if (ancestor_type == parser::ASTNodeType::WhileStatement || ancestor_type == parser::ASTNodeType::ForStatement) {
@@ -261,27 +256,6 @@ int hrl::semanalyzer::ControlFlowVerificationPass::log_not_all_path_return_error
     return E_SEMA_NOT_ALL_PATH_RETURN_VALUE;
 }
 
-int ControlFlowVerificationPass::visit_subroutine(const parser::AbstractSubroutineASTNodePtr &node, bool expect_return)
-{
-    BEGIN_VISIT();
-
-    _expected_return = expect_return;
-
-    push_return_record();
-    rc = traverse(node->get_body());
-    RETURN_IF_FAIL_IN_VISIT();
-    auto returned = get_return_record();
-    pop_return_record();
-
-    // only check the function (which expects return)
-    if (_expected_return && !returned) {
-        rc = log_not_all_path_return_error(*node->get_name(), node);
-        RETURN_IF_FAIL_IN_VISIT();
-    }
-
-    END_VISIT();
-}
-
 void hrl::semanalyzer::ControlFlowVerificationPass::push_return_record()
 {
     if (_returned_record_stack.empty()) {
@@ -56,6 +56,7 @@ int DeadCodeEliminationPass::visit(const parser::IfStatementASTNodePtr &node)
             if (else_branch) {
                 report_dead_code(else_branch, condition, DeadCodeReason::ConstantTrue);
                 else_branch = nullptr;
+                mark_modified();
             }
             auto &then_branch = node->get_then_branch();
             rc = traverse(then_branch);
@@ -138,6 +139,7 @@ int DeadCodeEliminationPass::visit(const parser::StatementBlockASTNodePtr &node)
             report_dead_code(*begin_unreachable, *std::prev(statements.end()), current_stmt, DeadCodeReason::EndOfFlow);
             // WARN: erase invalidates iterators and must return
             statements.erase(begin_unreachable, statements.end());
+            mark_modified();
             break;
         }
 
@@ -158,6 +160,7 @@ int DeadCodeEliminationPass::visit(const parser::StatementBlockASTNodePtr &node)
             report_dead_code(*next_stmt_it, *std::prev(statements.end()), current_stmt, DeadCodeReason::AfterInfiniteLoop);
             // WARN: erase invalidates iterators and must return
             statements.erase(next_stmt_it, statements.end());
+            mark_modified();
             break;
         }
     }
@@ -0,0 +1,92 @@
+#include <cassert>
+#include <vector>
+
+#include "FusedPass.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+int FusablePass::run()
+{
+    FusedPass fused(_filename, _root);
+    fused.add_pass(this);
+    return fused.run();
+}
+
+void FusedPass::add_pass(FusablePass *pass)
+{
+    assert(pass);
+    _passes.push_back(pass);
+}
+
+int FusedPass::run()
+{
+    _results.assign(_passes.size(), 0);
+    _active_end = _passes.size();
+    _ancestors.clear();
+
+    for (FusablePass *pass : _passes) {
+        pass->begin_traversal();
+    }
+
+    // the hooks report through the results, and the traversal itself always succeeds
+    visit(_root);
+
+    for (int rc : _results) {
+        if (rc != 0) {
+            return rc;
+        }
+    }
+    return 0;
+}
+
+PassTraits FusedPass::get_traits() const
+{
+    PassTraits traits { .read_only = true, .required_attributes = {}, .produced_attributes = {}, .invalidated_attributes = {} };
+    for (const FusablePass *pass : _passes) {
+        PassTraits pass_traits = pass->get_traits();
+        for (int attr : pass_traits.required_attributes) {
+            // an attribute produced by an earlier pass isn't required from outside
+            if (!traits.produced_attributes.contains(attr)) {
+                traits.required_attributes.insert(attr);
+            }
+        }
+        traits.produced_attributes.insert(pass_traits.produced_attributes.begin(), pass_traits.produced_attributes.end());
+    }
+    return traits;
+}
+
+void FusedPass::enter_node(const parser::ASTNodePtr &node)
+{
+    for (std::size_t i = 0; i < _active_end; ++i) {
+        if (_results[i] == 0) {
+            set_result(i, _passes[i]->on_node_enter(node, _ancestors));
+        }
+    }
+
+    SemanticAnalysisPass::enter_node(node);
+}
+
+void FusedPass::leave_node()
+{
+    assert(!_ancestors.empty());
+    parser::ASTNodePtr node = std::move(_ancestors.back());
+    SemanticAnalysisPass::leave_node();
+
+    for (std::size_t i = 0; i < _active_end; ++i) {
+        if (_results[i] == 0) {
+            set_result(i, _passes[i]->on_node_leave(node, _ancestors));
+        }
+    }
+}
+
+void FusedPass::set_result(std::size_t i, int rc)
+{
+    _results[i] = rc;
+    if (rc != 0 && _fail_fast) {
+        _active_end = i + 1;
+    }
+}
+
+CLOSE_SEMANALYZER_NAMESPACE
+// end
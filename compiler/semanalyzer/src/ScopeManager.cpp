@@ -1,8 +1,7 @@
+#include <cassert>
+#include <stack>
 #include <string>
 
-#include <boost/algorithm/string/join.hpp>
-#include <boost/algorithm/string/split.hpp>
-#include <boost/range/adaptors.hpp>
 #include <spdlog/spdlog.h>
 
 #include "ScopeManager.h"
@@ -13,34 +12,29 @@ OPEN_SEMANALYZER_NAMESPACE
 
 ScopeManager::ScopeManager()
 {
-    enter_scope(GLOBAL_SCOPE_ID, ScopeType::Global);
 }
 
 ScopeManager::~ScopeManager()
 {
 }
 
-std::string ScopeManager::get_current_scope_id() const
+void ScopeManager::reset(ScopeTree *tree)
 {
-    static const char delimiter[] = { DELIMITER, 0 };
-    return boost::join(
-        _current_scopes | boost::adaptors::transformed([](const std::pair<std::string, ScopeType> scope_pair) {
-            return scope_pair.first;
-        }),
-        delimiter);
+    _tree = tree;
+    _current_scopes.assign(1, ScopeTree::GLOBAL_SCOPE);
+    std::stack<int> scope_id;
+    scope_id.push(0);
+    _scope_id.swap(scope_id);
 }
 
 bool ScopeManager::enter_scope(const std::string &name, ScopeType scope_type)
 {
-    _current_scopes.push_back(std::make_pair(name, scope_type));
-    auto scope_id = get_current_scope_id();
-
-    if (_all_scopes.contains(scope_id)) {
-        _current_scopes.pop_back();
+    ScopeId scope_id = _tree->add_scope(_current_scopes.back(), name, scope_type);
+    if (scope_id == NO_SCOPE_ID) {
         return false;
     }
 
-    _all_scopes.insert(scope_id);
+    _current_scopes.push_back(scope_id);
     _scope_id.push(0);
     return true;
 }
@@ -66,31 +60,15 @@ void ScopeManager::exit_scope()
     _scope_id.pop();
 }
 
-std::vector<std::string> ScopeManager::get_ancestor_scopes(const std::string &scope_id)
-{
-    std::vector<std::string> result;
-
-    std::vector<std::string> parts;
-    boost::split(parts, scope_id, [](char c) { return c == '.'; });
-
-    std::string separator(1, DELIMITER);
-    for (std::size_t i = parts.size(); i > 0; --i) {
-        result.push_back(boost::algorithm::join(std::vector<std::string>(parts.begin(), parts.begin() + i), separator));
-    }
-
-    result.push_back("");
-    return result;
-}
-
 std::string ScopeInfoAttribute::to_string()
 {
     switch (_type) {
     case ScopeType::Global:
         return "scope: [global]";
     case ScopeType::Subroutine:
-        return "scope: [sub]" + _scope_id;
+        return "scope: [sub]#" + std::to_string(_scope_id);
     case ScopeType::Block:
-        return "scope: [blk]" + _scope_id;
+        return "scope: [blk]#" + std::to_string(_scope_id);
     }
     // not supposed to happen
     spdlog::critical("unrecognized scope type: {}. {}", static_cast<int>(_type), __PRETTY_FUNCTION__);
@@ -0,0 +1,68 @@
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "ScopeTree.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+ScopeTree::ScopeTree()
+{
+    clear();
+}
+
+ScopeId ScopeTree::add_scope(ScopeId parent, const std::string &name, ScopeType type)
+{
+    ScopeId id = static_cast<ScopeId>(_scopes.size());
+    auto [_, inserted] = _children.emplace(std::make_pair(parent, name), id);
+    if (!inserted) {
+        return NO_SCOPE_ID;
+    }
+
+    _scopes.push_back(Scope { .parent = parent, .depth = _scopes[parent].depth + 1, .type = type, .name = name });
+    return id;
+}
+
+bool ScopeTree::is_ancestor_of(ScopeId ancestor, ScopeId scope) const
+{
+    unsigned int ancestor_depth = get_depth(ancestor);
+    if (get_depth(scope) < ancestor_depth) {
+        return false;
+    }
+
+    while (get_depth(scope) > ancestor_depth) {
+        scope = get_parent(scope);
+    }
+    return scope == ancestor;
+}
+
+std::string ScopeTree::get_path(ScopeId scope) const
+{
+    std::vector<ScopeId> path;
+    for (ScopeId current = scope; current != LIBRARY_SCOPE; current = get_parent(current)) {
+        path.push_back(current);
+    }
+
+    std::string result;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        if (!result.empty()) {
+            result.push_back('.');
+        }
+        result += _scopes[*it].name;
+    }
+    return result;
+}
+
+void ScopeTree::clear()
+{
+    _scopes.clear();
+    _children.clear();
+    _scopes.push_back(Scope { .parent = NO_SCOPE_ID, .depth = 0, .type = ScopeType::Global, .name = "" });
+    ScopeId global = add_scope(LIBRARY_SCOPE, GLOBAL_SCOPE_ID, ScopeType::Global);
+    UNUSED(global);
+    assert(global == GLOBAL_SCOPE);
+}
+
+CLOSE_SEMANALYZER_NAMESPACE
+// end
@@ -307,11 +307,41 @@ int SemanticAnalysisPass::visit(const parser::CompilationUnitASTNodePtr &node)
 void SemanticAnalysisPass::request_to_replace_self(parser::ASTNodePtr to_be_replaced_with)
 {
     _node_replacement_requests[_ancestors.back()] = to_be_replaced_with;
+    mark_modified();
 }
 
 void SemanticAnalysisPass::request_to_remove_self()
 {
     _node_removal_requests.insert(_ancestors.back());
+    mark_modified();
+}
+
+int SemanticAnalysisPass::run_on_globals()
+{
+    enter_node(_root);
+    int rc = traverse_multiple(_root->get_floor_inits(), _root->get_var_decls());
+    leave_node();
+    return rc;
+}
+
+int SemanticAnalysisPass::run_on_subroutine(parser::AbstractSubroutineASTNodePtr &subroutine)
+{
+    enter_node(_root);
+    int rc = traverse(subroutine);
+    leave_node();
+    return rc;
+}
+
+void SemanticAnalysisPass::mark_modified()
+{
+    for (auto it = _ancestors.rbegin(); it != _ancestors.rend(); ++it) {
+        auto subroutine = std::dynamic_pointer_cast<parser::AbstractSubroutineASTNode>(*it);
+        if (subroutine) {
+            _changes.subroutines.insert(subroutine);
+            return;
+        }
+    }
+    _changes.globals = true;
 }
 
 bool SemanticAnalysisPass::ancestor_has(parser::ASTNodeType type) const
@@ -1,8 +1,21 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
 
+#include <boost/algorithm/string/join.hpp>
 #include <spdlog/spdlog.h>
 
 #include "ASTNodeGraphvizBuilder.h"
+#include "ErrorManager.h"
+#include "FusedPass.h"
 #include "SemanticAnalysisPassManager.h"
 #include "semanalyzer_global.h"
 
@@ -16,9 +29,11 @@ void SemanticAnalysisPassManager::add_pass(
     SemanticAnalysisPassPtr pass,
     const std::string &pass_name,
     const std::string &after_pass_graph_path,
-    const std::set<int> enabled_attributes)
+    const std::set<int> enabled_attributes,
+    SplitPassFactory split_pass_factory)
 {
     _passes.push_back(pass);
+    _split_pass_factories.push_back(std::move(split_pass_factory));
     _pass_names.push_back(pass_name);
     _pass_graph_filepaths.push_back(after_pass_graph_path);
     _pass_graph_enabled_attrs.push_back(enabled_attributes);
@@ -33,18 +48,50 @@ int SemanticAnalysisPassManager::run(bool fail_fast)
         && _pass_graph_filepaths.size() == _pass_graph_enabled_attrs.size());
 
     for (std::size_t i = 0; i < _passes.size(); ++i) {
+        std::size_t fusion_end = _fusion_enabled ? find_fusion_end(i) : i;
+        if (fusion_end - i > 1) {
+            int rc = run_fused(i, fusion_end, fail_fast);
+            if (rc != 0) {
+                if (fail_fast) {
+                    return rc;
+                } else {
+                    result = rc;
+                }
+            }
+            i = fusion_end - 1;
+            continue;
+        }
+
         const auto &pass = _passes.at(i);
         const auto &pass_name = _pass_names.at(i);
-        const auto &pass_path = _pass_graph_filepaths.at(i);
-        const auto &pass_attr = _pass_graph_enabled_attrs.at(i);
-
-        spdlog::info("Running semantic analysis pass {}...", pass_name);
-        int rc = pass->run();
-        if (!pass_path.empty()) {
-            parser::ASTNodeGraphvizBuilder graph_builder(_root);
-            graph_builder.generate_graphviz(pass_path, pass_attr);
+        PassTraits traits = pass->get_traits();
+
+        ASTChanges changes;
+        bool redo = _change_tracking_enabled && find_changes_since_last_run(i, traits, changes);
+        if (redo && changes.empty()) {
+            spdlog::info("Skipping semantic analysis pass {}, since the AST is unchanged since its last run", pass_name);
+            generate_graphviz(i);
+            continue;
         }
 
+        int rc;
+        if (redo && !changes.globals && _split_pass_factories.at(i)) {
+            // in the order of the subroutines, for the diagnostics
+            std::vector<parser::AbstractSubroutineASTNodePtr> changed_subroutines;
+            std::ranges::copy_if(_root->get_subroutines(), std::back_inserter(changed_subroutines),
+                [&](const parser::AbstractSubroutineASTNodePtr &subroutine) { return changes.subroutines.contains(subroutine); });
+            spdlog::info("Running semantic analysis pass {} on {} changed subroutines...", pass_name, changed_subroutines.size());
+            rc = run_split(i, changed_subroutines);
+        } else if (_thread_count > 1 && _split_pass_factories.at(i)) {
+            spdlog::info("Running semantic analysis pass {} on {} threads...", pass_name, _thread_count);
+            rc = run_split(i, _root->get_subroutines());
+        } else {
+            spdlog::info("Running semantic analysis pass {}...", pass_name);
+            rc = pass->run();
+        }
+        record_run(i, traits, rc);
+        generate_graphviz(i);
+
         if (rc != 0) {
             spdlog::error("Semantic pass {} failed", pass_name);
             if (fail_fast) {
@@ -58,6 +105,189 @@ int SemanticAnalysisPassManager::run(bool fail_fast)
     return result;
 }
 
+std::size_t SemanticAnalysisPassManager::find_fusion_end(std::size_t begin) const
+{
+    std::set<int> produced_attributes;
+    std::size_t end = begin;
+    for (; end < _passes.size(); ++end) {
+        if (!std::dynamic_pointer_cast<FusablePass>(_passes.at(end))) {
+            break;
+        }
+
+        // the attributes are attached node by node, so a pass cannot read what another pass of the same traversal attaches
+        PassTraits traits = _passes.at(end)->get_traits();
+        bool depends_on_fused = std::ranges::any_of(traits.required_attributes, [&](int attr) { return produced_attributes.contains(attr); });
+        if (!traits.read_only || depends_on_fused) {
+            break;
+        }
+        produced_attributes.insert(traits.produced_attributes.begin(), traits.produced_attributes.end());
+    }
+    return end;
+}
+
+int SemanticAnalysisPassManager::run_fused(std::size_t begin, std::size_t end, bool fail_fast)
+{
+    FusedPass fused(_filename, _root);
+    fused.set_fail_fast(fail_fast);
+    std::vector<std::string> names;
+    for (std::size_t i = begin; i < end; ++i) {
+        fused.add_pass(std::static_pointer_cast<FusablePass>(_passes.at(i)).get());
+        names.push_back(_pass_names.at(i));
+    }
+
+    spdlog::info("Running semantic analysis passes {} in one traversal...", boost::join(names, ", "));
+    int result = fused.run();
+    for (std::size_t i = begin; i < end; ++i) {
+        record_run(i, _passes.at(i)->get_traits(), fused.get_result(i - begin));
+        generate_graphviz(i);
+        if (fused.get_result(i - begin) != 0) {
+            spdlog::error("Semantic pass {} failed", _pass_names.at(i));
+        }
+    }
+    return result;
+}
+
+int SemanticAnalysisPassManager::run_split(std::size_t i, const std::vector<parser::AbstractSubroutineASTNodePtr> &subroutines)
+{
+    // the globals are analyzed by the pass itself, and their diagnostics are reported as usual
+    WithSubroutineSplit *main_pass = dynamic_cast<WithSubroutineSplit *>(_passes.at(i).get());
+    assert(main_pass);
+    int result = main_pass->run_globals();
+
+    // the first worker is the pass itself. The others analyze the globals again, with their diagnostics dropped.
+    std::size_t worker_count = std::max<std::size_t>(1, std::min<std::size_t>(_thread_count, subroutines.size()));
+    std::vector<SemanticAnalysisPassPtr> instances { _passes.at(i) };
+    for (std::size_t worker = 1; worker < worker_count; ++worker) {
+        instances.push_back(_split_pass_factories.at(i)());
+    }
+
+    std::vector<std::vector<CompilerMessage>> messages(subroutines.size());
+    std::vector<int> results(subroutines.size(), 0);
+    std::vector<std::exception_ptr> exceptions(worker_count);
+    std::atomic<std::size_t> next_subroutine = 0;
+
+    auto work = [&](std::size_t worker) {
+        try {
+            WithSubroutineSplit *pass = dynamic_cast<WithSubroutineSplit *>(instances.at(worker).get());
+            if (worker != 0) {
+                std::vector<CompilerMessage> dropped;
+                ErrorManager::set_thread_capture(&dropped);
+                pass->run_globals();
+            }
+
+            for (std::size_t s = next_subroutine++; s < subroutines.size(); s = next_subroutine++) {
+                ErrorManager::set_thread_capture(&messages.at(s));
+                results.at(s) = pass->run_subroutine(subroutines.at(s));
+            }
+            ErrorManager::set_thread_capture(nullptr);
+            pass->end_subroutines();
+        } catch (...) {
+            ErrorManager::set_thread_capture(nullptr);
+            exceptions.at(worker) = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t worker = 1; worker < worker_count; ++worker) {
+        threads.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (const std::exception_ptr &exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    // report as a run on one thread would, which stops at the first failed subroutine
+    for (std::size_t s = 0; s < subroutines.size(); ++s) {
+        ErrorManager::instance().report_captured(std::move(messages.at(s)));
+        if (results.at(s) != 0) {
+            result = results.at(s);
+            break;
+        }
+    }
+
+    return result;
+}
+
+bool SemanticAnalysisPassManager::find_changes_since_last_run(std::size_t i, const PassTraits &traits, ASTChanges &changes) const
+{
+    std::size_t since;
+    if (!traits.invalidated_attributes.empty()) {
+        // it redoes nothing if an attribute is gone already
+        since = _changes.size();
+        for (int attr : traits.invalidated_attributes) {
+            auto it = _attribute_revisions.find(attr);
+            if (it == _attribute_revisions.end()) {
+                return false;
+            }
+            since = std::min(since, it->second);
+        }
+    } else if (traits.read_only) {
+        const SemanticAnalysisPass &pass = *_passes.at(i);
+        auto it = _pass_revisions.find(std::type_index(typeid(pass)));
+        if (it == _pass_revisions.end()) {
+            return false;
+        }
+        // the attributes of that run must be kept, to be reused
+        bool attributes_kept = std::ranges::all_of(traits.produced_attributes, [&](int attr) {
+            auto attr_it = _attribute_revisions.find(attr);
+            return attr_it != _attribute_revisions.end() && attr_it->second >= it->second;
+        });
+        if (!attributes_kept) {
+            return false;
+        }
+        since = it->second;
+    } else {
+        return false;
+    }
+
+    changes = ASTChanges();
+    for (std::size_t revision = since; revision < _changes.size(); ++revision) {
+        changes.merge(_changes.at(revision));
+    }
+    return true;
+}
+
+void SemanticAnalysisPassManager::record_run(std::size_t i, const PassTraits &traits, int rc)
+{
+    SemanticAnalysisPass &pass = *_passes.at(i);
+    ASTChanges changes = pass.take_changes();
+    if (!changes.empty()) {
+        _changes.push_back(std::move(changes));
+    }
+
+    for (int attr : traits.invalidated_attributes) {
+        _attribute_revisions.erase(attr);
+    }
+
+    if (rc != 0) {
+        return;
+    }
+
+    std::size_t revision = _changes.size();
+    if (traits.read_only) {
+        _pass_revisions[std::type_index(typeid(pass))] = revision;
+    }
+    for (int attr : traits.produced_attributes) {
+        _attribute_revisions[attr] = revision;
+    }
+}
+
+void SemanticAnalysisPassManager::generate_graphviz(std::size_t i)
+{
+    const auto &pass_path = _pass_graph_filepaths.at(i);
+    const auto &pass_attr = _pass_graph_enabled_attrs.at(i);
+    if (!pass_path.empty()) {
+        parser::ASTNodeGraphvizBuilder graph_builder(_root);
+        graph_builder.generate_graphviz(pass_path, pass_attr);
+    }
+}
+
 void SemanticAnalysisPassManager::set_symbol_table(const SymbolTablePtr symtbl)
 {
     _symbol_table = symtbl;
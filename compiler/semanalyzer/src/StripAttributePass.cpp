@@ -1,19 +1,24 @@
+#include "ASTNodeArena.h"
 #include "StripAttributePass.h"
 #include "semanalyzer_global.h"
 
 OPEN_SEMANALYZER_NAMESPACE
 
+// The attributes live in the tables of the arena, so stripping one is a clear of its table without a traversal
 int StripAttributePass::run()
 {
-    return SemanticAnalysisPass::visit(_root);
-}
+    parser::ASTNodeArena *arena = _root->get_arena();
+    if (!arena) {
+        return 0;
+    }
 
-void StripAttributePass::enter_node(const parser::ASTNodePtr &node)
-{
     for (int attr : _attributes) {
-        node->remove_attribute(attr);
+        parser::AbstractASTNodeAttributeTable *table = arena->find_attribute_table(attr);
+        if (table) {
+            table->clear();
+        }
     }
-    SemanticAnalysisPass::enter_node(node);
+    return 0;
 }
 
 CLOSE_SEMANALYZER_NAMESPACE
\ No newline at end of file
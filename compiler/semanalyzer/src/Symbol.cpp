@@ -17,7 +17,7 @@ std::string Symbol::to_string()
         type_str = "Subroutine";
         break;
     }
-    auto str = boost::format("symbol: <%1%> %2%") % type_str % name;
+    auto str = boost::format("symbol: <%1%> %2%") % type_str % *name;
     return str.str();
 }
 
@@ -17,18 +17,18 @@
 
 OPEN_SEMANALYZER_NAMESPACE
 
-bool SymbolAnalysisPass::lookup_symbol_with_ancestors(const StringPtr &name, SymbolPtr &out_symbol, std::string &out_def_scope)
+bool SymbolAnalysisPass::lookup_symbol_with_ancestors(StringId name, SymbolPtr &out_symbol, ScopeId &out_def_scope)
 {
     return _symbol_table->lookup_symbol(_scope_manager.get_current_scope_id(), name, true, out_symbol, out_def_scope);
 }
 
-bool SymbolAnalysisPass::lookup_symbol_with_ancestors(const StringPtr &name, SymbolPtr &out_symbol)
+bool SymbolAnalysisPass::lookup_symbol_with_ancestors(StringId name, SymbolPtr &out_symbol)
 {
-    std::string _;
+    ScopeId _;
     return lookup_symbol_with_ancestors(name, out_symbol, _);
 }
 
-int SymbolAnalysisPass::attach_symbol_or_log_error(const StringPtr &name, SymbolType type, const ASTNodePtr &node)
+int SymbolAnalysisPass::attach_symbol_or_log_error(StringId name, SymbolType type, const ASTNodePtr &node)
 {
     SymbolPtr symbol;
     if (!lookup_symbol_with_ancestors(name, symbol) || symbol->type != type) {
@@ -40,7 +40,7 @@ int SymbolAnalysisPass::attach_symbol_or_log_error(const StringPtr &name, Symbol
     }
 }
 
-int SymbolAnalysisPass::add_subroutine_symbol_or_log_error(const StringPtr &name, bool has_param, bool has_return, const ASTNodePtr &node)
+int SymbolAnalysisPass::add_subroutine_symbol_or_log_error(StringId name, bool has_param, bool has_return, const ASTNodePtr &node)
 {
     SymbolPtr added;
     if (!_symbol_table->add_function_symbol(_scope_manager.get_current_scope_id(), name, has_param, has_return, _filename, node, added)) {
@@ -52,7 +52,7 @@ int SymbolAnalysisPass::add_subroutine_symbol_or_log_error(const StringPtr &name
     }
 }
 
-int SymbolAnalysisPass::add_variable_symbol_or_log_error(const StringPtr &name, const ASTNodePtr &node)
+int SymbolAnalysisPass::add_variable_symbol_or_log_error(StringId name, const ASTNodePtr &node)
 {
     SymbolPtr symbol, added;
     bool found_in_ancestor_or_current = lookup_symbol_with_ancestors(name, symbol);
@@ -67,7 +67,7 @@ int SymbolAnalysisPass::add_variable_symbol_or_log_error(const StringPtr &name,
         auto original_node = WEAK_TO_SHARED(symbol->definition);
 
         auto errstr = boost::format("variable '%1%' shadows a %2% from the outer scope")
-            % *name % (symbol->type == SymbolType::VARIABLE ? "variable" : "function");
+            % _symbol_table->get_strings()->str(name) % (symbol->type == SymbolType::VARIABLE ? "variable" : "function");
 
         ErrorManager::instance().report(
             W_SEMA_VAR_SHADOW_OUTER,
@@ -89,13 +89,14 @@ void SymbolAnalysisPass::attach_scope_id(const ASTNodePtr &node)
 {
     auto scope_id = _scope_manager.get_current_scope_id();
     auto scope_info = std::make_shared<ScopeInfoAttribute>(scope_id, _scope_manager.get_current_scope_type());
-    node->set_attribute(SemAnalzyerASTNodeAttributeId::ATTR_SEMANALYZER_SCOPE_INFO, scope_info);
+    ScopeInfoAttribute::set_scope(node, scope_info);
 }
 
-void SymbolAnalysisPass::log_redefinition_error(const StringPtr &name, SymbolType type, const ASTNodePtr &node)
+void SymbolAnalysisPass::log_redefinition_error(StringId name, SymbolType type, const ASTNodePtr &node)
 {
+    const std::string &name_str = _symbol_table->get_strings()->str(name);
     SymbolPtr defined_symbol;
-    std::string _;
+    ScopeId _;
     bool symbol_found = _symbol_table->lookup_symbol(_scope_manager.get_current_scope_id(), name, false, defined_symbol, _);
     UNUSED(symbol_found);
     assert(symbol_found); // won't happen
@@ -114,22 +115,23 @@ void SymbolAnalysisPass::log_redefinition_error(const StringPtr &name, SymbolTyp
     }
 
     auto errstr = boost::format("Redefinition of %1% '%2%'.")
-        % type_str % *name;
+        % type_str % name_str;
 
     ErrorManager::instance().report(
         E_SEMA_SYM_REDEF,
         ErrorSeverity::Error,
-        ErrorLocation(*_filename, node->lineno(), node->colno(), name->size()),
+        ErrorLocation(*_filename, node->lineno(), node->colno(), name_str.size()),
         errstr.str());
 
     ErrorManager::instance().report_continued(
         ErrorSeverity::Error,
-        ErrorLocation(defined_symbol->filename, defined_node->lineno(), defined_node->colno(), name->size()),
+        ErrorLocation(defined_symbol->filename, defined_node->lineno(), defined_node->colno(), name_str.size()),
         "Original defined in");
 }
 
-void SymbolAnalysisPass::log_undefined_error(const StringPtr &name, SymbolType type, const ASTNodePtr &node)
+void SymbolAnalysisPass::log_undefined_error(StringId name, SymbolType type, const ASTNodePtr &node)
 {
+    const std::string &name_str = _symbol_table->get_strings()->str(name);
     std::string type_str;
     switch (type) {
     case SymbolType::VARIABLE:
@@ -141,12 +143,12 @@ void SymbolAnalysisPass::log_undefined_error(const StringPtr &name, SymbolType t
     }
 
     auto errstr = boost::format("Undefined reference to '%2%'. The %1% '%2%' is not declared before use.")
-        % type_str % *name;
+        % type_str % name_str;
 
     ErrorManager::instance().report(
         E_SEMA_SYM_UNDEFINED,
         ErrorSeverity::Error,
-        ErrorLocation(*_filename, node->lineno(), node->colno(), name->size()),
+        ErrorLocation(*_filename, node->lineno(), node->colno(), name_str.size()),
         errstr.str());
 }
 
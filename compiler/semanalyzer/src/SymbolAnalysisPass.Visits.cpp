@@ -6,6 +6,7 @@
 #include <spdlog/spdlog.h>
 
 #include "ASTNode.h"
+#include "ASTNodeArena.h"
 #include "ASTNodeForward.h"
 #include "ErrorManager.h"
 #include "ErrorMessage.h"
@@ -42,7 +43,8 @@ OPEN_SEMANALYZER_NAMESPACE
 
 int SymbolAnalysisPass::run()
 {
-    init_symbol_table();
+    init_symbol_table(_root->get_arena()->strings());
+    _scope_manager.reset(&_symbol_table->get_scope_tree());
 
     int result = 0, rc = 0;
     rc = visit(_root);
@@ -60,7 +62,7 @@ int SymbolAnalysisPass::check_pending_invocations()
         auto node = _pending_invocation_check.front();
         _pending_invocation_check.pop();
 
-        StringPtr func_name = node->get_func_name();
+        StringId func_name = node->get_func_name_id();
         rc = attach_symbol_or_log_error(func_name, SymbolType::SUBROUTINE, node);
         RETURN_IF_FAIL();
 
@@ -82,16 +84,16 @@ int SymbolAnalysisPass::check_pending_invocations()
         if (def_has_param != node_has_param) {
             auto errstr = boost::format("signature mismatch: invoked as '%4%(%5%)' but defined as '%1% %2%(%3%)'")
                 % (def_has_return ? "function" : "sub")
-                % *func_name
+                % *node->get_func_name()
                 % (def_has_param ? "arg" : "")
-                % *func_name
+                % *node->get_func_name()
                 % (node_has_param ? "arg" : "");
             // % symbol->filename % def_astnode->lineno() % def_astnode->colno();
 
             ErrorManager::instance().report(
                 E_SEMA_SUBROUTINE_SIGNATURE_MISMATCH,
                 ErrorSeverity::Error,
-                ErrorLocation(*_filename, node->lineno(), node->colno(), func_name->size()),
+                ErrorLocation(*_filename, node->lineno(), node->colno(), node->get_func_name()->size()),
                 errstr.str());
             ErrorManager::instance().report_continued(
                 ErrorSeverity::Error,
@@ -119,7 +121,7 @@ int SymbolAnalysisPass::visit(const VariableDeclarationASTNodePtr &node)
     // Implement visit logic for VariableDeclarationASTNode
     BEGIN_VISIT();
 
-    rc = add_variable_symbol_or_log_error(node->get_name(), node);
+    rc = add_variable_symbol_or_log_error(node->get_name_id(), node);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
 
     rc = traverse(node->get_assignment());
@@ -133,7 +135,7 @@ int SymbolAnalysisPass::visit(const VariableAssignmentASTNodePtr &node)
     // Implement visit logic for VariableAssignmentASTNode
     BEGIN_VISIT();
 
-    rc = attach_symbol_or_log_error(node->get_name(), SymbolType::VARIABLE, node);
+    rc = attach_symbol_or_log_error(node->get_name_id(), SymbolType::VARIABLE, node);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
     rc = traverse(node->get_value());
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
@@ -146,7 +148,7 @@ int SymbolAnalysisPass::visit(const VariableAccessASTNodePtr &node)
     // Implement visit logic for VariableAccessASTNode
     BEGIN_VISIT();
 
-    rc = attach_symbol_or_log_error(node->get_name(), SymbolType::VARIABLE, node);
+    rc = attach_symbol_or_log_error(node->get_name_id(), SymbolType::VARIABLE, node);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
 
     END_VISIT();
@@ -182,7 +184,7 @@ int SymbolAnalysisPass::visit(const IncrementExpressionASTNodePtr &node)
     // Implement visit logic for IncrementExpressionASTNode
     BEGIN_VISIT();
 
-    rc = attach_symbol_or_log_error(node->get_var_name(), SymbolType::VARIABLE, node);
+    rc = attach_symbol_or_log_error(node->get_var_name_id(), SymbolType::VARIABLE, node);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
 
     END_VISIT();
@@ -193,7 +195,7 @@ int SymbolAnalysisPass::visit(const DecrementExpressionASTNodePtr &node)
     // Implement visit logic for DecrementExpressionASTNode
     BEGIN_VISIT();
 
-    rc = attach_symbol_or_log_error(node->get_var_name(), SymbolType::VARIABLE, node);
+    rc = attach_symbol_or_log_error(node->get_var_name_id(), SymbolType::VARIABLE, node);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
 
     END_VISIT();
@@ -420,14 +422,14 @@ int SymbolAnalysisPass::visit_subroutine(AbstractSubroutineASTNodePtr node, bool
     // 4. traverse function body
     BEGIN_VISIT();
 
-    const StringPtr &function_name = node->get_name();
+    StringId function_name = node->get_name_id();
     auto param = node->get_parameter();
     bool has_param = param.operator bool();
 
     rc = add_subroutine_symbol_or_log_error(function_name, has_param, has_return, node);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
 
-    enter_scope(function_name, ScopeType::Subroutine);
+    enter_scope(node->get_name(), ScopeType::Subroutine);
 
     rc = traverse(param);
     SET_RESULT_RC_AND_RETURN_IN_VISIT();
@@ -1,10 +1,11 @@
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include <boost/format.hpp>
 
-#include "ScopeManager.h"
+#include "ScopeTree.h"
 #include "Symbol.h"
 #include "SymbolTable.h"
 #include "hrl_global.h"
@@ -12,31 +13,90 @@
 
 OPEN_SEMANALYZER_NAMESPACE
 
-SymbolTable::SymbolTable()
+SymbolTable::SymbolTable(StringInternerPtr strings)
+    : _strings(std::move(strings))
 {
     create_library_symbols();
 }
 
-bool SymbolTable::add_symbol(const std::string &scope_id, SymbolPtr symbol)
+bool SymbolTable::add_symbol(ScopeId scope_id, SymbolPtr symbol)
 {
-    auto &scope = _scopes[scope_id];
-    if (scope.contains(symbol->name)) {
+    if (find_symbol(scope_id, symbol->name_id) != NO_SYMBOL) {
         return false;
     }
 
-    scope[symbol->name] = symbol;
+    std::uint32_t position = static_cast<std::uint32_t>(_symbols.size());
+    _symbols.push_back(std::move(symbol));
+    _symbol_scopes.push_back(scope_id);
+    index_symbol(scope_id, position);
     return true;
 }
 
-bool SymbolTable::add_function_symbol(const std::string &scope_id, StringPtr function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition)
+std::uint32_t SymbolTable::find_symbol(ScopeId scope_id, StringId name) const
+{
+    if (scope_id >= _scope_indexes.size()) {
+        return NO_SYMBOL;
+    }
+
+    const auto &slots = _scope_indexes[scope_id].slots;
+    if (slots.empty()) {
+        return NO_SYMBOL;
+    }
+
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t i = name & mask;; i = (i + 1) & mask) {
+        const IndexSlot &slot = slots[i];
+        if (slot.name == name) {
+            return slot.symbol;
+        }
+        if (slot.name == NO_STRING_ID) {
+            return NO_SYMBOL;
+        }
+    }
+}
+
+void SymbolTable::index_symbol(ScopeId scope_id, std::uint32_t position)
+{
+    if (scope_id >= _scope_indexes.size()) {
+        _scope_indexes.resize(scope_id + 1);
+    }
+
+    ScopeIndex &index = _scope_indexes[scope_id];
+    if ((index.count + 1) * 4 > index.slots.size() * 3) {
+        ScopeIndex grown;
+        grown.slots.resize(index.slots.empty() ? 8 : index.slots.size() * 2);
+        for (const IndexSlot &slot : index.slots) {
+            if (slot.name != NO_STRING_ID) {
+                insert_slot(grown, slot.name, slot.symbol);
+            }
+        }
+        index = std::move(grown);
+    }
+
+    insert_slot(index, _symbols[position]->name_id, position);
+}
+
+void SymbolTable::insert_slot(ScopeIndex &index, StringId name, std::uint32_t position)
+{
+    std::size_t mask = index.slots.size() - 1;
+    std::size_t i = name & mask;
+    while (index.slots[i].name != NO_STRING_ID) {
+        i = (i + 1) & mask;
+    }
+
+    index.slots[i] = IndexSlot { .name = name, .symbol = position };
+    ++index.count;
+}
+
+bool SymbolTable::add_function_symbol(ScopeId scope_id, StringId function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition)
 {
     SymbolPtr out;
     return add_function_symbol(scope_id, function_name, has_param, has_return, filename, definition, out);
 }
 
-bool SymbolTable::add_function_symbol(const std::string &scope_id, StringPtr function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out)
+bool SymbolTable::add_function_symbol(ScopeId scope_id, StringId function_name, bool has_param, bool has_return, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out)
 {
-    auto symbol = std::make_shared<Symbol>(SymbolType::SUBROUTINE, *function_name, filename, SHARED_TO_WEAK(definition));
+    auto symbol = std::make_shared<Symbol>(SymbolType::SUBROUTINE, function_name, _strings->shared(function_name), filename, SHARED_TO_WEAK(definition));
     symbol->set_param(has_param);
     symbol->set_return(has_return);
     bool ok = add_symbol(scope_id, symbol);
@@ -48,9 +108,9 @@ bool SymbolTable::add_function_symbol(const std::string &scope_id, StringPtr fun
     }
 }
 
-bool SymbolTable::add_variable_symbol(const std::string &scope_id, StringPtr variable_name, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out)
+bool SymbolTable::add_variable_symbol(ScopeId scope_id, StringId variable_name, StringPtr filename, const parser::ASTNodePtr &definition, SymbolPtr &out)
 {
-    auto symbol = std::make_shared<Symbol>(SymbolType::VARIABLE, *variable_name, filename, SHARED_TO_WEAK(definition));
+    auto symbol = std::make_shared<Symbol>(SymbolType::VARIABLE, variable_name, _strings->shared(variable_name), filename, SHARED_TO_WEAK(definition));
     bool ok = add_symbol(scope_id, symbol);
     if (ok) {
         out = symbol;
@@ -60,112 +120,97 @@ bool SymbolTable::add_variable_symbol(const std::string &scope_id, StringPtr var
     }
 }
 
-bool SymbolTable::add_variable_symbol(const std::string &scope_id, StringPtr variable_name, StringPtr filename, const parser::ASTNodePtr &definition)
+bool SymbolTable::add_variable_symbol(ScopeId scope_id, StringId variable_name, StringPtr filename, const parser::ASTNodePtr &definition)
 {
     SymbolPtr out;
     return add_variable_symbol(scope_id, variable_name, filename, definition, out);
 }
 
-bool SymbolTable::lookup_symbol(const std::string &scope_id, const std::string &name, bool lookup_ancestors, SymbolPtr &symbol_out, std::string &defined_scope_out)
+bool SymbolTable::lookup_symbol(ScopeId scope_id, StringId name, bool lookup_ancestors, SymbolPtr &symbol_out, ScopeId &defined_scope_out) const
 {
-    if (!lookup_ancestors) {
-        auto &scope = _scopes[scope_id];
-        auto it = scope.find(name);
-        if (it == scope.end()) {
-            return false;
-        } else {
-            symbol_out = it->second;
-            defined_scope_out = scope_id;
+    for (ScopeId current_scope_id = scope_id; current_scope_id != NO_SCOPE_ID; current_scope_id = _scope_tree.get_parent(current_scope_id)) {
+        std::uint32_t position = find_symbol(current_scope_id, name);
+        if (position != NO_SYMBOL) {
+            symbol_out = _symbols[position];
+            defined_scope_out = current_scope_id;
             return true;
         }
-    } else {
-        auto ancestors = ScopeManager::get_ancestor_scopes(scope_id);
-        for (auto &current_scope_id : ancestors) {
-            auto &scope = _scopes[current_scope_id];
-            auto it = scope.find(name);
-
-            if (it != scope.end()) {
-                symbol_out = it->second;
-                defined_scope_out = current_scope_id;
-                return true;
-            }
-        }
 
-        // looked up everything but there's no
-        return false;
+        if (!lookup_ancestors) {
+            break;
+        }
     }
+
+    // looked up everything but there's no
+    return false;
 }
 
-bool SymbolTable::lookup_symbol(const std::string &scope_id, const StringPtr &name, bool lookup_ancestors, SymbolPtr &symbol_out, std::string &defined_scope_out)
+bool SymbolTable::lookup_symbol(ScopeId scope_id, const std::string &name, bool lookup_ancestors, SymbolPtr &symbol_out, ScopeId &defined_scope_out) const
 {
-    return lookup_symbol(scope_id, *name, lookup_ancestors, symbol_out, defined_scope_out);
+    StringId name_id = _strings->find(name);
+    if (name_id == NO_STRING_ID) {
+        return false;
+    }
+    return lookup_symbol(scope_id, name_id, lookup_ancestors, symbol_out, defined_scope_out);
 }
 
 void SymbolTable::create_library_symbols()
 {
-    StringPtr outbox = std::make_shared<std::string>("outbox");
-    StringPtr inbox = std::make_shared<std::string>("inbox");
+    StringId outbox = _strings->intern("outbox");
+    StringId inbox = _strings->intern("inbox");
     StringPtr libfile = std::make_shared<std::string>("@stdlib");
     // absolutely topmost scope
-    add_function_symbol("", outbox, true, false, libfile, nullptr);
-    add_function_symbol("", inbox, false, true, libfile, nullptr);
+    add_function_symbol(ScopeTree::LIBRARY_SCOPE, outbox, true, false, libfile, nullptr);
+    add_function_symbol(ScopeTree::LIBRARY_SCOPE, inbox, false, true, libfile, nullptr);
 }
 
-void hrl::semanalyzer::SymbolTable::get_symbols_include_ancestors(const std::string &scope_id, std::vector<std::pair<SymbolPtr, std::string>> &out)
+void hrl::semanalyzer::SymbolTable::get_symbols_include_ancestors(ScopeId scope_id, std::vector<std::pair<SymbolPtr, ScopeId>> &out) const
 {
-    std::vector<std::pair<SymbolPtr, std::string>> result;
+    std::vector<std::pair<SymbolPtr, ScopeId>> result;
 
-    for (const auto &[scope_id_of_symbol, symbols] : _scopes) {
-        if (scope_id.starts_with(scope_id_of_symbol)) {
-            for (const auto &[_, symbol] : symbols) {
-                result.push_back(std::make_pair(symbol, scope_id_of_symbol));
-            }
+    for (std::size_t i = 0; i < _symbols.size(); ++i) {
+        if (_scope_tree.is_ancestor_of(_symbol_scopes[i], scope_id)) {
+            result.push_back(std::make_pair(_symbols[i], _symbol_scopes[i]));
         }
     }
 
     out.swap(result);
 }
 
-void hrl::semanalyzer::SymbolTable::get_symbols_exclude_ancestors(const std::string &scope_id, std::vector<SymbolPtr> &out)
+void hrl::semanalyzer::SymbolTable::get_symbols_exclude_ancestors(ScopeId scope_id, std::vector<SymbolPtr> &out) const
 {
     std::vector<SymbolPtr> result;
 
-    for (const auto &[id, sym_name_map] : _scopes) {
-        if (id == scope_id) {
-            for (const auto &[_, symbol] : sym_name_map) {
-                result.push_back(symbol);
-            }
+    for (std::size_t i = 0; i < _symbols.size(); ++i) {
+        if (_symbol_scopes[i] == scope_id) {
+            result.push_back(_symbols[i]);
         }
     }
 
     out.swap(result);
 }
 
-void SymbolTable::get_all_symbols(std::vector<std::pair<SymbolPtr, std::string>> &out)
+void SymbolTable::get_all_symbols(std::vector<std::pair<SymbolPtr, ScopeId>> &out) const
 {
-    std::vector<std::pair<SymbolPtr, std::string>> result;
+    std::vector<std::pair<SymbolPtr, ScopeId>> result;
 
-    for (const auto &[id, sym_name_map] : _scopes) {
+    for (std::size_t i = 0; i < _symbols.size(); ++i) {
         // skip the library functions
-        if (!id.empty()) {
-            for (const auto &[defined_scope, symbol] : sym_name_map) {
-                result.push_back(std::make_pair(symbol, defined_scope));
-            }
+        if (_symbol_scopes[i] != ScopeTree::LIBRARY_SCOPE) {
+            result.push_back(std::make_pair(_symbols[i], _symbol_scopes[i]));
         }
     }
 
     out.swap(result);
 }
 
-bool SymbolTable::is_symbol_in_scope(const SymbolPtr &symbol, const std::string &scope_id)
+bool SymbolTable::is_symbol_in_scope(const SymbolPtr &symbol, ScopeId scope_id) const
 {
-    auto ancestors = ScopeManager::get_ancestor_scopes(scope_id);
-    for (auto &current_scope_id : ancestors) {
-        auto &scope = _scopes[current_scope_id];
-        auto it = scope.find(symbol->name);
+    for (ScopeId current_scope_id = scope_id; current_scope_id != NO_SCOPE_ID; current_scope_id = _scope_tree.get_parent(current_scope_id)) {
+        std::uint32_t position = find_symbol(current_scope_id, symbol->name_id);
 
         // same name, then check if same ptr
-        if (it != scope.end() && it->second == symbol) {
+        if (position != NO_SYMBOL && _symbols[position] == symbol) {
             return true;
         }
     }
@@ -176,24 +221,41 @@ bool SymbolTable::is_symbol_in_scope(const SymbolPtr &symbol, const std::string
 
 void hrl::semanalyzer::SymbolTable::strip_symbols_from_file(const StringPtr &filename)
 {
-    for (auto &[scope, map] : _scopes) {
-        for (auto it = map.begin(); it != map.end(); ++it) {
-            if (*it->second->filename == *filename) {
-                it = map.erase(it);
-            }
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < _symbols.size(); ++i) {
+        if (*_symbols[i]->filename != *filename) {
+            _symbols[kept] = std::move(_symbols[i]);
+            _symbol_scopes[kept] = _symbol_scopes[i];
+            ++kept;
         }
     }
+
+    if (kept == _symbols.size()) {
+        return;
+    }
+
+    _symbols.resize(kept);
+    _symbol_scopes.resize(kept);
+
+    // the positions have moved
+    _scope_indexes.clear();
+    for (std::uint32_t i = 0; i < kept; ++i) {
+        index_symbol(_symbol_scopes[i], i);
+    }
 }
 
 void SymbolTable::clear_symbols()
 {
-    _scopes.clear();
+    _symbols.clear();
+    _symbol_scopes.clear();
+    _scope_indexes.clear();
+    _scope_tree.clear();
     create_library_symbols();
 }
 
-bool SymbolTable::is_library_function(const SymbolPtr &symbol)
+bool SymbolTable::is_library_function(const SymbolPtr &symbol) const
 {
-    return symbol->type == SymbolType::SUBROUTINE && is_symbol_in_scope(symbol, "");
+    return symbol->type == SymbolType::SUBROUTINE && is_symbol_in_scope(symbol, ScopeTree::LIBRARY_SCOPE);
 }
 
 CLOSE_SEMANALYZER_NAMESPACE
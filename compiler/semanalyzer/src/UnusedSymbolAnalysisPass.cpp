@@ -6,6 +6,7 @@
 #include "ErrorMessage.h"
 #include "SemanticAnalysisErrors.h"
 #include "SemanticAnalysisPass.h"
+#include "StaticASTNodeVisitor.h"
 #include "Symbol.h"
 #include "UnusedSymbolAnalysisPass.h"
 #include "semanalyzer_global.h"
@@ -28,10 +29,64 @@ OPEN_SEMANALYZER_NAMESPACE
         return rc;                  \
     }
 
+namespace {
+
+// Erases the symbols used by the subroutines from the unused ones
+class UsedSymbolCollector : public parser::StaticASTNodeVisitor<UsedSymbolCollector> {
+public:
+    explicit UsedSymbolCollector(std::set<SymbolPtr> &unused_symbols)
+        : _unused_symbols(unused_symbols)
+    {
+    }
+
+    using StaticASTNodeVisitor<UsedSymbolCollector>::visit;
+
+    int visit(parser::VariableAccessASTNode &node) { return use_variable(node); }
+
+    int visit(parser::VariableAssignmentASTNode &node) { return use_variable(node); }
+
+    int visit(parser::IncrementExpressionASTNode &node) { return use_variable(node); }
+
+    int visit(parser::DecrementExpressionASTNode &node) { return use_variable(node); }
+
+    // special handling for param
+    int visit(parser::FunctionDefinitionASTNode &node)
+    {
+        auto &param = node.get_parameter();
+        if (param) {
+            int rc = dispatch(param);
+            if (rc != 0) {
+                return rc;
+            }
+            SymbolPtr sym = Symbol::get_from(param);
+            assert(sym);
+            _unused_symbols.erase(sym);
+        }
+
+        return dispatch(node.get_body());
+    }
+
+    // we skip global vars
+    int visit(parser::CompilationUnitASTNode &node) { return dispatch(node.get_subroutines()); }
+
+private:
+    std::set<SymbolPtr> &_unused_symbols;
+
+    int use_variable(parser::ASTNode &node)
+    {
+        SymbolPtr symbol = Symbol::get_from(&node);
+        assert(symbol);
+        _unused_symbols.erase(symbol);
+        return 0;
+    }
+};
+
+} // namespace
+
 int UnusedSymbolAnalysisPass::run()
 {
     _unused_symbols.clear();
-    std::vector<std::pair<SymbolPtr, std::string>> all_symbols;
+    std::vector<std::pair<SymbolPtr, ScopeId>> all_symbols;
     _symbol_table->get_all_symbols(all_symbols);
     for (const auto &[symbol, define_scope] : all_symbols) {
         // care about self only?
@@ -41,13 +96,12 @@ int UnusedSymbolAnalysisPass::run()
         }
     }
 
-    _visit_state = VisitState::CollectionPass;
-    int rc = visit(_root);
+    UsedSymbolCollector collector(_unused_symbols);
+    int rc = collector.dispatch(_root);
     if (rc != 0) {
         return rc;
     }
 
-    _visit_state = VisitState::MutationPass;
     rc = visit(_root);
     if (rc != 0) {
         return rc;
@@ -71,19 +125,11 @@ int UnusedSymbolAnalysisPass::visit(const parser::VariableDeclarationASTNodePtr
     BEGIN_VISIT();
     assert(symbol);
 
-    switch (_visit_state) {
-    case VisitState::CollectionPass: {
-        rc = traverse(node->get_assignment());
-        RETURN_IF_FAIL_IN_VISIT(rc);
-    } break;
-    case VisitState::MutationPass: {
-        // we skip global vars. this is done by visit compilation unit without visiting globals
-        if (_unused_symbols.contains(symbol)) {
-            log_unused_variable(node);
-            request_to_remove_self();
-            // it's a warning so we return 0
-        }
-    } break;
+    // we skip global vars. this is done by visit compilation unit without visiting globals
+    if (_unused_symbols.contains(symbol)) {
+        log_unused_variable(node);
+        request_to_remove_self();
+        // it's a warning so we return 0
     }
 
     END_VISIT();
@@ -106,36 +152,9 @@ int hrl::semanalyzer::UnusedSymbolAnalysisPass::visit(const parser::VariableAssi
 
 int hrl::semanalyzer::UnusedSymbolAnalysisPass::visit_using_variable(const parser::ASTNodePtr &node)
 {
+    // the uses are collected already, and the values hold no declarations to remove
     BEGIN_VISIT();
     assert(symbol);
-
-    switch (_visit_state) {
-    case VisitState::CollectionPass: {
-        _unused_symbols.erase(symbol);
-    } break;
-    case VisitState::MutationPass: {
-    } break;
-    }
-
-    END_VISIT();
-}
-
-int UnusedSymbolAnalysisPass::visit(const parser::FunctionDefinitionASTNodePtr &node)
-{
-    BEGIN_VISIT();
-
-    auto &param = node->get_parameter();
-    if (param) {
-        rc = traverse(param);
-        RETURN_IF_FAIL_IN_VISIT(rc);
-        SymbolPtr sym = Symbol::get_from(param);
-        assert(sym);
-        _unused_symbols.erase(sym);
-    }
-
-    rc = traverse(node->get_body());
-    RETURN_IF_FAIL_IN_VISIT(rc);
-
     END_VISIT();
 }
 
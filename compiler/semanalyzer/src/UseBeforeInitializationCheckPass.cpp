@@ -1,10 +1,14 @@
 #include <cassert>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
 
 #include "ASTNode.h"
+#include "ASTNodeArena.h"
 #include "ASTNodeForward.h"
 #include "ErrorManager.h"
-#include "ScopeManager.h"
 #include "SemanticAnalysisErrors.h"
 #include "SemanticAnalysisPass.h"
 #include "Symbol.h"
@@ -31,16 +35,56 @@ OPEN_SEMANALYZER_NAMESPACE
 
 int UseBeforeInitializationCheckPass::run()
 {
-    init_symbol_table();
-    clear_scope_tracker();
-    return _root->accept(this);
+    int rc = run_globals();
+
+    // a failed subroutine stops the pass, but a failure in the globals doesn't
+    int rc_subroutines = traverse(_root->get_subroutines());
+    if (rc_subroutines != 0) {
+        rc = rc_subroutines;
+    }
+
+    end_subroutines();
+    return rc;
+}
+
+int UseBeforeInitializationCheckPass::run_globals()
+{
+    init_symbol_table(_root->get_arena()->strings());
+    _variable_indexes.clear();
+    _variables.clear();
+
+    // the compilation unit stays entered for the subroutines
+    enter_node(_root);
+
+    // the floor inits and the global variables are checked one after another, and both report their first failure
+    BitVector floor_inits_out;
+    int rc = check_region(BitVector(), floor_inits_out, [this]() { return traverse(_root->get_floor_inits()); });
+
+    int rc_var_decls = check_region(floor_inits_out, _globals_out, [this]() { return traverse(_root->get_var_decls()); });
+    if (rc_var_decls != 0) {
+        rc = rc_var_decls;
+    }
+
+    _global_variable_count = static_cast<std::uint32_t>(_variables.size());
+    return rc;
+}
+
+int UseBeforeInitializationCheckPass::run_subroutine(const parser::AbstractSubroutineASTNodePtr &node)
+{
+    parser::AbstractSubroutineASTNodePtr subroutine = node;
+    return traverse(subroutine);
+}
+
+void UseBeforeInitializationCheckPass::end_subroutines()
+{
+    leave_node();
 }
 
 int UseBeforeInitializationCheckPass::visit(const parser::DecrementExpressionASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    rc = check_node_symbol_assigned_or_report(node);
+    rc = add_event(EventType::Use, Symbol::get_from(node), node);
     RETURN_IF_FAIL_IN_VISIT(rc);
 
     END_VISIT();
@@ -50,7 +94,7 @@ int UseBeforeInitializationCheckPass::visit(const parser::IncrementExpressionAST
 {
     BEGIN_VISIT();
 
-    rc = check_node_symbol_assigned_or_report(node);
+    rc = add_event(EventType::Use, Symbol::get_from(node), node);
     RETURN_IF_FAIL_IN_VISIT(rc);
 
     END_VISIT();
@@ -59,8 +103,9 @@ int UseBeforeInitializationCheckPass::visit(const parser::IncrementExpressionAST
 int UseBeforeInitializationCheckPass::visit(const parser::VariableDeclarationASTNodePtr &node)
 {
     BEGIN_VISIT();
-    const auto &symbol = Symbol::get_from(node);
-    create_var_init_at_current_scope(symbol);
+
+    rc = add_event(EventType::Declare, Symbol::get_from(node), node);
+    RETURN_IF_FAIL_IN_VISIT(rc);
 
     rc = traverse(node->get_assignment());
     RETURN_IF_FAIL_IN_VISIT(rc);
@@ -70,75 +115,47 @@ int UseBeforeInitializationCheckPass::visit(const parser::VariableDeclarationAST
 
 int UseBeforeInitializationCheckPass::visit(const parser::IfStatementASTNodePtr &node)
 {
-    enter_node(node);
+    BEGIN_VISIT();
 
-    NodeResult pre_if_result = get_var_init_at_current_scope();
+    // the condition is not checked
+    std::uint32_t branch_block = _current_block;
 
-    NodeResult then_result, else_result, merged_result;
-    auto &then_branch = node->get_then_branch();
-    if (then_branch) {
-        int rc_then = traverse(then_branch);
-        RETURN_IF_FAIL_IN_VISIT(rc_then);
-        get_var_init_result(then_branch, then_result);
-    }
+    begin_block();
+    rc = traverse(node->get_then_branch());
+    RETURN_IF_FAIL_IN_VISIT(rc);
+    std::uint32_t then_end = _current_block;
 
+    // without an else branch, the if may assign nothing
+    std::uint32_t else_end = branch_block;
     auto &else_branch = node->get_else_branch();
     if (else_branch) {
-        int rc_else = traverse(else_branch);
-        RETURN_IF_FAIL_IN_VISIT(rc_else);
-        get_var_init_result(else_branch, else_result);
-    }
-
-    // process the var init results. if both are 1, the final is 1. if neither is 0, the final is 0.
-    // they may not share the same size. one may define more vars and returned
-    for (const auto &[symbol, _] : then_result) {
-        merged_result[symbol] = 0;
-    }
-
-    for (const auto &[symbol, _] : else_result) {
-        merged_result[symbol] = 0;
-    }
-
-    for (auto &[symbol, value] : merged_result) {
-        int then_is_initialized = then_result[symbol];
-        int else_is_initialized = else_result[symbol];
-
-        if (then_is_initialized && else_is_initialized) {
-            value = 1;
-        }
-    }
-    strip_symbols_beyond_scope(merged_result, get_current_scope_id());
-
-    for (auto &[symbol, value] : pre_if_result) {
-        auto if_initialized_it = merged_result.find(symbol);
-
-        // if the if-block initialized this var, it's initialized anyway
-        // if it's not (either it's not seen in if-block -> not found, or it's 0), keep it as-is
-        if (if_initialized_it != merged_result.end() && if_initialized_it->second == 1) {
-            value = 1;
-        }
+        add_edge(branch_block, begin_block(false));
+        rc = traverse(else_branch);
+        RETURN_IF_FAIL_IN_VISIT(rc);
+        else_end = _current_block;
     }
 
-    set_var_init_at_current_scope(pre_if_result);
+    std::uint32_t join = begin_block(false);
+    add_edge(then_end, join);
+    add_edge(else_end, join);
 
-    leave_node();
-    return 0;
+    END_VISIT();
 }
 
 int UseBeforeInitializationCheckPass::visit(const parser::WhileStatementASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    // There won't be var decl or asgn in cond
+    std::uint32_t head = begin_block();
     rc = traverse(node->get_condition());
     RETURN_IF_FAIL_IN_VISIT(rc);
 
-    NodeResult preloop_result = get_var_init_at_current_scope(); // assume the loop isn't executed
-
+    begin_block();
     rc = traverse(node->get_body());
     RETURN_IF_FAIL_IN_VISIT(rc);
+    add_edge(_current_block, head);
 
-    set_var_init_at_current_scope(preloop_result);
+    add_edge(head, begin_block(false));
 
     END_VISIT();
 }
@@ -147,57 +164,30 @@ int UseBeforeInitializationCheckPass::visit(const parser::ForStatementASTNodePtr
 {
     BEGIN_VISIT();
 
-    NodeResult preloop_result = get_var_init_at_current_scope(); // assume the loop isn't executed
-
-    NodeResult for_stage_results = preloop_result; // we collect the result after each for stage, and pass it through to the loop
-
-    auto &init_node = node->get_init();
-    auto &cond_node = node->get_condition();
-    auto &update_node = node->get_update();
-    auto &body_node = node->get_body();
-
-    // ensure for stmts share the same scope, so it doesn't pop between init, cond, update and body
-    // body is not nullable
-    track_scope_enter_manually(node, ScopeInfoAttribute::get_scope(body_node)->get_scope_id());
-
-    if (init_node) {
-        rc = traverse(init_node);
-        if (rc != 0) {
-            track_scope_leave_manually(node);
-            RETURN_IF_FAIL_IN_VISIT(rc);
-        }
-    }
+    std::uint32_t before = _current_block;
 
-    if (cond_node) {
-        rc = traverse(cond_node);
-        if (rc != 0) {
-            track_scope_leave_manually(node);
-            RETURN_IF_FAIL_IN_VISIT(rc);
-        }
-        // There won't be var decl or asgn in cond
-    }
+    begin_block();
+    rc = traverse(node->get_init());
+    RETURN_IF_FAIL_IN_VISIT(rc);
 
-    if (update_node) {
-        rc = traverse(update_node);
-        if (rc != 0) {
-            track_scope_leave_manually(node);
-            RETURN_IF_FAIL_IN_VISIT(rc);
-        }
-        // There won't be var decl or asgn in update
-    }
+    std::uint32_t head = begin_block();
+    rc = traverse(node->get_condition());
+    RETURN_IF_FAIL_IN_VISIT(rc);
 
-    if (body_node) {
-        rc = traverse(body_node);
-        if (rc != 0) {
-            track_scope_leave_manually(node);
-            RETURN_IF_FAIL_IN_VISIT(rc);
-        }
-    }
+    // the update is checked before the body
+    begin_block();
+    rc = traverse(node->get_update());
+    RETURN_IF_FAIL_IN_VISIT(rc);
 
-    track_scope_leave_manually(node);
+    begin_block();
+    rc = traverse(node->get_body());
+    RETURN_IF_FAIL_IN_VISIT(rc);
+    add_edge(_current_block, head);
 
-    // set back to pre loop
-    set_var_init_at_current_scope(preloop_result);
+    // the loop may not run, nor its init
+    std::uint32_t exit = begin_block(false);
+    add_edge(before, exit);
+    add_edge(head, exit);
 
     END_VISIT();
 }
@@ -209,46 +199,17 @@ int UseBeforeInitializationCheckPass::visit(const parser::VariableAssignmentASTN
     rc = traverse(node->get_value());
     RETURN_IF_FAIL_IN_VISIT(rc);
 
-    SymbolPtr symbol = Symbol::get_from(node);
-    set_var_init_at_current_scope(symbol, 1);
-
-    END_VISIT();
-}
-
-int UseBeforeInitializationCheckPass::visit(const parser::VariableAccessASTNodePtr &node)
-{
-    BEGIN_VISIT();
-
-    rc = check_node_symbol_assigned_or_report(node);
+    rc = add_event(EventType::Assign, Symbol::get_from(node), node);
     RETURN_IF_FAIL_IN_VISIT(rc);
 
     END_VISIT();
 }
 
-int UseBeforeInitializationCheckPass::visit(const parser::StatementBlockASTNodePtr &node)
+int UseBeforeInitializationCheckPass::visit(const parser::VariableAccessASTNodePtr &node)
 {
     BEGIN_VISIT();
 
-    // get the result of traversed node, and put to our own scope
-    auto passthrough_result = [this](const parser::ASTNodePtr &nodeparam) {
-        // these are the nodes with statement blocks
-        // can't be FunctionDefinitionASTNode nor SubprocDefinitionASTNode because we're in a statement block
-        auto node_type = nodeparam->get_node_type();
-        bool visit_defined_with_statement_block
-            = node_type == parser::ASTNodeType::WhileStatement
-            || node_type == parser::ASTNodeType::IfStatement
-            || node_type == parser::ASTNodeType::ForStatement;
-
-        // we skip this for those defined their own visits
-        if (!visit_defined_with_statement_block) {
-            NodeResult result;
-            get_var_init_result(nodeparam, result);
-            strip_symbols_beyond_scope(result, get_current_scope_id());
-            set_var_init_at_current_scope(result);
-        }
-    };
-
-    rc = traverse(node->get_statements(), passthrough_result);
+    rc = add_event(EventType::Use, Symbol::get_from(node), node);
     RETURN_IF_FAIL_IN_VISIT(rc);
 
     END_VISIT();
@@ -268,150 +229,202 @@ int UseBeforeInitializationCheckPass::visit_subroutine(parser::AbstractSubroutin
 {
     BEGIN_VISIT();
 
-    NodeResult prefunc_result = get_var_init_at_current_scope(); // assume the function isn't executed
+    auto traverse_subroutine = [&]() {
+        auto &parameter = node->get_parameter();
+        if (parameter) {
+            int rc_param = traverse(parameter);
+            if (rc_param != 0) {
+                return rc_param;
+            }
+            // the parameter doesn't have an 'assignment' part, but it's assigned by the caller
+            rc_param = add_event(EventType::Assign, Symbol::get_from(parameter), parameter);
+            if (rc_param != 0) {
+                return rc_param;
+            }
+        }
+        return traverse(node->get_body());
+    };
 
-    track_scope_enter_manually(node, ScopeInfoAttribute::get_scope(node->get_body())->get_scope_id());
-    auto &parameter = node->get_parameter();
-    if (parameter) {
-        rc = traverse(parameter);
-        RETURN_IF_FAIL_IN_VISIT(rc);
-        auto param_sym = Symbol::get_from(parameter);
-        assert(param_sym);
-        // we have to manually set visited here because parameter doesn't have an 'assignment' part
-        set_var_init_at_current_scope(param_sym, 1);
-    }
-    rc = traverse(node->get_body());
-    RETURN_IF_FAIL_IN_VISIT(rc);
-    track_scope_leave_manually(node);
+    BitVector subroutine_out;
+    rc = check_region(_globals_out, subroutine_out, traverse_subroutine);
 
-    set_var_init_at_current_scope(prefunc_result);
+    // forget the locals, so the next subroutine numbers its own from the globals
+    for (std::size_t i = _global_variable_count; i < _variables.size(); ++i) {
+        _variable_indexes.erase(_variables[i].get());
+    }
+    _variables.resize(_global_variable_count);
 
-    END_VISIT();
+    leave_node();
+    return rc;
 }
 
-int UseBeforeInitializationCheckPass::check_node_symbol_assigned_or_report(const parser::ASTNodePtr &node)
+int UseBeforeInitializationCheckPass::check_region(const BitVector &entry, BitVector &exit, const std::function<int()> &traverse_region)
 {
-    SymbolPtr symbol = Symbol::get_from(node);
-    assert(symbol);
-    assert(symbol->type == SymbolType::VARIABLE);
+    _blocks.clear();
+    _events.clear();
+    _blocks.push_back(Block { .events_begin = 0, .events_end = 0, .predecessors = {}, .successors = {}, .in = BitVector(), .out = BitVector() });
+    _current_block = 0;
+
+    // the building always succeeds
+    _checking = false;
+    traverse_region();
+    std::uint32_t last_block = _current_block;
+    _blocks[last_block].events_end = static_cast<std::uint32_t>(_events.size());
+
+    solve(entry);
+
+    _checking = true;
+    _current_block = 0;
+    _assigned = _blocks.front().in;
+    int rc = traverse_region();
+    _checking = false;
+
+    exit = _blocks[last_block].out;
+    return rc;
+}
 
-    int assigned = get_var_init_at_current_scope(symbol);
-    if (!assigned) {
-        log_use_before_initialization_error(symbol, node);
-        return E_SEMA_VAR_USE_BEFORE_INIT;
+std::uint32_t UseBeforeInitializationCheckPass::begin_block(bool fallthrough)
+{
+    // the blocks are entered again in the order they're built
+    if (_checking) {
+        ++_current_block;
+        _assigned = _blocks[_current_block].in;
+        return _current_block;
     }
 
-    return 0;
+    std::uint32_t events_end = static_cast<std::uint32_t>(_events.size());
+    _blocks[_current_block].events_end = events_end;
+
+    std::uint32_t block = static_cast<std::uint32_t>(_blocks.size());
+    _blocks.push_back(Block { .events_begin = events_end, .events_end = events_end, .predecessors = {}, .successors = {}, .in = BitVector(), .out = BitVector() });
+    if (fallthrough) {
+        add_edge(_current_block, block);
+    }
+    _current_block = block;
+    return block;
 }
 
-void UseBeforeInitializationCheckPass::on_scope_enter(const parser::ASTNodePtr &node, const std::string &scope_id)
+void UseBeforeInitializationCheckPass::add_edge(std::uint32_t from, std::uint32_t to)
 {
-    UNUSED(node);
-    UNUSED(scope_id);
-    // copy all elements from parent's scope
-    std::set<SymbolPtr> occured_vars;
-    for (auto &[symbol, stack] : _varinit_record_stacks) {
-        // Did we see this symbol in our parent scope? If not, we skip this one (defined in other scopes)
-        if (!_var_occured.top().contains(symbol)) {
-            continue;
-        }
-        assert(!stack.empty());
-        stack.push(stack.top());
-        occured_vars.insert(symbol);
+    if (_checking) {
+        return;
     }
-    _var_occured.push(occured_vars);
+
+    _blocks[from].successors.push_back(to);
+    _blocks[to].predecessors.push_back(from);
 }
 
-void UseBeforeInitializationCheckPass::on_scope_exit(const parser::ASTNodePtr &node, const std::string &current_scope_id)
+int UseBeforeInitializationCheckPass::add_event(EventType type, const SymbolPtr &symbol, const parser::ASTNodePtr &node)
 {
-    UNUSED(current_scope_id);
-    // return result to parent's scope
-    NodeResult result;
-    for (auto &[symbol, stack] : _varinit_record_stacks) {
-        // record stacks has all symbols. lookup only what we see in current scope
-        if (!_var_occured.top().contains(symbol)) {
-            continue;
+    assert(symbol);
+    assert(symbol->type == SymbolType::VARIABLE);
+
+    std::uint32_t variable;
+    if (type == EventType::Declare) {
+        auto [it, inserted] = _variable_indexes.emplace(symbol.get(), static_cast<std::uint32_t>(_variables.size()));
+        if (inserted) {
+            _variables.push_back(symbol);
         }
-        assert(!stack.empty());
-        int initialized = stack.top();
-        stack.pop();
-        result[symbol] = initialized;
+        variable = it->second;
+    } else {
+        variable = get_variable_index(symbol);
     }
-    strip_symbols_beyond_scope(result, current_scope_id);
-    _varinit_record_results[node] = result;
 
-    _var_occured.pop();
-}
+    if (!_checking) {
+        if (type != EventType::Use) {
+            _events.push_back(Event { .type = type, .variable = variable });
+        }
+        return 0;
+    }
 
-void UseBeforeInitializationCheckPass::get_var_init_result(const parser::ASTNodePtr &node_to_get_result, NodeResult &result)
-{
-    for (const auto &[symbol, _] : result) {
-        UNUSED(_);
-        UNUSED(symbol);
-        assert(_var_occured.top().contains(symbol));
+    switch (type) {
+    case EventType::Declare:
+        _assigned.reset(variable);
+        break;
+    case EventType::Assign:
+        _assigned.set(variable);
+        break;
+    case EventType::Use:
+        if (!_assigned.test(variable)) {
+            log_use_before_initialization_error(symbol, node);
+            return E_SEMA_VAR_USE_BEFORE_INIT;
+        }
+        break;
     }
-    result = _varinit_record_results[node_to_get_result];
+    return 0;
 }
 
-void UseBeforeInitializationCheckPass::set_var_init_at_current_scope(const NodeResult &result)
+std::uint32_t UseBeforeInitializationCheckPass::get_variable_index(const SymbolPtr &symbol)
 {
-    for (const auto &[sym_key, sym_initialized] : result) {
-        set_var_init_at_current_scope(sym_key, sym_initialized);
+    auto it = _variable_indexes.find(symbol.get());
+    if (it == _variable_indexes.end()) {
+        spdlog::critical("Variable '{}' is used but not declared in the globals or the subroutine. {}", *symbol->name, __PRETTY_FUNCTION__);
+        throw;
     }
+    return it->second;
 }
 
-void UseBeforeInitializationCheckPass::create_var_init_at_current_scope(const SymbolPtr &symbol)
+void UseBeforeInitializationCheckPass::solve(const BitVector &entry)
 {
-    assert(symbol);
-    assert(symbol->type == SymbolType::VARIABLE);
-    auto &stack = _varinit_record_stacks[symbol];
-    assert(stack.empty());
+    std::size_t variable_count = _variables.size();
+    BitVector entry_in = entry;
+    entry_in.resize(variable_count);
+
+    // every variable is assigned until a path to the block shows otherwise
+    for (Block &block : _blocks) {
+        block.in.assign(variable_count, true);
+        block.out.assign(variable_count, true);
+    }
 
-    stack.push(0);
-    _var_occured.top().insert(symbol);
-}
+    // the blocks are in the order of the AST, so the worklist only revisits the loops
+    std::vector<std::uint32_t> worklist(_blocks.size());
+    std::vector<bool> queued(_blocks.size(), true);
+    for (std::uint32_t i = 0; i < _blocks.size(); ++i) {
+        worklist[i] = static_cast<std::uint32_t>(_blocks.size()) - 1 - i;
+    }
 
-void UseBeforeInitializationCheckPass::set_var_init_at_current_scope(const SymbolPtr &symbol, int initialized)
-{
-    assert(symbol);
-    auto &stack = _varinit_record_stacks[symbol];
-    assert(!stack.empty());
-    stack.top() = initialized;
-    _var_occured.top().insert(symbol);
-}
+    BitVector out;
+    while (!worklist.empty()) {
+        std::uint32_t b = worklist.back();
+        worklist.pop_back();
+        queued[b] = false;
+
+        Block &block = _blocks[b];
+        if (block.predecessors.empty()) {
+            block.in = entry_in;
+        } else {
+            block.in = _blocks[block.predecessors.front()].out;
+            for (std::size_t p = 1; p < block.predecessors.size(); ++p) {
+                block.in &= _blocks[block.predecessors[p]].out;
+            }
+        }
 
-int UseBeforeInitializationCheckPass::get_var_init_at_current_scope(const SymbolPtr &symbol)
-{
-    assert(symbol);
-    assert(_var_occured.top().contains(symbol));
-    auto &stack = _varinit_record_stacks[symbol];
-    assert(!stack.empty());
-    return stack.top();
-}
+        out = block.in;
+        transfer(block, out);
+        if (out == block.out) {
+            continue;
+        }
 
-UseBeforeInitializationCheckPass::NodeResult UseBeforeInitializationCheckPass::get_var_init_at_current_scope()
-{
-    const auto &current_scope = get_current_scope_id();
-    NodeResult result;
-    for (const auto &[sym, stack] : _varinit_record_stacks) {
-        if (_symbol_table->is_symbol_in_scope(sym, current_scope)) {
-            assert(!stack.empty());
-            result[sym] = stack.top();
+        block.out = out;
+        for (std::uint32_t successor : block.successors) {
+            if (!queued[successor]) {
+                queued[successor] = true;
+                worklist.push_back(successor);
+            }
         }
     }
-    return result;
 }
 
-void UseBeforeInitializationCheckPass::strip_symbols_beyond_scope(NodeResult &results, const std::string &scope_id)
+void UseBeforeInitializationCheckPass::transfer(const Block &block, BitVector &assigned) const
 {
-    NodeResult stripped;
-    for (const auto &[symbol, is_initialized] : results) {
-        if (_symbol_table->is_symbol_in_scope(symbol, scope_id)) {
-            stripped[symbol] = is_initialized;
+    for (std::uint32_t e = block.events_begin; e < block.events_end; ++e) {
+        const Event &event = _events[e];
+        if (event.type == EventType::Declare) {
+            assigned.reset(event.variable);
+        } else {
+            assigned.set(event.variable);
         }
     }
-
-    results.swap(stripped);
 }
 
 void UseBeforeInitializationCheckPass::log_use_before_initialization_error(const SymbolPtr &symbol, const parser::ASTNodePtr &node)
@@ -421,12 +434,12 @@ void UseBeforeInitializationCheckPass::log_use_before_initialization_error(const
     assert(defined_node);
     assert(symbol->type == SymbolType::VARIABLE);
 
-    auto errstr = boost::format("Variable '%1%' may be used before assignment.") % symbol->name;
+    auto errstr = boost::format("Variable '%1%' may be used before assignment.") % *symbol->name;
 
     ErrorManager::instance().report(
         E_SEMA_VAR_USE_BEFORE_INIT,
         ErrorSeverity::Error,
-        ErrorLocation(*_filename, node->lineno(), node->colno(), symbol->name.size()),
+        ErrorLocation(*_filename, node->lineno(), node->colno(), symbol->name->size()),
         errstr.str());
 
     ErrorManager::instance().report_continued(
@@ -435,19 +448,5 @@ void UseBeforeInitializationCheckPass::log_use_before_initialization_error(const
         "Original defined in");
 }
 
-void UseBeforeInitializationCheckPass::enter_node(const parser::ASTNodePtr &node)
-{
-    SemanticAnalysisPass::enter_node(node);
-    track_scope_node_enter(node);
-}
-
-void UseBeforeInitializationCheckPass::leave_node()
-{
-    const auto &current_node = topmost_node();
-
-    track_scope_node_leave(current_node);
-    SemanticAnalysisPass::leave_node();
-}
-
 CLOSE_SEMANALYZER_NAMESPACE
 // end
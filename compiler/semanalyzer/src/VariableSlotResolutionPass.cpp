@@ -0,0 +1,113 @@
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <spdlog/spdlog.h>
+
+#include "ASTNode.h"
+#include "SemanticAnalysisPass.h"
+#include "Symbol.h"
+#include "VariableSlotResolutionPass.h"
+#include "semanalyzer_global.h"
+
+OPEN_SEMANALYZER_NAMESPACE
+
+std::string VariableSlotAttribute::to_string()
+{
+    auto str = boost::format("slot: [%1%] %2%") % (is_global() ? "global" : "local") % _slot;
+    return str.str();
+}
+
+std::string FrameLayoutAttribute::to_string()
+{
+    auto str = boost::format("frame: %1% slots") % _slot_count;
+    return str.str();
+}
+
+void VariableSlotResolutionPass::begin_traversal()
+{
+    _slots.clear();
+    _global_slot_count = 0;
+    _local_slot_count = 0;
+    _in_subroutine = false;
+}
+
+int VariableSlotResolutionPass::on_node_enter(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
+{
+    UNUSED(ancestors);
+
+    switch (node->get_node_type()) {
+    case parser::ASTNodeType::SubprocDefinition:
+    case parser::ASTNodeType::FunctionDefinition:
+        begin_frame();
+        break;
+    case parser::ASTNodeType::VariableDeclaration: {
+        SymbolPtr symbol = Symbol::get_from(node);
+        assert(symbol);
+
+        VariableSlotAttributePtr slot;
+        if (_in_subroutine) {
+            slot = std::make_shared<VariableSlotAttribute>(VariableStorage::Local, _local_slot_count++);
+        } else {
+            slot = std::make_shared<VariableSlotAttribute>(VariableStorage::Global, _global_slot_count++);
+        }
+        _slots[symbol] = slot;
+        VariableSlotAttribute::set_to(node, slot);
+    } break;
+    case parser::ASTNodeType::VariableAssignment:
+    case parser::ASTNodeType::VariableAccess:
+    case parser::ASTNodeType::IncrementExpression:
+    case parser::ASTNodeType::DecrementExpression: {
+        SymbolPtr symbol = Symbol::get_from(node);
+        assert(symbol);
+
+        auto slot_it = _slots.find(symbol);
+        if (slot_it == _slots.end()) {
+            spdlog::critical("Variable '{}' is used before it's declared. {}", *symbol->name, __PRETTY_FUNCTION__);
+            throw;
+        }
+        VariableSlotAttribute::set_to(node, slot_it->second);
+    } break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+int VariableSlotResolutionPass::on_node_leave(const parser::ASTNodePtr &node, const std::vector<parser::ASTNodePtr> &ancestors)
+{
+    UNUSED(ancestors);
+
+    switch (node->get_node_type()) {
+    case parser::ASTNodeType::SubprocDefinition:
+    case parser::ASTNodeType::FunctionDefinition:
+        end_frame(std::static_pointer_cast<parser::AbstractSubroutineASTNode>(node));
+        break;
+    case parser::ASTNodeType::CompilationUnit:
+        // globals are visited before subroutines
+        FrameLayoutAttribute::set_to(node, std::make_shared<FrameLayoutAttribute>(_global_slot_count));
+        break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+void VariableSlotResolutionPass::begin_frame()
+{
+    _in_subroutine = true;
+    _local_slot_count = 0;
+}
+
+void VariableSlotResolutionPass::end_frame(const parser::AbstractSubroutineASTNodePtr &node)
+{
+    FrameLayoutAttribute::set_to(node, std::make_shared<FrameLayoutAttribute>(_local_slot_count));
+    _in_subroutine = false;
+}
+
+CLOSE_SEMANALYZER_NAMESPACE
+// end
@@ -10,7 +10,7 @@ OPEN_SEMANALYZER_NAMESPACE
 
 WithScopeTracker::WithScopeTracker()
 {
-    clear_scope_tracker();
+    _scope_tracker.push(ScopeTree::LIBRARY_SCOPE);
 }
 
 WithScopeTracker::~WithScopeTracker()
@@ -30,14 +30,15 @@ void WithScopeTracker::track_scope_node_leave(const parser::ASTNodePtr &node)
     check_scope_leave(node, current_scope);
 }
 
-void WithScopeTracker::clear_scope_tracker()
+void WithScopeTracker::clear_scope_tracker(const ScopeTree &scope_tree)
 {
-    std::stack<std::string> empty;
-    empty.push("");
+    _scope_tree = &scope_tree;
+    std::stack<ScopeId> empty;
+    empty.push(ScopeTree::LIBRARY_SCOPE);
     empty.swap(_scope_tracker);
 }
 
-const std::string &WithScopeTracker::get_current_scope_id() const
+ScopeId WithScopeTracker::get_current_scope_id() const
 {
     return _scope_tracker.top();
 }
@@ -52,28 +53,28 @@ void WithScopeTracker::track_scope_leave_manually(const parser::ASTNodePtr &node
     track_scope_node_leave(node);
 }
 
-void WithScopeTracker::track_scope_enter_manually(const parser::ASTNodePtr &node, const std::string &scope_id)
+void WithScopeTracker::track_scope_enter_manually(const parser::ASTNodePtr &node, ScopeId scope_id)
 {
     // Invalid scope entered: not a children scope nor the same
-    assert(scope_id.size() >= _scope_tracker.top().size());
+    assert(_scope_tree->is_ancestor_of(_scope_tracker.top(), scope_id));
     check_scope_enter(node, scope_id);
 }
 
-void hrl::semanalyzer::WithScopeTracker::check_scope_enter(const parser::ASTNodePtr &node, const std::string scope_id)
+void hrl::semanalyzer::WithScopeTracker::check_scope_enter(const parser::ASTNodePtr &node, ScopeId scope_id)
 {
-    auto current_scope = scope_id;
-    auto last_scope = _scope_tracker.top();
+    ScopeId current_scope = scope_id;
+    ScopeId last_scope = _scope_tracker.top();
     _scope_tracker.push(current_scope);
-    if (current_scope.size() > last_scope.size()) {
+    if (_scope_tree->get_depth(current_scope) > _scope_tree->get_depth(last_scope)) {
         on_scope_enter(node, current_scope);
     }
 }
 
-void hrl::semanalyzer::WithScopeTracker::check_scope_leave(const parser::ASTNodePtr &node, const std::string scope_id)
+void hrl::semanalyzer::WithScopeTracker::check_scope_leave(const parser::ASTNodePtr &node, ScopeId scope_id)
 {
     _scope_tracker.pop();
-    auto last_scope = _scope_tracker.top();
-    if (scope_id.size() > last_scope.size()) {
+    ScopeId last_scope = _scope_tracker.top();
+    if (_scope_tree->get_depth(scope_id) > _scope_tree->get_depth(last_scope)) {
         on_scope_exit(node, scope_id);
     }
 }
@@ -0,0 +1,187 @@
+// Compares a traversal through the virtual visitor of SemanticAnalysisPass with the same traversal through
+// StaticASTNodeVisitor, on a large generated AST.
+// Usage: hrc_bench_ast_visitor [subroutine count] [rounds]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <boost/format.hpp>
+
+#include "ASTNode.h"
+#include "ASTParser.h"
+#include "HRLLexer.h"
+#include "SemanticAnalysisPass.h"
+#include "StaticASTNodeVisitor.h"
+
+namespace {
+
+// A nested expression on a and b with 2^depth leaves
+std::string generate_expression(int depth, int seed)
+{
+    if (depth == 0) {
+        return seed % 3 == 0 ? std::to_string(seed % 10) : (seed % 2 ? "a" : "b");
+    }
+
+    static const char *ops[] = { "+", "-", "*", "+" };
+    return "(" + generate_expression(depth - 1, seed * 7 + 1) + " " + ops[seed % 4] + " " + generate_expression(depth - 1, seed * 5 + 2) + ")";
+}
+
+std::string generate_source(int subroutine_count)
+{
+    std::ostringstream source;
+    for (int i = 0; i < subroutine_count; ++i) {
+        source << "function f" << i << "(a) {\n"
+               << "    let b = a;\n"
+               << "    b = " << generate_expression(4, i) << ";\n"
+               << "    while (a > 0) {\n"
+               << "        if (a == " << generate_expression(3, i + 1) << ") {\n"
+               << "            b = " << generate_expression(5, i + 2) << ";\n"
+               << "        } else {\n"
+               << "            outbox(" << generate_expression(4, i + 3) << ");\n"
+               << "        }\n"
+               << "        for (let c = 0, c < b, ++c) {\n"
+               << "            b = b - " << generate_expression(3, i + 4) << ";\n"
+               << "        }\n"
+               << "        a = a - 1;\n"
+               << "    }\n"
+               << "    return b;\n"
+               << "}\n";
+    }
+    source << "sub start() {\n    outbox(f0(inbox()));\n}\n";
+    return source.str();
+}
+
+bool parse_source(const std::string &source, hrl::parser::CompilationUnitASTNodePtr &root)
+{
+    FILE *file = std::tmpfile();
+    if (!file) {
+        return false;
+    }
+    std::fwrite(source.data(), 1, source.size(), file);
+    std::rewind(file);
+
+    hrl::lexer::HRLLexer lexer;
+    hrl::lexer::TokenBuffer tokens;
+    bool ok = lexer.lex(file, "bench.hrml", tokens);
+    std::fclose(file);
+    if (!ok) {
+        return false;
+    }
+
+    hrl::parser::ASTParser parser("bench.hrml", tokens);
+    return parser.parse(root);
+}
+
+// Counts the nodes and the variable accesses, the way a pass visits them today
+class DynamicCounter : public hrl::semanalyzer::SemanticAnalysisPass {
+public:
+    DynamicCounter(hrl::parser::CompilationUnitASTNodePtr root)
+        : SemanticAnalysisPass(std::make_shared<std::string>("bench.hrml"), std::move(root))
+    {
+    }
+
+    int run() override { return visit(_root); }
+
+    std::size_t nodes = 0;
+    std::size_t accesses = 0;
+
+protected:
+    void enter_node(const hrl::parser::ASTNodePtr &node) override
+    {
+        ++nodes;
+        SemanticAnalysisPass::enter_node(node);
+    }
+
+    int visit(const hrl::parser::VariableAccessASTNodePtr &node) override
+    {
+        ++accesses;
+        return SemanticAnalysisPass::visit(node);
+    }
+
+    using SemanticAnalysisPass::visit;
+};
+
+class StaticCounter : public hrl::parser::StaticASTNodeVisitor<StaticCounter> {
+public:
+    using StaticASTNodeVisitor<StaticCounter>::visit;
+
+    std::size_t nodes = 0;
+    std::size_t accesses = 0;
+
+    int visit(hrl::parser::VariableAccessASTNode &node)
+    {
+        UNUSED(node);
+        ++accesses;
+        return 0;
+    }
+
+    // every node is counted on its dispatch
+    int dispatch(hrl::parser::ASTNode &node)
+    {
+        ++nodes;
+        return StaticASTNodeVisitor<StaticCounter>::dispatch(node);
+    }
+
+    using StaticASTNodeVisitor<StaticCounter>::dispatch;
+};
+
+// The best time of \p rounds runs of \p func in nanoseconds
+template <typename Func>
+double time_best(int rounds, Func func)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < rounds; ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int subroutine_count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    hrl::parser::CompilationUnitASTNodePtr root;
+    if (!parse_source(generate_source(subroutine_count), root)) {
+        std::cerr << "Failed to parse the generated source" << std::endl;
+        return 1;
+    }
+
+    DynamicCounter dynamic_counter(root);
+    double dynamic_ns = time_best(rounds, [&]() {
+        dynamic_counter.nodes = dynamic_counter.accesses = 0;
+        UNUSED(dynamic_counter.run());
+    });
+
+    StaticCounter static_counter;
+    double static_ns = time_best(rounds, [&]() {
+        static_counter.nodes = static_counter.accesses = 0;
+        UNUSED(static_counter.dispatch(root));
+    });
+
+    if (dynamic_counter.nodes != static_counter.nodes || dynamic_counter.accesses != static_counter.accesses) {
+        std::cerr << boost::format("The traversals disagree: %1% nodes and %2% accesses, %3% nodes and %4% accesses")
+                % dynamic_counter.nodes % dynamic_counter.accesses % static_counter.nodes % static_counter.accesses
+                  << std::endl;
+        return 1;
+    }
+
+    std::size_t nodes = static_counter.nodes;
+    std::cout << boost::format("%1% nodes, %2% variable accesses, best of %3% rounds") % nodes % static_counter.accesses % rounds << std::endl;
+    std::cout << boost::format("SemanticAnalysisPass:  %10.3f ms  %6.2f ns/node") % (dynamic_ns / 1e6) % (dynamic_ns / nodes) << std::endl;
+    std::cout << boost::format("StaticASTNodeVisitor:  %10.3f ms  %6.2f ns/node") % (static_ns / 1e6) % (static_ns / nodes) << std::endl;
+    std::cout << boost::format("Speedup: %1$.2fx") % (dynamic_ns / static_ns) << std::endl;
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -8,6 +9,7 @@
 #include <spdlog/spdlog.h>
 
 #include "ASTInterpreter.h"
+#include "CompiledASTInterpreter.h"
 #include "InterpreterAccumulator.h"
 #include "InterpreterIOManager.h"
 #include "InterpreterMemoryManager.h"
@@ -122,6 +124,73 @@ TEST_P(ASTInterpreterTests, ASTCorrectnessTests)
 
     EXPECT_EQ(outputs, opt_outputs)
         << "AST interpreter: Optimized program yields different output than unoptimized";
+
+    if constexpr (hrl::interpreter::AbstractInterpreter::statistics_enabled()) {
+        const hrl::interpreter::InterpreterStatistics &stats = interpreter.get_statistics();
+        EXPECT_EQ(stats.inbox, inputs.size()) << "AST interpreter: Statistics inbox count mismatch";
+        EXPECT_EQ(stats.outbox, outputs.size()) << "AST interpreter: Statistics outbox count mismatch";
+        EXPECT_GE(stats.calls, 1u) << "AST interpreter: Statistics should count the call to start";
+        EXPECT_GT(stats.instructions_total, 0u) << "AST interpreter: Statistics instruction count is zero";
+    }
+}
+
+TEST_P(ASTInterpreterTests, CompiledASTCorrectnessTests)
+{
+    const auto &data = GetParam();
+    bool ok;
+
+    _test.setup_semantic_analyze(true, data, ok);
+    ASSERT_TRUE(ok) << "Failed in semantic analysis stages";
+
+    // run both engines on the same AST and expect identical behavior
+    auto run = [&](hrl::interpreter::AbstractInterpreter &interpreter, hrl::interpreter::InterpreterIOManager &ioman,
+                   std::vector<hrl::interpreter::HRMByte> &outputs, std::optional<hrl::interpreter::InterpreterException::ErrorType> &error) {
+        for (hrl::interpreter::HRMByte input : data.program_inputs) {
+            ioman.push_input(input);
+        }
+        ioman.set_on_output_pushed([&](hrl::interpreter::HRMByte val) {
+            outputs.push_back(val);
+        });
+
+        try {
+            int rc = interpreter.exec();
+            EXPECT_EQ(rc, 0) << "Interpreter did not return a success code";
+        } catch (const hrl::interpreter::InterpreterException &ex) {
+            error = ex.get_error_type();
+        }
+    };
+
+    hrl::interpreter::InterpreterMemoryManager memman, compiled_memman;
+    hrl::interpreter::InterpreterIOManager ioman, compiled_ioman;
+
+    hrl::interpreter::ASTInterpreter interpreter(
+        std::make_shared<std::string>(data.filename), _test.get_ast(), _test.get_symtbl(), ioman, memman);
+    hrl::interpreter::CompiledASTInterpreter compiled_interpreter(
+        std::make_shared<std::string>(data.filename), _test.get_ast(), _test.get_symtbl(), compiled_ioman, compiled_memman);
+
+    std::vector<hrl::interpreter::HRMByte> outputs, compiled_outputs;
+    std::optional<hrl::interpreter::InterpreterException::ErrorType> error, compiled_error;
+    run(interpreter, ioman, outputs, error);
+    run(compiled_interpreter, compiled_ioman, compiled_outputs, compiled_error);
+
+    EXPECT_EQ(compiled_outputs, data.expected_program_outputs)
+        << "Compiled AST interpreter: The program output is incorrect";
+    EXPECT_EQ(compiled_outputs, outputs)
+        << "Compiled AST interpreter: The output differs from AST interpreter";
+    EXPECT_EQ(compiled_error, error)
+        << "Compiled AST interpreter: The error differs from AST interpreter";
+    EXPECT_EQ(compiled_memman.get_floors(), memman.get_floors())
+        << "Compiled AST interpreter: The floor differs from AST interpreter";
+
+    if constexpr (hrl::interpreter::AbstractInterpreter::statistics_enabled()) {
+        const hrl::interpreter::InterpreterStatistics &stats = interpreter.get_statistics();
+        const hrl::interpreter::InterpreterStatistics &compiled_stats = compiled_interpreter.get_statistics();
+        EXPECT_EQ(compiled_stats.instructions, stats.instructions) << "Compiled AST interpreter: Statistics instruction histogram mismatch";
+        EXPECT_EQ(compiled_stats.calls, stats.calls) << "Compiled AST interpreter: Statistics call count mismatch";
+        EXPECT_EQ(compiled_stats.max_call_depth, stats.max_call_depth) << "Compiled AST interpreter: Statistics call depth mismatch";
+        EXPECT_EQ(compiled_stats.floor_reads, stats.floor_reads) << "Compiled AST interpreter: Statistics floor read mismatch";
+        EXPECT_EQ(compiled_stats.floor_writes, stats.floor_writes) << "Compiled AST interpreter: Statistics floor write mismatch";
+    }
 }
 
 INSTANTIATE_TEST_SUITE_P(ASTInterpreterOptTests, ASTInterpreterTests, ::testing::ValuesIn(read_ast_interpreter_test_cases()));
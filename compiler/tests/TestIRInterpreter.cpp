@@ -1,3 +1,4 @@
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -6,8 +7,19 @@
 #include <spdlog/sinks/ostream_sink.h>
 #include <spdlog/spdlog.h>
 
+#include "BuildControlFlowGraphPass.h"
+#include "EliminateDeadBasicBlockPass.h"
+#include "HRMAssemblyEmitter.h"
+#include "HRMAssemblySimulator.h"
+#include "IRGenOptions.h"
 #include "IRInterpreter.h"
+#include "IROptimizationPassManager.h"
 #include "InterpreterExceptions.h"
+#include "LIRInterpreter.h"
+#include "LowerToLIRPass.h"
+#include "PartialEvaluationPass.h"
+#include "RemoveDeadInstructionsPass.h"
+#include "StripEmptyBasicBlockPass.h"
 #include "Tests.h"
 #include "WithIR.h"
 
@@ -108,6 +120,151 @@ TEST_P(IRInterpreterTests, IRCorrectnessTests)
 
     EXPECT_EQ(outputs, opt_outputs)
         << "IR interpreter: Optimized program yields different output than unoptimized";
+
+    if constexpr (hrl::interpreter::AbstractInterpreter::statistics_enabled()) {
+        const hrl::interpreter::InterpreterStatistics &stats = interpreter.get_statistics();
+        EXPECT_EQ(stats.inbox, inputs.size()) << "IR interpreter: Statistics inbox count mismatch";
+        EXPECT_EQ(stats.outbox, outputs.size()) << "IR interpreter: Statistics outbox count mismatch";
+        EXPECT_GE(stats.calls, 1u) << "IR interpreter: Statistics should count the call to start";
+        EXPECT_GT(stats.instructions_total, 0u) << "IR interpreter: Statistics instruction count is zero";
+    }
+}
+
+TEST_P(IRInterpreterTests, IRPartialEvaluationTests)
+{
+    const auto &data = GetParam();
+    bool ok;
+
+    _test.setup_semantic_analyze(true, data, ok);
+    ASSERT_TRUE(ok) << "Failed in semantic analysis stages";
+
+    hrl::irgen::IRGenOptions irgen_opt = hrl::irgen::IRGenOptions::ForSpeed();
+    hrl::irgen::IROptimizationPassManager irop_passmgr(_test.get_program(), irgen_opt);
+    irop_passmgr.add_pass<hrl::irgen::RemoveDeadInstructionsPass>("StripNoOpPass");
+    irop_passmgr.add_pass<hrl::irgen::StripEmptyBasicBlockPass>("StripEmptyBasicBlockPass");
+    irop_passmgr.add_pass<hrl::irgen::BuildControlFlowGraphPass>("ControlFlowGraphBuilderPass");
+    irop_passmgr.add_pass<hrl::irgen::EliminateDeadBasicBlockPass>("EliminateDeadBasicBlockPass");
+    irop_passmgr.add_pass<hrl::interpreter::PartialEvaluationPass>("PartialEvaluationPass", "build/ir/pe.hrasm");
+    ASSERT_EQ(irop_passmgr.run(true), 0) << "Failed in partial evaluation";
+
+    hrl::interpreter::InterpreterMemoryManager memman;
+    hrl::interpreter::InterpreterIOManager ioman;
+
+    hrl::interpreter::IRInterpreter interpreter(ioman, memman, _test.get_program(), false);
+
+    for (hrl::interpreter::HRMByte input : data.program_inputs) {
+        ioman.push_input(input);
+    }
+
+    std::vector<hrl::interpreter::HRMByte> outputs;
+    ioman.set_on_output_pushed([&](hrl::interpreter::HRMByte val) {
+        outputs.push_back(val);
+    });
+
+    try {
+        int rc = interpreter.exec();
+        ASSERT_EQ(rc, 0) << "IR interpreter (partially evaluated) did not return a success code";
+    } catch (const hrl::interpreter::InterpreterException &ex) {
+        ASSERT_EQ(ex.get_error_type(), hrl::interpreter::InterpreterException::ErrorType::EndOfInput)
+            << "IR interpreter (partially evaluated) reported an error: " << ex.what();
+    }
+
+    EXPECT_EQ(outputs, data.expected_program_outputs)
+        << "IR interpreter: The partially evaluated program output is incorrect";
+}
+
+TEST_P(IRInterpreterTests, LIRCorrectnessTests)
+{
+    const auto &data = GetParam();
+    bool ok;
+
+    _opt_speed_test.setup_ir(1, data, ok);
+    ASSERT_TRUE(ok) << "Failed in IR optimization stages";
+
+    hrl::irgen::IRGenOptions irgen_opt = hrl::irgen::IRGenOptions::ForSpeed();
+    hrl::irgen::IROptimizationPassManager irop_passmgr(_opt_speed_test.get_program(), irgen_opt);
+    irop_passmgr.add_pass<hrl::irgen::LowerToLIRPass>("LowerToLIRPass", "build/ir/lir.hrasm");
+    ASSERT_EQ(irop_passmgr.run(true), 0) << "Failed in lowering to LIR";
+
+    hrl::interpreter::InterpreterMemoryManager memman;
+    hrl::interpreter::InterpreterIOManager ioman;
+
+    hrl::interpreter::LIRInterpreter interpreter(ioman, memman, _opt_speed_test.get_program());
+
+    for (hrl::interpreter::HRMByte input : data.program_inputs) {
+        ioman.push_input(input);
+    }
+
+    std::vector<hrl::interpreter::HRMByte> outputs;
+    ioman.set_on_output_pushed([&](hrl::interpreter::HRMByte val) {
+        outputs.push_back(val);
+    });
+
+    try {
+        int rc = interpreter.exec();
+        ASSERT_EQ(rc, 0) << "LIR interpreter did not return a success code";
+    } catch (const hrl::interpreter::InterpreterException &ex) {
+        ASSERT_EQ(ex.get_error_type(), hrl::interpreter::InterpreterException::ErrorType::EndOfInput)
+            << "LIR interpreter reported an error: " << ex.what();
+    }
+
+    EXPECT_EQ(outputs, data.expected_program_outputs)
+        << "LIR interpreter: The program output is incorrect";
+    EXPECT_GT(interpreter.get_steps(), 0u) << "LIR interpreter: No step is counted";
+
+    if constexpr (hrl::interpreter::AbstractInterpreter::statistics_enabled()) {
+        EXPECT_EQ(interpreter.get_statistics().instructions_total, interpreter.get_steps())
+            << "LIR interpreter: Statistics instruction count differs from the steps";
+    }
+}
+
+TEST_P(IRInterpreterTests, HRMAssemblyTests)
+{
+    const auto &data = GetParam();
+    bool ok;
+
+    _opt_speed_test.setup_ir(1, data, ok);
+    ASSERT_TRUE(ok) << "Failed in IR optimization stages";
+
+    hrl::irgen::IRGenOptions irgen_opt = hrl::irgen::IRGenOptions::ForSpeed();
+    hrl::irgen::IROptimizationPassManager irop_passmgr(_opt_speed_test.get_program(), irgen_opt);
+    irop_passmgr.add_pass<hrl::irgen::LowerToLIRPass>("LowerToLIRPass");
+    ASSERT_EQ(irop_passmgr.run(true), 0) << "Failed in lowering to LIR";
+
+    if (hrl::irgen::HRMAssemblyEmitter::has_recursion(_opt_speed_test.get_program())) {
+        GTEST_SKIP() << "HRM has no call stack for recursion";
+    }
+
+    std::ostringstream assembly;
+    hrl::irgen::HRMAssemblyEmitter emitter(_opt_speed_test.get_program());
+    ASSERT_EQ(emitter.emit(assembly), 0) << "Failed in emitting HRM assembly";
+
+    hrl::interpreter::InterpreterMemoryManager memman;
+    hrl::interpreter::InterpreterIOManager ioman;
+
+    hrl::interpreter::HRMAssemblySimulator simulator(ioman, memman, assembly.str());
+
+    for (hrl::interpreter::HRMByte input : data.program_inputs) {
+        ioman.push_input(input);
+    }
+
+    std::vector<hrl::interpreter::HRMByte> outputs;
+    ioman.set_on_output_pushed([&](hrl::interpreter::HRMByte val) {
+        outputs.push_back(val);
+    });
+
+    try {
+        int rc = simulator.exec();
+        ASSERT_EQ(rc, 0) << "HRM simulator did not return a success code";
+    } catch (const hrl::interpreter::InterpreterException &ex) {
+        ASSERT_EQ(ex.get_error_type(), hrl::interpreter::InterpreterException::ErrorType::EndOfInput)
+            << "HRM simulator reported an error: " << ex.what();
+    }
+
+    EXPECT_EQ(outputs, data.expected_program_outputs)
+        << "HRM simulator: The program output is incorrect\n"
+        << assembly.str();
+    EXPECT_EQ(simulator.get_size(), emitter.get_size()) << "HRM simulator: The size differs from the emitted";
 }
 
 INSTANTIATE_TEST_SUITE_P(IRInterpreterOptTests, IRInterpreterTests, ::testing::ValuesIn(read_ir_interpreter_test_cases()));
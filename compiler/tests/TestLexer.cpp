@@ -0,0 +1,175 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "HRLLexer.h"
+#include "HRLToken.h"
+#include "Tests.h"
+
+namespace {
+
+struct LexResult {
+    bool ok = false;
+    hrl::lexer::TokenBuffer tokens;
+};
+
+LexResult lex_file(const std::string &path, hrl::lexer::HRLLexer::Backend backend = hrl::lexer::HRLLexer::Backend::Flex)
+{
+    LexResult result;
+    FILE *file = std::fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return result;
+    }
+
+    hrl::lexer::HRLLexer lexer(backend);
+    result.ok = lexer.lex(file, path, result.tokens);
+    std::fclose(file);
+    return result;
+}
+
+LexResult lex_string(const std::string &source, hrl::lexer::HRLLexer::Backend backend)
+{
+    LexResult result;
+    FILE *file = std::tmpfile();
+    if (file == nullptr) {
+        return result;
+    }
+    std::fwrite(source.data(), 1, source.size(), file);
+    std::rewind(file);
+
+    hrl::lexer::HRLLexer lexer(backend);
+    result.ok = lexer.lex(file, "<string>", result.tokens);
+    std::fclose(file);
+    return result;
+}
+
+void expect_same_tokens(const LexResult &expected, const LexResult &actual, const std::string &name)
+{
+    ASSERT_EQ(expected.ok, actual.ok) << name;
+    ASSERT_EQ(expected.tokens.size(), actual.tokens.size()) << name;
+    for (std::size_t j = 0; j < expected.tokens.size(); ++j) {
+        hrl::lexer::TokenRef e = expected.tokens[j];
+        hrl::lexer::TokenRef a = actual.tokens[j];
+        EXPECT_EQ(e.token_id(), a.token_id()) << name << " token " << j;
+        EXPECT_EQ(e.lineno(), a.lineno()) << name << " token " << j;
+        EXPECT_EQ(e.colno(), a.colno()) << name << " token " << j;
+        EXPECT_EQ(e.width(), a.width()) << name << " token " << j;
+        EXPECT_EQ(e.token_text(), a.token_text()) << name << " token " << j;
+        if (e.token_id() == hrl::lexer::INTEGER && a.token_id() == hrl::lexer::INTEGER) {
+            EXPECT_EQ(e.get_integer(), a.get_integer()) << name << " token " << j;
+            EXPECT_EQ(e.get_is_char(), a.get_is_char()) << name << " token " << j;
+        } else if (e.token_id() == hrl::lexer::BOOLEAN && a.token_id() == hrl::lexer::BOOLEAN) {
+            EXPECT_EQ(e.get_boolean(), a.get_boolean()) << name << " token " << j;
+        }
+
+        auto e_metadata = e.metadata();
+        auto a_metadata = a.metadata();
+        ASSERT_EQ(e_metadata.size(), a_metadata.size()) << name << " token " << j;
+        for (std::size_t k = 0; k < e_metadata.size(); ++k) {
+            EXPECT_EQ(e_metadata[k].type, a_metadata[k].type) << name << " token " << j << " metadata " << k;
+            EXPECT_EQ(e_metadata[k].value, a_metadata[k].value) << name << " token " << j << " metadata " << k;
+        }
+    }
+}
+
+} // namespace
+
+TEST(LexerTests, ConcurrentLexingMatchesSequential)
+{
+    std::vector<std::string> paths;
+    for (const auto &[group, cases] : __test_cases) {
+        for (const TestCaseData &data : cases) {
+            paths.push_back(data.path);
+        }
+    }
+    ASSERT_FALSE(paths.empty());
+
+    // one lexer lexes all files in turn, so it also covers reusing a lexer
+    std::vector<LexResult> sequential;
+    {
+        hrl::lexer::HRLLexer lexer;
+        for (const std::string &path : paths) {
+            LexResult result;
+            FILE *file = std::fopen(path.c_str(), "r");
+            ASSERT_NE(file, nullptr) << "Failed to open HRML " << path;
+            result.ok = lexer.lex(file, path, result.tokens);
+            std::fclose(file);
+            sequential.push_back(std::move(result));
+        }
+    }
+
+    std::vector<LexResult> concurrent(paths.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        threads.emplace_back([&, i]() { concurrent[i] = lex_file(paths[i]); });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        expect_same_tokens(sequential[i], concurrent[i], paths[i]);
+    }
+}
+
+TEST(LexerTests, HandwrittenScannerMatchesFlex)
+{
+    using Backend = hrl::lexer::HRLLexer::Backend;
+
+    for (const auto &[group, cases] : __test_cases) {
+        for (const TestCaseData &data : cases) {
+            expect_same_tokens(lex_file(data.path, Backend::Flex), lex_file(data.path, Backend::Handwritten), data.path);
+        }
+    }
+
+    // the corners the test programs don't reach
+    const std::vector<std::string> sources = {
+        "",
+        "// only a comment",
+        "\n\n  \t\n",
+        "let a = 1;\r\nlet b = 'x';\r\n// crlf comment\r\n",
+        "12abc 007 99999999999999999999 'a' 'ab' 'Z'",
+        "a>=b<=c==d!=e>f<g&&h||!i++j--k+l-m*n/o%p=q;(){}[],",
+        "floor_max floors sub subs true false truely _x x_1",
+        "a & b",
+        "a | b",
+        "let x = @;",
+        "\tfunction f(a) {\n\t\treturn a; // trailing\n}",
+        "let long_identifier_spanning_more_than_sixteen_bytes = 1234567890123456;                 x",
+    };
+    for (const std::string &source : sources) {
+        expect_same_tokens(lex_string(source, Backend::Flex), lex_string(source, Backend::Handwritten), "'" + source + "'");
+    }
+}
+
+TEST(LexerTests, IdentifiersAreInterned)
+{
+    using Backend = hrl::lexer::HRLLexer::Backend;
+
+    for (Backend backend : { Backend::Flex, Backend::Handwritten }) {
+        LexResult result = lex_string("let a = b; a = a + bb; let b = inbox(); outbox(a);", backend);
+        ASSERT_TRUE(result.ok);
+
+        const StringInternerPtr &strings = result.tokens.strings();
+        ASSERT_TRUE(strings);
+        std::vector<hrl::lexer::TokenRef> identifiers;
+        for (std::size_t i = 0; i < result.tokens.size(); ++i) {
+            hrl::lexer::TokenRef token = result.tokens[i];
+            if (token.token_id() == hrl::lexer::IDENTIFIER) {
+                EXPECT_EQ(strings->str(token.get_identifier_id()), token.get_identifier());
+                identifiers.push_back(token);
+            }
+        }
+
+        // a, b, bb, inbox and outbox
+        EXPECT_EQ(strings->size(), 5u);
+        for (const auto &lhs : identifiers) {
+            for (const auto &rhs : identifiers) {
+                EXPECT_EQ(lhs.get_identifier() == rhs.get_identifier(), lhs.get_identifier_id() == rhs.get_identifier_id());
+            }
+        }
+    }
+}
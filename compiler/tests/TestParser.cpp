@@ -0,0 +1,213 @@
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "ASTBuilder.h"
+#include "ASTNodeArena.h"
+#include "ASTNodeForward.h"
+#include "ASTNodeGraphvizBuilder.h"
+#include "ASTParser.h"
+#include "ErrorManager.h"
+#include "HRLLexer.h"
+#include "HRLToken.h"
+#include "ParseTreeNodeForward.h"
+#include "RecursiveDescentParser.h"
+#include "Tests.h"
+
+namespace {
+
+// The AST graph with the position of every node
+class ASTNodePositionGraphvizBuilder : public hrl::parser::ASTNodeGraphvizBuilder {
+public:
+    using ASTNodeGraphvizBuilder::ASTNodeGraphvizBuilder;
+
+protected:
+    Vertex enter_and_create_vertex(const std::string &label, NodeType type, const hrl::parser::ASTNodePtr &node) override
+    {
+        if (!node) {
+            return ASTNodeGraphvizBuilder::enter_and_create_vertex(label, type, node);
+        }
+        auto position = boost::format("%1% @%2%:%3%-%4%:%5%") % label % node->lineno() % node->colno() % node->last_lineno() % node->last_colno();
+        return ASTNodeGraphvizBuilder::enter_and_create_vertex(position.str(), type, node);
+    }
+};
+
+// The ids of the nodes reachable from the root
+class ASTNodeIdCollector : public hrl::parser::ASTNodeGraphvizBuilder {
+public:
+    using ASTNodeGraphvizBuilder::ASTNodeGraphvizBuilder;
+
+    std::vector<std::size_t> ids;
+
+protected:
+    Vertex enter_and_create_vertex(const std::string &label, NodeType type, const hrl::parser::ASTNodePtr &node) override
+    {
+        if (node) {
+            ids.push_back(node->node_id());
+        }
+        return ASTNodeGraphvizBuilder::enter_and_create_vertex(label, type, node);
+    }
+};
+
+void expect_dense_node_ids(FILE *file, const std::string &path)
+{
+    ASSERT_NE(file, nullptr) << "Failed to open HRML " << path;
+
+    hrl::lexer::HRLLexer lexer;
+    hrl::lexer::TokenBuffer tokens;
+    bool lexed = lexer.lex(file, path, tokens);
+    std::fclose(file);
+    ASSERT_TRUE(lexed) << path;
+
+    hrl::parser::RecursiveDescentParser parser(path, tokens);
+    hrl::parser::CompilationUnitPTNodePtr compilation_unit;
+    if (!parser.parse(compilation_unit)) {
+        // the syntax error cases
+        return;
+    }
+    hrl::parser::CompilationUnitASTNodePtr root;
+    hrl::parser::ASTBuilder builder(compilation_unit, tokens.source(), tokens.strings());
+    ASSERT_TRUE(builder.build(root)) << path;
+    ASSERT_NE(root->get_arena(), nullptr) << path;
+
+    ASTNodeIdCollector collector(root);
+    collector.generate_graphviz("");
+    std::set<std::size_t> unique_ids(collector.ids.begin(), collector.ids.end());
+    // ASTBuilder keeps every node it creates, so the ids are exactly [0, node_count())
+    EXPECT_EQ(unique_ids.size(), collector.ids.size()) << path;
+    EXPECT_EQ(unique_ids.size(), root->get_arena()->node_count()) << path;
+    if (!unique_ids.empty()) {
+        EXPECT_EQ(*unique_ids.rbegin(), unique_ids.size() - 1) << path;
+    }
+}
+
+// The errors reported to the ErrorManager as printed, and clear them
+std::string take_reported_errors()
+{
+    std::ostringstream printed;
+    auto previous_logger = spdlog::default_logger();
+    auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(printed);
+    auto logger = std::make_shared<spdlog::logger>("errors", sink);
+    logger->set_pattern("%v");
+    spdlog::set_default_logger(logger);
+    ErrorManager::instance().print_all();
+    ErrorManager::instance().clear();
+    spdlog::set_default_logger(previous_logger);
+    return printed.str();
+}
+
+void expect_same_ast(FILE *file, const std::string &path)
+{
+    ASSERT_NE(file, nullptr) << "Failed to open HRML " << path;
+
+    hrl::lexer::HRLLexer lexer;
+    hrl::lexer::TokenBuffer tokens;
+    bool lexed = lexer.lex(file, path, tokens);
+    std::fclose(file);
+    ASSERT_TRUE(lexed) << path;
+
+    hrl::parser::CompilationUnitASTNodePtr built;
+    hrl::parser::RecursiveDescentParser parser(path, tokens);
+    hrl::parser::CompilationUnitPTNodePtr compilation_unit;
+    bool parsed = parser.parse(compilation_unit);
+    if (parsed) {
+        hrl::parser::ASTBuilder builder(compilation_unit, tokens.source(), tokens.strings());
+        ASSERT_TRUE(builder.build(built)) << path;
+    }
+    std::string parser_errors = take_reported_errors();
+
+    hrl::parser::CompilationUnitASTNodePtr direct;
+    hrl::parser::ASTParser ast_parser(path, tokens);
+    bool direct_parsed = ast_parser.parse(direct);
+    std::string ast_parser_errors = take_reported_errors();
+
+    ASSERT_EQ(parsed, direct_parsed) << path;
+    EXPECT_EQ(parser_errors, ast_parser_errors) << path;
+    if (parsed) {
+        EXPECT_EQ(ASTNodePositionGraphvizBuilder(built).generate_graphviz(""),
+            ASTNodePositionGraphvizBuilder(direct).generate_graphviz(""))
+            << path;
+    }
+}
+
+// the speculative parses that fail, and the nested ones
+const std::vector<std::string> SPECULATIVE_SOURCES = {
+    "sub f(a) { g(h(i(j(a)))); }",
+    "sub f(a) { a = g(h(i(a))) + h(a); }",
+    "sub f(a) { g(h(a) b); }",
+    "sub f(a) { g(a) = 1; }",
+    "sub f(a) { a = g(h(i(j(a; }",
+};
+
+FILE *open_string(const std::string &source)
+{
+    FILE *file = std::tmpfile();
+    if (file != nullptr) {
+        std::fwrite(source.data(), 1, source.size(), file);
+        std::rewind(file);
+    }
+    return file;
+}
+
+} // namespace
+
+TEST(ParserTests, ASTParserMatchesASTBuilder)
+{
+    // the errors left by the lexer tests
+    ErrorManager::instance().clear();
+
+    for (const auto &[group, cases] : __test_cases) {
+        for (const TestCaseData &data : cases) {
+            expect_same_ast(std::fopen(data.path.c_str(), "r"), data.path);
+        }
+    }
+
+    for (const std::string &source : SPECULATIVE_SOURCES) {
+        expect_same_ast(open_string(source), source);
+    }
+
+    // every node kind with its position, and the errors of each rule
+    const std::vector<std::string> sources = {
+        "import a;\nimport b;\ninit floor[1] = 'a';\ninit floor_max = 9;\ninit floor[0] = 3;\nlet g;\nlet h = -1;\n"
+        "function f(a b) { return a; }\n"
+        "sub s() {\n"
+        "  let x = +(1 + 2) * 3 - 4 / 5 % 6;\n"
+        "  let y = x >= 1 && x <= 2 || x == 3 && x != 4 || x > 5 && x < 6 || !true || !false;\n"
+        "  x = ++x; y = --y; floor[x] = floor[y + 1];\n"
+        "  for (let i = 0, i < 3, ++i) { if (i == 1) continue; else break; }\n"
+        "  for (x = 0, , x) ;\n"
+        "  while (f(x)) { outbox(inbox()); return; }\n"
+        "}\n",
+        "init floor[0] = 1; init floor_max = 1; init floor_max = 2;",
+        "init floor_min = 1;",
+        "sub s() { let = 1; }",
+        "sub s() { for (f(), , ) ; }",
+        "sub s() { if x ; }",
+        "sub s() { let x = ; }",
+        "sub s() { x = * 2; }",
+        "sub s() { floor[1 = 2; }",
+        "sub s() { } extra",
+        "function f(a { }",
+    };
+    for (const std::string &source : sources) {
+        expect_same_ast(open_string(source), source);
+    }
+}
+
+TEST(ParserTests, ASTNodeIdsAreDense)
+{
+    for (const auto &[group, cases] : __test_cases) {
+        for (const TestCaseData &data : cases) {
+            expect_dense_node_ids(std::fopen(data.path.c_str(), "r"), data.path);
+        }
+    }
+    ErrorManager::instance().clear();
+}
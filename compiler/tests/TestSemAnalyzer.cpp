@@ -1,3 +1,4 @@
+#include <cstdio>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -7,15 +8,20 @@
 #include <boost/format.hpp>
 #include <gtest/gtest.h>
 #include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
 
+#include "ASTNode.h"
+#include "ASTParser.h"
+#include "ASTSimplificationPass.h"
 #include "ClearSymbolTablePass.h"
-#include "ConstantFoldingPass.h"
 #include "ControlFlowVerificationPass.h"
-#include "DeadCodeEliminationPass.h"
 #include "ErrorManager.h"
+#include "HRLLexer.h"
 #include "SemanticAnalysisPassManager.h"
+#include "StringInterner.h"
 #include "StripAttributePass.h"
 #include "SymbolAnalysisPass.h"
+#include "SymbolTable.h"
 #include "Tests.h"
 #include "UnusedSymbolAnalysisPass.h"
 #include "UseBeforeInitializationCheckPass.h"
@@ -27,22 +33,21 @@ std::vector<TestCaseData> read_semanalyzer_test_cases()
 }
 
 class SemanticAnalyzerTests : public ::testing::TestWithParam<TestCaseData>, public WithParsed {
+protected:
+    // Run the analysis pipeline on the parsed ast, analyzing the subroutines on \p thread_count threads
+    int run_semantic_analysis(const TestCaseData &data, unsigned int thread_count);
+
+    // The diagnostics stored in the ErrorManager, as they're printed
+    std::string print_diagnostics();
 };
 
-TEST_P(SemanticAnalyzerTests, SemanticAnalysisTests)
+int SemanticAnalyzerTests::run_semantic_analysis(const TestCaseData &data, unsigned int thread_count)
 {
-    const auto &data = GetParam();
-    bool ok;
-    setup_parse(data, ok);
-    ASSERT_TRUE(ok) << "Failed in pre semantic analysis stages";
-
     using SemaAttrId = hrl::semanalyzer::SemAnalzyerASTNodeAttributeId;
 
-    // it's for conditional breakpoint
-    auto dbg = data.filename == "W3006_pass_var_shadow_global_block.hrml";
-    UNUSED(dbg);
-
     hrl::semanalyzer::SemanticAnalysisPassManager sem_passmgr(ast, std::make_shared<std::string>(data.filename));
+    sem_passmgr.set_thread_count(thread_count);
+    sem_passmgr.set_change_tracking_enabled(true);
 
     // won't mutate the node
     auto pre_symtbl_analyzer = sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>(
@@ -61,19 +66,13 @@ TEST_P(SemanticAnalyzerTests, SemanticAnalysisTests)
         });
 
     // may mutate the node
-    auto constfolder = sem_passmgr.add_pass<hrl::semanalyzer::ConstantFoldingPass>(
-        "ConstantFoldingPass",
-        data.filename + "-constfold.dot",
+    auto simplifier = sem_passmgr.add_pass<hrl::semanalyzer::ASTSimplificationPass>(
+        "ASTSimplificationPass",
+        data.filename + "-simplify.dot",
         std::set<int> {
             SemaAttrId::ATTR_SEMANALYZER_CONST_FOLDING_VALUE,
         });
 
-    // reannotate the node with symbol and scope
-    auto dce = sem_passmgr.add_pass<hrl::semanalyzer::DeadCodeEliminationPass>(
-        "DeadCodeElimination",
-        data.filename + "-dce.dot",
-        std::set<int> {});
-
     auto unused_var = sem_passmgr.add_pass<hrl::semanalyzer::UnusedSymbolAnalysisPass>(
         "UnusedVariableElimination",
         data.filename + "-uvar.dot",
@@ -110,7 +109,30 @@ TEST_P(SemanticAnalyzerTests, SemanticAnalysisTests)
     strip_sym_attr->add_attribute(SemaAttrId::ATTR_SEMANALYZER_SCOPE_INFO);
     strip_sym_attr->add_attribute(SemaAttrId::ATTR_SEMANALYZER_SYMBOL);
 
-    int sema_result = sem_passmgr.run(true);
+    return sem_passmgr.run(true);
+}
+
+std::string SemanticAnalyzerTests::print_diagnostics()
+{
+    // without the time, so they're comparable between runs. setup_parse() sets up a new logger.
+    spdlog::default_logger()->set_pattern("[%l] %v");
+    std::size_t begin = captured_outstream.str().size();
+    ErrorManager::instance().print_all();
+    return captured_outstream.str().substr(begin);
+}
+
+TEST_P(SemanticAnalyzerTests, SemanticAnalysisTests)
+{
+    const auto &data = GetParam();
+    bool ok;
+    setup_parse(data, ok);
+    ASSERT_TRUE(ok) << "Failed in pre semantic analysis stages";
+
+    // it's for conditional breakpoint
+    auto dbg = data.filename == "W3006_pass_var_shadow_global_block.hrml";
+    UNUSED(dbg);
+
+    int sema_result = run_semantic_analysis(data, 1);
     ErrorManager::instance().print_all();
 
     std::string captured = captured_outstream.str();
@@ -141,4 +163,174 @@ TEST_P(SemanticAnalyzerTests, SemanticAnalysisTests)
     }
 }
 
+// The subroutines analyzed on several threads report the same diagnostics, in the same order, as on one thread
+TEST_P(SemanticAnalyzerTests, DiagnosticsIndependentOfThreadCount)
+{
+    const auto &data = GetParam();
+    bool ok;
+
+    setup_parse(data, ok);
+    ASSERT_TRUE(ok) << "Failed in pre semantic analysis stages";
+    int single_thread_result = run_semantic_analysis(data, 1);
+    std::string single_thread_diagnostics = print_diagnostics();
+
+    // the passes mutate the ast, so it's parsed again
+    setup_parse(data, ok);
+    ASSERT_TRUE(ok) << "Failed in pre semantic analysis stages";
+    int multi_thread_result = run_semantic_analysis(data, 4);
+    std::string multi_thread_diagnostics = print_diagnostics();
+
+    EXPECT_EQ(multi_thread_result, single_thread_result);
+    EXPECT_EQ(multi_thread_diagnostics, single_thread_diagnostics);
+}
+
 INSTANTIATE_TEST_SUITE_P(CompilerMessageTests, SemanticAnalyzerTests, ::testing::ValuesIn(read_semanalyzer_test_cases()));
+
+TEST(SymbolTableTests, LookupStripAndClear)
+{
+    using hrl::semanalyzer::ScopeId;
+    using hrl::semanalyzer::ScopeTree;
+    using hrl::semanalyzer::ScopeType;
+    using hrl::semanalyzer::SymbolPtr;
+
+    auto strings = std::make_shared<StringInterner>();
+    hrl::semanalyzer::SymbolTable table(strings);
+    ScopeTree &tree = table.get_scope_tree();
+    ScopeId sub = tree.add_scope(ScopeTree::GLOBAL_SCOPE, "main", ScopeType::Subroutine);
+    ScopeId block = tree.add_scope(sub, "0", ScopeType::Block);
+
+    auto main_file = std::make_shared<std::string>("main.hrl");
+    auto lib_file = std::make_shared<std::string>("lib.hrl");
+
+    // enough to grow the index of the block scope a few times
+    std::vector<StringId> names;
+    for (int i = 0; i < 100; ++i) {
+        names.push_back(strings->intern("v" + std::to_string(i)));
+        ASSERT_TRUE(table.add_variable_symbol(block, names.back(), i % 2 == 0 ? main_file : lib_file, nullptr));
+    }
+    ASSERT_TRUE(table.add_function_symbol(ScopeTree::GLOBAL_SCOPE, strings->intern("main"), false, false, main_file, nullptr));
+    EXPECT_FALSE(table.add_variable_symbol(block, names[0], main_file, nullptr));
+
+    SymbolPtr symbol;
+    ScopeId defined_scope;
+    ASSERT_TRUE(table.lookup_symbol(block, "main", true, symbol, defined_scope));
+    EXPECT_EQ(defined_scope, ScopeTree::GLOBAL_SCOPE);
+    EXPECT_FALSE(table.lookup_symbol(block, "main", false, symbol, defined_scope));
+    EXPECT_FALSE(table.lookup_symbol(sub, names[1], true, symbol, defined_scope));
+    EXPECT_FALSE(table.lookup_symbol(block, "never_interned", true, symbol, defined_scope));
+    ASSERT_TRUE(table.lookup_symbol(block, "outbox", true, symbol, defined_scope));
+    EXPECT_TRUE(table.is_library_function(symbol));
+
+    table.strip_symbols_from_file(lib_file);
+    for (int i = 0; i < 100; ++i) {
+        bool found = table.lookup_symbol(block, names[i], false, symbol, defined_scope);
+        ASSERT_EQ(found, i % 2 == 0) << "v" << i;
+        if (found) {
+            EXPECT_EQ(symbol->name_id, names[i]);
+            EXPECT_TRUE(table.is_symbol_in_scope(symbol, block));
+            EXPECT_FALSE(table.is_symbol_in_scope(symbol, sub));
+        }
+    }
+
+    std::vector<std::pair<SymbolPtr, ScopeId>> all_symbols;
+    table.get_all_symbols(all_symbols);
+    EXPECT_EQ(all_symbols.size(), 51u);
+
+    table.clear_symbols();
+    table.get_all_symbols(all_symbols);
+    EXPECT_TRUE(all_symbols.empty());
+    EXPECT_EQ(table.get_scope_tree().size(), 2u);
+    EXPECT_FALSE(table.lookup_symbol(ScopeTree::GLOBAL_SCOPE, "main", true, symbol, defined_scope));
+    EXPECT_TRUE(table.lookup_symbol(ScopeTree::GLOBAL_SCOPE, "inbox", true, symbol, defined_scope));
+}
+
+namespace {
+
+// A UseBeforeInitializationCheckPass which keeps the subroutines it analyzed
+class RecordingUBIPass : public hrl::semanalyzer::UseBeforeInitializationCheckPass {
+public:
+    using UseBeforeInitializationCheckPass::UseBeforeInitializationCheckPass;
+
+    std::vector<hrl::parser::AbstractSubroutineASTNodePtr> analyzed;
+
+protected:
+    void enter_node(const hrl::parser::ASTNodePtr &node) override
+    {
+        UseBeforeInitializationCheckPass::enter_node(node);
+        auto subroutine = std::dynamic_pointer_cast<hrl::parser::AbstractSubroutineASTNode>(node);
+        if (subroutine) {
+            analyzed.push_back(subroutine);
+        }
+    }
+};
+
+// Reports an edit of the subroutines with an increment, without changing a node
+class EditIncrementsPass : public hrl::semanalyzer::SemanticAnalysisPass {
+public:
+    using SemanticAnalysisPass::SemanticAnalysisPass;
+
+    int run() override { return visit(_root); }
+
+protected:
+    void enter_node(const hrl::parser::ASTNodePtr &node) override
+    {
+        SemanticAnalysisPass::enter_node(node);
+        if (node->get_node_type() == hrl::parser::ASTNodeType::IncrementExpression) {
+            mark_modified();
+        }
+    }
+};
+
+hrl::parser::CompilationUnitASTNodePtr parse_source(const std::string &source)
+{
+    FILE *file = std::tmpfile();
+    if (file == nullptr) {
+        return nullptr;
+    }
+    std::fwrite(source.data(), 1, source.size(), file);
+    std::rewind(file);
+
+    hrl::lexer::HRLLexer lexer;
+    hrl::lexer::TokenBuffer tokens;
+    bool lexed = lexer.lex(file, "change_tracking.hrml", tokens);
+    std::fclose(file);
+    if (!lexed) {
+        return nullptr;
+    }
+
+    hrl::parser::ASTParser parser("change_tracking.hrml", tokens);
+    hrl::parser::CompilationUnitASTNodePtr root;
+    return parser.parse(root) ? root : nullptr;
+}
+
+} // namespace
+
+TEST(SemanticAnalysisPassManagerTests, ChangeTrackingSkipsUnchangedWork)
+{
+    ErrorManager::instance().clear();
+    auto root = parse_source(
+        "let g = 1;\n"
+        "function f(a) { let b = a; return b; }\n"
+        "function h(a) { let b = a; b = ++b; return b; }\n"
+        "sub start() { outbox(f(inbox()) + h(g)); }\n");
+    ASSERT_NE(root, nullptr);
+    auto subroutines = root->get_subroutines();
+    ASSERT_EQ(subroutines.size(), 3u);
+
+    hrl::semanalyzer::SemanticAnalysisPassManager sem_passmgr(root, std::make_shared<std::string>("change_tracking.hrml"));
+    sem_passmgr.set_change_tracking_enabled(true);
+    sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>("SymbolAnalysisPass");
+    auto ubi_first = sem_passmgr.add_pass<RecordingUBIPass>("1stUseBeforeInitializationCheckPass");
+    // nothing changed since the first check
+    auto ubi_unchanged = sem_passmgr.add_pass<RecordingUBIPass>("2ndUseBeforeInitializationCheckPass");
+    sem_passmgr.add_pass<EditIncrementsPass>("EditIncrementsPass");
+    // only h is edited
+    auto ubi_edited = sem_passmgr.add_pass<RecordingUBIPass>("3rdUseBeforeInitializationCheckPass");
+
+    ASSERT_EQ(sem_passmgr.run(true), 0);
+    EXPECT_FALSE(ErrorManager::instance().has_errors());
+
+    EXPECT_EQ(ubi_first->analyzed, subroutines);
+    EXPECT_TRUE(ubi_unchanged->analyzed.empty());
+    EXPECT_EQ(ubi_edited->analyzed, std::vector<hrl::parser::AbstractSubroutineASTNodePtr> { subroutines.at(1) });
+}
@@ -43,7 +43,7 @@ void WithParsed::setup_parse(const TestCaseData &data, bool &result)
 
     // Lexing
     hrl::lexer::HRLLexer lexer;
-    std::vector<hrl::lexer::TokenPtr> tokens;
+    hrl::lexer::TokenBuffer tokens;
     bool ok = lexer.lex(file, data.path, tokens);
     errmgr.print_all();
     ASSERT_TRUE(ok)
@@ -69,7 +69,7 @@ void WithParsed::setup_parse(const TestCaseData &data, bool &result)
     graphviz.generate_graphviz(data.filename + "-pt.dot");
 
     // Building AST
-    hrl::parser::ASTBuilder builder(compilation_unit);
+    hrl::parser::ASTBuilder builder(compilation_unit, tokens.source(), tokens.strings());
     bool built = builder.build(ast);
     errmgr.print_all();
     ASSERT_TRUE(built)
@@ -1,8 +1,7 @@
 #include "WithSemanticAnalyzed.h"
+#include "ASTSimplificationPass.h"
 #include "ClearSymbolTablePass.h"
-#include "ConstantFoldingPass.h"
 #include "ControlFlowVerificationPass.h"
-#include "DeadCodeEliminationPass.h"
 #include "ErrorManager.h"
 #include "SemanticAnalysisPassManager.h"
 #include "StripAttributePass.h"
@@ -10,6 +9,7 @@
 #include "TACGen.h"
 #include "UnusedSymbolAnalysisPass.h"
 #include "UseBeforeInitializationCheckPass.h"
+#include "VariableSlotResolutionPass.h"
 #include "WithParsed.h"
 
 WithSemanticAnalyzed::WithSemanticAnalyzed()
@@ -26,6 +26,8 @@ void WithSemanticAnalyzed::setup_semantic_analyze(bool optimize, const TestCaseD
     ASSERT_TRUE(result) << "Failed in parsing stages";
 
     hrl::semanalyzer::SemanticAnalysisPassManager sem_passmgr(ast, std::make_shared<std::string>(data.filename));
+    sem_passmgr.set_fusion_enabled(true);
+    sem_passmgr.set_change_tracking_enabled(true);
 
     // analyze, optimize and clean up
     if (optimize) {
@@ -33,8 +35,7 @@ void WithSemanticAnalyzed::setup_semantic_analyze(bool optimize, const TestCaseD
         auto pre_symtbl_analyzer = sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>("PreliminarySemanticAnalysisSymbolTableAnalyzer");
         auto ubi_preliminary = sem_passmgr.add_pass<hrl::semanalyzer::UseBeforeInitializationCheckPass>("PreliminaryUseBeforeInitializationCheckPass");
         // may mutate the node
-        auto constfolder = sem_passmgr.add_pass<hrl::semanalyzer::ConstantFoldingPass>("ConstantFoldingPass");
-        auto dce = sem_passmgr.add_pass<hrl::semanalyzer::DeadCodeEliminationPass>("DeadCodeElimination");
+        auto simplifier = sem_passmgr.add_pass<hrl::semanalyzer::ASTSimplificationPass>("ASTSimplificationPass");
         auto unused_var = sem_passmgr.add_pass<hrl::semanalyzer::UnusedSymbolAnalysisPass>("UnusedVariableElimination");
         auto clear_symtbl = sem_passmgr.add_pass<hrl::semanalyzer::ClearSymbolTablePass>("ClearSymbolTablePass");
         auto strip_sym_attr = sem_passmgr.add_pass<hrl::semanalyzer::StripAttributePass>("StripSymbolAttributesPass");
@@ -44,6 +45,7 @@ void WithSemanticAnalyzed::setup_semantic_analyze(bool optimize, const TestCaseD
     auto post_symtbl_analyzer = sem_passmgr.add_pass<hrl::semanalyzer::SymbolAnalysisPass>("FinalSemanticAnalysisSymbolTableAnalyzer");
     auto ubi_final = sem_passmgr.add_pass<hrl::semanalyzer::UseBeforeInitializationCheckPass>("FinalUseBeforeInitializationCheckPass");
     auto cfv = sem_passmgr.add_pass<hrl::semanalyzer::ControlFlowVerificationPass>("ControlFlowVerificationPass");
+    auto slot_resolver = sem_passmgr.add_pass<hrl::semanalyzer::VariableSlotResolutionPass>("VariableSlotResolutionPass");
     auto tacgen = sem_passmgr.add_pass<hrl::irgen::TACGen>("ControlFlowVerificationPass");
 
     int sema_result = sem_passmgr.run(true);
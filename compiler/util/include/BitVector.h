@@ -0,0 +1,68 @@
+#ifndef BITVECTOR_H
+#define BITVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A set of the integers below a size fixed on assignment, one bit each, for the dataflow analyses
+class BitVector {
+public:
+    BitVector() = default;
+
+    explicit BitVector(std::size_t size, bool value = false)
+    {
+        assign(size, value);
+    }
+
+    // Resize to \p size with every bit set to \p value
+    void assign(std::size_t size, bool value)
+    {
+        _size = size;
+        _words.assign((size + WORD_BITS - 1) / WORD_BITS, value ? ~std::uint64_t(0) : 0);
+        clear_padding();
+    }
+
+    // Resize to \p size. The bits added are not set.
+    void resize(std::size_t size)
+    {
+        _size = size;
+        _words.resize((size + WORD_BITS - 1) / WORD_BITS, 0);
+        clear_padding();
+    }
+
+    std::size_t size() const { return _size; }
+
+    bool test(std::size_t i) const { return (_words[i / WORD_BITS] >> (i % WORD_BITS)) & 1; }
+
+    void set(std::size_t i) { _words[i / WORD_BITS] |= std::uint64_t(1) << (i % WORD_BITS); }
+
+    void reset(std::size_t i) { _words[i / WORD_BITS] &= ~(std::uint64_t(1) << (i % WORD_BITS)); }
+
+    // Keep the bits set in both. The sizes must be the same.
+    BitVector &operator&=(const BitVector &other)
+    {
+        for (std::size_t w = 0; w < _words.size(); ++w) {
+            _words[w] &= other._words[w];
+        }
+        return *this;
+    }
+
+    bool operator==(const BitVector &other) const { return _size == other._size && _words == other._words; }
+
+private:
+    static constexpr std::size_t WORD_BITS = 64;
+
+    std::vector<std::uint64_t> _words;
+    std::size_t _size = 0;
+
+    // the bits beyond the size are always 0, so the words compare equal
+    void clear_padding()
+    {
+        if (_size % WORD_BITS != 0) {
+            _words.back() &= (std::uint64_t(1) << (_size % WORD_BITS)) - 1;
+        }
+    }
+};
+
+#endif
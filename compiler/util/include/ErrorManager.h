@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include <spdlog/spdlog.h>
 
 #include "ErrorMessage.h"
+#include "SourceFile.h"
 
 /**
  * @brief Manages error reporting and message filtering during the compilation process.
@@ -20,6 +22,8 @@
  * adding file content for detailed inline error reporting, and handling message severity (errors, warnings, and notes).
  *
  * ErrorManager is a singleton class, ensuring that there is only one instance of error management throughout the compilation process.
+ * Adding files and reporting messages are thread-safe, so the files can be lexed concurrently. A thread can also
+ * capture the messages it reports, to have them stored later in an order which doesn't depend on the threads.
  */
 class ErrorManager {
 public:
@@ -34,9 +38,9 @@ public:
      * @brief Add the file content to the ErrorManager, so the error message is able to print the inline text
      *
      * @param filename
-     * @param lines
+     * @param source The content shared with the tokens lexed from it
      */
-    void add_file(const std::string &filename, const std::vector<std::string> &lines);
+    void add_file(const std::string &filename, const SourceFilePtr &source);
 
     /**
      * @brief Add a message filter to the ErrorManager. The filter will be executed when \c print_all() is called.
@@ -82,6 +86,20 @@ public:
      */
     void report_continued(ErrorSeverity severity, const ErrorLocation &location, const std::string &message);
 
+    /**
+     * @brief Keep the messages reported on the calling thread in \p messages instead of storing them
+     *
+     * @param messages The messages are appended to it. nullptr stops capturing.
+     */
+    static void set_thread_capture(std::vector<CompilerMessage> *messages);
+
+    /**
+     * @brief Store the captured \p messages as if they were reported now, one after another
+     *
+     * @param messages
+     */
+    void report_captured(std::vector<CompilerMessage> messages);
+
     /**
      * @brief Print all errors, warnings and notes
      *
@@ -111,8 +129,9 @@ private:
     std::vector<CompilerMessage> _warnings; // Store warning messages
     std::vector<CompilerMessage> _notes; // Store note messages
     std::size_t _message_order_counter = 0; // Track message order
-    std::map<std::string, std::vector<std::string>> _lines; // Store filename -> lines
+    std::map<std::string, SourceFilePtr> _files; // Store filename -> content
     std::vector<CompilerMessageFilter> _error_filters;
+    std::mutex _mutex; // Guards the messages and the files against concurrent lexers
 
     bool apply_filters(CompilerMessage &msg) const;
     std::string msg_to_string(CompilerMessage msg) const;
@@ -0,0 +1,90 @@
+#ifndef SOURCEFILE_H
+#define SOURCEFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A byte offset into a source file. The tokens and the AST nodes keep their positions as offsets, which are
+ * turned into a line and a column only when they're printed.
+ */
+using SourceOffset = std::uint32_t;
+
+constexpr SourceOffset NO_SOURCE_OFFSET = UINT32_MAX;
+
+/**
+ * @brief The content of a source file, read once and shared by the tokens and the error messages.
+ *
+ * The file is memory-mapped when it can be, otherwise it is read into memory, such as a pipe. The views returned are
+ * valid as long as the SourceFile lives.
+ */
+class SourceFile {
+public:
+    /**
+     * @brief Read the file from its current position to the end. The position of \p in is unspecified after.
+     *
+     * @param in
+     */
+    explicit SourceFile(FILE *in);
+    ~SourceFile();
+
+    SourceFile(const SourceFile &) = delete;
+    SourceFile &operator=(const SourceFile &) = delete;
+
+    std::string_view content() const { return std::string_view(_data, _size); }
+
+    /**
+     * @brief The number of lines. A file not ending with a newline still has its last line counted.
+     */
+    std::size_t line_count() const { return _line_starts.size(); }
+
+    /**
+     * @brief The text of line \p lineno without the line break. Line starts from 1.
+     *
+     * @param lineno
+     * @return std::string_view
+     */
+    std::string_view line(std::size_t lineno) const;
+
+    /**
+     * @brief The line of the byte at \p offset, from 1. It's found in the line-start table by binary search.
+     *
+     * @param offset
+     * @return int The line, or -1 if the offset is NO_SOURCE_OFFSET
+     */
+    int lineno_at(SourceOffset offset) const;
+
+    /**
+     * @brief The column of the byte at \p offset, from 1
+     *
+     * @param offset
+     * @return int The column, or -1 if the offset is NO_SOURCE_OFFSET
+     */
+    int colno_at(SourceOffset offset) const;
+
+    /**
+     * @brief The offset of line \p lineno and column \p colno, both from 1
+     *
+     * @return SourceOffset The offset, or NO_SOURCE_OFFSET if the line is out of range
+     */
+    SourceOffset offset_at(int lineno, int colno) const;
+
+private:
+    const char *_data = nullptr;
+    std::size_t _size = 0;
+    void *_mapped = nullptr;
+    std::string _buffer; // holds the content when it is not mapped
+    std::vector<SourceOffset> _line_starts;
+
+    bool map(FILE *in);
+    void read(FILE *in);
+};
+
+using SourceFilePtr = std::shared_ptr<const SourceFile>;
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief The id of a string in a StringInterner. Equal strings of an interner have the same id, so the names are
+ * compared and hashed as integers.
+ */
+using StringId = std::uint32_t;
+
+constexpr StringId NO_STRING_ID = UINT32_MAX;
+
+/**
+ * @brief The strings of a compilation, each kept once and numbered from 0.
+ *
+ * The lexer interns the identifiers, and the AST, the symbol table and TACGen refer to them by id. The strings are
+ * never removed, so the ids and the shared strings are valid as long as the interner lives. It is not synchronized.
+ */
+class StringInterner {
+public:
+    StringInterner() = default;
+
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+    /**
+     * @brief The id of \p str, which is added if it's not interned yet
+     *
+     * @param str
+     * @return StringId
+     */
+    StringId intern(std::string_view str);
+
+    /**
+     * @brief The id of \p str without adding it
+     *
+     * @param str
+     * @return StringId The id, or NO_STRING_ID if it was never interned
+     */
+    StringId find(std::string_view str) const;
+
+    const std::string &str(StringId id) const { return *_strings[id]; }
+
+    // The string shared by everyone holding the name, instead of a copy of it
+    const std::shared_ptr<std::string> &shared(StringId id) const { return _strings[id]; }
+
+    std::size_t size() const { return _strings.size(); }
+
+private:
+    // indexed by id
+    std::vector<std::shared_ptr<std::string>> _strings;
+    // the keys view the strings above
+    std::unordered_map<std::string_view, StringId> _ids;
+};
+
+using StringInternerPtr = std::shared_ptr<StringInterner>;
+
+#endif
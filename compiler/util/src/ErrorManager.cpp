@@ -1,3 +1,4 @@
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -5,9 +6,20 @@
 #include "ErrorManager.h"
 #include "TerminalColor.h"
 
+namespace {
+// the messages of the thread are captured here instead of stored, if it's set
+thread_local std::vector<CompilerMessage> *captured_messages = nullptr;
+}
+
 void ErrorManager::report(int error_id, ErrorSeverity severity, const ErrorLocation &location, const std::string &message, const std::string &suggestion)
 {
     CompilerMessage msg(error_id, severity, location, message, suggestion);
+    if (captured_messages) {
+        captured_messages->push_back(std::move(msg));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
     msg.order = _message_order_counter++;
 
     // Store in appropriate container based on severity
@@ -107,10 +119,10 @@ std::string ErrorManager::msg_to_string(CompilerMessage msg) const
     }
     ss << msg.location.to_string() << ": " << __tc.C_HIGHLIGHT << msg.message << __tc.C_RESET;
 
-    if (_lines.contains(msg.location.file_name)) {
+    if (_files.contains(msg.location.file_name)) {
         ss << "\n"
            << __tc.C_LIGHT_GREEN;
-        ss << _lines.at(msg.location.file_name).at(msg.location.line - 1); // line starts from 1
+        ss << _files.at(msg.location.file_name)->line(msg.location.line); // line starts from 1
         ss << "\n";
         for (int i = 1; i < msg.location.column; ++i) {
             ss << ' ';
@@ -140,9 +152,10 @@ ErrorManager &ErrorManager::instance()
     return err_mgr;
 }
 
-void ErrorManager::add_file(const std::string &filename, const std::vector<std::string> &lines)
+void ErrorManager::add_file(const std::string &filename, const SourceFilePtr &source)
 {
-    _lines[filename] = lines;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _files[filename] = source;
 }
 
 bool ErrorManager::has_errors() const
@@ -181,6 +194,12 @@ void ErrorManager::add_common_filters()
 
 void ErrorManager::report(CompilerMessage message)
 {
+    if (captured_messages) {
+        captured_messages->push_back(std::move(message));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
     message.order = _message_order_counter++;
 
     // Store in appropriate container based on severity
@@ -200,6 +219,12 @@ void ErrorManager::report(CompilerMessage message)
 void ErrorManager::report_continued(ErrorSeverity severity, const ErrorLocation &location, const std::string &message)
 {
     CompilerMessage msg(severity, location, message);
+    if (captured_messages) {
+        captured_messages->push_back(std::move(msg));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
     msg.order = _message_order_counter++;
 
     // Store in appropriate container based on severity
@@ -215,3 +240,28 @@ void ErrorManager::report_continued(ErrorSeverity severity, const ErrorLocation
         break;
     }
 }
+
+void ErrorManager::set_thread_capture(std::vector<CompilerMessage> *messages)
+{
+    captured_messages = messages;
+}
+
+void ErrorManager::report_captured(std::vector<CompilerMessage> messages)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (CompilerMessage &msg : messages) {
+        msg.order = _message_order_counter++;
+
+        switch (msg.severity) {
+        case ErrorSeverity::Error:
+            _errors.push_back(std::move(msg));
+            break;
+        case ErrorSeverity::Warning:
+            _warnings.push_back(std::move(msg));
+            break;
+        case ErrorSeverity::Note:
+            _notes.push_back(std::move(msg));
+            break;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define SOURCEFILE_MMAP 1
+#endif
+
+#include "SourceFile.h"
+
+SourceFile::SourceFile(FILE *in)
+{
+    if (!map(in)) {
+        read(in);
+    }
+
+    _line_starts.push_back(0);
+    for (std::size_t i = 0; i < _size; ++i) {
+        if (_data[i] == '\n') {
+            _line_starts.push_back(static_cast<SourceOffset>(i + 1));
+        }
+    }
+}
+
+SourceFile::~SourceFile()
+{
+#ifdef SOURCEFILE_MMAP
+    if (_mapped != nullptr) {
+        munmap(_mapped, _size);
+    }
+#endif
+}
+
+std::string_view SourceFile::line(std::size_t lineno) const
+{
+    if (lineno == 0 || lineno > _line_starts.size()) {
+        throw std::out_of_range("line number is out of range");
+    }
+
+    std::size_t begin = _line_starts[lineno - 1];
+    // the next line starts after the '\n' ending this line
+    std::size_t end = lineno < _line_starts.size() ? _line_starts[lineno] - 1 : _size;
+    return std::string_view(_data + begin, end - begin);
+}
+
+int SourceFile::lineno_at(SourceOffset offset) const
+{
+    if (offset == NO_SOURCE_OFFSET) {
+        return -1;
+    }
+    // the last line starting at or before the offset
+    auto it = std::upper_bound(_line_starts.begin(), _line_starts.end(), offset);
+    return static_cast<int>(it - _line_starts.begin());
+}
+
+int SourceFile::colno_at(SourceOffset offset) const
+{
+    if (offset == NO_SOURCE_OFFSET) {
+        return -1;
+    }
+    int lineno = lineno_at(offset);
+    return static_cast<int>(offset - _line_starts[lineno - 1]) + 1;
+}
+
+SourceOffset SourceFile::offset_at(int lineno, int colno) const
+{
+    if (lineno <= 0 || static_cast<std::size_t>(lineno) > _line_starts.size()) {
+        return NO_SOURCE_OFFSET;
+    }
+    return _line_starts[lineno - 1] + static_cast<SourceOffset>(colno - 1);
+}
+
+bool SourceFile::map(FILE *in)
+{
+#ifdef SOURCEFILE_MMAP
+    // the mapping starts from the beginning of the file
+    if (std::ftell(in) != 0) {
+        return false;
+    }
+
+    int fd = fileno(in);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        return false;
+    }
+
+    void *mapped = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    _mapped = mapped;
+    _data = static_cast<const char *>(mapped);
+    _size = static_cast<std::size_t>(st.st_size);
+    return true;
+#else
+    (void)in;
+    return false;
+#endif
+}
+
+void SourceFile::read(FILE *in)
+{
+    char buf[4096];
+    std::size_t bytes_read;
+    while ((bytes_read = std::fread(buf, 1, sizeof(buf), in)) > 0) {
+        _buffer.append(buf, bytes_read);
+    }
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+}
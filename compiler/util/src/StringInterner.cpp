@@ -0,0 +1,20 @@
+#include "StringInterner.h"
+
+StringId StringInterner::intern(std::string_view str)
+{
+    auto it = _ids.find(str);
+    if (it != _ids.end()) {
+        return it->second;
+    }
+
+    StringId id = static_cast<StringId>(_strings.size());
+    _strings.push_back(std::make_shared<std::string>(str));
+    _ids.emplace(*_strings.back(), id);
+    return id;
+}
+
+StringId StringInterner::find(std::string_view str) const
+{
+    auto it = _ids.find(str);
+    return it != _ids.end() ? it->second : NO_STRING_ID;
+}
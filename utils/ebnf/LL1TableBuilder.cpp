@@ -0,0 +1,315 @@
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "ASTNode.h"
+#include "LL1TableBuilder.h"
+
+bool LL1TableBuilder::build()
+{
+    _state = std::make_unique<VisitState>();
+
+    for (const auto &production : _root_node->productions) {
+        if (_state->production_map.contains(production->id)) {
+            spdlog::error("Rules are conflicting: {}", production->id);
+            return false;
+        }
+        _state->productions.push_back(production);
+        _state->production_map[production->id] = production;
+    }
+
+    if (!_state->production_map.contains(_root_syntax_name)) {
+        spdlog::error("Root symbol '{0}' was not found", _root_syntax_name);
+        return false;
+    }
+
+    compute_first_set();
+    compute_follow_set();
+
+    // The table only speaks tokens. Literals and undefined rules would have no id to look up by.
+    bool ok = true;
+    std::set<std::string> terminals;
+    for (const auto &[production, first] : _state->first_set) {
+        terminals.insert(first.begin(), first.end());
+    }
+    for (const auto &[production, follow] : _state->follow_set) {
+        terminals.insert(follow.begin(), follow.end());
+    }
+    for (const auto &terminal : terminals) {
+        if (!_tokens.contains(terminal) && terminal != END_OF_INPUT) {
+            spdlog::error("'{}' is not a token. Declare it as a token to build the LL(1) table.", terminal);
+            ok = false;
+        }
+    }
+    if (!ok) {
+        return false;
+    }
+
+    _state->columns.assign(_tokens.begin(), _tokens.end());
+    _state->columns.push_back(END_OF_INPUT);
+
+    compute_prediction_table();
+    return true;
+}
+
+void LL1TableBuilder::compute_first_set()
+{
+    // Iterate until no changes occur. Left recursion simply adds nothing new.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto &production : _state->productions) {
+            std::set<std::string> first;
+            bool nullable = first_of(production->expression, first);
+
+            auto &current_first = _state->first_set[production->id];
+            auto size_before = current_first.size();
+            current_first.insert(first.begin(), first.end());
+            if (current_first.size() != size_before) {
+                changed = true;
+            }
+
+            if (nullable && !_state->nullable[production->id]) {
+                _state->nullable[production->id] = true;
+                changed = true;
+            }
+        }
+    }
+}
+
+void LL1TableBuilder::compute_follow_set()
+{
+    /*
+    Dragon book Section 4.4.2:
+        - Add the end-of-input marker ('$') to the FOLLOW set of the start symbol.
+        - For a production A -> aBb, add FIRST(b) - {e} to FOLLOW(B).
+        - For a production A -> aB or if b can derive e, add FOLLOW(A) to FOLLOW(B).
+    */
+    _state->follow_set[_root_syntax_name].insert(END_OF_INPUT);
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto &production : _state->productions) {
+            // copy, the FOLLOW of the production itself may grow while we walk it
+            std::set<std::string> after = _state->follow_set[production->id];
+            if (follow_of(production->expression, after)) {
+                changed = true;
+            }
+        }
+    }
+}
+
+void LL1TableBuilder::compute_prediction_table()
+{
+    for (const auto &production : _state->productions) {
+        auto &row = _state->prediction_table[production->id];
+        std::map<std::string, std::set<int>> predicted_by;
+
+        const auto &alternatives = production->expression->terms;
+        for (std::size_t i = 0; i < alternatives.size(); ++i) {
+            std::set<std::string> predict;
+            if (first_of(alternatives[i], predict)) {
+                const auto &follow = _state->follow_set[production->id];
+                predict.insert(follow.begin(), follow.end());
+            }
+
+            for (const auto &token : predict) {
+                predicted_by[token].insert(static_cast<int>(i));
+            }
+        }
+
+        for (const auto &[token, predicted] : predicted_by) {
+            if (predicted.size() == 1) {
+                row[token] = *predicted.begin();
+            } else {
+                _state->conflicts.push_back(LL1Conflict { production->id, token, predicted });
+            }
+        }
+    }
+}
+
+bool LL1TableBuilder::first_of(const ExpressionNodePtr &node, std::set<std::string> &first)
+{
+    bool nullable = false;
+    for (const auto &term : node->terms) {
+        if (first_of(term, first)) {
+            nullable = true;
+        }
+    }
+    return nullable;
+}
+
+bool LL1TableBuilder::first_of(const TermNodePtr &node, std::set<std::string> &first)
+{
+    for (const auto &factor : node->factors) {
+        if (!first_of(factor, first)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LL1TableBuilder::first_of(const FactorNodePtr &node, std::set<std::string> &first)
+{
+    if (node->literal) {
+        first.insert(node->literal->value);
+        return false;
+    }
+
+    if (node->identifier) {
+        const std::string &id = node->identifier->value;
+        if (!_state->production_map.contains(id)) {
+            // it's a token
+            first.insert(id);
+            return false;
+        }
+        const auto &referenced = _state->first_set[id];
+        first.insert(referenced.begin(), referenced.end());
+        return _state->nullable[id];
+    }
+
+    if (auto optional = std::dynamic_pointer_cast<OptionalNode>(node->node)) {
+        first_of(std::static_pointer_cast<ExpressionNode>(optional->expression), first);
+        return true;
+    } else if (auto repeated = std::dynamic_pointer_cast<RepeatedNode>(node->node)) {
+        first_of(std::static_pointer_cast<ExpressionNode>(repeated->expression), first);
+        return true;
+    } else if (auto grouped = std::dynamic_pointer_cast<GroupedNode>(node->node)) {
+        return first_of(std::static_pointer_cast<ExpressionNode>(grouped->expression), first);
+    } else if (auto epsilon = std::dynamic_pointer_cast<EpsilonNode>(node->node)) {
+        return true;
+    }
+
+    spdlog::critical("node is not literal nor identifier nor having another node. {}", __PRETTY_FUNCTION__);
+    throw;
+}
+
+bool LL1TableBuilder::follow_of(const ExpressionNodePtr &node, const std::set<std::string> &after)
+{
+    bool changed = false;
+    for (const auto &term : node->terms) {
+        if (follow_of(term, after)) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool LL1TableBuilder::follow_of(const TermNodePtr &node, const std::set<std::string> &after)
+{
+    bool changed = false;
+    // walk backwards, what follows a factor is what the factors after it may start with
+    std::set<std::string> current_after = after;
+    for (auto it = node->factors.rbegin(); it != node->factors.rend(); ++it) {
+        if (follow_of(*it, current_after)) {
+            changed = true;
+        }
+
+        std::set<std::string> first;
+        if (!first_of(*it, first)) {
+            current_after.clear();
+        }
+        current_after.insert(first.begin(), first.end());
+    }
+    return changed;
+}
+
+bool LL1TableBuilder::follow_of(const FactorNodePtr &node, const std::set<std::string> &after)
+{
+    if (node->literal) {
+        return false;
+    }
+
+    if (node->identifier) {
+        auto it = _state->production_map.find(node->identifier->value);
+        if (it == _state->production_map.end()) {
+            return false;
+        }
+        auto &follow = _state->follow_set[it->first];
+        auto size_before = follow.size();
+        follow.insert(after.begin(), after.end());
+        return follow.size() != size_before;
+    }
+
+    if (auto optional = std::dynamic_pointer_cast<OptionalNode>(node->node)) {
+        return follow_of(std::static_pointer_cast<ExpressionNode>(optional->expression), after);
+    } else if (auto repeated = std::dynamic_pointer_cast<RepeatedNode>(node->node)) {
+        // the repeated part may be followed by another repetition
+        auto expression = std::static_pointer_cast<ExpressionNode>(repeated->expression);
+        std::set<std::string> repeated_after = after;
+        first_of(expression, repeated_after);
+        return follow_of(expression, repeated_after);
+    } else if (auto grouped = std::dynamic_pointer_cast<GroupedNode>(node->node)) {
+        return follow_of(std::static_pointer_cast<ExpressionNode>(grouped->expression), after);
+    } else if (auto epsilon = std::dynamic_pointer_cast<EpsilonNode>(node->node)) {
+        return false;
+    }
+
+    spdlog::critical("node is not literal nor identifier nor having another node. {}", __PRETTY_FUNCTION__);
+    throw;
+}
+
+bool LL1TableBuilder::get_productions(std::vector<ProductionNodePtr> &productions)
+{
+    if (_state) {
+        productions = _state->productions;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool LL1TableBuilder::get_columns(std::vector<std::string> &columns)
+{
+    if (_state) {
+        columns = _state->columns;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool LL1TableBuilder::get_first_set(std::map<std::string, std::set<std::string>> &firsts)
+{
+    if (_state) {
+        firsts = _state->first_set;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool LL1TableBuilder::get_follow_set(std::map<std::string, std::set<std::string>> &follows)
+{
+    if (_state) {
+        follows = _state->follow_set;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool LL1TableBuilder::get_prediction_table(std::map<std::string, std::map<std::string, int>> &table)
+{
+    if (_state) {
+        table = _state->prediction_table;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool LL1TableBuilder::get_conflicts(std::vector<LL1Conflict> &conflicts)
+{
+    if (_state) {
+        conflicts = _state->conflicts;
+        return true;
+    } else {
+        return false;
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef LL1TABLEBUILDER_H
+#define LL1TABLEBUILDER_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ASTNodeForward.h"
+
+struct LL1Conflict {
+    std::string production;
+    std::string token;
+    // indices of the alternatives predicted by the token
+    std::set<int> alternatives;
+};
+
+/*
+Build the LL(1) prediction table of the grammar: for every production and every token, which alternative of the
+production to take when the token is the lookahead.
+
+The FIRST and FOLLOW sets are computed to a fixpoint over the syntax tree, so the nullable optionals and repeats are
+taken into account. The alternative i of production A is predicted by FIRST(alternative i), and also by FOLLOW(A)
+if the alternative can be empty. A token predicting more than one alternative is a conflict.
+*/
+class LL1TableBuilder {
+public:
+    // The marker of the end of input in FOLLOW sets
+    static constexpr const char *END_OF_INPUT = "$";
+
+    LL1TableBuilder(SyntaxNodePtr root, std::set<std::string> tokens, const std::string &root_syntax_name)
+        : _root_node(root)
+        , _tokens(tokens)
+        , _root_syntax_name(root_syntax_name)
+    {
+    }
+
+    virtual ~LL1TableBuilder()
+    {
+    }
+
+    virtual bool build();
+
+    // Productions in the order they're defined
+    virtual bool get_productions(std::vector<ProductionNodePtr> &productions);
+    // Tokens in the order of the table columns, END_OF_INPUT the last
+    virtual bool get_columns(std::vector<std::string> &columns);
+    virtual bool get_first_set(std::map<std::string, std::set<std::string>> &firsts);
+    virtual bool get_follow_set(std::map<std::string, std::set<std::string>> &follows);
+    // map<production, map<token, alternative>>. The conflicting tokens are not in the map.
+    virtual bool get_prediction_table(std::map<std::string, std::map<std::string, int>> &table);
+    virtual bool get_conflicts(std::vector<LL1Conflict> &conflicts);
+
+protected:
+    virtual void compute_first_set();
+    virtual void compute_follow_set();
+    virtual void compute_prediction_table();
+
+    // FIRST of the node, and whether it can derive the empty string
+    virtual bool first_of(const ExpressionNodePtr &node, std::set<std::string> &first);
+    virtual bool first_of(const TermNodePtr &node, std::set<std::string> &first);
+    virtual bool first_of(const FactorNodePtr &node, std::set<std::string> &first);
+
+    // Propagate the FOLLOW to the productions referenced under the node, with \p after following the node.
+    // Returns whether any FOLLOW set grew.
+    virtual bool follow_of(const ExpressionNodePtr &node, const std::set<std::string> &after);
+    virtual bool follow_of(const TermNodePtr &node, const std::set<std::string> &after);
+    virtual bool follow_of(const FactorNodePtr &node, const std::set<std::string> &after);
+
+    SyntaxNodePtr _root_node;
+    std::set<std::string> _tokens;
+    std::string _root_syntax_name;
+
+    struct VisitState {
+        std::vector<ProductionNodePtr> productions;
+        std::map<std::string, ProductionNodePtr> production_map;
+        std::vector<std::string> columns;
+
+        std::map<std::string, bool> nullable;
+        std::map<std::string, std::set<std::string>> first_set;
+        std::map<std::string, std::set<std::string>> follow_set;
+
+        std::map<std::string, std::map<std::string, int>> prediction_table;
+        std::vector<LL1Conflict> conflicts;
+    };
+
+    std::unique_ptr<VisitState> _state;
+};
+
+#endif
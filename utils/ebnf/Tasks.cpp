@@ -7,6 +7,8 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -19,6 +21,7 @@
 
 #include "ASTNode.h"
 #include "DependencyGraphAnalyzer.h"
+#include "LL1TableBuilder.h"
 
 #include "Tasks.h"
 
@@ -143,6 +146,199 @@ const std::map<std::string, std::set<std::string>> __ebnf_first_set_token {
     std::cout << "Written to " << header_filename << " and " << source_filename << std::endl;
 }
 
+static std::string ll1_column_name(const std::string &column)
+{
+    return column == LL1TableBuilder::END_OF_INPUT ? "EndOfInput" : column;
+}
+
+static void write_ll1_table_file(const std::string &path, LL1TableBuilder &builder)
+{
+    // templates
+    const std::string header_template =
+        R"(
+#ifndef %1%_H
+#define %1%_H
+
+#if defined(_MSVC_LANG)
+    #define CXX_STD _MSVC_LANG
+#else
+    #define CXX_STD __cplusplus
+#endif
+
+#if CXX_STD < 202002L
+    #error "This code requires at least C++20. Please use a compiler that supports C++20 or higher."
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// X(token) for every token of the grammar, in the order of the columns of the table
+#define EBNF_TOKENS(X) \
+%2%
+
+// The columns of the table. EndOfInput is the end of input.
+enum class EbnfToken : std::size_t {
+#define EBNF_TOKEN_ENUMERATOR(token) token,
+    EBNF_TOKENS(EBNF_TOKEN_ENUMERATOR)
+#undef EBNF_TOKEN_ENUMERATOR
+    EndOfInput,
+};
+
+// The rows of the table, in the order the rules are defined
+enum class EbnfProduction : std::size_t {
+%3%
+};
+
+constexpr std::size_t EBNF_TOKEN_COUNT = %4%;
+constexpr std::size_t EBNF_PRODUCTION_COUNT = %5%;
+
+// None of the alternatives of the rule starts with the token
+constexpr int EBNF_NO_ALTERNATIVE = -1;
+// More than one alternative of the rule may start with the token. The parser decides by other means.
+constexpr int EBNF_CONFLICT = -2;
+
+// The indices of the alternatives, for the rules whose alternatives are each a single rule or token
+namespace ebnf_alternatives {
+%6%
+}
+
+// __ebnf_ll1_prediction_table[production][token] is the alternative of the rule to take on the lookahead token
+constexpr std::array<std::array<std::int8_t, EBNF_TOKEN_COUNT>, EBNF_PRODUCTION_COUNT> __ebnf_ll1_prediction_table = []() {
+    std::array<std::array<std::int8_t, EBNF_TOKEN_COUNT>, EBNF_PRODUCTION_COUNT> table {};
+    for (auto &row : table) {
+        row.fill(EBNF_NO_ALTERNATIVE);
+    }
+
+#define EBNF_CELL(production, token) table[static_cast<std::size_t>(EbnfProduction::production)][static_cast<std::size_t>(EbnfToken::token)]
+%7%
+#undef EBNF_CELL
+
+    return table;
+}();
+
+#endif // %1%_H
+)";
+
+    std::filesystem::path filepath(path);
+    std::string filename_base = filepath.filename().string();
+    std::string filename_base_capital(filename_base);
+    std::transform(filename_base_capital.begin(), filename_base_capital.end(), filename_base_capital.begin(), ::toupper);
+
+    std::vector<ProductionNodePtr> productions;
+    std::vector<std::string> columns;
+    std::map<std::string, std::map<std::string, int>> table;
+    std::vector<LL1Conflict> conflicts;
+    builder.get_productions(productions);
+    builder.get_columns(columns);
+    builder.get_prediction_table(table);
+    builder.get_conflicts(conflicts);
+
+    std::vector<std::string> token_macro_lines;
+    for (const auto &column : columns) {
+        if (column != LL1TableBuilder::END_OF_INPUT) {
+            token_macro_lines.push_back((boost::format("    X(%1%) \\") % column).str());
+        }
+    }
+    token_macro_lines.push_back("    /* end */");
+
+    std::vector<std::string> production_enumerators;
+    std::vector<std::string> alternative_namespaces;
+    std::vector<std::string> cells;
+    for (const auto &production : productions) {
+        production_enumerators.push_back((boost::format("    %1%,") % production->id).str());
+
+        // name the alternatives after the rule or token they consist of
+        const auto &terms = production->expression->terms;
+        std::vector<std::string> alternative_names;
+        for (const auto &term : terms) {
+            if (term->factors.size() == 1 && term->factors.front()->identifier) {
+                alternative_names.push_back(term->factors.front()->identifier->value);
+            }
+        }
+        std::set<std::string> unique_names(alternative_names.begin(), alternative_names.end());
+        bool all_named = alternative_names.size() == terms.size() && unique_names.size() == terms.size();
+        if (terms.size() > 1 && all_named) {
+            std::vector<std::string> constants;
+            for (std::size_t i = 0; i < alternative_names.size(); ++i) {
+                constants.push_back((boost::format("    constexpr int %1% = %2%;") % alternative_names[i] % i).str());
+            }
+            alternative_namespaces.push_back((boost::format("namespace %1% {\n%2%\n}") % production->id % boost::join(constants, "\n")).str());
+        }
+
+        auto describe = [&](int alternative) {
+            return all_named ? alternative_names[alternative] : (boost::format("alternative %1%") % alternative).str();
+        };
+
+        cells.push_back((boost::format("\n    // %1%") % production->id).str());
+        const auto &row = table[production->id];
+        for (const auto &column : columns) {
+            auto it = row.find(column);
+            if (it != row.end()) {
+                cells.push_back((boost::format("    EBNF_CELL(%1%, %2%) = %3%; // %4%") % production->id % ll1_column_name(column) % it->second % describe(it->second)).str());
+            }
+        }
+        for (const auto &conflict : conflicts) {
+            if (conflict.production == production->id) {
+                std::vector<std::string> predicted;
+                for (int alternative : conflict.alternatives) {
+                    predicted.push_back(describe(alternative));
+                }
+                cells.push_back((boost::format("    EBNF_CELL(%1%, %2%) = EBNF_CONFLICT; // %3%") % production->id % ll1_column_name(conflict.token) % boost::join(predicted, ", ")).str());
+            }
+        }
+    }
+
+    // Write the contents
+    std::string header_filename = path + ".h";
+    std::ofstream header_file(header_filename);
+    if (!header_file) {
+        spdlog::error("Could not open the file {} for writing.", header_filename);
+    }
+    header_file
+        << boost::format(header_template)
+            % filename_base_capital
+            % boost::join(token_macro_lines, "\n")
+            % boost::join(production_enumerators, "\n")
+            % columns.size()
+            % productions.size()
+            % boost::join(alternative_namespaces, "\n")
+            % boost::join(cells, "\n");
+    if (header_file.fail()) {
+        spdlog::error("Failed to write to the file {}.", header_filename);
+    }
+    header_file.close();
+
+    std::cout << "Written to " << header_filename << std::endl;
+}
+
+void build_ll1_table(LL1TableBuilder &builder, const std::string &output_path)
+{
+    if (!builder.build()) {
+        spdlog::error("Failed to build the LL(1) table");
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::vector<LL1Conflict> conflicts;
+    builder.get_conflicts(conflicts);
+
+    std::cout << "LL(1) conflict(s):" << std::endl;
+    for (const auto &conflict : conflicts) {
+        std::vector<std::string> alternatives;
+        for (int alternative : conflict.alternatives) {
+            alternatives.push_back(std::to_string(alternative));
+        }
+        std::cout
+            << boost::format("LL(1) conflict: %1% predicts alternatives %2% of rule '%3%'") % conflict.token % boost::join(alternatives, ", ") % conflict.production
+            << std::endl;
+    }
+    std::cout << std::endl;
+
+    if (!output_path.empty()) {
+        write_ll1_table_file(output_path, builder);
+    }
+}
+
 void calculate_first_follow_set(DependencyGraphAnalyzer &checker, bool check_conflicts, const std::string &output_path)
 {
     std::map<std::string, std::set<FirstSetElement>> first_set;
@@ -4,10 +4,12 @@
 #include <string>
 
 class DependencyGraphAnalyzer;
+class LL1TableBuilder;
 
 void calculate_first_follow_set(DependencyGraphAnalyzer &checker, bool check_conflicts, const std::string &output_path);
 void check_unreachable(DependencyGraphAnalyzer &checker);
 void check_non_left_circular(DependencyGraphAnalyzer &checker);
 void check_left_recursion(DependencyGraphAnalyzer &checker);
+void build_ll1_table(LL1TableBuilder &builder, const std::string &output_path);
 
 #endif
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "ASTNodeVisitor.h"
 #include "DependencyGraphAnalyzer.h"
 #include "DependencyGraphBuilder.h"
+#include "LL1TableBuilder.h"
 #include "Tasks.h"
 
 namespace po = boost::program_options;
@@ -33,6 +34,7 @@ struct Arguments {
     std::string token_file;
     std::string graphviz_output;
     std::string first_follow_output;
+    std::string ll1_table_output;
     bool graphviz_requested = false;
     bool check_left_recursion = false;
     bool check_non_left_circular = false;
@@ -40,6 +42,7 @@ struct Arguments {
     bool calculate_first_set = false;
     bool reprint_ebnf = false;
     bool check_conflicts = false;
+    bool build_ll1_table = false;
 };
 
 void read_tokens_from_file(const std::string &file_path, std::set<std::string> &tokens)
@@ -86,6 +89,8 @@ Options:
   -F, --first-follow-set [file] Calculate the first and follow sets, also enforcing a left recursion check.
                               Optionally, write the C++ FIRST and FOLLOW maps. (FOLLOW is not yet supported)
   -N, --conflicts             Check for conflicts in the grammar.
+  -T, --ll1-table [file]      Build the LL(1) prediction table and report its conflicts.
+                              Optionally, write the table as a C++ constexpr header.
   -R, --reprint-ebnf          Reprint the grammar in Extended Backus-Naur Form (EBNF).
   -h, --help                  Display this help message and exit.
   -v, --version               Display the program version and exit.
@@ -119,6 +124,7 @@ Arguments parse_arguments(int argc, char **argv)
         ("unreachable,U", po::bool_switch(&args.check_unreachable), "Check for unreachable symbols") //
         ("first-follow-set,F", po::value<std::string>(&args.first_follow_output)->implicit_value(""), "Calculate the first-follow set") //
         ("conflicts,N", po::bool_switch(&args.check_conflicts), "Check for conflicts") //
+        ("ll1-table,T", po::value<std::string>(&args.ll1_table_output)->implicit_value(""), "Build the LL(1) prediction table") //
         ("reprint-ebnf,R", po::bool_switch(&args.reprint_ebnf), "Reprint the EBNF") //
         ("help,h", "Show help message") //
         ("version,v", "Show version information");
@@ -177,6 +183,10 @@ Arguments parse_arguments(int argc, char **argv)
         args.check_left_recursion = true; // Enforce left recursion check as in the original code
     }
 
+    if (vm.count("ll1-table")) {
+        args.build_ll1_table = true;
+    }
+
     return args;
 }
 
@@ -250,5 +260,10 @@ int main(int argc, char **argv)
         calculate_first_follow_set(checker, args.check_conflicts, args.first_follow_output);
     }
 
+    if (args.build_ll1_table) {
+        LL1TableBuilder ll1_builder(root, args.tokens, args.start_symbol);
+        build_ll1_table(ll1_builder, args.ll1_table_output);
+    }
+
     return 0;
 }